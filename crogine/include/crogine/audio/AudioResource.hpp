@@ -34,8 +34,10 @@ source distribution.
 #include <crogine/audio/AudioSource.hpp>
 
 #include <string>
+#include <vector>
 #include <unordered_map>
 #include <memory>
+#include <future>
 
 namespace cro
 {
@@ -46,6 +48,10 @@ namespace cro
 
     Note that this should have its life span outlive any instances of a Scene
     which use it, so that buffers in use are properly freed upon destruction.
+
+    Non-streaming sources are shared by path: loading a file which is already
+    loaded, or currently being loaded asynchronously, maps the new ID to the
+    existing buffer rather than decoding the file again.
     */
     class CRO_EXPORT_API AudioResource final
     {
@@ -61,6 +67,8 @@ namespace cro
 
         /*!
         \brief Loads an audio file and maps the resulting data to the given ID
+        If a non-streaming file at the given path has already been loaded the
+        ID is mapped to the existing buffer.
         \param id Unique ID to map to the new data source. If the ID is in use this will fail.
         \param path String containing the path to the file to load.
         \param streaming If set to true the requested file should be streamed from storage
@@ -80,6 +88,35 @@ namespace cro
         */
         std::int32_t load(const std::string& path, bool streaming = false);
 
+        /*!
+        \brief Loads an audio file in the background and maps it to the given ID.
+        The file is decoded on a worker thread and the buffer created on the
+        main thread by the App, within its upload budget. Until then get()
+        returns an empty buffer for this ID. Streaming sources only open their
+        file when loaded, so are loaded immediately.
+        \param id Unique ID to map to the new data source. If the ID is in use this will fail.
+        \param path String containing the path to the file to load.
+        \param streaming If set to true the requested file should be streamed from storage
+        rather than loaded entirely into RAM
+        \returns A future which becomes ready with the result once the buffer is created.
+        \see App::setUploadBudget()
+        */
+        std::future<bool> loadAsync(std::int32_t id, const std::string& path, bool streaming = false);
+
+        /*!
+        \brief Decodes a list of (non-streaming) audio files in parallel.
+        The files are decoded on the worker threads and this function blocks
+        until they are all done, after which the buffers are created on the
+        calling thread. Each file is mapped to an auto ID in the same way as
+        load(path), so subsequent calls to load() with any of these paths
+        return immediately. Use this when loading a level to load many sound
+        effects at once, rather than decoding them one after the other.
+        \param paths A vector of paths to the files to load. Paths which are
+        already loaded are skipped.
+        \returns The number of files successfully loaded.
+        */
+        std::size_t preload(const std::vector<std::string>& paths);
+
         /*!
         \brief Attempts to return the loaded data mapped to the given ID
         If the requested ID is not found an empty buffer will be returned
@@ -89,7 +126,22 @@ namespace cro
     private:
 
         std::unique_ptr<AudioSource> m_fallback;
-        std::unordered_map<std::int32_t, std::unique_ptr<AudioSource>> m_sources;
+        std::unordered_map<std::int32_t, std::shared_ptr<AudioSource>> m_sources;
         std::unordered_map<std::string, std::int32_t> m_usedPaths;
+
+        //sources loaded asynchronously are stored here until the next
+        //call to load(). Held by pointer so pending loads can tell if
+        //this has been destroyed.
+        struct AsyncState final
+        {
+            std::unordered_map<std::int32_t, std::string> pending;
+            std::unordered_map<std::int32_t, std::pair<std::string, std::shared_ptr<AudioSource>>> loaded;
+
+            //paths currently being decoded, with any other IDs
+            //requested for the same path while it was in flight
+            std::unordered_map<std::string, std::vector<std::pair<std::int32_t, std::shared_ptr<std::promise<bool>>>>> inFlight;
+        };
+        std::shared_ptr<AsyncState> m_asyncState;
+        void flushAsync();
     };
 }
\ No newline at end of file
@@ -0,0 +1,131 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/core/Clock.hpp>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Renders audio without an audio device, faster than real time.
+    While active all audio is mixed by crogine's software mixer, one
+    block at a time, only when render() is called. This allows scenes,
+    AudioScapes, the AudioMixer and any streams to be exercised on
+    machines with no audio hardware, such as CI runners or dedicated
+    servers, and reports the cost of decoding and mixing so that voice
+    budgets can be sized and performance regressions caught.
+
+    begin() replaces the active audio renderer, so it must be called
+    before any AudioResources are loaded or AudioEmitters are created.
+    */
+    class CRO_EXPORT_API OfflineAudioRenderer final
+    {
+    public:
+        /*!
+        \brief An action performed at a given time during render().
+        Use these to script plays, stops, seeks and mixer changes.
+        */
+        struct Event final
+        {
+            Time time;
+            std::function<void()> action;
+        };
+
+        /*!
+        \brief Performance counters collected during render()
+        */
+        struct Statistics final
+        {
+            float renderedSeconds = 0.f; //!< Duration of the audio rendered
+            float elapsedSeconds = 0.f; //!< Time taken to render it
+            float realtimeFactor = 0.f; //!< renderedSeconds / elapsedSeconds
+
+            std::uint64_t decodedFrames = 0; //!< Sample frames decoded from buffers and streams
+            float decodeSeconds = 0.f; //!< Time spent decoding them
+            float decodeThroughput = 0.f; //!< Frames decoded per second
+
+            std::uint64_t mixedVoiceFrames = 0; //!< Sample frames mixed, summed over all voices
+            float mixSeconds = 0.f; //!< Time spent mixing
+            float voiceCost = 0.f; //!< Time, in microseconds, to mix one voice for one second of audio
+
+            std::uint64_t streamRefills = 0; //!< Number of times stream data was decoded
+            float averageRefillMs = 0.f; //!< Average time taken to decode stream data
+            float maxRefillMs = 0.f; //!< Longest time taken to decode stream data
+            std::uint64_t streamUnderruns = 0; //!< Blocks where a stream had too little data to play
+        };
+
+        /*!
+        \brief Replaces the active audio renderer with the offline renderer.
+        \param outputPath Optional path to which to write the rendered audio,
+        as a 16 bit stereo wav file. If this is empty the output is discarded.
+        \returns true on success
+        */
+        static bool begin(const std::string& outputPath = {});
+
+        /*!
+        \brief Renders audio for the given duration.
+        The duration is rendered in blocks of around 10ms. Before each block
+        any Events in the script which are due are performed, followed by
+        the update function with the duration of the block in seconds -
+        usually this would call Scene::simulate() so that AudioSystems and
+        AudioPlayerSystems are updated. Counters are reset on each call.
+        \param duration Amount of audio to render
+        \param script Events to perform while rendering. Times are relative
+        to the start of this render.
+        \param update Optional function called once per block
+        \returns Statistics collected while rendering
+        */
+        static Statistics render(Time duration, std::vector<Event> script = {}, const std::function<void(float)>& update = {});
+
+        /*!
+        \brief Stops offline rendering, completing the output file.
+        If a valid audio renderer was active when begin() was called it
+        is restored, else audio is disabled. As with begin() this invalidates
+        all loaded audio resources.
+        */
+        static void end();
+
+        /*!
+        \brief Returns true between calls to begin() and end()
+        */
+        static bool isActive();
+
+        /*!
+        \brief Logs the given Statistics to the console
+        */
+        static void logStatistics(const Statistics&);
+    };
+}
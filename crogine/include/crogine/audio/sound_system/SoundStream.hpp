@@ -32,7 +32,6 @@ source distribution.
 #include <crogine/audio/sound_system/SoundSource.hpp>
 
 #include <array>
-#include <thread>
 #include <mutex>
 
 namespace cro
@@ -121,7 +120,8 @@ namespace cro
         \brief Request a new chunk of audio data from the stream
 
         This must be implemented by derived classes to provide the audio
-        data to the stream. It is called continuously by the stream thread.
+        data to the stream. It is called continuously by the streaming thread,
+        which is shared by all streams, so should avoid blocking.
 
         Returning false from this function will stop the current playback,
         else return true to continue playing. When returning true the
@@ -158,7 +158,7 @@ namespace cro
         static constexpr std::size_t BufferCount = 3;
         static constexpr std::size_t BufferRetries = 2;
 
-        std::thread m_thread;
+        std::uint32_t m_streamJob;
         mutable std::recursive_mutex m_mutex;
         Status m_startState;
         bool m_isStreaming;
@@ -170,8 +170,15 @@ namespace cro
         std::uint64_t m_samplesProcessed;
         std::int32_t m_processingInterval;
         std::array<std::int64_t, BufferCount> m_bufferSeeks = {};
+        bool m_buffersCreated;
+        bool m_requestStop;
+        std::size_t m_chunkSampleCount;
 
-        void threadFunc(); //called by stream's thread
+        //called by the streaming thread. Returns the number of milliseconds
+        //until the stream next needs updating, or -1 once the stream has finished
+        std::int32_t update();
+
+        void destroyBuffers();
 
         [[nodiscard]] bool fillAndPushBuffer(std::uint32_t bufferID, bool loopImmediate = false); //returns true if the stream requests to stop
 
@@ -179,9 +186,9 @@ namespace cro
 
         void clearQueue();
 
-        void launchThread(Status initialState);
+        void launchStream(Status initialState);
 
-        void waitThread();
+        void waitStream();
 
     };
 }
\ No newline at end of file
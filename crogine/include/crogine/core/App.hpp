@@ -142,6 +142,19 @@ namespace cro
         */
         void saveScreenshot();
 
+        /*!
+        \brief Sets the time, in milliseconds, spent each frame creating
+        GPU and audio resources for assets which were loaded asynchronously,
+        for example with TextureResource::loadAsync(). At least one asset
+        is always processed each frame. Defaults to 2ms.
+        */
+        void setUploadBudget(float milliseconds) { m_uploadBudget = milliseconds; }
+
+        /*!
+        \brief Returns the current asynchronous upload budget, in milliseconds.
+        */
+        float getUploadBudget() const { return m_uploadBudget; }
+
     protected:
         
         virtual void handleEvent(const Event&) = 0;
@@ -206,6 +219,7 @@ namespace cro
         Colour m_clearColour;
         HiResTimer* m_frameClock;
         bool m_running;
+        float m_uploadBudget;
 
         void handleEvents();
 
@@ -42,6 +42,7 @@ source distribution.
 #include <crogine/detail/glm/vec4.hpp>
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <sstream>
 
@@ -55,7 +56,7 @@ namespace cro
     class CRO_EXPORT_API ConfigItem
     {
     public:
-        ConfigItem(const std::string& name);
+        ConfigItem(std::string name);
         virtual ~ConfigItem() = default;
         ConfigItem(const ConfigItem&) = default;
         ConfigItem& operator = (const ConfigItem&) = default;
@@ -72,8 +73,10 @@ namespace cro
         ConfigItem* getParent() const;
         void setName(const std::string& name);
     private:
+        friend class ConfigObject;
         ConfigItem* m_parent;
         std::string m_name;
+        std::uint64_t m_nameHash; //compared before m_name when searching
     };
     
     /*!
@@ -84,7 +87,7 @@ namespace cro
     {
         friend class ConfigObject;
     public:
-        ConfigProperty(const std::string& name, const std::string& value);
+        ConfigProperty(std::string name, std::string value);
 
         /*!
         \brief Attempts to retrieve the value as the requested type.
@@ -123,7 +126,7 @@ namespace cro
     {
     public:
         using NameValue = std::pair<std::string, std::string>;
-        ConfigObject(const std::string& name = "", const std::string& id = "");
+        ConfigObject(std::string name = "", std::string id = "");
 
         /*! 
         \brief Get the id of the object
@@ -133,7 +136,7 @@ namespace cro
         /*!
         \brief Sets the ID of this object
         */
-        void setId(const std::string id) { m_id = id; }
+        void setId(const std::string& id);
 
         /*!
         \brief Returns a pointer to the property if found, else nullptr
@@ -254,18 +257,35 @@ namespace cro
         */
         bool loadFromFile(const std::string& path, bool relative = true);
 
+        /*!
+        \brief Sets a directory in which a binary copy of each successfully
+        parsed config file is stored.
+        Subsequent calls to loadFromFile() read the binary copy instead of
+        parsing the text, provided the modification time and size of the
+        original file have not changed. Files read from a mounted archive
+        or parsed as json are not cached. The directory is created if it
+        does not exist. Pass an empty string to disable caching (the default).
+        */
+        static void setCacheDirectory(const std::string& path);
+
     private:
         std::string m_id;
+        std::uint64_t m_idHash;
         std::vector<ConfigProperty> m_properties;
         std::vector<ConfigObject> m_objects;
 
-        static NameValue getObjectName(const std::string& line);
-        static NameValue getPropertyName(const std::string& line);
-        static bool isProperty(const std::string& line);
-        static void removeComment(std::string& line);
-
+        bool parseText(std::string_view data, const std::string& path);
         bool parseAsJson(SDL_RWops*);
 
+        bool loadFromCache(const std::string& path);
+        void writeCache(const std::string& path) const;
+        bool readBinary(const std::uint8_t*& data, const std::uint8_t* end);
+        void writeBinary(std::vector<std::uint8_t>& dst) const;
+
+        ConfigProperty* findProperty(std::string_view name, std::uint64_t hash) const;
+        ConfigObject* findObjectWithId(std::string_view id, std::uint64_t hash) const;
+        ConfigObject* findObjectWithName(std::string_view name, std::uint64_t hash) const;
+
         std::size_t write(SDL_RWops* file, std::uint16_t depth = 0u);
     };
 
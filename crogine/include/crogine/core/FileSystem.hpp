@@ -36,6 +36,8 @@ source distribution.
 #include <string>
 #include <vector>
 
+struct SDL_RWops;
+
 namespace cro
 {
     /*!
@@ -172,6 +174,55 @@ namespace cro
         */
         static void setResourceDirectory(const std::string& path);
 
+        /*!
+        \brief Mounts a packed asset archive created with createArchive().
+        Files in mounted archives are found by fileExists() and openResource()
+        using paths relative to the resource directory, for example
+        "assets/images/tiles.png". Archives mounted later take priority
+        over those mounted earlier.
+        \param path Path to the archive to mount
+        \returns true if the archive was mounted successfully
+        */
+        static bool mountArchive(const std::string& path);
+
+        /*!
+        \brief Unmounts a previously mounted archive.
+        Any SDL_RWops returned from openResource() which reference
+        the archive become invalid so they should be closed first.
+        */
+        static void unmountArchive(const std::string& path);
+
+        /*!
+        \brief Sets whether or not loose files on disk take priority
+        over files stored in mounted archives. Defaults to true, which
+        allows overriding packed assets during development.
+        */
+        static void setLooseFileOverride(bool enabled);
+
+        /*!
+        \brief Opens the file at the given path for reading, searching
+        mounted archives and the file system according to the loose file
+        override setting. Files read from an archive are not copied, the
+        returned SDL_RWops reads directly from the mapped archive.
+        \param path Path to the file, usually prefixed with getResourcePath()
+        \returns SDL_RWops which should be closed with SDL_RWclose() or
+        nullptr if the file was not found.
+        */
+        static SDL_RWops* openResource(const std::string& path);
+
+        /*!
+        \brief Packs all the files in the given directory, including sub-directories,
+        into an archive which can be mounted with mountArchive().
+        File data is stored uncompressed so that it can be read directly from
+        the mapped archive.
+        \param sourceDirectory Directory containing the files to pack. Paths
+        within the archive are relative to this directory, so it is usually
+        the same as the resource directory.
+        \param outputPath Path to write the archive to
+        \returns true on success
+        */
+        static bool createArchive(const std::string& sourceDirectory, const std::string& outputPath);
+
         enum ButtonType
         {
             OK, OKCancel, YesNo, YesNoCancel
@@ -41,6 +41,7 @@ source distribution.
 
 #include <string>
 #include <cstring>
+#include <vector>
 
 namespace cro::Detail::ModelBinary
 {
@@ -80,6 +81,14 @@ namespace cro::Detail::ModelBinary
         HeaderV2() { version = 2; };
     };
 
+    //version 3 header indicates that the MeshHeader is followed
+    //by a MeshFormatV3 struct describing how the vertex attributes
+    //and indices are stored.
+    struct CRO_EXPORT_API HeaderV3 final : public Header
+    {
+        HeaderV3() { version = 3; };
+    };
+
 
     //appears at Header::meshOffset bytes from beginning of the file
     struct CRO_EXPORT_API MeshHeader final
@@ -112,8 +121,26 @@ namespace cro::Detail::ModelBinary
         BlendWeights, 4 float, should sum as close as possible to 1
 
     Vertex data is interleaved in the above order
+
+    Version 3 files insert a MeshFormatV3 between the MeshHeader and the
+    array sizes. Each attribute is stored with attributeSizes[i] components
+    of the cro::Mesh::AttributeFormat in attributeFormats[i], so that vertex
+    data is an array of bytes rather than floats, and the index arrays are
+    made of indexSize bytes per index.
     */
 
+    //appears directly after the MeshHeader in version 3 files
+    struct CRO_EXPORT_API MeshFormatV3 final
+    {
+        std::uint8_t attributeFormats[Mesh::Attribute::Total] = {};
+        std::uint8_t attributeSizes[Mesh::Attribute::Total] = {};
+        std::uint16_t indexSize = sizeof(std::uint32_t);
+    };
+
+    //positions with any component larger than this are stored as
+    //float, rather than half float, when quantising vertex data
+    static constexpr float MaxHalfPosition = 16.f;
+
 
 
 
@@ -273,7 +300,33 @@ namespace cro::Detail::ModelBinary
         }
     };
 
-    CRO_EXPORT_API bool write(cro::Entity, const std::string&, bool includeSkeleton = true);
+    /*!
+    \brief Writes the Model and optionally the Skeleton of the given entity to a binary file
+    \param entity Entity with the Model component to write
+    \param path Path to the file to write
+    \param includeSkeleton If true and the entity has a Skeleton component the skeleton is
+    written to the file along with the vertex blend data.
+    \param quantise If true vertex attributes are stored in smaller formats: colour, blend
+    weights and indices as 8 bit values, normals and tangents as 8 bit signed normalised
+    values and UV coordinates as half floats. Positions are stored as half floats if the
+    mesh fits within MaxHalfPosition. The attributes are loaded into the vertex buffer in
+    the same format, reducing both file size and GPU memory usage, at the cost of precision.
+    Indices are always written as 16 bit values when there are fewer than 65536 vertices.
+    \param optimise If true triangle list meshes have duplicate vertices removed and are
+    reordered for the vertex cache, overdraw and vertex fetch with MeshOptimiser::optimise().
+    The statistics of each pass are printed to the console.
+    */
+    CRO_EXPORT_API bool write(cro::Entity entity, const std::string& path, bool includeSkeleton = true, bool quantise = false, bool optimise = true);
+
+    /*!
+    \brief Reads the mesh section of a model binary file.
+    The file should be positioned at the beginning of the MeshHeader. Vertex data is
+    converted to the float layout described above regardless of the file version, with
+    the storage formats and sizes of the file returned in format.
+    \returns false if the mesh data is invalid
+    */
+    CRO_EXPORT_API bool readMesh(SDL_RWops* file, const Header& header, MeshHeader& meshHeader, MeshFormatV3& format,
+        std::vector<float>& dstVert, std::vector<std::vector<std::uint32_t>>& dstIdx);
 
     /*!
     \brief Reads vertex positions and index arrays from a binary file at the given path
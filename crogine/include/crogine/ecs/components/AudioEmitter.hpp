@@ -180,12 +180,36 @@ namespace cro
         */
         std::uint8_t getMixerChannel() const { return m_mixerChannel; }
 
+        /*!
+        \brief Sets the priority of the emitter.
+        When there are more emitters playing than the AudioSystem has
+        voices available, those with a higher priority are given real
+        voices first. Emitters of the same priority are then ordered by
+        how loud they are at the listener, favouring newer sounds.
+        Emitters which miss out are virtualised - they continue to track
+        their playback position silently and resume seamlessly when a
+        voice becomes available. Defaults to 0.
+        \see AudioSystem::setMaxVoices()
+        */
+        void setPriority(std::int32_t priority) { m_priority = priority; }
+
+        /*!
+        \brief Returns the current priority of the emitter
+        */
+        std::int32_t getPriority() const { return m_priority; }
+
         enum class State{Playing = 0, Paused = 1, Stopped = 2};
         /*!
         \brief Returns the current state of the AudioEmitter 
         */
         State getState() const { return m_state; }
 
+        /*!
+        \brief Returns true if the emitter is playing but is currently
+        virtualised by the AudioSystem, and therefore not audible.
+        */
+        bool isVirtual() const { return m_state == State::Playing && m_ID < 1; }
+
     private:
 
         friend class AudioPlayerSystem;
@@ -199,6 +223,12 @@ namespace cro
         glm::vec3 m_velocity;
 
         std::uint8_t m_mixerChannel;
+        std::int32_t m_priority;
+
+        //tracked so virtual emitters know where to resume
+        float m_playTime;
+        float m_age;
+        float m_duration; //zero if unknown
 
         enum
         {
@@ -211,6 +241,20 @@ namespace cro
         std::uint8_t m_transportFlags;
 
         Time m_playingOffset;
+
+        //properties changed since they were last sent to the renderer
+        enum
+        {
+            DirtyPitch    = 0x1,
+            DirtyVolume   = 0x2,
+            DirtyRolloff  = 0x4,
+            DirtyVelocity = 0x8,
+            DirtyPosition = 0x10, //position is otherwise compared with m_lastPosition
+            DirtyAll = DirtyPitch | DirtyVolume | DirtyRolloff | DirtyVelocity | DirtyPosition
+        };
+        std::uint8_t m_dirtyFlags;
+        glm::vec3 m_lastPosition; //as last sent to the renderer
+
         bool m_newDataSource;
         std::int32_t m_ID;
         std::int32_t m_dataSourceID;
@@ -30,11 +30,14 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
+#include <crogine/detail/Assert.hpp>
 #include <crogine/graphics/Colour.hpp>
 
 #include <crogine/detail/glm/vec2.hpp>
 #include <crogine/detail/glm/vec3.hpp>
 
+#include <vector>
+
 namespace cro
 {
     /*!
@@ -66,6 +69,12 @@ namespace cro
     Creation of these models can be automated with the use of a ModelDefinition file.
     See the ModelDefinition class and model_definition_format.md document in the
     repository for further information
+
+    Geometry is stored in a persistent buffer which grows as needed. Only
+    billboards which are added, modified or removed are uploaded when the
+    BillboardSystem next updates, so small edits to large collections are
+    cheap. Removing a billboard swaps it with the last billboard in the
+    collection, so indices of existing billboards may change on removal.
     \see ModelDefinition
     */
     class CRO_EXPORT_API BillboardCollection final
@@ -87,6 +96,53 @@ namespace cro
         void addBillboard(Billboard billboard)
         {
             m_billboards.push_back(billboard);
+            m_dirtyFlags.push_back(1);
+            m_dirty = true;
+        }
+
+        /*!
+        \brief Replaces the properties of an existing Billboard.
+        \param index Index of the Billboard to replace. Must be less
+        than getBillboardCount()
+        \param billboard A Billboard struct containing the new properties
+        */
+        void setBillboard(std::size_t index, Billboard billboard)
+        {
+            CRO_ASSERT(index < m_billboards.size(), "Index out of range");
+            m_billboards[index] = billboard;
+            m_dirtyFlags[index] = 1;
+            m_dirty = true;
+        }
+
+        /*!
+        \brief Removes the Billboard at the given index.
+        The last Billboard in the collection is moved into the
+        removed Billboard's place, so that only a single quad
+        needs to be updated.
+        \param index Index of the Billboard to remove.  Must be less
+        than getBillboardCount()
+        */
+        void removeBillboard(std::size_t index)
+        {
+            CRO_ASSERT(index < m_billboards.size(), "Index out of range");
+            if (index != m_billboards.size() - 1)
+            {
+                m_billboards[index] = m_billboards.back();
+                m_dirtyFlags[index] = 1;
+            }
+            m_billboards.pop_back();
+            m_dirtyFlags.pop_back();
+            m_dirty = true;
+        }
+
+        /*!
+        \brief Removes all billboards from the collection
+        */
+        void clear()
+        {
+            m_billboards.clear();
+            m_dirtyFlags.clear();
+            m_resetBounds = true;
             m_dirty = true;
         }
 
@@ -98,12 +154,32 @@ namespace cro
         void setBillboards(std::vector<Billboard>& billboards)
         {
             m_billboards.swap(billboards);
+            m_dirtyFlags.assign(m_billboards.size(), 1);
+            m_resetBounds = true;
             m_dirty = true;
         }
 
+        /*!
+        \brief Returns the Billboard at the given index
+        */
+        const Billboard& getBillboard(std::size_t index) const
+        {
+            CRO_ASSERT(index < m_billboards.size(), "Index out of range");
+            return m_billboards[index];
+        }
+
+        /*!
+        \brief Returns the current number of billboards in the collection
+        */
+        std::size_t getBillboardCount() const { return m_billboards.size(); }
+
     private:
         bool m_dirty = false;
+        bool m_resetBounds = true; //bounds only grow unless the collection is replaced
         std::vector<Billboard> m_billboards;
+        std::vector<std::uint8_t> m_dirtyFlags;
+
+        std::size_t m_bufferCapacity = 0; //number of quads the vertex buffer can hold
 
         friend class BillboardSystem;
     };
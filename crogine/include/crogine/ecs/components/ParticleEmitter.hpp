@@ -39,6 +39,7 @@ source distribution.
 #include <crogine/detail/glm/vec3.hpp>
 
 #include <array>
+#include <vector>
 
 namespace cro
 {
@@ -79,6 +80,15 @@ namespace cro
             Add,
             Multiply
         } blendmode = Alpha;
+
+        /*!
+        \brief If true particles are sorted back to front for each camera
+        pass before they are drawn. Only affects the Alpha blend mode, as
+        Add and Multiply are order independent. Sorting costs roughly linear
+        time in the number of live particles, so is best reserved for emitters
+        where blending artefacts are noticable.
+        */
+        bool depthSort = false;
         glm::vec3 gravity = glm::vec3(0.f);
         glm::vec3 initialVelocity = glm::vec3(0.f, 1.f, 0.f);
         glm::vec3 spawnOffset = glm::vec3(0.f);
@@ -167,6 +177,7 @@ namespace cro
     private:
         std::uint32_t m_vbo;
         std::uint32_t m_vao; //< used on desktop
+        std::uint32_t m_ibo; //< used when depth sorting
         
         std::array<Particle, MaxParticles> m_particles;
         std::size_t m_nextFreeParticle;
@@ -179,6 +190,19 @@ namespace cro
 
         std::int32_t m_releaseCount;
 
+        //vertex data is built on a worker thread and
+        //uploaded to the VBO by the ParticleSystem
+        std::vector<float> m_vertexData;
+
+        //emitters which haven't been drawn for a while are put to sleep
+        std::uint32_t m_framesHidden;
+        bool m_sleeping;
+        float m_sleepTime; //time spent asleep
+        float m_sleepLifetime; //longest remaining particle lifetime when falling asleep
+        float m_sleepMaxSpeed; //fastest particle when falling asleep
+        std::uint32_t m_sleepEmitCount; //particles which would have been emitted while asleep
+        Sphere m_sleepBounds;
+
         friend class ParticleSystem;
     };
 }
\ No newline at end of file
@@ -44,6 +44,11 @@ namespace cro
     struct Glyph;
     class Drawable2D;
 
+    namespace Detail::Text
+    {
+        struct Layout;
+    }
+
     /*!
     \brief 2D Text component.
     Text components, when used in conjunction with Transformable
@@ -235,6 +240,7 @@ namespace cro
         std::uint16_t m_dirtyFlags;
 
         void updateVertices(Drawable2D&);
+        void updateVertices(Drawable2D&, const Detail::Text::Layout&);
 
         friend class TextSystem;
     };
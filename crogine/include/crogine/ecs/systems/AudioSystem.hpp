@@ -30,9 +30,18 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/audio/AudioMixer.hpp>
+
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <array>
+#include <vector>
 
 namespace cro
 {
+    class AudioEmitter;
+    struct AudioSourceUpdate;
+
     /*!
     \brief Processes the Scene's AudioEmitter components
     based on the Scene's active AudioListener.
@@ -42,16 +51,70 @@ namespace cro
     these scenes should have an AudioSystem active within it.
     To render non-positional audio, such as music or a UI in
     a secondary Scene and AudioPlayerSystem should be used instead.
+
+    The AudioSystem limits the number of real voices in use to
+    the value set with setMaxVoices(). Playing emitters are scored
+    by their priority, their volume at the listener and their age,
+    and only the highest scoring are given real voices. The rest
+    are virtualised until they score highly enough to be promoted.
+    Only emitter properties which have changed since the last update
+    are sent to the audio renderer, in a single batch each frame.
     \see AudioPlayerSystem
+    \see AudioEmitter::setPriority()
     */
     class CRO_EXPORT_API AudioSystem final : public System
     {
     public:
         explicit AudioSystem(MessageBus&);
+        ~AudioSystem();
 
         void process(float) override;
 
+        /*!
+        \brief Sets the maximum number of real voices used by this system.
+        Defaults to 64. Note that the platform may have a lower limit,
+        and that this is shared with any other Scene using audio.
+        */
+        void setMaxVoices(std::uint32_t count) { m_maxVoices = count; }
+
+        /*!
+        \brief Returns the maximum number of real voices used by the system
+        */
+        std::uint32_t getMaxVoices() const { return m_maxVoices; }
+
+        /*!
+        \brief Returns the number of emitters with a real voice after the last update
+        */
+        std::uint32_t getRealVoiceCount() const { return m_realVoiceCount; }
+
+        /*!
+        \brief Returns the number of playing emitters which were virtualised
+        in the last update
+        */
+        std::uint32_t getVirtualVoiceCount() const { return m_virtualVoiceCount; }
+
     private:
+        std::uint32_t m_maxVoices;
+        std::uint32_t m_realVoiceCount;
+        std::uint32_t m_virtualVoiceCount;
+
+        struct Candidate final
+        {
+            AudioEmitter* emitter = nullptr;
+            glm::vec3 position = glm::vec3(0.f);
+            float score = 0.f;
+            bool audible = true;
+        };
+        std::vector<Candidate> m_candidates;
+        std::vector<AudioEmitter*> m_idleVoices; //have a voice but aren't playing
+        std::vector<AudioEmitter*> m_promoted; //played once their properties are submitted
+
+        std::vector<AudioSourceUpdate> m_sourceUpdates;
+        std::array<float, AudioMixer::MaxChannels> m_channelVolumes = {};
+
+        void promote(AudioEmitter&);
+        void demote(AudioEmitter&);
+        void updateSource(AudioEmitter&, glm::vec3 position);
 
         void onEntityAdded(Entity) override;
     };
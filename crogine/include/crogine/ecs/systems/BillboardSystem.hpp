@@ -31,6 +31,8 @@ source distribution.
 
 #include <crogine/ecs/System.hpp>
 
+#include <vector>
+
 namespace cro
 {
     /*!
@@ -45,6 +47,9 @@ namespace cro
         void process(float) override;
 
     private:
-
+        //indices are the same for every quad so are generated once
+        //and shared by all collections
+        std::vector<std::uint32_t> m_indexData;
+        std::vector<float> m_vertexData;
     };
 }
@@ -35,11 +35,20 @@ source distribution.
 #include <crogine/graphics/Shader.hpp>
 #include <crogine/graphics/Texture.hpp>
 
+#include <crogine/detail/glm/mat4x4.hpp>
+
 #include <vector>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 
 namespace cro
 {
+    class ParticleEmitter;
+    class Transform;
+
     /*!
     \brief Particle system.
     Updates and renders all particle emitters in the scene.
@@ -48,6 +57,13 @@ namespace cro
     added to a Scene after any other render systems such as the
     ModelRenderer. This allows for correct blending of alpha transparent
     particle systems.
+
+    Emitters which have not appeared in any camera's draw list for
+    a number of frames are put to sleep. Sleeping emitters are not
+    fully simulated, rather their state is estimated cheaply and
+    brought up to date when they next become visible. Awake emitters
+    are simulated concurrently on worker threads, while vertex data
+    is always uploaded on the thread which calls process().
     */
     class CRO_EXPORT_API ParticleSystem final : public Renderable, public System
     {
@@ -66,18 +82,33 @@ namespace cro
 
         void render(Entity, const RenderTarget&) override;
 
+        /*!
+        \brief Sets the number of frames an emitter can go without being
+        drawn by any camera before it is put to sleep.
+        Setting this to zero disables sleeping so that all emitters
+        are fully simulated every frame. Defaults to 30
+        */
+        void setSleepFrameCount(std::uint32_t count) { m_sleepFrameCount = count; }
+
+        /*!
+        \brief Returns the number of frames an emitter can go without
+        being drawn before it is put to sleep
+        */
+        std::uint32_t getSleepFrameCount() const { return m_sleepFrameCount; }
+
     private:
         //for two passes, normal and reflection
-        using DrawList = std::array<std::vector<Entity>, 2u>;
+        //entities are paired with their view depth so they can be drawn back to front
+        using DrawList = std::array<std::vector<std::pair<Entity, float>>, 2u>;
         //one of these is inserted for each active camera based on the Camera draw list index
         std::vector<DrawList> m_drawLists;
 
         void onEntityAdded(Entity) override;
         void onEntityRemoved(Entity) override;
 
-        std::vector<float> m_dataBuffer;
         std::vector<std::uint32_t> m_vboIDs;
         std::vector<std::uint32_t> m_vaoIDs; //< used on desktop
+        std::vector<std::uint32_t> m_iboIDs;
         std::size_t m_nextBuffer;
         std::size_t m_bufferCount;
 
@@ -88,6 +119,39 @@ namespace cro
 
         void allocateBuffer();
 
+        //scratch space for depth sorting particles
+        std::vector<float> m_sortDepths;
+        std::vector<std::uint16_t> m_sortKeys;
+        std::vector<std::uint16_t> m_sortIndices;
+        std::vector<std::uint16_t> m_sortKeysTemp;
+        std::vector<std::uint16_t> m_sortIndicesTemp;
+
+        //sorts the given emitter's particles back to front and updates its index buffer
+        void sortParticles(const ParticleEmitter&, const glm::mat4& viewMatrix);
+
+        std::uint32_t m_sleepFrameCount;
+        std::vector<ParticleEmitter*> m_activeEmitters;
+
+        void spawnParticle(ParticleEmitter&, const Transform&);
+        void sleep(ParticleEmitter&);
+        void updateSleeping(ParticleEmitter&, const Transform&, float);
+        void wake(ParticleEmitter&, const Transform&);
+        static void simulate(ParticleEmitter&, float);
+
+        //worker threads for simulating awake emitters
+        std::vector<std::unique_ptr<std::thread>> m_workerThreads;
+        std::mutex m_workMutex;
+        std::condition_variable m_workCondition;
+        std::condition_variable m_completeCondition;
+        std::atomic<std::size_t> m_nextJob;
+        std::size_t m_pendingWorkers;
+        std::uint32_t m_workGeneration;
+        bool m_threadsRunning;
+        float m_frameTime;
+
+        void threadFunc();
+        void runJobs();
+
         std::vector<std::unique_ptr<Shader>> m_shaders;
 
         enum UniformID
@@ -30,10 +30,21 @@ source distribution.
 #pragma once
 
 #include <crogine/ecs/System.hpp>
+#include <crogine/graphics/Shader.hpp>
+
+#include <memory>
+#include <unordered_map>
 
 namespace cro
 {
     class Font;
+    class Drawable2D;
+    struct TextContext;
+
+    namespace Detail::Text
+    {
+        struct Layout;
+    }
 
     /*!
     \brief Updates the geometry of Drawable2D components which
@@ -42,6 +53,14 @@ namespace cro
     custom System can be defined which will combine multiple
     text instances into a single Drawable2D component.
 
+    Glyph layouts are cached by font, character size, style and
+    string so that identical labels are only laid out once. When
+    only the end of a string is modified, such as when appending
+    to a log, only the affected lines are laid out again.
+
+    Text using a Font in distance field mode is drawn with a distance
+    field shader, applied automatically to the Drawable2D component.
+
     \see System, Text, RenderSystem2D
     */
     class CRO_EXPORT_API TextSystem final : public cro::System
@@ -52,10 +71,29 @@ namespace cro
         \param mb A reference to the active MessageBus
         */
         explicit TextSystem(MessageBus& mb);
+        ~TextSystem();
+
+        TextSystem(const TextSystem&) = delete;
+        TextSystem(TextSystem&&) = delete;
+        TextSystem& operator = (const TextSystem&) = delete;
+        TextSystem& operator = (TextSystem&&) = delete;
 
         void process(float) override;
 
     private:
+        //the most recent layout of each entity, indexed by entity ID
+        std::vector<std::unique_ptr<Detail::Text::Layout>> m_layouts;
+
+        //layouts shared between entities with identical text
+        std::unordered_map<std::size_t, std::unique_ptr<Detail::Text::Layout>> m_layoutCache;
+        std::uint32_t m_frameCount;
+
+        const Detail::Text::Layout& fetchLayout(Entity, const TextContext&);
+
+        Shader m_distanceFieldShader;
+        void applyDistanceField(Drawable2D&, const TextContext&);
+
+        void onEntityRemoved(Entity) override;
 
         //mechanism for marking fonts with updated pages
         //as read. This is double buffered to save iterating
@@ -31,10 +31,18 @@ source distribution.
 
 #include <crogine/graphics/MeshBuilder.hpp>
 
+namespace cro::Detail::ModelBinary
+{
+    struct MeshFormatV3;
+}
+
 namespace cro
 {
     /*!
-    \brief Class for loading the CroModelBinary format aka *.cmb files
+    \brief Class for loading the CroModelBinary format aka *.cmb files.
+    Version 3 files with quantised vertex attributes are uploaded to
+    the vertex buffer in their stored format, and 16 bit indices are
+    kept as 16 bit, see Mesh::AttributeFormat
     */
     class CRO_EXPORT_API BinaryMeshBuilder final : public cro::MeshBuilder
     {
@@ -49,5 +57,7 @@ namespace cro
         std::size_t m_uid;
         mutable Skeleton m_skeleton;
         Mesh::Data build() const override;
+
+        void createQuantisedVBO(Mesh::Data&, const std::vector<float>&, const Detail::ModelBinary::MeshFormatV3&) const;
     };
 }
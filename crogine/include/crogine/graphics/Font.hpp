@@ -40,6 +40,10 @@ source distribution.
 #include <vector>
 #include <any>
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
 
 namespace cro
 {
@@ -96,6 +100,8 @@ namespace cro
         /*!
         \brief Attempts to return a float rect representing the sub rectangle of the atlas
         for the given codepoint.
+        In distance field mode outlineThickness is ignored, as outlines
+        are drawn by the shader.
         */
         Glyph getGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold = false, float outlineThickness = 0.f) const;
 
@@ -120,6 +126,51 @@ namespace cro
         */
         void setSmooth(bool smooth);
 
+        /*!
+        \brief Enables or disables distance field mode.
+        When enabled glyphs are rasterised at DistanceFieldSize and
+        converted to a signed distance field, stored in a single texture
+        which is used for all character sizes. Text using the font is drawn
+        with a distance field shader which remains sharp when scaled, and
+        outlines and shadows are applied by the shader rather than with
+        additional geometry. Outlines are limited to the distance covered
+        by DistanceFieldSpread, as are shadow offsets.
+
+        Printable ASCII characters are generated on a background thread
+        when this is enabled, other characters may be queued with
+        preloadGlyphs(). Any glyph requested before it has been generated
+        is created immediately.
+
+        This clears any existing glyph pages, so should be set before
+        the font is used. The default value is false.
+        */
+        void setDistanceField(bool enabled);
+
+        /*!
+        \brief Returns true if distance field mode is enabled
+        */
+        bool isDistanceField() const { return m_distanceField; }
+
+        /*!
+        \brief Queues a range of codepoints to be generated on a
+        background thread. Only has an effect in distance field mode.
+        \param first First codepoint in the range
+        \param last Last codepoint in the range, inclusive
+        \param bold Set to true to generate the bold variant of the glyphs
+        */
+        void preloadGlyphs(std::uint32_t first, std::uint32_t last, bool bold = false);
+
+        /*!
+        \brief Character size at which distance field glyphs are rasterised
+        */
+        static constexpr std::uint32_t DistanceFieldSize = 48;
+
+        /*!
+        \brief Distance in pixels, at DistanceFieldSize, stored either
+        side of a glyph's edge in distance field mode.
+        */
+        static constexpr std::uint32_t DistanceFieldSpread = 8;
+
     private:
 
         std::vector<Uint8> m_buffer;
@@ -155,6 +206,37 @@ namespace cro
         FloatRect getGlyphRect(Page&, std::uint32_t w, std::uint32_t h) const;
         bool setCurrentCharacterSize(std::uint32_t) const;
 
+        //in distance field mode all glyphs are stored in page 0
+        Page& getPage(std::uint32_t charSize) const;
+
+        //distance field glyphs are rasterised on a worker thread with its
+        //own FT_Face, and added to the atlas when next requested on the main thread
+        struct DistanceFieldGlyph final
+        {
+            std::uint64_t key = 0;
+            Glyph glyph;
+            std::uint32_t width = 0;
+            std::uint32_t height = 0;
+            std::vector<std::uint8_t> pixels;
+        };
+
+        bool m_distanceField;
+        std::unique_ptr<std::thread> m_distanceFieldThread;
+        std::atomic_bool m_threadRunning;
+        mutable std::mutex m_distanceFieldMutex;
+        std::condition_variable m_distanceFieldCondition;
+        std::vector<std::pair<std::uint32_t, bool>> m_distanceFieldQueue;
+        mutable std::vector<DistanceFieldGlyph> m_distanceFieldResults;
+        mutable std::atomic_bool m_resultsReady;
+
+        void startDistanceFieldThread();
+        void stopDistanceFieldThread();
+        void distanceFieldThreadFunc();
+
+        Glyph getDistanceFieldGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold) const;
+        void flushDistanceFieldGlyphs() const;
+        const Glyph& addDistanceFieldGlyph(const DistanceFieldGlyph&) const;
+
         void cleanup();
 
         friend class TextSystem;
@@ -34,6 +34,7 @@ source distribution.
 
 #include <crogine/detail/glm/vec2.hpp>
 
+#include <future>
 #include <string>
 #include <vector>
 
@@ -113,6 +114,53 @@ namespace cro
         */
         bool write(const std::string& path);
 
+        /*!
+        \brief Saves this image to the given path on a worker thread.
+        The pixel data is copied so the image may be safely modified or
+        destroyed as soon as this function returns. Only PNG files are
+        supported. This does not require a valid OpenGL context.
+        \param path Path to the file to write
+        \returns A future which becomes ready with the result of the write
+        */
+        std::future<bool> writeAsync(const std::string& path) const;
+
+        /*!
+        \brief Flips the rows of the image in place, so that the top
+        row becomes the bottom row. Useful for images read back from
+        OpenGL which have their origin at the bottom left.
+        */
+        void flipVertically();
+
+        /*!
+        \brief Converts the image between RGB and RGBA formats.
+        When expanding RGB images to RGBA the alpha channel is set to 255,
+        when converting RGBA to RGB the alpha channel is discarded.
+        \param format The format to convert the image to, RGB or RGBA
+        \returns false if either the current or requested format is not
+        RGB or RGBA, else true
+        */
+        bool convert(ImageFormat::Type format);
+
+        /*!
+        \brief Multiplies the colour channels of an RGBA image by its alpha channel.
+        Has no effect on images with any other format.
+        */
+        void premultiplyAlpha();
+
+        /*!
+        \brief Converts the colour channels of an RGB or RGBA image from
+        sRGB to linear colour space. Alpha channels are unaffected.
+        Note that 8 bit images lose precision in dark colours when converted
+        to linear space.
+        */
+        void convertToLinear();
+
+        /*!
+        \brief Converts the colour channels of an RGB or RGBA image from
+        linear to sRGB colour space. Alpha channels are unaffected.
+        */
+        void convertToSRGB();
+
         /*!
         \brief Sets the pixel at the given position to the given colour
         \param x The x coordinate of the pixel
@@ -167,7 +167,8 @@ namespace cro
             {
                 Index = 0,
                 Size,
-                Offset
+                Offset,
+                Format
             };
 
             /*!
@@ -297,8 +298,8 @@ namespace cro
             */
 
             std::uint32_t shader = 0;
-            //maps attrib location to attrib size between shader and mesh - index, size, pointer offset
-            std::array<std::array<std::int32_t, 3u>, Shader::AttributeID::Count> attribs{};
+            //maps attrib location to attrib size between shader and mesh - index, size, pointer offset, Mesh::AttributeFormat
+            std::array<std::array<std::int32_t, 4u>, Shader::AttributeID::Count> attribs{};
             std::size_t attribCount = 0; //< count of attributes successfully mapped
             //maps uniform locations by indexing via Uniform enum
             std::array<std::int32_t, Uniform::Total> uniforms{-1,-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
@@ -30,6 +30,7 @@ source distribution.
 #pragma once
 
 #include <crogine/Config.hpp>
+#include <crogine/graphics/MeshOptimiser.hpp>
 #include <crogine/detail/glm/mat4x4.hpp>
 
 #include <cstdint>
@@ -93,6 +94,14 @@ namespace cro
         */
         void updateMeshData(Mesh::Data& data) const;
 
+        /*!
+        \brief Optimises the batched vertex data for the vertex cache, overdraw
+        and vertex fetch with MeshOptimiser::optimise(). This should be called
+        once after all meshes have been added and before updateMeshData()
+        \returns The optimisation statistics
+        */
+        MeshOptimiser::Report optimise();
+
     private:
 
         std::uint32_t m_flags;
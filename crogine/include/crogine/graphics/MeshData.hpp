@@ -76,6 +76,31 @@ namespace cro
             Total
         };
 
+        /*!
+        \brief Storage format of vertex attribute components in a vertex buffer.
+        Attributes are stored as Float unless otherwise specified. Normalised
+        formats are converted to the range 0 - 1 (or -1 - 1 for signed formats)
+        when they are read by a shader, and UInt8 is converted to a float with
+        the same integer value. Each attribute should be padded to a multiple
+        of 4 bytes, for example a 3 component normal stored as SNorm8 should
+        be given a size of 4.
+        */
+        struct AttributeFormat final
+        {
+            enum
+            {
+                Float = 0,
+                HalfFloat,
+                SNorm16,
+                UNorm16,
+                SNorm8,
+                UNorm8,
+                UInt8,
+
+                Count
+            };
+        };
+
         /*!
         \brief Index data for sub-mesh
         */
@@ -110,6 +135,7 @@ namespace cro
             std::uint32_t vbo = 0;
             std::uint32_t primitiveType = 0;
             std::array<std::size_t, Mesh::Attribute::Total> attributes{}; //!< size of attribute if it exists
+            std::array<std::uint8_t, Mesh::Attribute::Total> attributeFormats{}; //!< AttributeFormat of each attribute. Defaults to Float
             std::uint32_t attributeFlags = 0; //!< bitmask of VertexProperty flags indicating the current properties of the vertex data.
 
             //index arrays
@@ -122,7 +148,25 @@ namespace cro
         };
 
         /*!
-        \brief Utility to read back vertex data and index data
+        \brief Returns the size in bytes of a single component of the given AttributeFormat
+        */
+        std::size_t CRO_EXPORT_API getAttributeFormatSize(std::uint8_t format);
+
+        /*!
+        \brief Returns the size in bytes of a single vertex of the given mesh once
+        it has been read with readVertexData(). This differs from Data::vertexSize
+        when the vertex attributes are stored in a quantised AttributeFormat, so
+        this should always be used as the stride of the float vertex data.
+        */
+        std::size_t CRO_EXPORT_API getFloatVertexSize(const Data& meshData);
+
+        /*!
+        \brief Utility to read back vertex data and index data.
+        Vertex attributes stored in a quantised AttributeFormat are converted
+        to float, so the size of each vertex in destVerts is given by
+        getFloatVertexSize() rather than Data::vertexSize.
+        Indices are converted to the requested type regardless of the
+        format in which they are stored.
         */
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices);
         void CRO_EXPORT_API readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint16_t>>& destIndices);
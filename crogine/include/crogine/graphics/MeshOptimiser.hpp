@@ -0,0 +1,143 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace cro::MeshOptimiser
+{
+    /*!
+    \brief Vertex cache and fetch statistics of a mesh, used to measure
+    the effectiveness of each optimisation pass without requiring a GPU.
+    */
+    struct CRO_EXPORT_API Stats final
+    {
+        float acmr = 0.f; //!< Average cache miss ratio. Vertices transformed per triangle, from 3 (worst) to around 0.5
+        float atvr = 0.f; //!< Average transform to vertex ratio. Vertices transformed per unique vertex, 1 is ideal
+        float overfetch = 0.f; //!< Bytes fetched from memory per byte of vertex data, 1 is ideal
+        std::size_t vertexCount = 0;
+        std::size_t triangleCount = 0;
+    };
+
+    /*!
+    \brief Statistics recorded after each pass of optimise()
+    */
+    struct CRO_EXPORT_API Report final
+    {
+        enum Pass
+        {
+            Original,
+            Deduplicate,
+            VertexCache,
+            Overdraw,
+            VertexFetch,
+
+            Count
+        };
+        std::array<Stats, Pass::Count> passes = {};
+
+        /*!
+        \brief Prints the statistics of each pass to the console
+        */
+        void log() const;
+    };
+
+    /*!
+    \brief Size of the FIFO vertex cache used when measuring ACMR and ATVR
+    */
+    static constexpr std::size_t CacheSize = 16;
+
+    /*!
+    \brief Measures the post-transform cache efficiency and vertex fetch efficiency
+    of the given triangle list index arrays.
+    \param indices Array of index arrays, one for each sub-mesh
+    \param vertexCount Number of vertices referenced by the index arrays
+    \param vertexSize Size of a single vertex in bytes, used to measure overfetch
+    */
+    CRO_EXPORT_API Stats analyse(const std::vector<std::vector<std::uint32_t>>& indices, std::size_t vertexCount, std::size_t vertexSize);
+
+    /*!
+    \brief Removes any vertices which are bitwise identical, updating the
+    index arrays to reference the remaining vertex.
+    \param vertices Interleaved float vertex data
+    \param stride Number of floats in a single vertex
+    \param indices Array of index arrays, one for each sub-mesh
+    \returns The number of vertices which were removed
+    */
+    CRO_EXPORT_API std::size_t deduplicateVertices(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices);
+
+    /*!
+    \brief Reorders the triangles in a triangle list index array to improve
+    the hit rate of the post-transform vertex cache, using Tom Forsyth's
+    linear-speed vertex cache optimisation algorithm.
+    \param indices Triangle list index array to reorder
+    \param vertexCount Number of vertices referenced by the index array
+    */
+    CRO_EXPORT_API void optimiseVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+    /*!
+    \brief Reorders clusters of triangles so that those facing away from the centre
+    of the mesh are drawn first, reducing overdraw for convex-ish meshes.
+    This should be applied after optimiseVertexCache(), as clusters are created
+    at points where the vertex cache would be flushed so that the cache
+    efficiency is mostly preserved.
+    \param indices Triangle list index array to reorder
+    \param vertices Interleaved float vertex data, with the position in the first 3 components
+    \param stride Number of floats in a single vertex
+    \param threshold Maximum ratio by which the ACMR may increase. If this is exceeded
+    the original order is kept. A value of 1.05 allows a 5% increase
+    */
+    CRO_EXPORT_API void optimiseOverdraw(std::vector<std::uint32_t>& indices, const std::vector<float>& vertices, std::size_t stride, float threshold = 1.05f);
+
+    /*!
+    \brief Reorders vertices in the order in which they are first referenced by the
+    index arrays, improving memory locality when the vertices are fetched. Any
+    unreferenced vertices are removed.
+    \param vertices Interleaved float vertex data
+    \param stride Number of floats in a single vertex
+    \param indices Array of index arrays, one for each sub-mesh, which are updated
+    to reference the reordered vertices.
+    */
+    CRO_EXPORT_API void optimiseVertexFetch(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices);
+
+    /*!
+    \brief Applies all the optimisation passes in order to the given triangle list mesh.
+    \param vertices Interleaved float vertex data, with the position in the first 3 components
+    \param stride Number of floats in a single vertex
+    \param indices Array of index arrays, one for each sub-mesh. Each must be a triangle list.
+    \returns Report containing the statistics of the mesh after each pass
+    */
+    CRO_EXPORT_API Report optimise(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices);
+}
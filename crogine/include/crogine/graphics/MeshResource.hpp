@@ -37,6 +37,8 @@ source distribution.
 
 #include <unordered_map>
 #include <array>
+#include <memory>
+#include <future>
 
 namespace cro
 {    
@@ -83,6 +85,21 @@ namespace cro
         */
         std::size_t loadMesh(const MeshBuilder& mb, bool forceReload = false);
 
+        /*!
+        \brief Loads a mesh in the background and automatically assigns an ID.
+        The MeshBuilder is run on a worker thread, and the vertex buffers
+        are created on the main thread by the App, within its upload budget.
+        Builders which make their own OpenGL calls, rather than using
+        MeshBuilder::createVBO() and MeshBuilder::createIBO(), such as the
+        DynamicMeshBuilder, must be loaded with loadMesh() instead.
+        \param mb The MeshBuilder to use. The resource takes ownership of this.
+        \returns A future which becomes ready with the ID of the mesh once it has
+        been created, or 0 if loading failed. Meshes which are already loaded
+        return their existing ID.
+        \see App::setUploadBudget()
+        */
+        std::future<std::size_t> loadMeshAsync(std::unique_ptr<MeshBuilder> mb);
+
         /*!
         \brief Returns the mesh data for the given ID.
         */
@@ -109,6 +126,9 @@ namespace cro
         std::unordered_map<std::size_t, Mesh::Data> m_meshData;
         std::unordered_map<std::size_t, Skeleton> m_skeletalData;
 
+        //lets pending async loads know if the resource was destroyed
+        std::shared_ptr<MeshResource*> m_asyncHandle;
+
         void deleteMesh(Mesh::Data);
     };
 }
\ No newline at end of file
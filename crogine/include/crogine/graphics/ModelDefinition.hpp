@@ -41,11 +41,59 @@ source distribution.
 
 #include <array>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace cro
 {
     class Entity;
     class EnvironmentMap;
+    class ConfigObject;
+    class ModelDefinition;
+
+    /*!
+    \brief Stores the resolved mesh and material IDs of ModelDefinitions
+    loaded into a ResourceCollection, keyed by the definition's path and
+    load options.
+    When ModelDefinition::loadFromFile() is called with a path which has
+    already been loaded with the same options, the definition is populated
+    from the cache, skipping parsing the file and resolving its resources,
+    so that only the cost of createModel() is paid for each instance.
+    Definitions with billboard meshes are never cached as they require
+    unique mesh data each time they are loaded.
+
+    This is a member of ResourceCollection and generally doesn't need to be
+    used directly, other than calling clear() if the mesh or material resources
+    of the collection are flushed, which would invalidate the cached IDs.
+    */
+    class CRO_EXPORT_API ModelDefinitionCache final
+    {
+    public:
+        /*!
+        \brief Removes all cached definitions. Resources loaded by
+        the definitions are not affected.
+        */
+        void clear() { m_entries.clear(); }
+
+        /*!
+        \brief Returns the number of currently cached definitions
+        */
+        std::size_t size() const { return m_entries.size(); }
+
+    private:
+        friend class ModelDefinition;
+        struct Entry final
+        {
+            std::size_t meshID = 0;
+            std::array<std::int32_t, Mesh::IndexData::MaxBuffers> materialIDs = {};
+            std::array<std::int32_t, Mesh::IndexData::MaxBuffers> shadowIDs = {};
+            std::size_t materialCount = 0;
+            Skeleton skeleton;
+            bool castShadows = false;
+        };
+        std::unordered_map<std::string, Entry> m_entries;
+    };
 
     /*!
     \brief Struct of resource managers.
@@ -59,6 +107,7 @@ namespace cro
         ShaderResource shaders;
         TextureResource textures;
         AudioResource audio;
+        ModelDefinitionCache modelDefinitions;
     };
 
     /*!
@@ -128,10 +177,31 @@ namespace cro
         \param forceReload Forces the ResourceCollection to reload any mesh data from
         file, rather than recycling any existing VBO. Generally should be false.
         \returns true if the configuration file was parsed without error.
-        \see ConfigFile, EnvironmentMap
+
+        Definitions which have previously been loaded into the same ResourceCollection
+        with the same path and options (and EnvironmentMap and working directory)
+        are populated from the collection's ModelDefinitionCache, and share the
+        material and mesh IDs of the earlier load, unless forceReload is true.
+        \see ConfigFile, EnvironmentMap, ModelDefinitionCache
         */
         bool loadFromFile(const std::string& path, bool instanced = false, bool useDeferredShaders = false, bool forceReload = false);
 
+        /*!
+        \brief Loads a list of definitions at once.
+        Definition files are parsed, and their meshes are built, in parallel on
+        worker threads. Materials, shaders and textures are then resolved on the
+        calling thread, which must be the main thread as this function blocks until
+        all definitions are loaded. Each definition in the list must be unique, and
+        may be constructed with different ResourceCollections or EnvironmentMaps.
+        \param definitions A list of pairs of ModelDefinition and the path of the
+        file to load into it
+        \param instanced Set to true to load the definitions for instanced rendering
+        \param useDeferredShaders Set to true if using the DeferredRenderingSystem
+        \returns The number of definitions successfully loaded
+        \see loadFromFile()
+        */
+        static std::size_t loadFromFiles(const std::vector<std::pair<ModelDefinition*, std::string>>& definitions, bool instanced = false, bool useDeferredShaders = false);
+
         /*!
         \brief Creates a Model component from the loaded config on the given entity.
         \returns true on success, else false (no model definition has been loaded)
@@ -197,6 +267,14 @@ namespace cro
 
         bool m_modelLoaded = false;
 
+        //state shared between parsing a file and resolving its resources
+        struct PendingLoad;
+        std::string getCacheKey(const std::string& path, bool instanced, bool useDeferredShaders) const;
+        bool loadFromCache(const std::string& key);
+        bool prepareLoad(const ConfigObject& cfg, PendingLoad& pending);
+        bool finishLoad(PendingLoad& pending, std::size_t meshID);
+        void updateLocalPath(std::string& filePath, const std::string& definitionPath) const;
+
         void reset();
     };
 }
\ No newline at end of file
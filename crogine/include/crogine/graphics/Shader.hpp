@@ -37,6 +37,7 @@ source distribution.
 #include <string>
 #include <array>
 #include <unordered_map>
+#include <vector>
 
 namespace cro
 {
@@ -119,6 +120,12 @@ namespace cro
     private:
         bool loadFromSource(const char* v, const char* g, const char* f, const char* d);
 
+        //used by the ShaderResource program cache
+        friend class ShaderResource;
+        bool m_retrievable;
+        bool loadFromBinary(std::uint32_t format, const std::vector<std::uint8_t>& data);
+        bool getBinary(std::uint32_t& format, std::vector<std::uint8_t>& dst) const;
+
         std::uint32_t m_handle;
         std::array<std::int32_t, AttributeID::Count> m_attribMap;
         bool fillAttribMap();
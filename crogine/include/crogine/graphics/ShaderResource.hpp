@@ -34,6 +34,7 @@ source distribution.
 #include <crogine/detail/SDLResource.hpp>
 #include <crogine/graphics/Shader.hpp>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -148,12 +149,48 @@ namespace cro
         */
         void addInclude(const std::string& inc, const char* source);
 
+        /*!
+        \brief Statistics on the programs requested from this ShaderResource
+        */
+        struct Stats final
+        {
+            std::size_t requested = 0; //!< total number of successful load requests
+            std::size_t compiled = 0; //!< number of programs compiled from source
+            std::size_t shared = 0; //!< number of requests which reused a program with identical source
+            std::size_t binariesLoaded = 0; //!< number of programs loaded from the program binary store
+        };
+
+        /*!
+        \brief Returns the statistics of programs loaded by this ShaderResource
+        */
+        const Stats& getStats() const { return m_stats; }
+
+        /*!
+        \brief Sets a directory in which the driver's compiled program binaries
+        are stored.
+        Programs loaded by any ShaderResource are first looked up in this
+        directory by the hash of their preprocessed source, and are only compiled
+        if no valid binary is found, after which the binary is written to the
+        directory. Binaries created with a different driver or GPU are ignored
+        and replaced. This is only supported on desktop platforms where the driver
+        supports at least one program binary format. The directory is created if
+        it does not exist. Pass an empty string to disable the store (the default).
+        \param path Path to the directory, usually somewhere in the user's
+        preferences directory, eg FileSystem::getConfigDirectory(appName)
+        */
+        static void setProgramCacheDirectory(const std::string& path);
+
     private:
 
         Shader m_defaultShader;
-        std::unordered_map<std::int32_t, Shader> m_shaders;
+
+        //IDs which map to identical source share a single program
+        std::unordered_map<std::int32_t, Shader*> m_shaders;
+        std::unordered_map<std::uint64_t, std::unique_ptr<Shader>> m_programs;
         std::unordered_map<std::string, const char*> m_includes;
+        Stats m_stats;
 
+        bool loadProgram(std::int32_t id, const std::string& vertex, const std::string& geom, const std::string& fragment, const std::string& defines, bool hasGeometry);
         std::string parseIncludes(const std::string& src) const;
     };
 }
\ No newline at end of file
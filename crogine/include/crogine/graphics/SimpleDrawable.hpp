@@ -144,6 +144,13 @@ namespace cro
         \brief Returns a pointer to the active texture if there is one
         */
         const Texture* getTexture() const { return m_texture; }
+
+        /*!
+        \brief Replaces any custom shader with the built-in shader
+        used for the current texture, or the colour shader if no
+        texture is set. This also resets all uniform values.
+        */
+        void resetShader();
         
         /*!
         \brief Sets the OpenGL primitive type with which to
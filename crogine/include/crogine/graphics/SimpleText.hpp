@@ -60,6 +60,8 @@ namespace cro
         */
         SimpleText(const Font& font);
 
+        ~SimpleText();
+
         /*!
         \brief Set the font to be used with this Text
         \param font Font to use when rendering
@@ -230,6 +232,7 @@ namespace cro
         FloatRect m_localBounds;
         glm::uvec2 m_lastTextureSize;
         const Texture* m_fontTexture;
+        bool m_distanceField;
 
         struct DirtyFlags final
         {
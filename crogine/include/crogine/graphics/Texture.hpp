@@ -41,6 +41,11 @@ source distribution.
 namespace cro
 {
     class Image;
+    class TextureResource;
+    namespace Detail
+    {
+        struct CompressedImageData;
+    }
 
     /*!
     \brief Generic texture wrapper for OpenGL RGB or RGBA textures.
@@ -74,6 +79,12 @@ namespace cro
 
         /*!
         \brief Attempts to load the file in the given file path.
+        Files with a .dds or .ktx2 extension are treated as block compressed
+        containers (BC1-5, BC7 or ETC2) and are uploaded directly to the GPU
+        along with any mip levels they contain. These can be created with
+        TextureCompression::compress(). Compressed textures are read-only and
+        cannot be modified with update(), nor can mipmaps be generated for
+        them at runtime - they should be included in the file instead.
         \param path Path to file to load. The image file should have pow2 dimensions on mobile platforms
         \param createMipMaps Set true to automatically create mipmap levels for this texture
         \returns true on success, else false
@@ -111,10 +122,16 @@ namespace cro
         glm::uvec2 getSize() const;
 
         /*!
-        \brief Returns the current format of the texture
+        \brief Returns the current format of the texture.
+        For compressed textures this is the closest uncompressed equivalent
         */
         ImageFormat::Type getFormat() const;
 
+        /*!
+        \brief Returns true if this texture was loaded from a block compressed file
+        */
+        bool isCompressed() const { return m_compressed; }
+
         /*!
         brief Returns the OpenGL handle used by this texture.
         */
@@ -183,6 +200,11 @@ namespace cro
         bool m_smooth;
         bool m_repeated;
         bool m_hasMipMaps;
+        bool m_compressed;
+
+        friend class TextureResource;
+        bool loadFromCompressed(const Detail::CompressedImageData&, bool createMipMaps);
+        void evict();
 
         bool isFloat(SDL_RWops* file);
         bool loadAsFloat(SDL_RWops* file, bool createMipmaps);
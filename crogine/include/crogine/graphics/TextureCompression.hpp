@@ -0,0 +1,98 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cro
+{
+    class Image;
+}
+
+namespace cro::TextureCompression
+{
+    /*!
+    \brief Block compression formats which can be created by compress()
+    */
+    enum class Format
+    {
+        Automatic, //!< BC1 for RGB images, BC3 for RGBA images and BC4 for single channel images
+        BC1, //!< 4 bits per pixel RGB, 8:1 compared to RGBA8. Also known as DXT1
+        BC3, //!< 8 bits per pixel RGBA, 4:1 compared to RGBA8. Also known as DXT5
+        BC4, //!< 4 bits per pixel single channel. Stores the red channel only
+        BC5 //!< 8 bits per pixel two channel. Stores red and green, useful for normal maps
+    };
+
+    /*!
+    \brief Options used when compressing a texture
+    */
+    struct CRO_EXPORT_API Settings final
+    {
+        Format format = Format::Automatic;
+        bool generateMipMaps = true; //!< Creates a full mip chain down to 1x1 pixel
+        bool gammaCorrect = true; //!< Filter colour channels in linear space. Disable for non-colour data. Ignored by BC4 and BC5
+        bool repeated = false; //!< Wrap the filter kernel at the image edges, for textures which are tiled
+    };
+
+    /*!
+    \brief Builds a mip chain from the given image and compresses each
+    level, writing the result to a .dds file which can be loaded with
+    Texture::loadFromFile(). This is intended for offline use as it is
+    far slower than loading the resulting file.
+
+    Mip levels are filtered with a Kaiser windowed sinc which preserves
+    more detail than the box filter used by glGenerateMipmap().
+    \param image The source image to compress
+    \param outputPath Path to the .dds file to write
+    \param settings Compression settings
+    \returns true on success, else false
+    */
+    CRO_EXPORT_API bool compress(const Image& image, const std::string& outputPath, const Settings& settings = {});
+
+    /*!
+    \brief Loads the given image file and compresses it
+    \see compress()
+    */
+    CRO_EXPORT_API bool compress(const std::string& inputPath, const std::string& outputPath, const Settings& settings = {});
+
+    /*!
+    \brief Encodes an RGBA8 image into the given block format.
+    Images whose dimensions aren't a multiple of 4 have their edge
+    pixels repeated to fill the last row/column of blocks.
+    \param pixels Pointer to width * height * 4 bytes of RGBA data
+    \returns Vector of encoded blocks ordered left to right, top to bottom
+    */
+    CRO_EXPORT_API std::vector<std::uint8_t> encode(const std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, Format format);
+}
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace cro
+{
+    /*!
+    \brief Reports the estimated amount of GPU memory used by textures
+    and render targets, and optionally enforces a budget on it.
+
+    Textures, Font pages, RenderTextures, MultiRenderTextures, DepthTextures,
+    CubemapTextures and EnvironmentMaps all record the size of their
+    allocations, which is estimated from their dimensions and format.
+    The actual amount of memory used by the driver may differ.
+
+    When a budget is set, and the total exceeds it, textures owned by a
+    TextureResource which have not been drawn recently are evicted, least
+    recently used first. Evicted textures keep their OpenGL handle, so any
+    Materials or Sprites referencing them remain valid, and are reloaded in
+    the background the next time they are drawn. Until they are reloaded
+    they appear as a single transparent texel. Textures which cannot be
+    reloaded from disk, such as render targets or textures created or
+    modified at run time, are never evicted.
+
+    Only textures drawn by crogine's own renderers, such as the ModelRenderer,
+    RenderSystem2D, ParticleSystem, SimpleDrawables and the ImGui::Image helpers,
+    are marked as used. Code which binds a texture from a TextureResource directly,
+    for example with glBindTexture(), must call markUsed() each frame it does so,
+    else the texture may be evicted while still in use.
+    */
+    class CRO_EXPORT_API TextureMemory final
+    {
+    public:
+        enum Category
+        {
+            Texture,
+            Font,
+            RenderTarget,
+            DepthTarget,
+            EnvironmentMap,
+
+            Count
+        };
+
+        struct Stats final
+        {
+            std::size_t total = 0; //!< total estimated bytes of all allocations
+            std::array<std::size_t, Category::Count> categoryTotals = {}; //!< total bytes used by each Category
+            std::size_t evictable = 0; //!< bytes used by textures which may be evicted
+            std::size_t budget = 0; //!< current budget, or 0 if unlimited
+            std::size_t evictedCount = 0; //!< number of textures currently evicted
+            std::size_t evictionCount = 0; //!< total number of evictions performed
+            std::size_t restoreCount = 0; //!< total number of evicted textures reloaded
+        };
+
+        /*!
+        \brief Sets the budget, in bytes, for texture memory.
+        Set to zero (the default) to disable eviction.
+        */
+        static void setBudget(std::size_t bytes);
+
+        /*!
+        \brief Returns the current budget, in bytes
+        */
+        static std::size_t getBudget();
+
+        /*!
+        \brief Returns the current memory statistics
+        */
+        static Stats getStats();
+
+        /*!
+        \brief Marks the texture with the given OpenGL handle as used this frame.
+        Evicted textures are reloaded when marked as used. This is only required
+        when binding textures directly, rather than via crogine's renderers.
+        */
+        static void markUsed(std::uint32_t handle);
+
+        /*!
+        \brief Returns the name of the given Category as a string
+        */
+        static const char* getCategoryName(Category);
+    };
+}
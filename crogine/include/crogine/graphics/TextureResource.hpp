@@ -36,6 +36,7 @@ source distribution.
 #include <unordered_map>
 #include <string>
 #include <memory>
+#include <future>
 
 //hash for colours
 namespace std
@@ -78,10 +79,30 @@ namespace cro
         */
         bool load(std::uint32_t id, const std::string& path, bool createMipMaps = false);
 
+        /*!
+        \brief Loads the image at the given path in the background.
+        The image is decoded on a worker thread, and the texture is created
+        on the main thread by the App, within its upload budget. Until then
+        get() returns the fallback texture for this ID.
+        \param id ID to assign to the loaded texture, if successful.
+        \param path String containing the path of the image to attempt to load
+        \param createMipMaps Attempts to create the default MipMap levels
+        when loading the texture.
+        \returns A future which becomes ready with the result of load()
+        once the texture has been created.
+        \see App::setUploadBudget()
+        */
+        std::future<bool> loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps = false);
+
         /*!
         \brief Returns a reference to the texture currently assigned to the given ID
         If the ID doesn't correspond to a loaded texture then a reference to the fallback
-        texture is returned
+        texture is returned.
+        Textures loaded from file by a TextureResource may be evicted from GPU memory
+        when a TextureMemory budget is set and they haven't been drawn recently. They
+        are reloaded automatically when next drawn, unless they have been modified with
+        Texture::update() or Texture::create().
+        \see TextureMemory
         */
         Texture& get(std::uint32_t id);
 
@@ -109,5 +130,19 @@ namespace cro
         std::unordered_map<std::uint32_t, std::pair<std::string, std::unique_ptr<Texture>>> m_textures;
         std::unordered_map<Colour, std::unique_ptr<Texture>> m_fallbackTextures;
         Colour m_fallbackColour;
+
+        //textures loaded asynchronously are moved here from the
+        //main thread until the next call to get() or load(). Held
+        //by pointer so pending loads can tell if this has been destroyed.
+        struct AsyncState final
+        {
+            std::unordered_map<std::uint32_t, std::string> pending;
+            std::unordered_map<std::uint32_t, std::pair<std::string, std::unique_ptr<Texture>>> loaded;
+        };
+        std::shared_ptr<AsyncState> m_asyncState;
+        void flushAsync();
+
+        //allows the texture to be evicted when over the TextureMemory budget
+        static void setEvictable(std::weak_ptr<AsyncState>, Texture&, const std::string& path);
     };
 }
\ No newline at end of file
@@ -83,30 +83,36 @@ namespace cro
 }
 
 #include <crogine/graphics/Texture.hpp>
+#include <crogine/graphics/TextureMemory.hpp>
 namespace ImGui
 {
     static inline void Image(const cro::Texture& texture, const ImVec2& size, const ImVec2& uv0 = { 0.f, 0.f }, const ImVec2& uv1 = { 1.f, 1.f })
     {
+        cro::TextureMemory::markUsed(texture.getGLHandle());
         ImGui::Image((void*)(std::size_t)texture.getGLHandle(), size, uv0, uv1);
     }
 
     static inline void Image(const cro::TextureID texture, const ImVec2& size, const ImVec2& uv0 = { 0.f, 0.f }, const ImVec2& uv1 = { 1.f, 1.f })
     {
+        cro::TextureMemory::markUsed(texture.textureID);
         ImGui::Image((void*)(std::size_t)texture.textureID, size, uv0, uv1);
     }
 
     static inline bool ImageButton(const cro::Texture& texture, const ImVec2& size, const ImVec2& uv0 = { 0.f, 0.f }, const ImVec2& uv1 = { 1.f, 1.f })
     {
+        cro::TextureMemory::markUsed(texture.getGLHandle());
         return ImGui::ImageButton((void*)(std::size_t)texture.getGLHandle(), size, uv0, uv1);
     }
 
     static inline bool ImageButton(const cro::TextureID texture, const ImVec2& size, const ImVec2& uv0 = { 0.f, 0.f }, const ImVec2& uv1 = { 1.f, 1.f })
     {
+        cro::TextureMemory::markUsed(texture.textureID);
         return ImGui::ImageButton((void*)(std::size_t)texture.textureID, size, uv0, uv1);
     }
 
     static inline bool ImageButton(std::uint32_t texture, const ImVec2& size, const ImVec2& uv0 = { 0.f, 0.f }, const ImVec2& uv1 = { 1.f, 1.f })
     {
+        cro::TextureMemory::markUsed(texture);
         return ImGui::ImageButton((void*)(std::size_t)texture, size, uv0, uv1);
     }
 }
\ No newline at end of file
@@ -0,0 +1,274 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/detail/glm/gtc/quaternion.hpp>
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Returns the number of bits needed to store values from 0 to maxValue
+    */
+    static inline constexpr std::uint32_t bitsRequired(std::uint32_t maxValue)
+    {
+        std::uint32_t bits = 0;
+        while (maxValue)
+        {
+            bits++;
+            maxValue >>= 1;
+        }
+        return bits;
+    }
+
+    /*!
+    \brief Serialises values into a tightly packed stream of bits.
+    Values are written with the minimum number of bits needed for their
+    range, rather than their full size, so that packets carry only the
+    information they need. For example a float in the range 0 - 100 with
+    a precision of 0.01 requires 14 bits rather than 32, and a rotation
+    can be written in 29 bits rather than 128. Data written with a BitWriter
+    must be read back in the same order, with the same ranges, with a BitReader.
+
+    Once written the data can be sent with NetHost or NetClient as raw
+    bytes, or copied into a NetPacket.
+    \see BitReader
+    */
+    class CRO_EXPORT_API BitWriter final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param reserve Number of bytes to reserve in the buffer, usually
+        the largest expected size of the data
+        */
+        explicit BitWriter(std::size_t reserve = 64);
+
+        /*!
+        \brief Writes the lowest bitCount bits of value.
+        \param value The value to write
+        \param bitCount Number of bits to write, from 1 to 32
+        */
+        void writeBits(std::uint32_t value, std::uint32_t bitCount);
+
+        /*!
+        \brief Writes a single bit. Useful for flagging the presence
+        of optional values.
+        */
+        void writeBool(bool value);
+
+        /*!
+        \brief Writes an integer which falls within the given range,
+        using only as many bits as the range requires.
+        Values outside the range are clamped.
+        */
+        void writeInt(std::int32_t value, std::int32_t min, std::int32_t max);
+
+        /*!
+        \brief Writes an unsigned integer using 8 bits for values below 128,
+        and up to 40 bits for larger values. Use this for values which are
+        usually small but may occasionally be large, such as counts or IDs.
+        */
+        void writeVarUInt(std::uint32_t value);
+
+        /*!
+        \brief Writes a signed integer with writeVarUInt(), encoded so
+        that small negative values are also written with few bits.
+        */
+        void writeVarInt(std::int32_t value);
+
+        /*!
+        \brief Writes a full precision float in 32 bits
+        */
+        void writeFloat(float value);
+
+        /*!
+        \brief Quantises a float to the given precision within the given range.
+        For example a range of -512 to 512 with a precision of 0.01 requires
+        17 bits. Values outside the range are clamped.
+        \param value The value to write
+        \param min The minimum value expected
+        \param max The maximum value expected
+        \param precision The largest acceptable error when the value is read
+        */
+        void writeFloat(float value, float min, float max, float precision);
+
+        /*!
+        \brief Writes each component of the vector with writeFloat(value, min, max, precision)
+        */
+        void writeVec3(glm::vec3 value, float min, float max, float precision);
+
+        /*!
+        \brief Writes a rotation using the 'smallest three' encoding.
+        The largest component of a normalised quaternion can be derived from
+        the other three, so only the index of the largest component is written,
+        followed by the remaining three components.
+        \param value A normalised quaternion
+        \param bitsPerComponent The number of bits used for each of the three
+        smallest components. The default of 9 uses 29 bits in total, which is
+        adequate for most rotations, and 10 uses 32 bits. Valid values are 2 to 15.
+        */
+        void writeQuat(glm::quat value, std::uint32_t bitsPerComponent = 9);
+
+        /*!
+        \brief Writes an array of bytes, for example a string.
+        */
+        void writeBytes(const void* data, std::size_t size);
+
+        /*!
+        \brief Pads the stream with zeros up to the next byte boundary
+        */
+        void alignToByte();
+
+        /*!
+        \brief Returns a pointer to the written data
+        */
+        const std::uint8_t* getData() const { return m_buffer.data(); }
+
+        /*!
+        \brief Returns the size of the written data in bytes,
+        including any partially written byte
+        */
+        std::size_t getSize() const { return m_buffer.size(); }
+
+        /*!
+        \brief Returns the number of bits written
+        */
+        std::size_t getBitCount() const { return m_bitPosition; }
+
+        /*!
+        \brief Clears all written data so the writer may be reused
+        without allocating its buffer again.
+        */
+        void clear();
+
+    private:
+        std::vector<std::uint8_t> m_buffer;
+        std::size_t m_bitPosition;
+    };
+
+    /*!
+    \brief Reads data written by a BitWriter.
+    Values must be read in the same order, and with the same ranges,
+    with which they were written. Reading beyond the end of the data
+    returns zero values and flags the reader as having overflowed,
+    which should be checked once all values have been read to make
+    sure the packet was not truncated or malformed.
+    \see BitWriter
+    */
+    class CRO_EXPORT_API BitReader final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param data Pointer to the data to read, for example NetEvent::Packet::getData().
+        This is not copied, so must remain valid for the lifetime of the reader.
+        \param size The size of the data in bytes
+        */
+        BitReader(const void* data, std::size_t size);
+
+        /*!
+        \brief Reads bitCount bits, from 1 to 32
+        */
+        std::uint32_t readBits(std::uint32_t bitCount);
+
+        /*!
+        \brief Reads a single bit
+        */
+        bool readBool();
+
+        /*!
+        \brief Reads an integer written with BitWriter::writeInt()
+        */
+        std::int32_t readInt(std::int32_t min, std::int32_t max);
+
+        /*!
+        \brief Reads an integer written with BitWriter::writeVarUInt()
+        */
+        std::uint32_t readVarUInt();
+
+        /*!
+        \brief Reads an integer written with BitWriter::writeVarInt()
+        */
+        std::int32_t readVarInt();
+
+        /*!
+        \brief Reads a full precision float
+        */
+        float readFloat();
+
+        /*!
+        \brief Reads a float written with BitWriter::writeFloat(value, min, max, precision)
+        */
+        float readFloat(float min, float max, float precision);
+
+        /*!
+        \brief Reads a vector written with BitWriter::writeVec3()
+        */
+        glm::vec3 readVec3(float min, float max, float precision);
+
+        /*!
+        \brief Reads a rotation written with BitWriter::writeQuat()
+        \returns A normalised quaternion
+        */
+        glm::quat readQuat(std::uint32_t bitsPerComponent = 9);
+
+        /*!
+        \brief Reads size bytes into the given buffer
+        */
+        void readBytes(void* dst, std::size_t size);
+
+        /*!
+        \brief Skips to the next byte boundary
+        */
+        void alignToByte();
+
+        /*!
+        \brief Returns the number of bits which have not yet been read
+        */
+        std::size_t getRemainingBits() const { return (m_size * 8) - m_bitPosition; }
+
+        /*!
+        \brief Returns true if an attempt was made to read more data than was available
+        */
+        bool overflowed() const { return m_overflow; }
+
+    private:
+        const std::uint8_t* m_data;
+        std::size_t m_size;
+        std::size_t m_bitPosition;
+        bool m_overflow;
+    };
+}
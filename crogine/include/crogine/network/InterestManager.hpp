@@ -0,0 +1,150 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/network/NetData.hpp>
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace cro
+{
+    /*!
+    \brief Decides which replicated entities are relevant to each connected peer.
+
+    Entities are registered with a position, a group and a priority, and peers
+    with a position, an interest radius, a mask of groups in which they are
+    interested, and an optional bandwidth budget. When passed to SnapshotHost::send()
+    each peer is sent only the entities relevant to it: those in one of its groups
+    and within its interest radius. Entities which move out of range are removed
+    from the peer's snapshot.
+
+    When a peer has a bandwidth budget, changed entities are sent in order of
+    an accumulated priority, which grows each tick an entity is relevant but
+    not sent, weighted by its priority and proximity to the peer. Entities
+    which don't fit in the budget keep their previous state on the client and
+    are sent on a later tick, so that distant or low priority entities are
+    updated less often, but are never starved.
+
+    Entities are placed in a grid on the XZ plane for fast lookup, so the cell
+    size should be roughly the size of a typical interest radius.
+    Entities in a snapshot which are not registered with the InterestManager
+    are considered relevant to every peer.
+    \see SnapshotHost
+    */
+    class CRO_EXPORT_API InterestManager final
+    {
+    public:
+        /*!
+        \brief Constructor
+        \param cellSize Size of the grid cells in world units
+        */
+        explicit InterestManager(float cellSize = 50.f);
+
+        /*!
+        \brief Interest settings for a single peer
+        */
+        struct PeerInterest final
+        {
+            glm::vec3 position = glm::vec3(0.f); //! <Position from which the peer is viewing, eg its player or camera
+            float radius = 0.f; //! <Entities further than this from the position are not sent. 0 is no limit.
+            std::uint32_t groups = 0xffffffff; //! <Bitmask of groups the peer is interested in, eg its team or current hole
+            std::size_t bandwidthBudget = 0; //! <Maximum number of bytes sent per tick. 0 is no limit.
+        };
+
+        /*!
+        \brief Registers an entity or updates an existing one.
+        \param entityID ID of the entity as used with SnapshotHost::setState()
+        \param position World position of the entity
+        \param group Group index 0 - 31 to which the entity belongs
+        \param priority Relative priority of the entity when the
+        bandwidth budget is limited. Higher values are sent more often.
+        */
+        void setEntity(std::uint32_t entityID, glm::vec3 position, std::uint32_t group = 0, float priority = 1.f);
+
+        /*!
+        \brief Removes the entity with the given ID
+        */
+        void removeEntity(std::uint32_t entityID);
+
+        /*!
+        \brief Removes all registered entities
+        */
+        void clearEntities();
+
+        /*!
+        \brief Adds a peer or updates its existing interest.
+        Peers which are not added are sent all entities.
+        */
+        void setPeer(const NetPeer& peer, const PeerInterest& interest);
+
+        /*!
+        \brief Removes the given peer. This should be called when
+        a peer disconnects.
+        */
+        void removePeer(const NetPeer& peer);
+
+    private:
+        float m_cellSize;
+
+        struct EntityInfo final
+        {
+            glm::vec3 position = glm::vec3(0.f);
+            std::uint32_t group = 0;
+            float priority = 1.f;
+        };
+        std::unordered_map<std::uint32_t, EntityInfo> m_entities;
+        std::unordered_map<std::uint64_t, std::vector<std::uint32_t>> m_cells;
+
+        struct PeerInfo final
+        {
+            NetPeer peer;
+            PeerInterest interest;
+            std::vector<std::uint32_t> relevant;
+            std::unordered_map<std::uint32_t, float> priorities;
+        };
+        std::vector<PeerInfo> m_peers;
+
+        std::uint64_t getCellKey(std::int32_t x, std::int32_t z) const;
+        std::int32_t getCellCoord(float) const;
+        void update();
+        void updatePeer(PeerInfo&);
+
+        PeerInfo* getPeer(const NetPeer&);
+        bool isRegistered(std::uint32_t entityID) const;
+        float accumulatePriority(PeerInfo&, std::uint32_t entityID) const;
+
+        friend class SnapshotHost;
+    };
+}
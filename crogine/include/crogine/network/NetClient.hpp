@@ -139,6 +139,17 @@ namespace cro
         */
         void sendPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag flags, std::uint8_t channel = 0) const;
 
+        /*!
+        \brief Sends a packet which was serialised in place to the server,
+        if a connection is established, else does nothing.
+        The packet data is not copied.
+        \param packet The packet to send
+        \param channel Stream channel over which to send the data. Lower number
+        channels have higher priority, with 0 being highest.
+        \see NetPacket
+        */
+        void sendPacket(const NetPacket& packet, std::uint8_t channel = 0) const;
+
         /*!
         \brief Returns a reference to the client's peer.
         Peers are only valid when connected to a server.
@@ -35,6 +35,7 @@ source distribution.
 
 #include <cstring>
 #include <string>
+#include <type_traits>
 
 struct _ENetPacket;
 struct _ENetPeer;
@@ -79,6 +80,61 @@ namespace cro
         friend class NetHost;
     };
 
+    /*!
+    \brief Read-only view of received packet data.
+    Values are read in order, directly from the packet, so that
+    large packets aren't copied in their entirety as they are with
+    NetEvent::Packet::as(). As packet data follows a single byte ID
+    it is not aligned, so values are always read by copying them
+    rather than by casting pointers into the packet.
+    */
+    class CRO_EXPORT_API NetPacketView final
+    {
+    public:
+        NetPacketView() = default;
+        NetPacketView(const void* data, std::size_t size);
+
+        /*!
+        \brief Reads the next value from the packet into dst.
+        \returns false if there is not enough data remaining,
+        in which case dst is left unmodified.
+        */
+        template <typename T>
+        bool read(T& dst);
+
+        /*!
+        \brief Reads size bytes from the packet into dst
+        \returns false if there is not enough data remaining
+        */
+        bool read(void* dst, std::size_t size);
+
+        /*!
+        \brief Skips the given number of bytes
+        \returns false if there is not enough data remaining
+        */
+        bool skip(std::size_t size);
+
+        /*!
+        \brief Returns a pointer to the data at the current read position
+        */
+        const void* getData() const { return m_data + m_position; }
+
+        /*!
+        \brief Returns the total size of the viewed data in bytes
+        */
+        std::size_t getSize() const { return m_size; }
+
+        /*!
+        \brief Returns the number of bytes remaining to be read
+        */
+        std::size_t getRemaining() const { return m_size - m_position; }
+
+    private:
+        const std::uint8_t* m_data = nullptr;
+        std::size_t m_size = 0;
+        std::size_t m_position = 0;
+    };
+
     /*!
     \brief Network event.
     These are used to poll NetHost and NetClient objects
@@ -132,6 +188,14 @@ namespace cro
             */
             std::size_t getSize() const;
 
+            /*!
+            \brief Returns a view of the packet data which can be used
+            to read it without copying the entire packet.
+            The view is only valid for the lifetime of this packet.
+            \see NetPacketView
+            */
+            NetPacketView getView() const;
+
         private:
             _ENetPacket* m_packet;
             std::uint8_t m_id;
@@ -147,8 +211,6 @@ namespace cro
         NetPeer peer;
     };
 
-#include "NetData.inl"
-
     /*!
     \brief Reliability enum.
     These are used to flag sent packets with a requested reliability.
@@ -159,4 +221,76 @@ namespace cro
         Unsequenced = 0x2, //! <packet will not be sequenced with other packets. Not supported on reliable packets
         Unreliable = 0x4 //! <packet will be fragments and sent unreliably if it exceeds MTU
     };
+
+    /*!
+    \brief An outgoing packet which is serialised in place.
+    The packet is allocated once at its final size, and data is
+    written directly into it, either with write() or via getData().
+    It can then be passed to NetHost::sendPacket(), NetHost::broadcastPacket()
+    or NetClient::sendPacket() without being copied. The same packet
+    may be sent to multiple peers, but must not be modified once sent.
+    Packet memory is recycled, so creating packets is cheap.
+    */
+    class CRO_EXPORT_API NetPacket final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param id Unique ID for this packet
+        \param size Size of the packet data in bytes, not including the ID
+        \param flags Requested reliability of the packet
+        */
+        NetPacket(std::uint8_t id, std::size_t size, NetFlag flags);
+        ~NetPacket();
+
+        NetPacket(const NetPacket&) = delete;
+        NetPacket(NetPacket&&) noexcept;
+        NetPacket& operator = (const NetPacket&) = delete;
+        NetPacket& operator = (NetPacket&&) noexcept;
+
+        /*!
+        \brief Returns the ID of this packet
+        */
+        std::uint8_t getID() const;
+
+        /*!
+        \brief Returns a pointer to the packet data, following the ID.
+        This must not be written to once the packet has been sent.
+        */
+        void* getData();
+        const void* getData() const;
+
+        /*!
+        \brief Returns the size of the packet data in bytes, not including the ID
+        */
+        std::size_t getSize() const;
+
+        /*!
+        \brief Writes the given value at the current write position,
+        and advances the write position by its size.
+        \returns false if there is not enough room left in the packet
+        */
+        template <typename T>
+        bool write(const T& data);
+
+        /*!
+        \brief Writes size bytes from data at the current write position
+        \returns false if there is not enough room left in the packet
+        */
+        bool write(const void* data, std::size_t size);
+
+        /*!
+        \brief Returns true if the packet was successfully allocated
+        */
+        operator bool() const { return m_packet != nullptr; }
+
+    private:
+        _ENetPacket* m_packet;
+        std::size_t m_position;
+
+        friend class NetClient;
+        friend class NetHost;
+    };
+
+#include "NetData.inl"
 }
\ No newline at end of file
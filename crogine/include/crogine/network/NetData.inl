@@ -37,4 +37,17 @@ T NetEvent::Packet::as() const
     std::memcpy(&returnData, getData(), getSize());
 
     return returnData;
+}
+template <typename T>
+bool NetPacketView::read(T& dst)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read from a packet");
+    return read(&dst, sizeof(T));
+}
+
+template <typename T>
+bool NetPacket::write(const T& data)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written to a packet");
+    return write(&data, sizeof(T));
 }
\ No newline at end of file
@@ -152,6 +152,28 @@ namespace cro
         */
         void sendPacket(const NetPeer& peer, std::uint8_t id, const void* data, std::size_t size, NetFlag flags, std::uint8_t channel = 0) const;
 
+        /*!
+        \brief Sends a packet which was serialised in place to the given peer.
+        The packet data is not copied, and the same packet may be sent to
+        more than one peer, although it must not be modified once sent.
+        \param peer The peer over which to send the packet.
+        \param packet The packet to send
+        \param channel Stream channel over which to send the data. Lower number
+        channels have higher priority, with 0 being highest.
+        \see NetPacket
+        */
+        void sendPacket(const NetPeer& peer, const NetPacket& packet, std::uint8_t channel = 0) const;
+
+        /*!
+        \brief Broadcasts a packet which was serialised in place to all connected clients.
+        The packet data is not copied.
+        \param packet The packet to broadcast
+        \param channel Stream channel over which to send the data. Lower number
+        channels have higher priority, with 0 being highest.
+        \see NetPacket
+        */
+        void broadcastPacket(const NetPacket& packet, std::uint8_t channel = 0) const;
+
 
         /*!
         \brief Disconnects the given peer from this host, if it is valid
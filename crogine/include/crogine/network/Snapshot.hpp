@@ -0,0 +1,280 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+#include <crogine/network/NetData.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace cro
+{
+    class BitWriter;
+    class BitReader;
+    class InterestManager;
+    class NetClient;
+    class NetHost;
+
+    namespace Detail
+    {
+        /*
+        The state of all replicated entities at a single network tick.
+        Entity IDs are kept sorted, and each state occupies
+        a padded stride in a single flat buffer, so that two
+        snapshots can be compared with a single pass.
+        */
+        struct Snapshot final
+        {
+            std::uint32_t sequence = 0;
+            std::vector<std::uint32_t> ids;
+            std::vector<std::uint8_t> data;
+
+            std::size_t find(std::uint32_t id) const;
+            void clear();
+        };
+    }
+
+    /*!
+    \brief Server side replication of entity state via delta compressed snapshots.
+
+    Each network tick the server sets the current state of every replicated
+    entity, as a fixed size, trivially copyable struct, and calls send().
+    Rather than sending the full state of every entity to every client, each
+    snapshot is delta encoded against the most recent snapshot acknowledged
+    by the receiving client, so that only the entities - and the 4 byte words
+    of their state - which have changed are sent. Entities which are added or
+    removed are included automatically.
+
+    Snapshots are sent unreliably. If a client fails to acknowledge any of the
+    last historySize snapshots, for example during heavy packet loss, the full
+    state is sent instead until a new acknowledgement is received.
+
+    Snapshots are received with a SnapshotClient, which must be created with the
+    same state size and packet IDs.
+    \see SnapshotClient
+    */
+    class CRO_EXPORT_API SnapshotHost final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        \param stateSize Size in bytes of the state of a single entity
+        \param snapshotID Packet ID used when sending snapshots
+        \param ackID Packet ID on which clients acknowledge received snapshots
+        \param historySize Number of sent snapshots stored per client which can
+        be used as a baseline for delta compression. At 20 ticks per second the
+        default of 32 allows acknowledgements to take up to 1.6 seconds
+        */
+        SnapshotHost(std::size_t stateSize, std::uint8_t snapshotID, std::uint8_t ackID, std::size_t historySize = 32);
+
+        /*!
+        \brief Sets the current state of an entity, adding it to the
+        snapshot if it doesn't yet exist.
+        \param entityID Unique ID of the entity, such as its server side entity index
+        \param state Struct containing the entity state. This must be trivially
+        copyable, and the size must match the stateSize given on construction
+        */
+        template <typename T>
+        void setState(std::uint32_t entityID, const T& state);
+
+        /*!
+        \brief Sets the current state of an entity from a pointer to
+        stateSize bytes.
+        */
+        void setState(std::uint32_t entityID, const void* state);
+
+        /*!
+        \brief Removes the entity with the given ID from subsequent snapshots
+        */
+        void removeEntity(std::uint32_t entityID);
+
+        /*!
+        \brief Removes all entities from subsequent snapshots
+        */
+        void clearEntities();
+
+        /*!
+        \brief Adds a client to which snapshots are sent.
+        The first snapshot sent to a new client contains the full state.
+        */
+        void addPeer(const NetPeer& peer);
+
+        /*!
+        \brief Stops sending snapshots to the given client
+        */
+        void removePeer(const NetPeer& peer);
+
+        /*!
+        \brief Passes a network event to the host.
+        This should be called for every event polled from the NetHost, so that
+        acknowledgements are processed. Disconnected clients are removed
+        automatically.
+        \returns true if the event was a snapshot acknowledgement and needs no
+        further processing
+        */
+        bool handleEvent(const NetEvent& evt);
+
+        /*!
+        \brief Sends a snapshot of the current entity state to all added clients
+        \param host The NetHost used to send the snapshots
+        \param channel The channel on which to send the snapshots
+        */
+        void send(NetHost& host, std::uint8_t channel = 0);
+
+        /*!
+        \brief Sends a snapshot to all added clients, containing only the
+        entities relevant to each, as decided by the given InterestManager.
+        \param host The NetHost used to send the snapshots
+        \param interest The InterestManager containing the position of
+        each entity and the interest of each client
+        \param channel The channel on which to send the snapshots
+        \see InterestManager
+        */
+        void send(NetHost& host, InterestManager& interest, std::uint8_t channel = 0);
+
+        /*!
+        \brief Returns the total number of bytes sent by the most recent call to send()
+        */
+        std::size_t getLastSendSize() const { return m_lastSendSize; }
+
+    private:
+        std::size_t m_stateSize;
+        std::size_t m_stride;
+        std::uint8_t m_snapshotID;
+        std::uint8_t m_ackID;
+        std::size_t m_historySize;
+        std::uint32_t m_sequence;
+        std::size_t m_lastSendSize;
+
+        Detail::Snapshot m_currentState;
+
+        struct PeerState final
+        {
+            NetPeer peer;
+            std::uint32_t lastAck = 0;
+            std::vector<Detail::Snapshot> history;
+        };
+        std::vector<PeerState> m_peers;
+        std::vector<std::uint8_t> m_zeroState;
+
+        struct Entry final
+        {
+            std::uint32_t id = 0;
+            const std::uint8_t* state = nullptr;
+            const std::uint8_t* baseState = nullptr;
+            float priority = 0.f;
+            std::size_t bitCount = 0;
+        };
+        std::vector<Entry> m_entries;
+        std::vector<std::size_t> m_pending;
+
+        void sendSnapshots(NetHost&, InterestManager*, std::uint8_t);
+        bool buildPeerState(InterestManager&, const NetPeer&, const Detail::Snapshot& baseline, Detail::Snapshot& dst);
+        void encode(BitWriter&, const Detail::Snapshot& state, const Detail::Snapshot& baseline) const;
+    };
+
+    /*!
+    \brief Client side receiver of snapshots sent by a SnapshotHost.
+    Received snapshots are decoded against the baseline on which
+    they were encoded, and acknowledged to the server. The most
+    recently received entity state can then be read with getState().
+    \see SnapshotHost
+    */
+    class CRO_EXPORT_API SnapshotClient final
+    {
+    public:
+        /*!
+        \brief Constructor.
+        Parameters must match those of the SnapshotHost
+        \param stateSize Size in bytes of the state of a single entity
+        \param snapshotID Packet ID on which snapshots are received
+        \param ackID Packet ID used to acknowledge received snapshots
+        \param historySize Number of received snapshots to store for decoding
+        */
+        SnapshotClient(std::size_t stateSize, std::uint8_t snapshotID, std::uint8_t ackID, std::size_t historySize = 32);
+
+        /*!
+        \brief Passes a network event to the client.
+        This should be called for every event polled from the NetClient.
+        \param evt The event to process
+        \param client The NetClient from which the event was polled, used
+        to acknowledge received snapshots
+        \returns true if the event was a snapshot which was successfully decoded,
+        in which case the entity state is updated.
+        */
+        bool handleEvent(const NetEvent& evt, NetClient& client);
+
+        /*!
+        \brief Returns the sequence number of the most recent snapshot, or 0
+        if none has been received.
+        */
+        std::uint32_t getSequence() const;
+
+        /*!
+        \brief Returns the IDs of all entities in the most recent snapshot,
+        sorted in ascending order.
+        */
+        const std::vector<std::uint32_t>& getEntityIDs() const;
+
+        /*!
+        \brief Copies the state of the given entity into dst.
+        \returns false if the entity doesn't exist, in which case dst is not modified
+        */
+        template <typename T>
+        bool getState(std::uint32_t entityID, T& dst) const;
+
+        /*!
+        \brief Copies stateSize bytes of the given entity's state into dst.
+        \returns false if the entity doesn't exist
+        */
+        bool getState(std::uint32_t entityID, void* dst) const;
+
+        /*!
+        \brief Clears all received snapshots, for example when reconnecting
+        */
+        void reset();
+
+    private:
+        std::size_t m_stateSize;
+        std::size_t m_stride;
+        std::uint8_t m_snapshotID;
+        std::uint8_t m_ackID;
+
+        std::vector<Detail::Snapshot> m_history;
+        std::size_t m_current;
+        Detail::Snapshot m_decodeBuffer;
+
+        bool decode(BitReader&, const Detail::Snapshot& baseline, Detail::Snapshot& dst);
+    };
+
+#include "Snapshot.inl"
+}
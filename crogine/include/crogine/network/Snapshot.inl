@@ -0,0 +1,45 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+template <typename T>
+void SnapshotHost::setState(std::uint32_t entityID, const T& state)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be replicated");
+    CRO_ASSERT(sizeof(T) == m_stateSize, "This type's size does not match the state size");
+    setState(entityID, static_cast<const void*>(&state));
+}
+
+template <typename T>
+bool SnapshotClient::getState(std::uint32_t entityID, T& dst) const
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be replicated");
+    CRO_ASSERT(sizeof(T) == m_stateSize, "This type's size does not match the state size");
+    return getState(entityID, static_cast<void*>(&dst));
+}
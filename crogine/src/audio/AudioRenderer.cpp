@@ -29,8 +29,10 @@ source distribution.
 
 #include "AudioRenderer.hpp"
 #include "OpenALImpl.hpp"
+#include "SoftwareMixerImpl.hpp"
 //#include "SDLMixerImpl.hpp"
 #include "NullImpl.hpp"
+#include "StreamScheduler.hpp"
 
 #include <crogine/audio/AudioMixer.hpp>
 #include <crogine/detail/Assert.hpp>
@@ -42,11 +44,38 @@ std::unique_ptr<AudioRendererImpl> AudioRenderer::m_impl;
 namespace
 {
     bool valid = false;
+
+    //the last listener values sent to the renderer, so that
+    //unchanged values aren't resubmitted every frame
+    struct ListenerCache final
+    {
+        enum
+        {
+            Position    = 0x1,
+            Orientation = 0x2,
+            Volume      = 0x4,
+            Velocity    = 0x8
+        };
+        std::uint8_t validFlags = 0;
+
+        glm::vec3 position = glm::vec3(0.f);
+        glm::vec3 forward = glm::vec3(0.f);
+        glm::vec3 up = glm::vec3(0.f);
+        glm::vec3 velocity = glm::vec3(0.f);
+        float volume = 1.f;
+    }listenerCache;
 }
 
 bool AudioRenderer::init()
 {
-#ifdef AL_AUDIO
+    if (m_impl)
+    {
+        m_impl->shutdown();
+    }
+
+#ifdef SOFT_AUDIO
+    m_impl = std::make_unique<Detail::SoftwareMixerImpl>();
+#elif defined(AL_AUDIO)
     m_impl = std::make_unique<Detail::OpenALImpl>();
 #elif defined(SDL_AUDIO)
     m_impl = std::make_unique<Detail::SDLMixerImpl>();
@@ -54,6 +83,25 @@ bool AudioRenderer::init()
 #endif
 
     valid = m_impl->init();
+    listenerCache = {};
+
+    if (!valid) m_impl = std::make_unique<Detail::NullImpl>();
+
+    return valid;
+}
+
+bool AudioRenderer::init(std::unique_ptr<AudioRendererImpl> impl)
+{
+    CRO_ASSERT(impl, "Invalid renderer");
+
+    if (m_impl)
+    {
+        m_impl->shutdown();
+    }
+
+    m_impl = std::move(impl);
+    valid = m_impl->init();
+    listenerCache = {};
 
     if (!valid) m_impl = std::make_unique<Detail::NullImpl>();
 
@@ -64,6 +112,10 @@ void AudioRenderer::shutdown()
 {
     CRO_ASSERT(m_impl, "Audio not initialised");
     m_impl->shutdown();
+
+    //implementations only remove their own streams, as SoundStreams
+    //may also be using the scheduler, so stop it here for all of them
+    Detail::StreamScheduler::shutdown();
 }
 
 bool AudioRenderer::isValid()
@@ -73,22 +125,57 @@ bool AudioRenderer::isValid()
 
 void AudioRenderer::setListenerPosition(glm::vec3 position)
 {
+    if ((listenerCache.validFlags & ListenerCache::Position)
+        && listenerCache.position == position)
+    {
+        return;
+    }
+
     m_impl->setListenerPosition(position);
+    listenerCache.position = position;
+    listenerCache.validFlags |= ListenerCache::Position;
 }
 
 void AudioRenderer::setListenerOrientation(glm::vec3 forward, glm::vec3 up)
 {
+    if ((listenerCache.validFlags & ListenerCache::Orientation)
+        && listenerCache.forward == forward
+        && listenerCache.up == up)
+    {
+        return;
+    }
+
     m_impl->setListenerOrientation(forward, up);
+    listenerCache.forward = forward;
+    listenerCache.up = up;
+    listenerCache.validFlags |= ListenerCache::Orientation;
 }
 
 void AudioRenderer::setListenerVolume(float volume)
 {
-    m_impl->setListenerVolume(std::max(0.f, volume));
+    volume = std::max(0.f, volume);
+    if ((listenerCache.validFlags & ListenerCache::Volume)
+        && listenerCache.volume == volume)
+    {
+        return;
+    }
+
+    m_impl->setListenerVolume(volume);
+    listenerCache.volume = volume;
+    listenerCache.validFlags |= ListenerCache::Volume;
 }
 
 void AudioRenderer::setListenerVelocity(glm::vec3 velocity)
 {
+    if ((listenerCache.validFlags & ListenerCache::Velocity)
+        && listenerCache.velocity == velocity)
+    {
+        return;
+    }
+
     m_impl->setListenerVelocity(velocity);
+    listenerCache.velocity = velocity;
+    listenerCache.validFlags |= ListenerCache::Velocity;
 }
 
 glm::vec3 AudioRenderer::getListenerPosition()
@@ -111,6 +198,15 @@ void AudioRenderer::deleteBuffer(std::int32_t buffer)
     m_impl->deleteBuffer(buffer);
 }
 
+cro::Time AudioRenderer::getBufferDuration(std::int32_t buffer)
+{
+    if (buffer < 1)
+    {
+        return {};
+    }
+    return m_impl->getBufferDuration(buffer);
+}
+
 std::int32_t AudioRenderer::requestNewStream(const std::string& path)
 {
     return m_impl->requestNewStream(path);
@@ -209,6 +305,14 @@ void AudioRenderer::setSourceVelocity(std::int32_t src, glm::vec3 velocity)
     m_impl->setSourceVelocity(src, velocity);
 }
 
+void AudioRenderer::updateSources(const std::vector<AudioSourceUpdate>& updates)
+{
+    if (!updates.empty())
+    {
+        m_impl->updateSources(updates);
+    }
+}
+
 void AudioRenderer::setDopplerFactor(float factor)
 {
     CRO_ASSERT(factor >= 0, "Must not be negative");
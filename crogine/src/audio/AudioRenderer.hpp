@@ -37,6 +37,7 @@ source distribution.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cro
 {
@@ -45,6 +46,34 @@ namespace cro
         struct PCMData;
     }
     
+    /*!
+    \brief A set of changed properties for a single audio source.
+    These are collected by the AudioSystem each frame and submitted
+    together with AudioRenderer::updateSources(), so that only properties
+    which have actually changed are sent to the renderer.
+    */
+    struct AudioSourceUpdate final
+    {
+        enum Flags
+        {
+            Position = 0x1,
+            Velocity = 0x2,
+            Pitch    = 0x4,
+            Volume   = 0x8,
+            Rolloff  = 0x10,
+            All = Position | Velocity | Pitch | Volume | Rolloff
+        };
+
+        std::int32_t source = -1;
+        std::uint8_t flags = 0;
+
+        glm::vec3 position = glm::vec3(0.f);
+        glm::vec3 velocity = glm::vec3(0.f);
+        float pitch = 1.f;
+        float volume = 1.f;
+        float rolloff = 1.f;
+    };
+
     /*!
     \brief Defines the interface for an audio renderer.
     Allows for defining multiple rendersystems for targeting different
@@ -74,6 +103,7 @@ namespace cro
         virtual std::int32_t requestNewBuffer(const std::string&) = 0;
         virtual std::int32_t requestNewBuffer(const Detail::PCMData&) = 0;
         virtual void deleteBuffer(std::int32_t) = 0;
+        virtual cro::Time getBufferDuration(std::int32_t) const = 0;
 
         virtual std::int32_t requestNewStream(const std::string&) = 0;
         virtual void deleteStream(std::int32_t) = 0;
@@ -95,6 +125,7 @@ namespace cro
         virtual void setSourceVolume(std::int32_t, float) = 0;
         virtual void setSourceRolloff(std::int32_t, float) = 0;
         virtual void setSourceVelocity(std::int32_t, glm::vec3) = 0;
+        virtual void updateSources(const std::vector<AudioSourceUpdate>&) = 0;
         virtual void setDopplerFactor(float) = 0;
         virtual void setSpeedOfSound(float) = 0;
     };
@@ -121,8 +152,17 @@ namespace cro
         static bool init();
 
         /*!
-        \brief Used to tidy up any resources used by the implementation.
-        This is called during shutdown
+        \brief Replaces the active renderer with the given implementation.
+        Any active renderer is shut down first, so all existing buffers,
+        streams and sources become invalid. Used by the OfflineAudioRenderer.
+        \returns true if the new renderer was initialised, else the Null
+        renderer is used and this returns false.
+        */
+        static bool init(std::unique_ptr<AudioRendererImpl> impl);
+
+        /*!
+        \brief Used to tidy up any resources used by the implementation,
+        and stops the audio streaming thread. This is called during shutdown
         */
         static void shutdown();
 
@@ -190,6 +230,12 @@ namespace cro
         */
         static void deleteBuffer(std::int32_t buffer);
 
+        /*!
+        \brief Returns the play time of the buffer with the given ID,
+        or zero if the buffer doesn't exist
+        */
+        static cro::Time getBufferDuration(std::int32_t buffer);
+
         /*!
         \brief Requests a new audio stream from a file on disk.
         \param path Path to file to stream.
@@ -292,6 +338,14 @@ namespace cro
         */
         static void setSourceVelocity(std::int32_t src, glm::vec3 velocity);
 
+        /*!
+        \brief Applies a batch of source property changes at once.
+        Only the properties flagged in each update are set. Renderers
+        may apply the whole batch atomically, so this is preferable to
+        calling the individual setters for many sources.
+        */
+        static void updateSources(const std::vector<AudioSourceUpdate>& updates);
+
         /*!
         \brief Sets the Doppler effect multiplier.
         This has the effects of multiplying the current source and listener velocities
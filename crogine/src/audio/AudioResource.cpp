@@ -31,8 +31,16 @@ source distribution.
 #include <crogine/audio/AudioBuffer.hpp>
 #include <crogine/audio/AudioStream.hpp>
 #include <crogine/core/Log.hpp>
+#include <crogine/core/FileSystem.hpp>
 #include <crogine/detail/Assert.hpp>
 
+#include "WavLoader.hpp"
+#include "VorbisLoader.hpp"
+#include "../detail/AsyncLoader.hpp"
+
+#include <cstring>
+
+#include <algorithm>
 #include <vector>
 
 using namespace cro;
@@ -40,9 +48,71 @@ using namespace cro;
 namespace
 {
     std::int32_t autoID = std::numeric_limits<std::int32_t>::max();
+
+    //PCM data decoded on a worker thread, copied
+    //from the loader so it outlives it
+    struct DecodedAudio final
+    {
+        Detail::PCMData info;
+        std::vector<std::uint8_t> pcm;
+    };
+
+    DecodedAudio decode(const std::string& path)
+    {
+        const auto fullPath = FileSystem::getResourcePath() + path;
+        const auto ext = FileSystem::getFileExtension(fullPath);
+
+        std::unique_ptr<Detail::AudioFile> loader;
+        if (ext == ".wav")
+        {
+            loader = std::make_unique<Detail::WavLoader>();
+        }
+        else if (ext == ".ogg")
+        {
+            loader = std::make_unique<Detail::VorbisLoader>();
+        }
+        else
+        {
+            LogE << ext << ": format not supported" << std::endl;
+        }
+
+        DecodedAudio result;
+        if (loader && loader->open(fullPath))
+        {
+            result.info = loader->getData();
+            if (result.info.data)
+            {
+                result.pcm.resize(result.info.size);
+                std::memcpy(result.pcm.data(), result.info.data, result.info.size);
+            }
+            result.info.data = nullptr;
+        }
+        return result;
+    }
+
+    //must be called on the main thread
+    std::shared_ptr<AudioSource> createBuffer(DecodedAudio& decoded)
+    {
+        if (decoded.pcm.empty())
+        {
+            return nullptr;
+        }
+
+        const auto format = decoded.info.format;
+        const bool stereo = (format == Detail::PCMData::Format::STEREO8 || format == Detail::PCMData::Format::STEREO16);
+        const std::uint8_t bitDepth = (format == Detail::PCMData::Format::MONO8 || format == Detail::PCMData::Format::STEREO8) ? 8 : 16;
+
+        auto buffer = std::make_shared<AudioBuffer>();
+        if (!buffer->loadFromMemory(decoded.pcm.data(), bitDepth, decoded.info.frequency, stereo, decoded.pcm.size()))
+        {
+            return nullptr;
+        }
+        return buffer;
+    }
 }
 
 AudioResource::AudioResource()
+    : m_asyncState(std::make_shared<AsyncState>())
 {
     m_fallback = std::make_unique<AudioBuffer>();
     std::vector<std::uint8_t> data(10, 0);
@@ -52,35 +122,54 @@ AudioResource::AudioResource()
 //public
 bool AudioResource::load(std::int32_t ID, const std::string& path, bool streaming)
 {
+    flushAsync();
+
     if (!streaming &&
-        m_sources.count(ID) > 0)
+        (m_sources.count(ID) > 0 || m_asyncState->pending.count(ID) > 0))
     {
         Logger::log("Data Source with ID " + std::to_string(ID) + " alread exists", Logger::Type::Error);
         return false;
     }
 
-    std::unique_ptr<AudioSource> buffer;
+    //share the buffer if this file is already loaded
+    if (!streaming)
+    {
+        if (auto existing = m_usedPaths.find(path); existing != m_usedPaths.end())
+        {
+            m_sources.insert(std::make_pair(ID, m_sources.at(existing->second)));
+            return true;
+        }
+    }
+
+    std::shared_ptr<AudioSource> buffer;
     
     if (streaming)
     {
-        buffer = std::make_unique<AudioStream>();
+        buffer = std::make_shared<AudioStream>();
     }
     else
     {
-        buffer = std::make_unique<AudioBuffer>();
+        buffer = std::make_shared<AudioBuffer>();
     }
     
     auto result = buffer->loadFromFile(path);
     if (result)
     {
         m_sources.insert(std::make_pair(ID, std::move(buffer)));
-        m_usedPaths.insert(std::make_pair(path, ID));
+
+        //only buffers are shared, each stream is unique
+        if (!streaming)
+        {
+            m_usedPaths.insert(std::make_pair(path, ID));
+        }
     }
     return result;
 }
 
 std::int32_t AudioResource::load(const std::string& path, bool streaming)
 {
+    flushAsync();
+
     //streaming sources shouldn't be shared
     //cos, well, they're streaming
 
@@ -102,8 +191,138 @@ std::int32_t AudioResource::load(const std::string& path, bool streaming)
     return -1;
 }
 
+std::future<bool> AudioResource::loadAsync(std::int32_t id, const std::string& path, bool streaming)
+{
+    flushAsync();
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result = promise->get_future();
+
+    if (streaming
+        || m_sources.count(id) > 0
+        || m_asyncState->pending.count(id) > 0
+        || m_usedPaths.count(path) > 0)
+    {
+        promise->set_value(load(id, path, streaming));
+        return result;
+    }
+
+    m_asyncState->pending.insert(std::make_pair(id, path));
+
+    //this file is already being decoded so wait for that to finish
+    if (auto inFlight = m_asyncState->inFlight.find(path); inFlight != m_asyncState->inFlight.end())
+    {
+        inFlight->second.emplace_back(id, promise);
+        return result;
+    }
+    m_asyncState->inFlight[path];
+
+    std::weak_ptr<AsyncState> weakState = m_asyncState;
+    Detail::AsyncLoader::queueJob([weakState, promise, id, path]()
+        {
+            if (weakState.expired())
+            {
+                promise->set_value(false);
+                return;
+            }
+
+            auto decoded = std::make_shared<DecodedAudio>(decode(path));
+
+            Detail::AsyncLoader::queueUpload([weakState, promise, decoded, id, path]()
+                {
+                    auto state = weakState.lock();
+                    if (!state)
+                    {
+                        promise->set_value(false);
+                        return;
+                    }
+
+                    auto buffer = createBuffer(*decoded);
+                    const bool success = buffer != nullptr;
+
+                    auto requests = std::move(state->inFlight[path]);
+                    state->inFlight.erase(path);
+                    requests.emplace_back(id, promise);
+
+                    for (auto& [requestID, requestPromise] : requests)
+                    {
+                        state->pending.erase(requestID);
+                        if (success)
+                        {
+                            state->loaded.insert(std::make_pair(requestID, std::make_pair(path, buffer)));
+                        }
+                        requestPromise->set_value(success);
+                    }
+                });
+        });
+
+    return result;
+}
+
+std::size_t AudioResource::preload(const std::vector<std::string>& paths)
+{
+    flushAsync();
+
+    std::vector<std::pair<std::string, std::future<DecodedAudio>>> jobs;
+    for (const auto& path : paths)
+    {
+        if (m_usedPaths.count(path) != 0
+            || std::find_if(jobs.begin(), jobs.end(), [&path](const auto& j) {return j.first == path; }) != jobs.end())
+        {
+            continue;
+        }
+
+        auto promise = std::make_shared<std::promise<DecodedAudio>>();
+        jobs.emplace_back(path, promise->get_future());
+
+        Detail::AsyncLoader::queueJob([promise, path]()
+            {
+                promise->set_value(decode(path));
+            });
+    }
+
+    std::size_t count = 0;
+    for (auto& [path, job] : jobs)
+    {
+        auto decoded = job.get();
+        if (auto buffer = createBuffer(decoded); buffer)
+        {
+            CRO_ASSERT(autoID > 0, "Something is very wrong if you've used this many IDs.");
+            m_sources.insert(std::make_pair(autoID, std::move(buffer)));
+            m_usedPaths.insert(std::make_pair(path, autoID));
+            autoID--;
+            count++;
+        }
+        else
+        {
+            LogE << "Failed preloading " << path << std::endl;
+        }
+    }
+
+    return count;
+}
+
 const AudioSource& AudioResource::get(std::int32_t id) const
 {
-    if (m_sources.count(id) == 0) return *m_fallback;
+    if (m_sources.count(id) == 0)
+    {
+        //may have been loaded asynchronously since load() was last called
+        if (auto result = m_asyncState->loaded.find(id); result != m_asyncState->loaded.end())
+        {
+            return *result->second.second;
+        }
+        return *m_fallback;
+    }
     return *m_sources.find(id)->second;
-}
\ No newline at end of file
+}
+
+//private
+void AudioResource::flushAsync()
+{
+    for (auto& [id, source] : m_asyncState->loaded)
+    {
+        m_usedPaths.insert(std::make_pair(source.first, id));
+        m_sources.insert(std::make_pair(id, std::move(source.second)));
+    }
+    m_asyncState->loaded.clear();
+}
@@ -48,6 +48,23 @@ bool AudioScape::loadFromFile(const std::string& path, AudioResource& audioResou
         m_configs.clear();
 
         const auto& objs = cfg.getObjects();
+
+        //decode all the buffered sounds in parallel up front
+        //so that load() below only has to look them up
+        std::vector<std::string> bufferPaths;
+        for (const auto& obj : objs)
+        {
+            const auto* pathProp = obj.findProperty("path");
+            const auto* streamProp = obj.findProperty("streaming");
+            if (pathProp && streamProp
+                && !streamProp->getValue<bool>()
+                && FileSystem::fileExists(FileSystem::getResourcePath() + pathProp->getValue<std::string>()))
+            {
+                bufferPaths.push_back(pathProp->getValue<std::string>());
+            }
+        }
+        audioResource.preload(bufferPaths);
+
         for (const auto& obj : objs)
         {
             if (obj.getId().empty())
@@ -52,6 +52,7 @@ namespace cro
             std::int32_t requestNewBuffer(const std::string&) override { return -1; }
             std::int32_t requestNewBuffer(const Detail::PCMData&) override { return -1; }
             void deleteBuffer(std::int32_t) override {}
+            cro::Time getBufferDuration(std::int32_t) const override { return {}; }
 
             std::int32_t requestNewStream(const std::string&) override { return -1; }
             void deleteStream(std::int32_t) override {}
@@ -72,6 +73,7 @@ namespace cro
             void setSourceVolume(std::int32_t, float) override {}
             void setSourceRolloff(std::int32_t, float) override {}
             void setSourceVelocity(std::int32_t, glm::vec3) override {}
+            void updateSources(const std::vector<AudioSourceUpdate>&) override {}
             void setDopplerFactor(float) override {}
             void setSpeedOfSound(float) override {}
         };
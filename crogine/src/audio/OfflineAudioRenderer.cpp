@@ -0,0 +1,182 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/audio/OfflineAudioRenderer.hpp>
+#include <crogine/core/Log.hpp>
+
+#include "AudioRenderer.hpp"
+#include "SoftwareMixerImpl.hpp"
+#include "NullImpl.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace cro;
+
+namespace
+{
+    //owned by the AudioRenderer while active
+    Detail::SoftwareMixerImpl* mixer = nullptr;
+    bool restoreRenderer = false;
+
+    constexpr float NanoToSeconds = 1.f / 1000000000.f;
+}
+
+bool OfflineAudioRenderer::begin(const std::string& outputPath)
+{
+    if (mixer)
+    {
+        LogW << "Offline audio rendering already started" << std::endl;
+        return true;
+    }
+
+    restoreRenderer = AudioRenderer::isValid();
+
+    auto impl = std::make_unique<Detail::SoftwareMixerImpl>(Detail::SoftwareMixerImpl::Output::Offline, outputPath);
+    auto* ptr = impl.get();
+    if (!AudioRenderer::init(std::move(impl)))
+    {
+        LogE << "Failed to start offline audio rendering" << std::endl;
+        return false;
+    }
+
+    mixer = ptr;
+    return true;
+}
+
+OfflineAudioRenderer::Statistics OfflineAudioRenderer::render(Time duration, std::vector<Event> script, const std::function<void(float)>& update)
+{
+    Statistics stats;
+    if (!mixer)
+    {
+        LogE << "Offline audio rendering not started, call OfflineAudioRenderer::begin() first" << std::endl;
+        return stats;
+    }
+
+    std::stable_sort(script.begin(), script.end(),
+        [](const Event& a, const Event& b)
+        {
+            return a.time < b.time;
+        });
+
+    auto& counters = mixer->getStatistics();
+    counters.reset();
+
+    const auto sampleRate = mixer->getSampleRate();
+    const auto totalFrames = static_cast<std::uint64_t>(std::max(0, duration.asMilliseconds())) * sampleRate / 1000;
+    const auto blockTime = static_cast<float>(Detail::SoftwareMixerImpl::BlockFrames) / static_cast<float>(sampleRate);
+
+    std::uint64_t frameCount = 0;
+    std::size_t nextEvent = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    while (frameCount < totalFrames)
+    {
+        const auto now = seconds(static_cast<float>(frameCount) / static_cast<float>(sampleRate));
+        while (nextEvent < script.size()
+            && script[nextEvent].time <= now)
+        {
+            if (script[nextEvent].action)
+            {
+                script[nextEvent].action();
+            }
+            nextEvent++;
+        }
+
+        if (update)
+        {
+            update(blockTime);
+        }
+
+        frameCount += mixer->renderBlock();
+    }
+    const auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    stats.renderedSeconds = static_cast<float>(frameCount) / static_cast<float>(sampleRate);
+    stats.elapsedSeconds = elapsed;
+    stats.realtimeFactor = elapsed > 0 ? stats.renderedSeconds / elapsed : 0.f;
+
+    stats.decodedFrames = counters.decodedFrames;
+    stats.decodeSeconds = static_cast<float>(counters.decodeTime) * NanoToSeconds;
+    stats.decodeThroughput = stats.decodeSeconds > 0 ? static_cast<float>(stats.decodedFrames) / stats.decodeSeconds : 0.f;
+
+    stats.mixedVoiceFrames = counters.mixedVoiceFrames;
+    stats.mixSeconds = static_cast<float>(counters.mixTime) * NanoToSeconds;
+    if (stats.mixedVoiceFrames)
+    {
+        const auto voiceSeconds = static_cast<float>(stats.mixedVoiceFrames) / static_cast<float>(sampleRate);
+        stats.voiceCost = (stats.mixSeconds / voiceSeconds) * 1000000.f;
+    }
+
+    stats.streamRefills = counters.streamRefills;
+    if (stats.streamRefills)
+    {
+        stats.averageRefillMs = (static_cast<float>(counters.refillTime) / static_cast<float>(stats.streamRefills)) / 1000000.f;
+    }
+    stats.maxRefillMs = static_cast<float>(counters.maxRefillTime) / 1000000.f;
+    stats.streamUnderruns = counters.streamUnderruns;
+
+    return stats;
+}
+
+void OfflineAudioRenderer::end()
+{
+    if (!mixer)
+    {
+        return;
+    }
+
+    //replacing the renderer shuts down the mixer, which completes
+    //the output file. AudioRenderer::shutdown() isn't used here as it
+    //would also stop any SoundStreams still using the stream scheduler
+    mixer = nullptr;
+
+    if (restoreRenderer)
+    {
+        AudioRenderer::init();
+    }
+    else
+    {
+        AudioRenderer::init(std::make_unique<Detail::NullImpl>());
+    }
+}
+
+bool OfflineAudioRenderer::isActive()
+{
+    return mixer != nullptr;
+}
+
+void OfflineAudioRenderer::logStatistics(const Statistics& stats)
+{
+    LogI << "Rendered " << stats.renderedSeconds << "s of audio in " << stats.elapsedSeconds << "s (" << stats.realtimeFactor << "x real time)" << std::endl;
+    LogI << "Decoded " << stats.decodedFrames << " frames in " << stats.decodeSeconds << "s (" << stats.decodeThroughput << " frames per second)" << std::endl;
+    LogI << "Mixing: " << stats.mixSeconds << "s, " << stats.voiceCost << "us per voice per second of audio" << std::endl;
+    LogI << "Streams: " << stats.streamRefills << " refills, average " << stats.averageRefillMs << "ms, max " << stats.maxRefillMs << "ms, " << stats.streamUnderruns << " underruns" << std::endl;
+}
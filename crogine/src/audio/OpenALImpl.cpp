@@ -43,7 +43,9 @@ source distribution.
 #pragma clang diagnostic ignored "-Wdeprecated-declarations"
 #endif
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 using namespace cro;
 using namespace cro::Detail;
@@ -52,6 +54,11 @@ namespace
 {
     constexpr std::size_t STREAM_CHUNK_SIZE = 32768;// 48000u * sizeof(std::uint16_t) * 30; //30 sec of stereo @ highest quality (mono)
 
+    //how often a stream which isn't playing is checked. Streams
+    //are woken immediately when played so this can be fairly long
+    constexpr StreamScheduler::Duration StreamIdleInterval(100);
+    constexpr StreamScheduler::Duration StreamMinInterval(5);
+
     ALenum getFormatFromData(const PCMData& data)
     {
         switch (data.format)
@@ -67,11 +74,36 @@ namespace
             return AL_FORMAT_STEREO16;
         }
     }
+
+    //the play time of the given data
+    StreamScheduler::Duration getDuration(const PCMData& data)
+    {
+        std::uint32_t bytesPerSecond = data.frequency;
+        switch (data.format)
+        {
+        default: break;
+        case PCMData::Format::MONO16:
+        case PCMData::Format::STEREO8:
+            bytesPerSecond *= 2;
+            break;
+        case PCMData::Format::STEREO16:
+            bytesPerSecond *= 4;
+            break;
+        }
+
+        if (bytesPerSecond == 0)
+        {
+            return StreamMinInterval;
+        }
+        return StreamScheduler::Duration((static_cast<std::uint64_t>(data.size) * 1000) / bytesPerSecond);
+    }
 }
 
 OpenALImpl::OpenALImpl()
     : m_device          (nullptr),
     m_context           (nullptr),
+    m_deferUpdates      (nullptr),
+    m_processUpdates    (nullptr),
     m_nextFreeStream    (0)
 {
     for (auto i = 0u; i < m_streamIDs.size(); ++i)
@@ -101,6 +133,13 @@ bool OpenALImpl::init()
     bool current = false;
     /*alcCheck*/(current = alcMakeContextCurrent(m_context));
 
+    if (current
+        && alIsExtensionPresent("AL_SOFT_deferred_updates"))
+    {
+        m_deferUpdates = reinterpret_cast<UpdatesFunc>(alGetProcAddress("alDeferUpdatesSOFT"));
+        m_processUpdates = reinterpret_cast<UpdatesFunc>(alGetProcAddress("alProcessUpdatesSOFT"));
+    }
+
     return current;
 }
 
@@ -211,6 +250,27 @@ void OpenALImpl::deleteBuffer(std::int32_t buffer)
     }
 }
 
+cro::Time OpenALImpl::getBufferDuration(std::int32_t buffer) const
+{
+    ALint size = 0;
+    ALint channels = 0;
+    ALint bits = 0;
+    ALint frequency = 0;
+
+    auto buf = static_cast<ALuint>(buffer);
+    alCheck(alGetBufferi(buf, AL_SIZE, &size));
+    alCheck(alGetBufferi(buf, AL_CHANNELS, &channels));
+    alCheck(alGetBufferi(buf, AL_BITS, &bits));
+    alCheck(alGetBufferi(buf, AL_FREQUENCY, &frequency));
+
+    const auto bytesPerSecond = channels * (bits / 8) * frequency;
+    if (bytesPerSecond == 0)
+    {
+        return {};
+    }
+    return cro::seconds(static_cast<float>(size) / static_cast<float>(bytesPerSecond));
+}
+
 std::int32_t OpenALImpl::requestNewStream(const std::string& path)
 {
     //check we have available streams
@@ -220,12 +280,12 @@ std::int32_t OpenALImpl::requestNewStream(const std::string& path)
         return -1;
     }
 
-    //we shouldn't have to lock here as the stream's thread has not yet been created
+    //we shouldn't have to lock here as the stream has not yet been scheduled
     auto streamID = m_streamIDs[m_nextFreeStream];
 
     //attempt to open the file
     auto& stream = m_streams[streamID];
-    CRO_ASSERT(!stream.thread, "this shouldn't be running yet!");
+    CRO_ASSERT(stream.job == StreamScheduler::InvalidHandle, "this shouldn't be running yet!");
 
     auto ext = FileSystem::getFileExtension(path);
     if (ext == ".wav")
@@ -265,8 +325,9 @@ std::int32_t OpenALImpl::requestNewStream(const std::string& path)
             alCheck(alBufferData(b, getFormatFromData(audioData), audioData.data, audioData.size, audioData.frequency));
         }
 
-        stream.running = true;
-        stream.thread = std::make_unique<std::thread>(&OpenALStream::updateStream, &stream);
+        stream.prefetchData.size = 0;
+        stream.state = AL_STOPPED;
+        stream.job = StreamScheduler::add([&stream]() { return stream.update(); }, StreamIdleInterval);
 
         //hurrah we has stream
         m_nextFreeStream++;
@@ -283,15 +344,10 @@ void OpenALImpl::deleteStream(std::int32_t id)
     {
         alCheck(alSourceStop(stream.sourceID));
     }
-    stream.running = false;
 
-    if (stream.thread)
-    {
-        //we can't just detach as we need to reset the
-        //thread pointer.
-        stream.thread->join();
-        stream.thread.reset();
-    }
+    //blocks if the stream is currently being serviced
+    StreamScheduler::remove(stream.job);
+    stream.job = StreamScheduler::InvalidHandle;
 
     if (stream.buffers[0])
     {
@@ -337,12 +393,9 @@ std::int32_t OpenALImpl::requestAudioSource(std::int32_t buffer, bool streaming)
         {
             //sync with the stream thread...
             auto& stream = m_streams[buffer];
-            while (stream.busy) {}
-
-            stream.accessed = true;
+            std::scoped_lock lock(stream.mutex);
             stream.sourceID = source;
             alCheck(alSourceQueueBuffers(source, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-            stream.accessed = false;
         }
         return source;
     }
@@ -373,12 +426,9 @@ void OpenALImpl::updateAudioSource(std::int32_t sourceID, std::int32_t bufferID,
     {
         auto& stream = m_streams[bufferID];
 
-        while (stream.busy) {}
-
-        stream.accessed = true;
+        std::scoped_lock lock(stream.mutex);
         stream.sourceID = sourceID;
         alCheck(alSourceQueueBuffers(sourceID, static_cast<ALsizei>(stream.buffers.size()), stream.buffers.data()));
-        stream.accessed = false;
     }
 }
 
@@ -402,15 +452,9 @@ void OpenALImpl::deleteAudioSource(std::int32_t source)
 
     //if this is associated with a stream, delete the stream
     //and return it to the pool
-    auto result = std::find_if(std::begin(m_streams), std::end(m_streams),
-        [source](const OpenALStream& str)
-    {
-        return str.sourceID == source;
-    });
-
-    if (result != m_streams.end())
+    if (auto* stream = findStream(source); stream != nullptr)
     {
-        std::int32_t idx = static_cast<std::int32_t>(std::distance(std::begin(m_streams), result));
+        std::int32_t idx = static_cast<std::int32_t>(std::distance(m_streams.data(), stream));
         deleteStream(idx);
     }
 
@@ -427,25 +471,26 @@ void OpenALImpl::playSource(std::int32_t source, bool looped)
 
     ALuint src = static_cast<ALuint>(source);
 
-    auto result = std::find_if(std::begin(m_streams), std::end(m_streams),
-        [src](const OpenALStream& str)
-    {
-        return str.sourceID == src;
-    });
-
-    if (result == m_streams.end())
+    auto* stream = findStream(source);
+    if (stream == nullptr)
     {
         alCheck(alSourcei(src, AL_LOOPING, looped ? AL_TRUE : AL_FALSE));
+        alCheck(alSourcePlay(src));
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
-        result->looped = looped;
-        result->accessed = false;
+        {
+            std::scoped_lock lock(stream->mutex);
+            if (stream->looped != looped)
+            {
+                //prefetched data may have been read with the wrong loop setting
+                stream->looped = looped;
+                stream->prefetchData.size = 0;
+            }
+            alCheck(alSourcePlay(src));
+        }
+        StreamScheduler::wake(stream->job);
     }
-    alCheck(alSourcePlay(src));
 }
 
 void OpenALImpl::pauseSource(std::int32_t source)
@@ -459,6 +504,12 @@ void OpenALImpl::stopSource(std::int32_t source)
 {
     ALuint src = static_cast<ALuint>(source);
     alCheck(alSourceStop(src));
+
+    //let the stream rewind itself as soon as possible
+    if (auto* stream = findStream(source); stream != nullptr)
+    {
+        StreamScheduler::wake(stream->job);
+    }
 }
 
 void OpenALImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
@@ -470,23 +521,19 @@ void OpenALImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
 
     ALuint src = static_cast<ALuint>(source);
 
-    auto result = std::find_if(std::begin(m_streams), std::end(m_streams),
-        [src](const OpenALStream& str)
-        {
-            return str.sourceID == src;
-        });
-
-    if (result == m_streams.end())
+    auto* stream = findStream(source);
+    if (stream == nullptr)
     {
         alCheck(alSourcef(src, AL_SEC_OFFSET, offset.asSeconds()));
     }
     else
     {
-        while (result->busy) {}
-
-        result->accessed = true;
-        result->audioFile->seek(offset);
-        result->accessed = false;
+        {
+            std::scoped_lock lock(stream->mutex);
+            stream->audioFile->seek(offset);
+            stream->prefetchData.size = 0;
+        }
+        StreamScheduler::wake(stream->job);
     }
 }
 
@@ -535,6 +582,51 @@ void OpenALImpl::setSourceVelocity(std::int32_t src, glm::vec3 velocity)
     alCheck(alSource3f(src, AL_VELOCITY, velocity.x, velocity.y, velocity.z));
 }
 
+void OpenALImpl::updateSources(const std::vector<AudioSourceUpdate>& updates)
+{
+    //hold changes until the whole batch is set so that
+    //they're all heard on the same mix update
+    const bool deferred = m_deferUpdates && m_processUpdates;
+    if (deferred)
+    {
+        m_deferUpdates();
+    }
+
+    for (const auto& update : updates)
+    {
+        const auto src = update.source;
+        if (update.flags & AudioSourceUpdate::Position)
+        {
+            alCheck(alSource3f(src, AL_POSITION, update.position.x, update.position.y, update.position.z));
+        }
+
+        if (update.flags & AudioSourceUpdate::Velocity)
+        {
+            alCheck(alSource3f(src, AL_VELOCITY, update.velocity.x, update.velocity.y, update.velocity.z));
+        }
+
+        if (update.flags & AudioSourceUpdate::Pitch)
+        {
+            alCheck(alSourcef(src, AL_PITCH, update.pitch));
+        }
+
+        if (update.flags & AudioSourceUpdate::Volume)
+        {
+            alCheck(alSourcef(src, AL_GAIN, update.volume));
+        }
+
+        if (update.flags & AudioSourceUpdate::Rolloff)
+        {
+            alCheck(alSourcef(src, AL_ROLLOFF_FACTOR, update.rolloff));
+        }
+    }
+
+    if (deferred)
+    {
+        m_processUpdates();
+    }
+}
+
 void OpenALImpl::setDopplerFactor(float factor)
 {
     alCheck(alDopplerFactor(factor));
@@ -545,75 +637,113 @@ void OpenALImpl::setSpeedOfSound(float speed)
     alCheck(alSpeedOfSound(speed));
 }
 
-//stream thread function
-void OpenALStream::updateStream()
+//private
+OpenALStream* OpenALImpl::findStream(std::int32_t sourceID)
 {
-    //this is called by a stream's thread
-    while (running)
+    auto result = std::find_if(std::begin(m_streams), std::end(m_streams),
+        [sourceID](const OpenALStream& str)
+        {
+            return str.sourceID == sourceID;
+        });
+
+    return result == m_streams.end() ? nullptr : &(*result);
+}
+
+//stream functions
+void OpenALStream::prefetch()
+{
+    const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
+
+    prefetchBuffer.resize(data.size);
+    if (data.size > 0)
     {
-        //wait for the main thread to finish what it's
-        //doing to the stream
-        while (accessed) {}
+        std::memcpy(prefetchBuffer.data(), data.data, data.size);
+    }
 
-        //check if we need update
-        busy = true;
+    prefetchData = data;
+    prefetchData.data = prefetchBuffer.data();
+}
 
-        if (sourceID > -1)
-        {
-            std::int32_t processed = 0;
-            alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+StreamScheduler::Duration OpenALStream::update()
+{
+    //this is called by the streaming thread
+    std::scoped_lock lock(mutex);
 
-            //if stopped rewind file and load buffers
-            ALenum newState;
-            alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
-            if (newState != state && newState == AL_STOPPED)
-            {
-                audioFile->seek(cro::Time());
-                processed = static_cast<ALint>(buffers.size());
-            }
+    if (sourceID < 0)
+    {
+        return StreamIdleInterval;
+    }
 
-            //update the buffers if necessary
-            if (processed > 0
-                && state == AL_PLAYING)
+    std::int32_t processed = 0;
+    alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+
+    //if stopped rewind file and load buffers
+    ALenum newState;
+    alCheck(alGetSourcei(sourceID, AL_SOURCE_STATE, &newState));
+    if (newState != state && newState == AL_STOPPED)
+    {
+        audioFile->seek(cro::Time());
+        prefetchData.size = 0;
+        processed = static_cast<ALint>(buffers.size());
+    }
+
+    //update the buffers if necessary
+    if (processed > 0
+        && state == AL_PLAYING)
+    {
+        for (auto i = 0; i < processed; ++i)
+        {
+            if (prefetchData.size == 0)
             {
-                for (auto i = 0; i < processed; ++i)
-                {
-                    //fill buffer
-                    const auto& data = audioFile->getData(STREAM_CHUNK_SIZE, looped);
-                    if (data.size > 0) //only update if we have data else we'll loop even if we don't want to
-                    {
-                        //unqueue
-                        alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
-
-                        //refill
-                        alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(data), data.data, data.size, data.frequency));
-
-                        //requeue
-                        alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
-
-                        //increment currentBuffer
-                        currentBuffer = (currentBuffer + 1) % buffers.size();
-                    }
-                }
-
-                busy = false;
-                processed = 0;
+                prefetch();
             }
-            else
+
+            if (prefetchData.size > 0) //only update if we have data else we'll loop even if we don't want to
             {
-                //sleep for a bit
-                //it's important to sleep *after* the busy flag is set to
-                //false as this is the time the main thread might set the 'accessed' flag
-                busy = false;
-                std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
+                //unqueue
+                alCheck(alSourceUnqueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+
+                //refill
+                alCheck(alBufferData(buffers[currentBuffer], getFormatFromData(prefetchData), prefetchData.data, prefetchData.size, prefetchData.frequency));
+
+                //requeue
+                alCheck(alSourceQueueBuffers(sourceID, 1, &buffers[currentBuffer]));
+
+                //increment currentBuffer
+                currentBuffer = (currentBuffer + 1) % buffers.size();
+                prefetchData.size = 0;
             }
-            state = newState;
-        }
-        else
-        {
-            //sleep for a bit
-            busy = false;
-            std::this_thread::sleep_for(std::chrono::duration<int, std::milli>(50));
         }
     }
-}
\ No newline at end of file
+    state = newState;
+
+    if (state != AL_PLAYING)
+    {
+        return StreamIdleInterval;
+    }
+
+    //decode the next chunk now while there's plenty of time
+    if (prefetchData.size == 0)
+    {
+        prefetch();
+    }
+
+    //the underrun deadline is when the queued buffers run out. Aim
+    //to be serviced when the first of them has been played, and well
+    //before the deadline if the queue is running low
+    ALint queued = 0;
+    alCheck(alGetSourcei(sourceID, AL_BUFFERS_QUEUED, &queued));
+    alCheck(alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed));
+
+    if (prefetchData.size == 0)
+    {
+        //reached the end of the file, so there's nothing to do
+        //other than notice when the source stops
+        return StreamIdleInterval;
+    }
+
+    const auto chunkDuration = getDuration(prefetchData);
+    const auto deadline = chunkDuration * std::max(0, queued - processed);
+
+    return std::max(StreamMinInterval, std::min(chunkDuration, deadline / 2));
+}
@@ -31,6 +31,7 @@ source distribution.
 
 #include "AudioRenderer.hpp"
 #include "AudioFile.hpp"
+#include "StreamScheduler.hpp"
 
 #ifdef __APPLE__
 #include <al.h>
@@ -40,10 +41,10 @@ source distribution.
 #include <AL/alc.h>
 #endif
 
-#include <atomic>
 #include <array>
-#include <thread>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace cro
 {
@@ -55,17 +56,19 @@ namespace cro
 
             std::array<ALuint, 4u> buffers{};
             std::size_t currentBuffer = 0;
-            //ALint processed = 0;
 
-            std::atomic<bool> busy{ false }; //signifies the thread is processing
-            std::atomic<bool> running{ false }; //signifies the thread is running
-            std::atomic<bool> accessed{ false }; //signifies the main thread is modifying the stream
-            
-            std::unique_ptr<std::thread> thread;
-            void updateStream(); //runs in own thread
+            //the next chunk is decoded ahead of need so that
+            //refilling a buffer is only an upload
+            std::vector<std::uint8_t> prefetchBuffer;
+            PCMData prefetchData;
+            void prefetch();
+
+            std::mutex mutex; //guards the stream between the main and streaming thread
+            StreamScheduler::Handle job = StreamScheduler::InvalidHandle;
+            StreamScheduler::Duration update(); //called by the streaming thread
 
             std::int32_t sourceID = -1;
-            std::atomic<bool> looped{ false };
+            bool looped = false;
             ALenum state = AL_STOPPED;
         };
 
@@ -87,6 +90,7 @@ namespace cro
             std::int32_t requestNewBuffer(const std::string& path) override;
             std::int32_t requestNewBuffer(const PCMData&) override;
             void deleteBuffer(std::int32_t) override;
+            cro::Time getBufferDuration(std::int32_t) const override;
 
             std::int32_t requestNewStream(const std::string&) override;
             void deleteStream(std::int32_t) override;
@@ -107,6 +111,7 @@ namespace cro
             void setSourceVolume(std::int32_t, float) override;
             void setSourceRolloff(std::int32_t, float) override;
             void setSourceVelocity(std::int32_t, glm::vec3) override;
+            void updateSources(const std::vector<AudioSourceUpdate>&) override;
             void setDopplerFactor(float) override;
             void setSpeedOfSound(float) override;
 
@@ -114,10 +119,18 @@ namespace cro
             ALCdevice* m_device;
             ALCcontext* m_context;
 
+            //AL_SOFT_deferred_updates, if available, lets
+            //batches of source updates be applied at once
+            using UpdatesFunc = void(AL_APIENTRY*)(void);
+            UpdatesFunc m_deferUpdates;
+            UpdatesFunc m_processUpdates;
+
             static constexpr std::size_t MaxStreams = 128;
             std::array<OpenALStream, MaxStreams> m_streams = {};
             std::array<std::int32_t, MaxStreams> m_streamIDs = {};
             std::size_t m_nextFreeStream;
+
+            OpenALStream* findStream(std::int32_t sourceID);
         };
     }
 }
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace cro::Detail
+{
+    /*
+    Lock-free, fixed capacity queue for passing data from exactly
+    one producer thread to exactly one consumer thread. push*()
+    may only be called by the producer and pop*()/clear() only by
+    the consumer. Capacity must be a power of two.
+    */
+    template <typename T, std::size_t Capacity>
+    class SPSCQueue final
+    {
+        static_assert(Capacity > 1 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        //returns false if the queue is full
+        bool push(T&& item)
+        {
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            if (tail - m_head.load(std::memory_order_acquire) == Capacity)
+            {
+                return false;
+            }
+
+            m_data[tail & Mask] = std::move(item);
+            m_tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        //returns false if the queue is empty
+        bool pop(T& dst)
+        {
+            const auto head = m_head.load(std::memory_order_relaxed);
+            if (head == m_tail.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+
+            dst = std::move(m_data[head & Mask]);
+            m_data[head & Mask] = T();
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        //pushes as many items as there is space for, and returns the count
+        std::size_t pushRange(const T* src, std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+            const auto tail = m_tail.load(std::memory_order_relaxed);
+            count = std::min(count, Capacity - (tail - m_head.load(std::memory_order_acquire)));
+
+            const auto start = tail & Mask;
+            const auto first = std::min(count, Capacity - start);
+            std::memcpy(&m_data[start], src, first * sizeof(T));
+            std::memcpy(&m_data[0], src + first, (count - first) * sizeof(T));
+
+            m_tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        //pops up to count items, and returns the number popped
+        std::size_t popRange(T* dst, std::size_t count)
+        {
+            static_assert(std::is_trivially_copyable_v<T>);
+
+            const auto head = m_head.load(std::memory_order_relaxed);
+            count = std::min(count, m_tail.load(std::memory_order_acquire) - head);
+
+            const auto start = head & Mask;
+            const auto first = std::min(count, Capacity - start);
+            std::memcpy(dst, &m_data[start], first * sizeof(T));
+            std::memcpy(dst + first, &m_data[0], (count - first) * sizeof(T));
+
+            m_head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        //discards everything currently in the queue
+        void clear()
+        {
+            m_head.store(m_tail.load(std::memory_order_acquire), std::memory_order_release);
+        }
+
+        //approximate when called from a thread other than the
+        //producer or consumer, as the queue may be modified
+        std::size_t size() const
+        {
+            return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+        }
+
+        std::size_t capacity() const { return Capacity; }
+
+    private:
+        static constexpr std::size_t Mask = Capacity - 1;
+
+        //head and tail only ever increase, and are masked on access
+        alignas(64) std::atomic<std::size_t> m_head = 0;
+        alignas(64) std::atomic<std::size_t> m_tail = 0;
+        alignas(64) std::array<T, Capacity> m_data = {};
+    };
+}
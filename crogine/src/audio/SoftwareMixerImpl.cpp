@@ -0,0 +1,1302 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "SoftwareMixerImpl.hpp"
+#include "WavLoader.hpp"
+#include "VorbisLoader.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+#include <crogine/detail/glm/geometric.hpp>
+#include <crogine/util/Constants.hpp>
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_MIXER_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_MIXER_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr std::uint32_t OutputSampleRate = 48000;
+    constexpr std::size_t StreamChunkBytes = 8192;
+
+    //limits how far a voice can advance through its source per output frame
+    constexpr double MaxStep = 4.0;
+
+    constexpr std::int32_t StatePlaying = 0;
+    constexpr std::int32_t StatePaused = 1;
+    constexpr std::int32_t StateStopped = 2;
+
+    std::uint32_t getChannelCount(PCMData::Format format)
+    {
+        return (format == PCMData::Format::STEREO8 || format == PCMData::Format::STEREO16) ? 2 : 1;
+    }
+
+    void convert16(const std::int16_t* src, float* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+#if defined(CRO_MIXER_SSE2)
+        const __m128 scale = _mm_set1_ps(1.f / 32768.f);
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+
+            //unpacking against itself then shifting sign extends to 32 bit
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+#elif defined(CRO_MIXER_NEON)
+        const float32x4_t scale = vdupq_n_f32(1.f / 32768.f);
+        for (; i + 8 <= count; i += 8)
+        {
+            const int16x8_t v = vld1q_s16(src + i);
+            vst1q_f32(dst + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), scale));
+            vst1q_f32(dst + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), scale));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            dst[i] = static_cast<float>(src[i]) / 32768.f;
+        }
+    }
+
+    //converts interleaved PCM data to floats in the range -1 to 1
+    void convertSamples(const PCMData& data, std::vector<float>& dst)
+    {
+        if (data.format == PCMData::Format::MONO8
+            || data.format == PCMData::Format::STEREO8)
+        {
+            //8 bit PCM is unsigned
+            const auto* src = static_cast<const std::uint8_t*>(data.data);
+            dst.resize(data.size);
+            for (auto i = 0u; i < data.size; ++i)
+            {
+                dst[i] = (static_cast<float>(src[i]) - 128.f) / 128.f;
+            }
+        }
+        else
+        {
+            const auto count = data.size / sizeof(std::int16_t);
+            dst.resize(count);
+
+            //the data isn't guaranteed to be aligned
+            std::vector<std::int16_t> temp(count);
+            std::memcpy(temp.data(), data.data, count * sizeof(std::int16_t));
+            convert16(temp.data(), dst.data(), count);
+        }
+    }
+
+    //adds interleaved stereo src to dst, ramping the gain linearly across the block
+    void accumulate(float* dst, const float* src, std::uint32_t frameCount, float startLeft, float startRight, float endLeft, float endRight)
+    {
+        const float stepLeft = (endLeft - startLeft) / static_cast<float>(frameCount);
+        const float stepRight = (endRight - startRight) / static_cast<float>(frameCount);
+
+        std::uint32_t i = 0;
+#if defined(CRO_MIXER_SSE2)
+        //two frames at a time
+        __m128 gain = _mm_setr_ps(startLeft, startRight, startLeft + stepLeft, startRight + stepRight);
+        const __m128 step = _mm_setr_ps(stepLeft * 2.f, stepRight * 2.f, stepLeft * 2.f, stepRight * 2.f);
+        for (; i + 2 <= frameCount; i += 2)
+        {
+            const __m128 d = _mm_loadu_ps(dst + i * 2);
+            const __m128 s = _mm_loadu_ps(src + i * 2);
+            _mm_storeu_ps(dst + i * 2, _mm_add_ps(d, _mm_mul_ps(s, gain)));
+            gain = _mm_add_ps(gain, step);
+        }
+#elif defined(CRO_MIXER_NEON)
+        const float g[] = { startLeft, startRight, startLeft + stepLeft, startRight + stepRight };
+        const float st[] = { stepLeft * 2.f, stepRight * 2.f, stepLeft * 2.f, stepRight * 2.f };
+        float32x4_t gain = vld1q_f32(g);
+        const float32x4_t step = vld1q_f32(st);
+        for (; i + 2 <= frameCount; i += 2)
+        {
+            vst1q_f32(dst + i * 2, vmlaq_f32(vld1q_f32(dst + i * 2), vld1q_f32(src + i * 2), gain));
+            gain = vaddq_f32(gain, step);
+        }
+#endif
+        for (; i < frameCount; ++i)
+        {
+            dst[i * 2] += src[i * 2] * (startLeft + stepLeft * static_cast<float>(i));
+            dst[i * 2 + 1] += src[i * 2 + 1] * (startRight + stepRight * static_cast<float>(i));
+        }
+    }
+
+    void clampSamples(float* samples, std::size_t count)
+    {
+        std::size_t i = 0;
+#if defined(CRO_MIXER_SSE2)
+        const __m128 lo = _mm_set1_ps(-1.f);
+        const __m128 hi = _mm_set1_ps(1.f);
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(samples + i, _mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + i), lo), hi));
+        }
+#elif defined(CRO_MIXER_NEON)
+        const float32x4_t lo = vdupq_n_f32(-1.f);
+        const float32x4_t hi = vdupq_n_f32(1.f);
+        for (; i + 4 <= count; i += 4)
+        {
+            vst1q_f32(samples + i, vminq_f32(vmaxq_f32(vld1q_f32(samples + i), lo), hi));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            samples[i] = std::clamp(samples[i], -1.f, 1.f);
+        }
+    }
+
+    //linearly interpolates source frames into interleaved stereo. Returns the number
+    //of frames written, which is less than frameCount if the source ran out
+    std::uint32_t resample(const float* src, std::size_t srcFrames, std::uint32_t channelCount,
+        double& position, double step, bool loop, float* dst, std::uint32_t frameCount)
+    {
+        if (srcFrames == 0)
+        {
+            return 0;
+        }
+
+        //when the rates match there's nothing to interpolate
+        if (step == 1.0 && position == std::floor(position))
+        {
+            std::uint32_t written = 0;
+            while (written < frameCount)
+            {
+                auto idx = static_cast<std::size_t>(position);
+                if (idx >= srcFrames)
+                {
+                    if (!loop)
+                    {
+                        break;
+                    }
+                    idx %= srcFrames;
+                    position = static_cast<double>(idx);
+                }
+
+                const auto count = static_cast<std::uint32_t>(std::min(static_cast<std::size_t>(frameCount - written), srcFrames - idx));
+                if (channelCount == 1)
+                {
+                    for (auto i = 0u; i < count; ++i)
+                    {
+                        dst[(written + i) * 2] = dst[(written + i) * 2 + 1] = src[idx + i];
+                    }
+                }
+                else
+                {
+                    std::memcpy(dst + written * 2, src + idx * 2, count * 2 * sizeof(float));
+                }
+                written += count;
+                position += count;
+            }
+            return written;
+        }
+
+        for (auto i = 0u; i < frameCount; ++i)
+        {
+            auto idx = static_cast<std::size_t>(position);
+            if (idx >= srcFrames)
+            {
+                if (!loop)
+                {
+                    return i;
+                }
+                position = std::fmod(position, static_cast<double>(srcFrames));
+                idx = static_cast<std::size_t>(position);
+            }
+
+            auto next = idx + 1;
+            if (next == srcFrames)
+            {
+                next = loop ? 0 : idx;
+            }
+
+            const auto t = static_cast<float>(position - static_cast<double>(idx));
+            if (channelCount == 1)
+            {
+                dst[i * 2] = dst[i * 2 + 1] = src[idx] + (src[next] - src[idx]) * t;
+            }
+            else
+            {
+                dst[i * 2] = src[idx * 2] + (src[next * 2] - src[idx * 2]) * t;
+                dst[i * 2 + 1] = src[idx * 2 + 1] + (src[next * 2 + 1] - src[idx * 2 + 1]) * t;
+            }
+            position += step;
+        }
+        return frameCount;
+    }
+
+    std::unique_ptr<AudioFile> openAudioFile(const std::string& path)
+    {
+        std::unique_ptr<AudioFile> file;
+
+        auto ext = FileSystem::getFileExtension(path);
+        if (ext == ".wav")
+        {
+            file = std::make_unique<WavLoader>();
+        }
+        else if (ext == ".ogg")
+        {
+            file = std::make_unique<VorbisLoader>();
+        }
+        else
+        {
+            LogE << ext << ": format not supported" << std::endl;
+            return file;
+        }
+
+        if (!file->open(path))
+        {
+            LogE << "Failed to open " << path << std::endl;
+            file.reset();
+        }
+        return file;
+    }
+
+    template <typename T>
+    void writeValue(std::FILE* file, T value)
+    {
+        std::fwrite(&value, sizeof(T), 1, file);
+    }
+
+    std::uint64_t nanosecondsSince(std::chrono::steady_clock::time_point start)
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+SoftwareMixerImpl::SoftwareMixerImpl(Output output, const std::string& outputPath)
+    : m_output          (output),
+    m_outputPath        (outputPath),
+    m_sampleRate        (OutputSampleRate),
+    m_device            (0),
+    m_running           (false),
+    m_file              (nullptr),
+    m_fileDataSize      (0),
+    m_listenerPosition  (0.f),
+    m_nextBufferID      (1),
+    m_nextStreamID      (0)
+{
+    for (auto& state : m_sourceStates)
+    {
+        state = StateStopped;
+    }
+}
+
+SoftwareMixerImpl::~SoftwareMixerImpl()
+{
+    shutdown();
+}
+
+//public
+bool SoftwareMixerImpl::init()
+{
+    m_outputBuffer.resize(BlockFrames * 2);
+    m_voiceBuffer.resize(BlockFrames * 2);
+
+    switch (m_output)
+    {
+    default: break;
+    case Output::Device:
+    {
+        SDL_AudioSpec want;
+        SDL_zero(want);
+        want.freq = OutputSampleRate;
+        want.format = AUDIO_F32SYS;
+        want.channels = 2;
+        want.samples = BlockFrames;
+        want.callback = &SoftwareMixerImpl::deviceCallback;
+        want.userdata = this;
+
+        SDL_AudioSpec have;
+        m_device = SDL_OpenAudioDevice(nullptr, 0, &want, &have, SDL_AUDIO_ALLOW_FREQUENCY_CHANGE);
+        if (m_device == 0)
+        {
+            LogE << "Failed opening audio device: " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        m_sampleRate = have.freq;
+        SDL_PauseAudioDevice(m_device, 0);
+    }
+        break;
+    case Output::File:
+    case Output::Null:
+        openFile();
+        m_running = true;
+        m_outputThread = std::make_unique<std::thread>(&SoftwareMixerImpl::outputThreadFunc, this);
+        break;
+    case Output::Offline:
+        openFile();
+        break;
+    }
+
+    return true;
+}
+
+void SoftwareMixerImpl::shutdown()
+{
+    if (m_device)
+    {
+        SDL_CloseAudioDevice(m_device);
+        m_device = 0;
+    }
+
+    m_running = false;
+    if (m_outputThread)
+    {
+        m_outputThread->join();
+        m_outputThread.reset();
+    }
+    closeFile();
+
+    for (auto& [id, stream] : m_streams)
+    {
+        StreamScheduler::remove(stream->job);
+    }
+    m_streams.clear();
+    m_buffers.clear();
+
+    //nothing is mixing any more so we can safely reset these from here
+    for (auto& voice : m_voices)
+    {
+        voice = Voice();
+    }
+    Command cmd;
+    while (m_commands.pop(cmd)) {}
+}
+
+void SoftwareMixerImpl::setListenerPosition(glm::vec3 position)
+{
+    m_listenerPosition = position;
+
+    Command cmd;
+    cmd.type = Command::ListenerPosition;
+    cmd.a = position;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::setListenerOrientation(glm::vec3 forward, glm::vec3 up)
+{
+    Command cmd;
+    cmd.type = Command::ListenerOrientation;
+    cmd.a = forward;
+    cmd.b = up;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::setListenerVolume(float volume)
+{
+    Command cmd;
+    cmd.type = Command::ListenerVolume;
+    cmd.value = volume;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::setListenerVelocity(glm::vec3)
+{
+    //doppler isn't simulated
+}
+
+glm::vec3 SoftwareMixerImpl::getListenerPosition() const
+{
+    return m_listenerPosition;
+}
+
+std::int32_t SoftwareMixerImpl::requestNewBuffer(const std::string& filePath)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    auto file = openAudioFile(FileSystem::getResourcePath() + filePath);
+    if (file)
+    {
+        const auto& data = file->getData();
+        if (data.data)
+        {
+            const auto id = requestNewBuffer(data);
+            if (id > -1)
+            {
+                m_statistics.decodedFrames += m_buffers.at(id)->frameCount;
+                m_statistics.decodeTime += nanosecondsSince(start);
+            }
+            return id;
+        }
+    }
+    return -1;
+}
+
+std::int32_t SoftwareMixerImpl::requestNewBuffer(const PCMData& data)
+{
+    if (data.data == nullptr
+        || data.size == 0)
+    {
+        return -1;
+    }
+
+    auto buffer = std::make_shared<Buffer>();
+    buffer->channelCount = getChannelCount(data.format);
+    buffer->sampleRate = data.frequency;
+    convertSamples(data, buffer->samples);
+    buffer->frameCount = buffer->samples.size() / buffer->channelCount;
+
+    const auto id = m_nextBufferID++;
+    m_buffers.insert(std::make_pair(id, std::move(buffer)));
+
+    return id;
+}
+
+void SoftwareMixerImpl::deleteBuffer(std::int32_t buffer)
+{
+    //any voices still using the buffer keep it alive until they're detached
+    m_buffers.erase(buffer);
+}
+
+cro::Time SoftwareMixerImpl::getBufferDuration(std::int32_t buffer) const
+{
+    if (auto result = m_buffers.find(buffer); result != m_buffers.end())
+    {
+        return cro::seconds(static_cast<float>(result->second->frameCount) / static_cast<float>(result->second->sampleRate));
+    }
+    return {};
+}
+
+std::int32_t SoftwareMixerImpl::requestNewStream(const std::string& path)
+{
+    auto stream = std::make_shared<Stream>();
+    stream->audioFile = openAudioFile(path);
+    if (!stream->audioFile)
+    {
+        return -1;
+    }
+
+    //read the first chunk now to find the format
+    const auto& data = stream->audioFile->getData(StreamChunkBytes);
+    if (data.size == 0)
+    {
+        LogE << path << ": no audio data found" << std::endl;
+        return -1;
+    }
+
+    stream->channelCount = getChannelCount(data.format);
+    stream->sampleRate = data.frequency;
+    convertSamples(data, stream->decodeBuffer);
+    stream->samples.pushRange(stream->decodeBuffer.data(), stream->decodeBuffer.size());
+
+    stream->statistics = &m_statistics;
+
+    //offline streams are decoded as they're mixed, so
+    //that they can keep up when rendering faster than real time
+    if (m_output != Output::Offline)
+    {
+        auto* s = stream.get();
+        stream->job = StreamScheduler::add([s]() { return s->decode(); });
+    }
+
+    const auto id = m_nextStreamID++;
+    m_streams.insert(std::make_pair(id, std::move(stream)));
+
+    return id;
+}
+
+void SoftwareMixerImpl::deleteStream(std::int32_t id)
+{
+    if (auto result = m_streams.find(id); result != m_streams.end())
+    {
+        //once removed the stream is no longer decoded, but any
+        //voice still using it keeps it alive until it's detached
+        StreamScheduler::remove(result->second->job);
+        m_streams.erase(result);
+    }
+}
+
+std::int32_t SoftwareMixerImpl::requestAudioSource(std::int32_t dataID, bool streaming)
+{
+    auto result = std::find_if(m_sources.begin(), m_sources.end(), [](const SourceSlot& s) {return !s.allocated; });
+    if (result == m_sources.end())
+    {
+        LogW << "Maximum number of audio sources has been reached!" << std::endl;
+        return -1;
+    }
+
+    result->allocated = true;
+    const auto source = static_cast<std::int32_t>(std::distance(m_sources.begin(), result)) + 1;
+    updateAudioSource(source, dataID, streaming);
+
+    return source;
+}
+
+void SoftwareMixerImpl::updateAudioSource(std::int32_t source, std::int32_t dataID, bool streaming)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0)
+    {
+        return;
+    }
+
+    Command cmd;
+    cmd.source = slot;
+    cmd.type = Command::Detach;
+
+    if (streaming)
+    {
+        if (auto result = m_streams.find(dataID); result != m_streams.end())
+        {
+            cmd.type = Command::AttachStream;
+            cmd.stream = result->second;
+        }
+    }
+    else
+    {
+        if (auto result = m_buffers.find(dataID); result != m_buffers.end())
+        {
+            cmd.type = Command::AttachBuffer;
+            cmd.buffer = result->second;
+        }
+    }
+
+    if (cmd.type == Command::Detach)
+    {
+        LogW << dataID << ": audio data not found" << std::endl;
+    }
+
+    m_sources[slot].streaming = streaming;
+    m_sources[slot].dataID = dataID;
+    m_sourceStates[slot] = StateStopped;
+    m_pendingCommands[slot]++;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::deleteAudioSource(std::int32_t source)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0)
+    {
+        return;
+    }
+
+    m_sources[slot] = SourceSlot();
+    m_sourceStates[slot] = StateStopped;
+
+    Command cmd;
+    cmd.type = Command::Detach;
+    cmd.source = slot;
+    m_pendingCommands[slot]++;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::playSource(std::int32_t source, bool looped)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0)
+    {
+        return;
+    }
+
+    if (m_sources[slot].streaming)
+    {
+        if (auto result = m_streams.find(m_sources[slot].dataID); result != m_streams.end())
+        {
+            //streams loop as they're decoded
+            result->second->looped = looped;
+
+            //resuming continues, else start from the beginning
+            if (m_sourceStates[slot] != StatePaused)
+            {
+                result->second->seek(0);
+            }
+        }
+    }
+
+    m_sourceStates[slot] = StatePlaying;
+
+    Command cmd;
+    cmd.type = Command::Play;
+    cmd.source = slot;
+    cmd.flag = looped;
+    m_pendingCommands[slot]++;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::pauseSource(std::int32_t source)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0)
+    {
+        return;
+    }
+
+    if (m_sourceStates[slot] == StatePlaying)
+    {
+        m_sourceStates[slot] = StatePaused;
+    }
+
+    Command cmd;
+    cmd.type = Command::Pause;
+    cmd.source = slot;
+    m_pendingCommands[slot]++;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::stopSource(std::int32_t source)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0)
+    {
+        return;
+    }
+
+    m_sourceStates[slot] = StateStopped;
+
+    Command cmd;
+    cmd.type = Command::Stop;
+    cmd.source = slot;
+    m_pendingCommands[slot]++;
+    pushCommand(std::move(cmd));
+}
+
+void SoftwareMixerImpl::setPlayingOffset(std::int32_t source, cro::Time offset)
+{
+    const auto slot = getSlot(source);
+    if (slot < 0
+        || m_sourceStates[slot] == StateStopped)
+    {
+        return;
+    }
+
+    if (m_sources[slot].streaming)
+    {
+        if (auto result = m_streams.find(m_sources[slot].dataID); result != m_streams.end())
+        {
+            result->second->seek(offset.asMilliseconds());
+        }
+    }
+    else
+    {
+        Command cmd;
+        cmd.type = Command::SetOffset;
+        cmd.source = slot;
+        cmd.value = offset.asSeconds();
+        pushCommand(std::move(cmd));
+    }
+}
+
+std::int32_t SoftwareMixerImpl::getSourceState(std::int32_t source) const
+{
+    const auto slot = getSlot(source);
+    return slot < 0 ? StateStopped : m_sourceStates[slot].load();
+}
+
+void SoftwareMixerImpl::setSourcePosition(std::int32_t source, glm::vec3 position)
+{
+    if (const auto slot = getSlot(source); slot > -1)
+    {
+        Command cmd;
+        cmd.type = Command::SourcePosition;
+        cmd.source = slot;
+        cmd.a = position;
+        pushCommand(std::move(cmd));
+    }
+}
+
+void SoftwareMixerImpl::setSourcePitch(std::int32_t source, float pitch)
+{
+    if (const auto slot = getSlot(source); slot > -1)
+    {
+        Command cmd;
+        cmd.type = Command::SourcePitch;
+        cmd.source = slot;
+        cmd.value = pitch;
+        pushCommand(std::move(cmd));
+    }
+}
+
+void SoftwareMixerImpl::setSourceVolume(std::int32_t source, float volume)
+{
+    if (const auto slot = getSlot(source); slot > -1)
+    {
+        Command cmd;
+        cmd.type = Command::SourceVolume;
+        cmd.source = slot;
+        cmd.value = volume;
+        pushCommand(std::move(cmd));
+    }
+}
+
+void SoftwareMixerImpl::setSourceRolloff(std::int32_t source, float rolloff)
+{
+    if (const auto slot = getSlot(source); slot > -1)
+    {
+        Command cmd;
+        cmd.type = Command::SourceRolloff;
+        cmd.source = slot;
+        cmd.value = rolloff;
+        pushCommand(std::move(cmd));
+    }
+}
+
+void SoftwareMixerImpl::setSourceVelocity(std::int32_t, glm::vec3)
+{
+    //doppler isn't simulated
+}
+
+void SoftwareMixerImpl::updateSources(const std::vector<AudioSourceUpdate>& updates)
+{
+    //one command per source carries all of its changes
+    for (const auto& update : updates)
+    {
+        if (const auto slot = getSlot(update.source); slot > -1)
+        {
+            Command cmd;
+            cmd.type = Command::SourceUpdate;
+            cmd.source = slot;
+            cmd.a = update.position;
+            cmd.b = { update.pitch, update.volume, update.rolloff };
+            cmd.updateFlags = update.flags;
+            pushCommand(std::move(cmd));
+        }
+    }
+}
+
+void SoftwareMixerImpl::setDopplerFactor(float)
+{
+
+}
+
+void SoftwareMixerImpl::setSpeedOfSound(float)
+{
+
+}
+
+std::uint32_t SoftwareMixerImpl::renderBlock()
+{
+    CRO_ASSERT(m_output == Output::Offline, "Only valid for offline output");
+
+    //streams are decoded inline so they keep up when rendering faster than
+    //real time. This happens outside of render() so that the decode time
+    //is counted by the streams and not included in the mix time
+    processCommands();
+    for (auto& [id, stream] : m_streams)
+    {
+        stream->decode();
+    }
+
+    render(m_outputBuffer.data(), BlockFrames);
+    writeBlock(m_outputBuffer.data(), BlockFrames);
+    return BlockFrames;
+}
+
+void SoftwareMixerImpl::render(float* output, std::uint32_t frameCount)
+{
+    const auto start = std::chrono::steady_clock::now();
+    m_statistics.mixedFrames += frameCount;
+
+    processCommands();
+
+    while (frameCount)
+    {
+        const auto blockSize = std::min(frameCount, BlockFrames);
+        std::fill(output, output + (blockSize * 2), 0.f);
+
+        for (auto i = 0u; i < m_voices.size(); ++i)
+        {
+            auto& voice = m_voices[i];
+            if (voice.playing && !voice.paused)
+            {
+                mixVoice(voice, output, blockSize);
+                m_statistics.mixedVoiceFrames += blockSize;
+
+                //ran out of data - only report it if there's
+                //not a newer command which changes the state
+                if (!voice.playing
+                    && m_pendingCommands[i] == 0)
+                {
+                    m_sourceStates[i] = StateStopped;
+                }
+            }
+        }
+        clampSamples(output, blockSize * 2);
+
+        output += blockSize * 2;
+        frameCount -= blockSize;
+    }
+
+    m_statistics.mixTime += nanosecondsSince(start);
+}
+
+void SoftwareMixerImpl::Statistics::reset()
+{
+    decodedFrames = 0;
+    decodeTime = 0;
+    mixedFrames = 0;
+    mixedVoiceFrames = 0;
+    mixTime = 0;
+    streamRefills = 0;
+    refillTime = 0;
+    maxRefillTime = 0;
+    streamUnderruns = 0;
+}
+
+//private
+void SoftwareMixerImpl::Stream::seek(std::int32_t milliseconds)
+{
+    seekTarget = milliseconds;
+    seekPending = true;
+    StreamScheduler::wake(job);
+}
+
+StreamScheduler::Duration SoftwareMixerImpl::Stream::decode()
+{
+    //this is called by the streaming thread
+    if (seekPending)
+    {
+        audioFile->seek(cro::milliseconds(seekTarget));
+        ended = false;
+
+        //the mixer discards what's already queued, and we wait for it
+        //so new data isn't discarded with the old
+        flushPending = true;
+        seekPending = false;
+    }
+
+    if (flushPending)
+    {
+        return StreamScheduler::Duration(2);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t decodedSamples = 0;
+
+    //room for a chunk of 8 bit data is room for any format
+    while (!ended
+        && samples.capacity() - samples.size() >= StreamChunkBytes)
+    {
+        const auto& data = audioFile->getData(StreamChunkBytes, looped);
+        if (data.size == 0)
+        {
+            ended = true;
+            break;
+        }
+
+        convertSamples(data, decodeBuffer);
+        samples.pushRange(decodeBuffer.data(), decodeBuffer.size());
+        decodedSamples += decodeBuffer.size();
+    }
+
+    if (decodedSamples
+        && statistics)
+    {
+        const auto refillTime = nanosecondsSince(start);
+        statistics->streamRefills++;
+        statistics->refillTime += refillTime;
+        statistics->decodedFrames += decodedSamples / channelCount;
+        statistics->decodeTime += refillTime;
+
+        auto maxTime = statistics->maxRefillTime.load();
+        while (refillTime > maxTime
+            && !statistics->maxRefillTime.compare_exchange_weak(maxTime, refillTime)) {}
+    }
+
+    if (ended)
+    {
+        //nothing to do until we're seeked
+        return StreamScheduler::Duration(100);
+    }
+
+    //aim to top up the queue when half has been played
+    const auto buffered = static_cast<std::int64_t>(samples.size() / channelCount);
+    const auto remaining = StreamScheduler::Duration((buffered * 1000) / sampleRate);
+    return std::clamp(remaining / 2, StreamScheduler::Duration(5), StreamScheduler::Duration(100));
+}
+
+void SoftwareMixerImpl::pushCommand(Command&& cmd)
+{
+    while (!m_commands.push(std::move(cmd)))
+    {
+        if (m_output == Output::Offline)
+        {
+            //we're also the consumer so make some room
+            processCommands();
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void SoftwareMixerImpl::processCommands()
+{
+    Command cmd;
+    while (m_commands.pop(cmd))
+    {
+        auto& voice = m_voices[cmd.source];
+
+        switch (cmd.type)
+        {
+        default: break;
+        case Command::ListenerPosition:
+            m_listener.position = cmd.a;
+            break;
+        case Command::ListenerOrientation:
+            if (auto right = glm::cross(cmd.a, cmd.b); glm::dot(right, right) != 0.f)
+            {
+                m_listener.right = glm::normalize(right);
+            }
+            break;
+        case Command::ListenerVolume:
+            m_listener.volume = cmd.value;
+            break;
+        case Command::AttachBuffer:
+        case Command::AttachStream:
+        case Command::Detach:
+        {
+            //preserve the properties set by the source owner
+            const auto pitch = voice.pitch;
+            const auto volume = voice.volume;
+            const auto rolloff = voice.rolloff;
+            const auto position = voice.worldPosition;
+
+            voice = Voice();
+            voice.buffer = std::move(cmd.buffer);
+            voice.stream = std::move(cmd.stream);
+            if (cmd.type != Command::Detach)
+            {
+                voice.pitch = pitch;
+                voice.volume = volume;
+                voice.rolloff = rolloff;
+                voice.worldPosition = position;
+            }
+
+            if (voice.stream)
+            {
+                voice.window.resize((static_cast<std::size_t>(BlockFrames * MaxStep) + 4) * voice.stream->channelCount);
+            }
+            m_pendingCommands[cmd.source]--;
+        }
+            break;
+        case Command::Play:
+            if (!voice.paused)
+            {
+                voice.position = 0.0;
+                voice.windowFrames = 0;
+            }
+            voice.playing = voice.buffer || voice.stream;
+            voice.paused = false;
+            voice.looped = cmd.flag;
+            m_pendingCommands[cmd.source]--;
+            break;
+        case Command::Pause:
+            voice.paused = voice.playing;
+            m_pendingCommands[cmd.source]--;
+            break;
+        case Command::Stop:
+            voice.playing = false;
+            voice.paused = false;
+            voice.position = 0.0;
+            voice.windowFrames = 0;
+            m_pendingCommands[cmd.source]--;
+            break;
+        case Command::SetOffset:
+            if (voice.buffer)
+            {
+                voice.position = std::min(static_cast<double>(cmd.value) * voice.buffer->sampleRate, static_cast<double>(voice.buffer->frameCount));
+            }
+            break;
+        case Command::SourcePosition:
+            voice.worldPosition = cmd.a;
+            break;
+        case Command::SourcePitch:
+            voice.pitch = cmd.value;
+            break;
+        case Command::SourceVolume:
+            voice.volume = cmd.value;
+            break;
+        case Command::SourceRolloff:
+            voice.rolloff = cmd.value;
+            break;
+        case Command::SourceUpdate:
+            if (cmd.updateFlags & AudioSourceUpdate::Position)
+            {
+                voice.worldPosition = cmd.a;
+            }
+            if (cmd.updateFlags & AudioSourceUpdate::Pitch)
+            {
+                voice.pitch = cmd.b.x;
+            }
+            if (cmd.updateFlags & AudioSourceUpdate::Volume)
+            {
+                voice.volume = cmd.b.y;
+            }
+            if (cmd.updateFlags & AudioSourceUpdate::Rolloff)
+            {
+                voice.rolloff = cmd.b.z;
+            }
+            break;
+        }
+
+        //make sure any released data isn't held on to by the queue
+        cmd = Command();
+    }
+}
+
+void SoftwareMixerImpl::mixVoice(Voice& voice, float* output, std::uint32_t frameCount)
+{
+    const float* src = nullptr;
+    std::size_t srcFrames = 0;
+    std::uint32_t channelCount = 1;
+    std::uint32_t sampleRate = m_sampleRate;
+
+    if (voice.buffer)
+    {
+        src = voice.buffer->samples.data();
+        srcFrames = voice.buffer->frameCount;
+        channelCount = voice.buffer->channelCount;
+        sampleRate = voice.buffer->sampleRate;
+    }
+    else
+    {
+        auto& stream = *voice.stream;
+        channelCount = stream.channelCount;
+        sampleRate = stream.sampleRate;
+
+        if (stream.flushPending)
+        {
+            stream.samples.clear();
+            voice.windowFrames = 0;
+            voice.position = 0.0;
+            stream.flushPending = false;
+        }
+        src = voice.window.data();
+    }
+
+    const auto step = std::clamp((static_cast<double>(sampleRate) / m_sampleRate) * voice.pitch, 0.0, MaxStep);
+
+    if (voice.stream
+        && !voice.stream->seekPending) //else wait for the seek rather than play old data
+    {
+        //pull enough frames from the stream to cover this block
+        const auto required = std::min(static_cast<std::size_t>(voice.position + (frameCount * step)) + 2, voice.window.size() / channelCount);
+        if (required > voice.windowFrames)
+        {
+            const auto count = voice.stream->samples.popRange(voice.window.data() + (voice.windowFrames * channelCount), (required - voice.windowFrames) * channelCount);
+            voice.windowFrames += count / channelCount;
+        }
+        srcFrames = voice.windowFrames;
+    }
+
+    const auto written = resample(src, srcFrames, channelCount, voice.position, step, voice.looped && voice.buffer, m_voiceBuffer.data(), frameCount);
+    if (written < frameCount)
+    {
+        std::fill(m_voiceBuffer.begin() + (written * 2), m_voiceBuffer.begin() + (frameCount * 2), 0.f);
+    }
+
+    if (voice.stream)
+    {
+        //discard frames we've played, keeping the one we're interpolating from
+        const auto consumed = std::min(static_cast<std::size_t>(voice.position), voice.windowFrames);
+        if (consumed)
+        {
+            std::memmove(voice.window.data(), voice.window.data() + (consumed * channelCount), (voice.windowFrames - consumed) * channelCount * sizeof(float));
+            voice.windowFrames -= consumed;
+            voice.position -= static_cast<double>(consumed);
+        }
+
+        //else it's an underrun and we'll try to catch up next block
+        if (written < frameCount
+            && voice.stream->ended
+            && !voice.stream->seekPending
+            && !voice.stream->flushPending
+            && voice.stream->samples.size() == 0)
+        {
+            voice.playing = false;
+        }
+        else if (written < frameCount
+            && !voice.stream->seekPending
+            && !voice.stream->flushPending)
+        {
+            m_statistics.streamUnderruns++;
+        }
+    }
+    else if (written < frameCount)
+    {
+        voice.playing = false;
+        voice.position = 0.0;
+    }
+
+
+    //calculate the gain
+    const float gain = voice.volume * m_listener.volume;
+    float left = gain;
+    float right = gain;
+
+    if (channelCount == 1)
+    {
+        //inverse distance clamped, with a reference distance of 1
+        const auto direction = voice.worldPosition - m_listener.position;
+        const auto distance = glm::length(direction);
+        const auto attenuation = 1.f / (1.f + (voice.rolloff * (std::max(distance, 1.f) - 1.f)));
+
+        //equal power pan
+        const auto pan = distance > 0.001f ? std::clamp(glm::dot(direction / distance, m_listener.right), -1.f, 1.f) : 0.f;
+        const auto angle = (pan + 1.f) * (Util::Const::PI / 4.f);
+
+        left *= attenuation * std::cos(angle);
+        right *= attenuation * std::sin(angle);
+    }
+
+    if (voice.gainLeft < 0)
+    {
+        voice.gainLeft = left;
+        voice.gainRight = right;
+    }
+
+    accumulate(output, m_voiceBuffer.data(), frameCount, voice.gainLeft, voice.gainRight, left, right);
+    voice.gainLeft = left;
+    voice.gainRight = right;
+
+    if (!voice.playing)
+    {
+        voice.gainLeft = voice.gainRight = -1.f;
+    }
+}
+
+void SoftwareMixerImpl::outputThreadFunc()
+{
+    //paces the mix to real time, as a device would
+    const auto blockDuration = std::chrono::microseconds((static_cast<std::int64_t>(BlockFrames) * 1000000) / m_sampleRate);
+    auto nextBlock = std::chrono::steady_clock::now();
+
+    while (m_running)
+    {
+        render(m_outputBuffer.data(), BlockFrames);
+        writeBlock(m_outputBuffer.data(), BlockFrames);
+
+        nextBlock += blockDuration;
+        std::this_thread::sleep_until(nextBlock);
+    }
+}
+
+void SoftwareMixerImpl::writeBlock(const float* samples, std::uint32_t frameCount)
+{
+    if (!m_file)
+    {
+        return;
+    }
+
+    m_fileBuffer.resize(frameCount * 2);
+    for (auto i = 0u; i < m_fileBuffer.size(); ++i)
+    {
+        m_fileBuffer[i] = static_cast<std::int16_t>(samples[i] * 32767.f);
+    }
+
+    const auto size = static_cast<std::uint32_t>(m_fileBuffer.size() * sizeof(std::int16_t));
+    std::fwrite(m_fileBuffer.data(), size, 1, m_file);
+    m_fileDataSize += size;
+}
+
+void SoftwareMixerImpl::openFile()
+{
+    if (m_output == Output::Null
+        || m_outputPath.empty())
+    {
+        return;
+    }
+
+    m_file = std::fopen(m_outputPath.c_str(), "wb");
+    if (!m_file)
+    {
+        LogE << "Failed opening " << m_outputPath << " for audio output" << std::endl;
+        return;
+    }
+
+    //sizes are filled in when the file is closed
+    m_fileDataSize = 0;
+    std::fwrite("RIFF", 4, 1, m_file);
+    writeValue<std::uint32_t>(m_file, 0);
+    std::fwrite("WAVE", 4, 1, m_file);
+
+    std::fwrite("fmt ", 4, 1, m_file);
+    writeValue<std::uint32_t>(m_file, 16);
+    writeValue<std::uint16_t>(m_file, 1); //PCM
+    writeValue<std::uint16_t>(m_file, 2);
+    writeValue<std::uint32_t>(m_file, m_sampleRate);
+    writeValue<std::uint32_t>(m_file, m_sampleRate * 2 * sizeof(std::int16_t));
+    writeValue<std::uint16_t>(m_file, 2 * sizeof(std::int16_t));
+    writeValue<std::uint16_t>(m_file, 16);
+
+    std::fwrite("data", 4, 1, m_file);
+    writeValue<std::uint32_t>(m_file, 0);
+}
+
+void SoftwareMixerImpl::closeFile()
+{
+    if (m_file)
+    {
+        std::fseek(m_file, 4, SEEK_SET);
+        writeValue<std::uint32_t>(m_file, 36 + m_fileDataSize);
+        std::fseek(m_file, 40, SEEK_SET);
+        writeValue<std::uint32_t>(m_file, m_fileDataSize);
+
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+std::int32_t SoftwareMixerImpl::getSlot(std::int32_t source) const
+{
+    if (source < 1
+        || source > static_cast<std::int32_t>(MaxSources)
+        || !m_sources[source - 1].allocated)
+    {
+        return -1;
+    }
+    return source - 1;
+}
+
+void SoftwareMixerImpl::deviceCallback(void* userData, std::uint8_t* stream, std::int32_t length)
+{
+    auto* mixer = static_cast<SoftwareMixerImpl*>(userData);
+    mixer->render(reinterpret_cast<float*>(stream), static_cast<std::uint32_t>(length / (sizeof(float) * 2)));
+}
@@ -0,0 +1,287 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include "AudioRenderer.hpp"
+#include "AudioFile.hpp"
+#include "SPSCQueue.hpp"
+#include "StreamScheduler.hpp"
+
+#include <crogine/detail/glm/vec3.hpp>
+
+#include <SDL_audio.h>
+
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace cro::Detail
+{
+    /*
+    Audio renderer which mixes all sources in-process. The calling
+    thread only sends commands over a lock-free queue, and the mix
+    is performed in blocks on the output thread - either the SDL
+    audio callback or, for File and Null output, a thread of our own.
+    With Offline output there is no thread at all and blocks are
+    mixed by calling renderBlock(), as fast as the CPU allows.
+
+    Mono sources are attenuated with the inverse distance clamped
+    model, and panned between the left and right channels based on
+    their position relative to the listener. Stereo sources are not
+    spatialised. Doppler effects are not simulated.
+    */
+    class SoftwareMixerImpl final : public cro::AudioRendererImpl
+    {
+    public:
+        enum class Output
+        {
+            Device, //plays through the default audio device
+            File, //writes a 16 bit stereo wav file, in real time
+            Null, //mixes in real time but discards the output
+            Offline //mixes only when renderBlock() is called and writes to file if a path is given
+        };
+
+        explicit SoftwareMixerImpl(Output output = Output::Device, const std::string& outputPath = {});
+        ~SoftwareMixerImpl();
+
+        bool init() override;
+        void shutdown() override;
+
+        void setListenerPosition(glm::vec3) override;
+        void setListenerOrientation(glm::vec3, glm::vec3) override;
+        void setListenerVolume(float) override;
+        void setListenerVelocity(glm::vec3) override;
+
+        glm::vec3 getListenerPosition() const override;
+
+        std::int32_t requestNewBuffer(const std::string& path) override;
+        std::int32_t requestNewBuffer(const PCMData&) override;
+        void deleteBuffer(std::int32_t) override;
+        cro::Time getBufferDuration(std::int32_t) const override;
+
+        std::int32_t requestNewStream(const std::string&) override;
+        void deleteStream(std::int32_t) override;
+
+        std::int32_t requestAudioSource(std::int32_t, bool) override;
+        void updateAudioSource(std::int32_t, std::int32_t, bool) override;
+        void deleteAudioSource(std::int32_t) override;
+
+        void playSource(std::int32_t, bool) override;
+        void pauseSource(std::int32_t) override;
+        void stopSource(std::int32_t) override;
+
+        void setPlayingOffset(std::int32_t, cro::Time) override;
+        std::int32_t getSourceState(std::int32_t src) const override;
+
+        void setSourcePosition(std::int32_t, glm::vec3) override;
+        void setSourcePitch(std::int32_t, float) override;
+        void setSourceVolume(std::int32_t, float) override;
+        void setSourceRolloff(std::int32_t, float) override;
+        void setSourceVelocity(std::int32_t, glm::vec3) override;
+        void updateSources(const std::vector<AudioSourceUpdate>&) override;
+        void setDopplerFactor(float) override;
+        void setSpeedOfSound(float) override;
+
+        //mixes one block and sends it to the output. Only valid with Offline output.
+        //Returns the number of frames mixed.
+        std::uint32_t renderBlock();
+
+        //mixes frameCount stereo frames into the given buffer, which must
+        //have room for frameCount * 2 samples. Called by the output thread.
+        void render(float* output, std::uint32_t frameCount);
+
+        std::uint32_t getSampleRate() const { return m_sampleRate; }
+
+        //performance counters, read by the OfflineAudioRenderer. Times are in
+        //nanoseconds. Updated by the mixing and streaming threads.
+        struct Statistics final
+        {
+            std::atomic<std::uint64_t> decodedFrames = 0;
+            std::atomic<std::uint64_t> decodeTime = 0;
+
+            std::atomic<std::uint64_t> mixedFrames = 0;
+            std::atomic<std::uint64_t> mixedVoiceFrames = 0; //frames multiplied by the number of voices
+            std::atomic<std::uint64_t> mixTime = 0;
+
+            std::atomic<std::uint64_t> streamRefills = 0;
+            std::atomic<std::uint64_t> refillTime = 0;
+            std::atomic<std::uint64_t> maxRefillTime = 0;
+            std::atomic<std::uint64_t> streamUnderruns = 0;
+
+            void reset();
+        };
+        Statistics& getStatistics() { return m_statistics; }
+
+        static constexpr std::size_t MaxSources = 256;
+        static constexpr std::uint32_t BlockFrames = 512;
+
+    private:
+        struct Buffer final
+        {
+            std::vector<float> samples;
+            std::uint32_t channelCount = 1;
+            std::uint32_t sampleRate = 44100;
+            std::size_t frameCount = 0;
+        };
+
+        //decoded by the StreamScheduler, ahead of the mixer
+        struct Stream final
+        {
+            std::unique_ptr<AudioFile> audioFile;
+            std::uint32_t channelCount = 1;
+            std::uint32_t sampleRate = 44100;
+            StreamScheduler::Handle job = StreamScheduler::InvalidHandle;
+
+            SPSCQueue<float, 65536> samples;
+            std::vector<float> decodeBuffer;
+
+            std::atomic_bool looped = false;
+            std::atomic_bool ended = false;
+            std::atomic<std::int32_t> seekTarget = 0; //milliseconds
+            std::atomic_bool seekPending = false; //set by the main thread
+            std::atomic_bool flushPending = false; //set by the decoder once seeked, cleared by the mixer
+
+            Statistics* statistics = nullptr;
+
+            void seek(std::int32_t milliseconds);
+            StreamScheduler::Duration decode();
+        };
+
+        struct Command final
+        {
+            enum Type : std::uint8_t
+            {
+                ListenerPosition, ListenerOrientation, ListenerVolume,
+                AttachBuffer, AttachStream, Detach,
+                Play, Pause, Stop, SetOffset,
+                SourcePosition, SourcePitch, SourceVolume, SourceRolloff,
+                SourceUpdate //a = position, b = {pitch, volume, rolloff}, flags from AudioSourceUpdate
+            }type = ListenerPosition;
+
+            std::uint32_t source = 0;
+            glm::vec3 a = glm::vec3(0.f);
+            glm::vec3 b = glm::vec3(0.f);
+            float value = 0.f;
+            bool flag = false;
+            std::uint8_t updateFlags = 0;
+
+            std::shared_ptr<const Buffer> buffer;
+            std::shared_ptr<Stream> stream;
+        };
+
+        //owned by the mixing thread
+        struct Voice final
+        {
+            std::shared_ptr<const Buffer> buffer;
+            std::shared_ptr<Stream> stream;
+
+            double position = 0.0; //in source frames
+            bool playing = false;
+            bool paused = false;
+            bool looped = false;
+
+            float pitch = 1.f;
+            float volume = 1.f;
+            float rolloff = 1.f;
+            glm::vec3 worldPosition = glm::vec3(0.f);
+
+            //gains used last block, so changes can be ramped
+            float gainLeft = -1.f;
+            float gainRight = -1.f;
+
+            //frames pulled from a stream but not yet played
+            std::vector<float> window;
+            std::size_t windowFrames = 0;
+        };
+
+        //owned by the calling thread
+        struct SourceSlot final
+        {
+            bool allocated = false;
+            bool streaming = false;
+            std::int32_t dataID = -1;
+        };
+
+        Output m_output;
+        std::string m_outputPath;
+        std::uint32_t m_sampleRate;
+
+        SDL_AudioDeviceID m_device;
+        std::unique_ptr<std::thread> m_outputThread;
+        std::atomic_bool m_running;
+        std::FILE* m_file;
+        std::uint32_t m_fileDataSize;
+        std::vector<float> m_outputBuffer;
+        std::vector<std::int16_t> m_fileBuffer;
+
+        SPSCQueue<Command, 8192> m_commands;
+        Statistics m_statistics;
+
+        //calling thread state
+        glm::vec3 m_listenerPosition;
+        std::int32_t m_nextBufferID;
+        std::int32_t m_nextStreamID;
+        std::unordered_map<std::int32_t, std::shared_ptr<const Buffer>> m_buffers;
+        std::unordered_map<std::int32_t, std::shared_ptr<Stream>> m_streams;
+        std::array<SourceSlot, MaxSources> m_sources = {};
+
+        //shared - written by the mixer when a source stops by itself
+        std::array<std::atomic<std::int32_t>, MaxSources> m_sourceStates = {};
+        std::array<std::atomic<std::uint32_t>, MaxSources> m_pendingCommands = {};
+
+        //mixing thread state
+        struct Listener final
+        {
+            glm::vec3 position = glm::vec3(0.f);
+            glm::vec3 right = glm::vec3(1.f, 0.f, 0.f);
+            float volume = 1.f;
+        }m_listener;
+        std::array<Voice, MaxSources> m_voices = {};
+        std::vector<float> m_voiceBuffer;
+
+        void pushCommand(Command&&);
+        void processCommands();
+        void mixVoice(Voice&, float* output, std::uint32_t frameCount);
+        void outputThreadFunc();
+        void writeBlock(const float* samples, std::uint32_t frameCount);
+        void openFile();
+        void closeFile();
+
+        std::int32_t getSlot(std::int32_t source) const;
+
+        static void deviceCallback(void* userData, std::uint8_t* stream, std::int32_t length);
+    };
+}
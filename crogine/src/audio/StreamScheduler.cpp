@@ -0,0 +1,229 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "StreamScheduler.hpp"
+
+#include <crogine/detail/Assert.hpp>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct Job final
+    {
+        StreamScheduler::ServiceFunc func;
+        Clock::time_point deadline;
+        bool wakePending = false; //woken while being serviced
+    };
+
+    struct QueueEntry final
+    {
+        Clock::time_point deadline;
+        StreamScheduler::Handle handle = StreamScheduler::InvalidHandle;
+
+        bool operator > (const QueueEntry& other) const
+        {
+            return deadline > other.deadline;
+        }
+    };
+
+    struct SchedulerState final
+    {
+        std::unique_ptr<std::thread> thread;
+        bool running = false;
+
+        std::mutex mutex;
+        std::condition_variable serviceCondition; //wakes the streaming thread
+        std::condition_variable idleCondition; //signals a service function has returned
+
+        std::unordered_map<StreamScheduler::Handle, Job> jobs;
+
+        //entries are not removed when a job is rescheduled, rather they
+        //are skipped if the deadline no longer matches the job's
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+        StreamScheduler::Handle nextHandle = 1;
+        StreamScheduler::Handle activeHandle = StreamScheduler::InvalidHandle;
+    }state;
+
+    void threadFunc()
+    {
+        std::unique_lock lock(state.mutex);
+        while (state.running)
+        {
+            if (state.queue.empty())
+            {
+                state.serviceCondition.wait(lock);
+                continue;
+            }
+
+            const auto entry = state.queue.top();
+            auto result = state.jobs.find(entry.handle);
+            if (result == state.jobs.end()
+                || result->second.deadline != entry.deadline)
+            {
+                //stale entry
+                state.queue.pop();
+                continue;
+            }
+
+            if (Clock::now() < entry.deadline)
+            {
+                //woken early if a new job or earlier deadline is queued
+                state.serviceCondition.wait_until(lock, entry.deadline);
+                continue;
+            }
+            state.queue.pop();
+
+            //map nodes are stable, and remove() waits for us to finish,
+            //so it's safe to call this without holding the lock
+            auto* func = &result->second.func;
+            state.activeHandle = entry.handle;
+            lock.unlock();
+
+            const auto next = (*func)();
+
+            lock.lock();
+            state.activeHandle = StreamScheduler::InvalidHandle;
+
+            //iterators may have been invalidated by a rehash
+            result = state.jobs.find(entry.handle);
+            auto& job = result->second;
+            if (next < StreamScheduler::Duration(0))
+            {
+                state.jobs.erase(result);
+            }
+            else
+            {
+                job.deadline = job.wakePending ? Clock::now() : Clock::now() + next;
+                job.wakePending = false;
+                state.queue.push({ job.deadline, entry.handle });
+            }
+            state.idleCondition.notify_all();
+        }
+    }
+}
+
+StreamScheduler::Handle StreamScheduler::add(ServiceFunc func, Duration delay)
+{
+    CRO_ASSERT(func, "");
+
+    Handle handle = InvalidHandle;
+    {
+        std::scoped_lock lock(state.mutex);
+
+        //started on demand so there's no thread unless we're actually streaming
+        if (!state.thread)
+        {
+            state.running = true;
+            state.thread = std::make_unique<std::thread>(&threadFunc);
+        }
+
+        handle = state.nextHandle++;
+        if (state.nextHandle == InvalidHandle)
+        {
+            state.nextHandle++;
+        }
+
+        auto& job = state.jobs[handle];
+        job.func = std::move(func);
+        job.deadline = Clock::now() + delay;
+        state.queue.push({ job.deadline, handle });
+    }
+    state.serviceCondition.notify_one();
+
+    return handle;
+}
+
+void StreamScheduler::remove(Handle handle)
+{
+    if (handle == InvalidHandle)
+    {
+        return;
+    }
+
+    std::unique_lock lock(state.mutex);
+    CRO_ASSERT(!state.thread || state.thread->get_id() != std::this_thread::get_id(), "Can't remove a stream from within a service function");
+
+    state.idleCondition.wait(lock, [handle]() {return state.activeHandle != handle; });
+    state.jobs.erase(handle);
+}
+
+void StreamScheduler::wake(Handle handle)
+{
+    {
+        std::scoped_lock lock(state.mutex);
+        auto result = state.jobs.find(handle);
+        if (result == state.jobs.end())
+        {
+            return;
+        }
+
+        if (state.activeHandle == handle)
+        {
+            result->second.wakePending = true;
+            return;
+        }
+
+        result->second.deadline = Clock::now();
+        state.queue.push({ result->second.deadline, handle });
+    }
+    state.serviceCondition.notify_one();
+}
+
+void StreamScheduler::shutdown()
+{
+    {
+        std::scoped_lock lock(state.mutex);
+        state.running = false;
+    }
+    state.serviceCondition.notify_all();
+
+    if (state.thread)
+    {
+        state.thread->join();
+        state.thread.reset();
+    }
+
+    std::scoped_lock lock(state.mutex);
+    state.jobs.clear();
+    state.queue = {};
+}
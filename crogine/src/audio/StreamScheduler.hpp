@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace cro::Detail
+{
+    /*
+    Services all streaming audio from a single thread. Each stream
+    registers a service function which refills its buffers and returns
+    the time remaining before it next needs servicing - usually how
+    long until its queued buffers underrun. Streams are serviced in
+    order of this deadline, and the thread sleeps on a condition
+    variable until the earliest deadline arrives or a stream is woken.
+    The thread is started on demand when the first stream is added.
+    */
+    class StreamScheduler final
+    {
+    public:
+        using Handle = std::uint32_t;
+        using Duration = std::chrono::milliseconds;
+
+        //called on the streaming thread. Return the time until the next
+        //service is required, or Finished to remove the stream.
+        using ServiceFunc = std::function<Duration()>;
+
+        static constexpr Handle InvalidHandle = 0;
+        static constexpr Duration Finished = Duration(-1);
+
+        //adds a stream to be first serviced after the given delay
+        static Handle add(ServiceFunc, Duration delay = Duration(0));
+
+        //removes a stream. If the stream is currently being serviced this
+        //blocks until the service function returns, so it must not be
+        //called from within a service function.
+        static void remove(Handle);
+
+        //requests the stream be serviced as soon as possible, for example
+        //when it starts playing or is seeked. May be called from any thread
+        static void wake(Handle);
+
+        //stops the streaming thread and removes all streams
+        static void shutdown();
+    };
+}
@@ -29,6 +29,8 @@ source distribution.
 
 #include "VorbisLoader.hpp"
 
+#include <crogine/core/FileSystem.hpp>
+
 #include <algorithm>
 
 using namespace cro;
@@ -69,7 +71,7 @@ bool VorbisLoader::open(const std::string& path)
         m_vorbisFile = nullptr;
     }
 
-    m_file.file = SDL_RWFromFile(path.c_str(), "rb");
+    m_file.file = FileSystem::openResource(path);
     if (!m_file.file)
     {
         Logger::log("Failed opening " + path, Logger::Type::Error);
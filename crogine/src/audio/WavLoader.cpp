@@ -30,6 +30,7 @@ source distribution.
 #include "WavLoader.hpp"
 
 #include <crogine/core/Log.hpp>
+#include <crogine/core/FileSystem.hpp>
 
 #include <SDL_rwops.h>
 
@@ -76,7 +77,7 @@ bool WavLoader::open(const std::string& path)
         m_file.file = nullptr;
     }
     
-    m_file.file = SDL_RWFromFile(path.c_str(), "rb");
+    m_file.file = FileSystem::openResource(path);
     if (m_file.file)
     {
         //file opened, let's do stuff!
@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 
 #include "../ALCheck.hpp"
+#include "../StreamScheduler.hpp"
 
 #ifdef __APPLE__
 #include <al.h>
@@ -42,10 +43,14 @@ source distribution.
 #include <AL/al.h>
 #endif
 
+#include <algorithm>
+
 using namespace cro;
 
 namespace
 {
+    constexpr std::int32_t StreamFinished = -1;
+
     std::int32_t getFormatFromChannelCount(unsigned int channelCount)
     {
         std::int32_t format = 0;
@@ -85,21 +90,25 @@ namespace
 }
 
 SoundStream::SoundStream()
-    : m_startState      (Status::Stopped),
+    : m_streamJob       (Detail::StreamScheduler::InvalidHandle),
+    m_startState        (Status::Stopped),
     m_isStreaming       (false),
     m_channelCount      (0),
     m_sampleRate        (0),
     m_format            (0),
     m_loop              (false),
     m_samplesProcessed  (0),
-    m_processingInterval(10)
+    m_processingInterval(10),
+    m_buffersCreated    (false),
+    m_requestStop       (false),
+    m_chunkSampleCount  (0)
 {
 
 }
 
 SoundStream::~SoundStream() noexcept
 {
-    waitThread();
+    waitStream();
 }
 
 //public
@@ -135,7 +144,7 @@ void SoundStream::play()
         stop();
     }
 
-    launchThread(Status::Playing);
+    launchStream(Status::Playing);
 }
 
 void SoundStream::pause()
@@ -155,7 +164,7 @@ void SoundStream::pause()
 
 void SoundStream::stop()
 {
-    waitThread();
+    waitStream();
 
     onSeek(0);
 }
@@ -217,125 +226,140 @@ std::int64_t SoundStream::onLoop()
 }
 
 //private
-void SoundStream::threadFunc()
+std::int32_t SoundStream::update()
 {
-    std::this_thread::sleep_for(std::chrono::milliseconds(m_processingInterval));
-
-    bool requestStop = false;
-
     {
         std::scoped_lock lock(m_mutex);
 
-        if (m_startState == Status::Stopped)
+        if (!m_isStreaming
+            || (!m_buffersCreated && m_startState == Status::Stopped))
         {
+            destroyBuffers();
             m_isStreaming = false;
-            return;
+            return StreamFinished;
         }
     }
 
-    alCheck(alGenBuffers(BufferCount, m_buffers.data()));
+    if (!m_buffersCreated)
+    {
+        alCheck(alGenBuffers(BufferCount, m_buffers.data()));
+        m_buffersCreated = true;
+
+        m_requestStop = fillQueue();
 
-    requestStop = fillQueue();
+        alCheck(alSourcePlay(m_alSource));
 
-    alCheck(alSourcePlay(m_alSource));
+        {
+            std::scoped_lock lock(m_mutex);
 
-    {
-        std::scoped_lock lock(m_mutex);
+            if (m_startState == Status::Paused)
+            {
+                alCheck(alSourcePause(m_alSource));
+            }
+        }
+        return m_processingInterval;
+    }
 
-        if (m_startState == Status::Paused)
+    //restart if we underran, or finish if we're out of data
+    if (SoundSource::getStatus() == Status::Stopped)
+    {
+        if (!m_requestStop)
+        {
+            alCheck(alSourcePlay(m_alSource));
+        }
+        else
         {
-            alCheck(alSourcePause(m_alSource));
+            std::scoped_lock lock(m_mutex);
+            m_isStreaming = false;
+            destroyBuffers();
+            return StreamFinished;
         }
     }
 
 
+    ALint processedBuffers = 0;
+    alCheck(alGetSourcei(m_alSource, AL_BUFFERS_PROCESSED, &processedBuffers));
 
-    //thread loop
-    while (1)
+    while (processedBuffers--)
     {
-        //break out the loop if requested
-        {
-            std::scoped_lock lock(m_mutex);
+        ALuint buffer = 0;
+        alCheck(alSourceUnqueueBuffers(m_alSource, 1, &buffer));
 
-            if (!m_isStreaming)
+        std::uint32_t bufferIndex = 0;
+        for (auto i = 0u; i < BufferCount; ++i)
+        {
+            if (m_buffers[i] == buffer)
             {
+                bufferIndex = i;
                 break;
             }
         }
 
-        //sleep a bit
-        if (SoundSource::getStatus() != Status::Stopped)
+        if (m_bufferSeeks[bufferIndex] != NoLoop)
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(m_processingInterval));
+            m_samplesProcessed = static_cast<std::uint64_t>(m_bufferSeeks[bufferIndex]);
+            m_bufferSeeks[bufferIndex] = NoLoop;
         }
         else
         {
-            if (!requestStop)
+            ALint size = 0;
+            ALint bits = 0;
+
+            alCheck(alGetBufferi(buffer, AL_SIZE, &size));
+            alCheck(alGetBufferi(buffer, AL_BITS, &bits));
+
+            if (bits == 0)
             {
-                alCheck(alSourcePlay(m_alSource));
+                LogE << "Bits in sound stream are 0. Make sure audio is not corrupt and initialise() was called correctly" << std::endl;
+
+                std::scoped_lock lock(m_mutex);
+                m_isStreaming = false;
+                m_requestStop = true;
+                break;
             }
             else
             {
-                std::scoped_lock lock(m_mutex);
-                m_isStreaming = false;
+                m_samplesProcessed += static_cast<std::uint64_t>(size / (bits / 8));
             }
         }
 
-
-        ALint processedBuffers = 0;
-        alCheck(alGetSourcei(m_alSource, AL_BUFFERS_PROCESSED, &processedBuffers));
-
-        while (processedBuffers--)
+        if (!m_requestStop)
         {
-            ALuint buffer = 0;
-            alCheck(alSourceUnqueueBuffers(m_alSource, 1, &buffer));
-
-            std::uint32_t bufferIndex = 0;
-            for (auto i = 0u; i < BufferCount; ++i)
+            if (fillAndPushBuffer(bufferIndex))
             {
-                if (m_buffers[i] == buffer)
-                {
-                    bufferIndex = i;
-                    break;
-                }
+                m_requestStop = true;
             }
+        }
+    }
 
-            if (m_bufferSeeks[bufferIndex] != NoLoop)
-            {
-                m_samplesProcessed = static_cast<std::uint64_t>(m_bufferSeeks[bufferIndex]);
-                m_bufferSeeks[bufferIndex] = NoLoop;
-            }
-            else
-            {
-                ALint size = 0;
-                ALint bits = 0;
-
-                alCheck(alGetBufferi(buffer, AL_SIZE, &size));
-                alCheck(alGetBufferi(buffer, AL_BITS, &bits));
-
-                if (bits == 0)
-                {
-                    LogE << "Bits in sound stream are 0. Make sure audio is not corrupt and initialise() was called correctly" << std::endl;
-
-                    std::scoped_lock lock(m_mutex);
-                    m_isStreaming = false;
-                    requestStop = true;
-                    break;
-                }
-                else
-                {
-                    m_samplesProcessed += static_cast<std::uint64_t>(size / (bits / 8));
-                }
-            }
+    //the buffer currently playing may be nearly done, so the
+    //underrun deadline is estimated from the remaining buffers.
+    //Aim to update well before then, or at the processing interval.
+    ALint queuedBuffers = 0;
+    alCheck(alGetSourcei(m_alSource, AL_BUFFERS_QUEUED, &queuedBuffers));
 
-            if (!requestStop)
-            {
-                if (fillAndPushBuffer(bufferIndex))
-                {
-                    requestStop = true;
-                }
-            }
-        }        
+    std::int32_t nextUpdate = m_processingInterval;
+    const auto samplesPerSecond = static_cast<std::uint64_t>(m_sampleRate) * m_channelCount;
+    if (queuedBuffers > 0 && samplesPerSecond != 0)
+    {
+        const auto pendingSamples = static_cast<std::uint64_t>(queuedBuffers - 1) * m_chunkSampleCount;
+        const auto deadline = static_cast<std::int32_t>((pendingSamples * 1000) / samplesPerSecond);
+        nextUpdate = std::clamp(deadline / 2, 1, std::max(1, m_processingInterval));
+    }
+    else if (!m_requestStop)
+    {
+        //we've underrun so try again asap
+        nextUpdate = 1;
+    }
+
+    return nextUpdate;
+}
+
+void SoundStream::destroyBuffers()
+{
+    if (!m_buffersCreated)
+    {
+        return;
     }
 
     alCheck(alSourceStop(m_alSource));
@@ -346,6 +370,8 @@ void SoundStream::threadFunc()
 
     alCheck(alSourcei(m_alSource, AL_BUFFER, 0));
     alCheck(alDeleteBuffers(BufferCount, m_buffers.data()));
+
+    m_buffersCreated = false;
 }
 
 bool SoundStream::fillAndPushBuffer(std::uint32_t bufferID, bool loopImmediate)
@@ -387,6 +413,7 @@ bool SoundStream::fillAndPushBuffer(std::uint32_t bufferID, bool loopImmediate)
 
         auto size = static_cast<ALsizei>(chunk.sampleCount * sizeof(std::int16_t));
         alCheck(alBufferData(buffer, m_format, chunk.samples, size, static_cast<ALsizei>(m_sampleRate)));
+        m_chunkSampleCount = chunk.sampleCount;
         alCheck(alSourceQueueBuffers(m_alSource, 1, &buffer));
     }
     else
@@ -424,24 +451,31 @@ void SoundStream::clearQueue()
     }
 }
 
-void SoundStream::launchThread(SoundStream::Status status)
+void SoundStream::launchStream(SoundStream::Status status)
 {
     m_isStreaming = true;
     m_startState = status;
+    m_requestStop = false;
 
-    CRO_ASSERT(!m_thread.joinable(), "");
-    m_thread = std::thread(&SoundStream::threadFunc, this);
+    CRO_ASSERT(m_streamJob == Detail::StreamScheduler::InvalidHandle, "");
+    m_streamJob = Detail::StreamScheduler::add([&]()
+        {
+            const auto next = update();
+            return next == StreamFinished ? Detail::StreamScheduler::Finished : Detail::StreamScheduler::Duration(next);
+        }, Detail::StreamScheduler::Duration(m_processingInterval));
 }
 
-void SoundStream::waitThread()
+void SoundStream::waitStream()
 {
     {
         std::scoped_lock lock(m_mutex);
         m_isStreaming = false;
     }
 
-    if (m_thread.joinable())
-    {
-        m_thread.join();
-    }
-}
\ No newline at end of file
+    //blocks if the stream is currently being updated. If the
+    //stream already finished by itself this does nothing.
+    Detail::StreamScheduler::remove(m_streamJob);
+    m_streamJob = Detail::StreamScheduler::InvalidHandle;
+
+    destroyBuffers();
+}
@@ -37,6 +37,7 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 #include <crogine/audio/AudioMixer.hpp>
 #include <crogine/gui/Gui.hpp>
+#include <crogine/graphics/Image.hpp>
 #include <crogine/util/String.hpp>
 
 #include <SDL.h>
@@ -44,6 +45,8 @@ source distribution.
 #include <SDL_filesystem.h>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/AsyncLoader.hpp"
+#include "../detail/TextureRegistry.hpp"
 #include "../detail/SDLImageRead.hpp"
 #include "../imgui/imgui_impl_opengl3.h"
 #include "../imgui/imgui_impl_sdl.h"
@@ -203,6 +206,7 @@ App::App(std::uint32_t styleFlags)
     : m_windowStyleFlags(styleFlags),
     m_frameClock        (nullptr),
     m_running           (false),
+    m_uploadBudget      (2.f),
     m_controllerCount   (0),
     m_drawDebugWindows  (true),
     m_orgString         ("Trederia"),
@@ -415,6 +419,13 @@ void App::run()
 
             simulate(frameTime);
         }
+
+        //create any resources which finished loading in the background
+        Detail::AsyncLoader::processUploads(m_uploadBudget);
+
+        //evict unused textures if we're over the memory budget
+        Detail::TextureRegistry::update();
+
         //DPRINT("Frame time", std::to_string(timeSinceLastUpdate.asMilliseconds()));
         doImGui();
 
@@ -429,6 +440,7 @@ void App::run()
 
     Console::finalise();
     m_messageBus.disable(); //prevents spamming a load of quit messages
+    Detail::AsyncLoader::shutdown();
     finalise();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
@@ -492,16 +504,15 @@ void App::saveScreenshot()
     glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 1));
     glCheck(glReadPixels(0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, buffer.data()));
 
-    //flip row order
-    stbi_flip_vertically_on_write(1);
-
     std::string filename = "screenshot_" + SysTime::dateString() + "_" + SysTime::timeString() + ".png";
     std::replace(filename.begin(), filename.end(), '/', '_');
     std::replace(filename.begin(), filename.end(), ':', '_');
 
-    RaiiRWops out;
-    out.file = SDL_RWFromFile(filename.c_str(), "w");
-    stbi_write_png_to_func(image_write_func, out.file, size.x, size.y, 4, buffer.data(), size.x * 4);
+    //flip row order and encode on a worker thread so we don't stall the frame
+    Image image;
+    image.loadFromMemory(buffer.data(), size.x, size.y, ImageFormat::RGBA);
+    image.flipVertically();
+    image.writeAsync(filename);
 }
 
 //protected
@@ -37,8 +37,14 @@ source distribution.
 
 #include <SDL_rwops.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
 #include <sstream>
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
 
 using namespace cro;
 using json = nlohmann::json;
@@ -46,7 +52,6 @@ using json = nlohmann::json;
 namespace
 {
     const std::string indentBlock("    ");
-    std::size_t currentLine = 0;
 
     template <typename T>
     void addToObject(ConfigObject* dst, const std::string& key, json& value)
@@ -54,16 +59,256 @@ namespace
         T v = value;
         dst->addProperty(key).setValue(v);
     }
+
+    //FNV-1a
+    std::uint64_t hashName(std::string_view name)
+    {
+        std::uint64_t hash = 0xcbf29ce484222325;
+        for (auto c : name)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    //splits a file buffer into lines without copying them. Tabs and carriage
+    //returns are stripped, which requires a copy, so they are written to a
+    //scratch buffer - only when a line actually contains them.
+    class LineReader final
+    {
+    public:
+        explicit LineReader(std::string_view data)
+            : m_data(data), m_position(0), m_lineNumber(0) {}
+
+        bool atEnd() const { return m_position >= m_data.size(); }
+
+        //returns an empty line once the end of the buffer is reached
+        std::string_view next()
+        {
+            if (atEnd())
+            {
+                return {};
+            }
+
+            auto end = m_data.find('\n', m_position);
+            if (end == std::string_view::npos)
+            {
+                end = m_data.size();
+            }
+
+            auto line = m_data.substr(m_position, end - m_position);
+            m_position = end + 1;
+            m_lineNumber++;
+
+            if (line.find_first_of("\t\r") != std::string_view::npos)
+            {
+                m_scratch.clear();
+                for (auto c : line)
+                {
+                    if (c != '\t' && c != '\r')
+                    {
+                        m_scratch.push_back(c);
+                    }
+                }
+                line = m_scratch;
+            }
+
+            return clean(line);
+        }
+
+    private:
+        std::string_view m_data;
+        std::size_t m_position;
+        std::size_t m_lineNumber;
+        std::string m_scratch;
+
+        //removes comments and leading spaces
+        std::string_view clean(std::string_view line) const
+        {
+            auto result = line.find('/');
+
+            //make sure to only crop comments outside of string literals
+            if (result != std::string_view::npos
+                && result < line.size() - 1 && line[result + 1] == '/')
+            {
+                auto otherResult = line.find_last_of('\"');
+                if (result > otherResult || otherResult == std::string_view::npos)
+                {
+                    line = line.substr(0, result);
+                }
+            }
+
+            auto start = line.find_first_not_of(' ');
+            line = start == std::string_view::npos ? std::string_view() : line.substr(start);
+
+            if (line.find(';') != std::string_view::npos)
+            {
+                LogW << "Line " << m_lineNumber << " contains semi-colon, is this intentional?" << std::endl;
+            }
+            return line;
+        }
+    };
+
+    bool isProperty(std::string_view line)
+    {
+        auto pos = line.find('=');
+        return(pos != std::string_view::npos && pos > 1 && line.length() > 5);
+    }
+
+    std::string removeSpaces(std::string_view str)
+    {
+        std::string retVal;
+        retVal.reserve(str.size());
+        for (auto c : str)
+        {
+            if (c != ' ')
+            {
+                retVal.push_back(c);
+            }
+        }
+        return retVal;
+    }
+
+    std::pair<std::string, std::string> getObjectName(std::string_view line)
+    {
+        auto result = line.find(' ');
+        if (result != std::string_view::npos)
+        {
+            auto first = line.substr(0, result);
+            auto second = line.substr(result + 1);
+            //make sure id has no spaces by truncating it
+            second = second.substr(0, second.find(' '));
+
+            return std::make_pair(std::string(first), std::string(second));
+        }
+        return std::make_pair(std::string(line), std::string());
+    }
+
+    std::pair<std::string, std::string> getPropertyName(std::string_view line)
+    {
+        auto result = line.find('=');
+        CRO_ASSERT(result != std::string_view::npos, "");
+
+        auto first = removeSpaces(line.substr(0, result));
+        auto second = line.substr(result + 1);
+
+        //check for string literal
+        result = second.find('\"');
+        if (result != std::string_view::npos)
+        {
+            auto otherResult = second.find_last_of('\"');
+            if (otherResult != result)
+            {
+                second = second.substr(result + 1, otherResult - result - 1);
+                if (!second.empty() && second[0] == '/') second = second.substr(1);
+
+                std::string value;
+                value.reserve(second.size());
+                for (auto c : second)
+                {
+                    if (c != '\"')
+                    {
+                        value.push_back(c);
+                    }
+                }
+                return std::make_pair(std::move(first), std::move(value));
+            }
+            else
+            {
+                Logger::log("String property \'" + first + "\' has missing \'\"\', value may not be as expected", Logger::Type::Warning);
+                return std::make_pair(std::move(first), std::string(second));
+            }
+        }
+
+        return std::make_pair(std::move(first), removeSpaces(second));
+    }
+
+    /*
+    Binary cache
+    */
+    constexpr std::uint32_t CacheMagic = 0x43474643; //'CFGC'
+    constexpr std::uint32_t CacheVersion = 1;
+
+    struct CacheState final
+    {
+        std::mutex mutex;
+        std::string directory;
+    }cacheState;
+
+    struct CacheHeader final
+    {
+        std::uint32_t magic = CacheMagic;
+        std::uint32_t version = CacheVersion;
+        std::int64_t timestamp = 0;
+        std::uint64_t fileSize = 0;
+        std::uint64_t dataSize = 0; //size of the data following this header and the path
+        std::uint64_t pathSize = 0;
+    };
+
+    //returns false if the file isn't on disk, eg it's in an archive or APK
+    bool getFileStats(const std::string& path, std::int64_t& timestamp, std::uint64_t& size)
+    {
+        struct stat info;
+        if (stat(path.c_str(), &info) != 0
+            || (info.st_mode & S_IFDIR))
+        {
+            return false;
+        }
+
+        timestamp = static_cast<std::int64_t>(info.st_mtime);
+        size = static_cast<std::uint64_t>(info.st_size);
+        return true;
+    }
+
+    std::string getCachePath(const std::string& directory, const std::string& path)
+    {
+        std::stringstream ss;
+        ss << directory << std::hex << hashName(path) << ".ccf";
+        return ss.str();
+    }
+
+    void writeString(std::vector<std::uint8_t>& dst, const std::string& str)
+    {
+        const auto size = static_cast<std::uint32_t>(str.size());
+        const auto* sizePtr = reinterpret_cast<const std::uint8_t*>(&size);
+        dst.insert(dst.end(), sizePtr, sizePtr + sizeof(size));
+        dst.insert(dst.end(), str.begin(), str.end());
+    }
+
+    bool readUint32(const std::uint8_t*& data, const std::uint8_t* end, std::uint32_t& dst)
+    {
+        if (end - data < static_cast<std::ptrdiff_t>(sizeof(dst)))
+        {
+            return false;
+        }
+        std::memcpy(&dst, data, sizeof(dst));
+        data += sizeof(dst);
+        return true;
+    }
+
+    bool readString(const std::uint8_t*& data, const std::uint8_t* end, std::string& dst)
+    {
+        std::uint32_t size = 0;
+        if (!readUint32(data, end, size)
+            || end - data < static_cast<std::ptrdiff_t>(size))
+        {
+            return false;
+        }
+        dst.assign(reinterpret_cast<const char*>(data), size);
+        data += size;
+        return true;
+    }
 }
 
 //--------------------//
-ConfigProperty::ConfigProperty(const std::string& name, const std::string& value)
-    : ConfigItem(name),
-    m_value(value), m_isStringValue(false)
+ConfigProperty::ConfigProperty(std::string name, std::string value)
+    : ConfigItem(std::move(name)),
+    m_value(std::move(value)), m_isStringValue(false)
 {
-    m_isStringValue = !value.empty()
-        && ((value.front() == '\"' && value.back() == '\"')
-        || value.find(' ') != std::string::npos);
+    m_isStringValue = !m_value.empty()
+        && ((m_value.front() == '\"' && m_value.back() == '\"')
+        || m_value.find(' ') != std::string::npos);
 }
 
 void ConfigProperty::setValue(const std::string& value)
@@ -135,10 +380,10 @@ std::vector<float> ConfigProperty::valueAsArray() const
 
     while (next != std::string::npos && start < end)
     {
-        float val;
-        std::istringstream is(m_value.substr(start, next));
-        if (is >> val) retval.push_back(val);
-        else retval.push_back(0.f);
+        const char* str = m_value.c_str() + start;
+        char* strEnd = nullptr;
+        float val = std::strtof(str, &strEnd);
+        retval.push_back(strEnd != str ? val : 0.f);
 
         start = ++next;
         next = m_value.find_first_of(',', start);
@@ -156,21 +401,29 @@ std::vector<float> ConfigProperty::valueAsArray() const
 
 //-------------------------------------
 
-ConfigObject::ConfigObject(const std::string& name, const std::string& id)
-    : ConfigItem    (name), m_id(id){}
+ConfigObject::ConfigObject(std::string name, std::string id)
+    : ConfigItem    (std::move(name)), 
+    m_id            (std::move(id)),
+    m_idHash        (hashName(m_id)) {}
 
 bool ConfigObject::loadFromFile(const std::string& filePath, bool relative)
 {
     auto path = relative ? FileSystem::getResourcePath() + filePath : filePath;
-    currentLine = 0;
 
-    m_id = "";
+    setId("");
     setName("");
     m_properties.clear();
     m_objects.clear();
 
+    const bool isJson = cro::FileSystem::getFileExtension(path) == ".json";
+    if (!isJson
+        && loadFromCache(path))
+    {
+        return true;
+    }
+
     RaiiRWops rr;
-    rr.file = SDL_RWFromFile(path.c_str(), "r");
+    rr.file = FileSystem::openResource(path);
 
     if (!rr.file)
     {
@@ -180,138 +433,58 @@ bool ConfigObject::loadFromFile(const std::string& filePath, bool relative)
     
     //fetch file size
     auto fileSize = SDL_RWsize(rr.file);
-    if (fileSize == 0)
+    if (fileSize <= 0)
     {
         LOG(path + ": file empty", Logger::Type::Warning);
         return false;
     }
 
-    if (rr.file)
+    if (isJson)
     {
-        if (cro::FileSystem::getFileExtension(path) == ".json")
-        {
-            return parseAsJson(rr.file);
-        }
-
-        //remove any opening comments
-        std::string data;
-        std::int64_t readTotal = 0;
-        static const std::int32_t DEST_SIZE = 256;
-        char dest[DEST_SIZE];
-        while (data.empty() && readTotal < fileSize)
-        {
-            data = std::string(Util::String::rwgets(dest, DEST_SIZE, rr.file, &readTotal));
-            removeComment(data);       
-        }
-        //check config is not opened with a property
-        if (isProperty(data))
-        {
-            Logger::log(path + ": Cannot start configuration file with a property", Logger::Type::Error);
-            return false;
-        }
-        
-        //make sure next line is a brace to ensure we have an object
-        std::string lastLine = data;
-        data = std::string(Util::String::rwgets(dest, DEST_SIZE, rr.file, &readTotal));
-        removeComment(data);
+        return parseAsJson(rr.file);
+    }
 
-        //tracks brace balance
-        std::vector<ConfigObject*> objStack;
+    //read the whole file in one go and parse it in place
+    std::vector<char> data(static_cast<std::size_t>(fileSize));
+    if (SDL_RWread(rr.file, data.data(), data.size(), 1) != 1)
+    {
+        Logger::log(path + ": failed reading file", Logger::Type::Error);
+        return false;
+    }
 
-        if (data[0] == '{')
-        {
-            //we have our opening object
-            auto objectName = getObjectName(lastLine);
-            setName(objectName.first);
-            m_id = objectName.second;
-            
-            objStack.push_back(this);
-        }
-        else
-        {
-            Logger::log(path + " Invalid configuration header (missing '{' ?)", Logger::Type::Error);
-            return false;
-        }
+    if (parseText(std::string_view(data.data(), data.size()), path))
+    {
+        writeCache(path);
+        return true;
+    }
+    return false;
+}
 
+void ConfigObject::setCacheDirectory(const std::string& path)
+{
+    std::string directory = path;
+    std::replace(directory.begin(), directory.end(), '\\', '/');
+    if (!directory.empty() && directory.back() != '/')
+    {
+        directory.push_back('/');
+    }
 
-        while (readTotal < fileSize)
-        {
-            data = std::string(Util::String::rwgets(dest, DEST_SIZE, rr.file, &readTotal));
-            removeComment(data);
-            if (!data.empty())
-            {
-                if (data[0] == '}')
-                {
-                    //close current object and move to parent
-                    objStack.pop_back();
-                }
-                else if (isProperty(data))
-                {           
-                    //insert name / value property into current object
-                    auto prop = getPropertyName(data);
-                    //TODO need to reinstate this and create a property
-                    //capable of storing arrays
-                    /*if (currentObject->findProperty(prop.first))
-                    {
-                        Logger::log("Property \'" + prop.first + "\' already exists in \'" + currentObject->getName() + "\', skipping entry...", Logger::Type::Warning);
-                        continue;
-                    }*/
+    if (!directory.empty()
+        && !FileSystem::directoryExists(directory)
+        && !FileSystem::createDirectory(directory))
+    {
+        LogE << "Failed creating config cache directory " << directory << std::endl;
+        directory.clear();
+    }
 
-                    if (prop.second.empty())
-                    {
-                        Logger::log("\'" + objStack.back()->getName() + "\' property \'" + prop.first + "\' has no valid value", Logger::Type::Warning);
-                        continue;
-                    }
-                    objStack.back()->addProperty(prop.first, prop.second);
-                }
-                else
-                {
-                    //add a new object and make it current
-                    std::string prevLine = data;
-                    data = std::string(Util::String::rwgets(dest, DEST_SIZE, rr.file, &readTotal));
-                    removeComment(data);
-                    if (data[0] == '{')
-                    {
-                        //TODO we have to allow mutliple objects with the same name in this instance
-                        //as a model may have multiple material defs.
-                        auto name = getObjectName(prevLine);
-                        //if (name.second.empty() || objStack.back()->findObjectWithId(name.second) == nullptr)
-                        //{
-                        //    //safe to add new object as the name doesn't exist
-                        //    objStack.push_back(objStack.back()->addObject(name.first, name.second));
-                        //}
-                        //else
-                        //{
-                        //    Logger::log("Object with ID " + name.second + " has already been added, duplicate is skipped...", Logger::Type::Warning);
-
-                        //    //fast forward to closing brace
-                        //    while (data[0] != '}')
-                        //    {
-                        //        data = std::string(Util::String::rwgets(dest, DEST_SIZE, rr.file, &readTotal));
-                        //        removeComment(data);
-                        //    }
-                        //}
-
-                        objStack.push_back(objStack.back()->addObject(name.first, name.second));
-                    }
-                    else //last line was probably garbage or nothing but spaces
-                    {
-                        //LogW << filePath << ": Missing line or incorrect syntax at " << currentLine << std::endl;
-                        continue;
-                    }
-                }
-            }       
-        }
+    std::scoped_lock l(cacheState.mutex);
+    cacheState.directory = directory;
+}
 
-        if (!objStack.empty())
-        {
-            Logger::log("Brace count not at 0 after parsing \'" + path + "\'. Config data may not be correct.", Logger::Type::Warning);
-        }
-        return true;
-    }
-    
-    Logger::log(filePath + " file invalid or not found.", Logger::Type::Error);
-    return false;
+void ConfigObject::setId(const std::string& id)
+{
+    m_id = id;
+    m_idHash = hashName(m_id);
 }
 
 const std::string& ConfigObject::getId() const
@@ -321,24 +494,7 @@ const std::string& ConfigObject::getId() const
 
 ConfigProperty* ConfigObject::findProperty(const std::string& name) const
 {
-    auto result = std::find_if(m_properties.begin(), m_properties.end(),
-        [&name](const ConfigProperty& p)
-    {
-        return (p.getName() == name);
-    });
-
-    if (result != m_properties.end())
-    {
-        return const_cast<ConfigProperty*>(&*result);
-    }
-    //recurse
-    for (auto& o : m_objects)
-    {
-        auto p = o.findProperty(name);
-        if (p) return p;
-    }
-
-    return nullptr;
+    return findProperty(name, hashName(name));
 }
 
 ConfigObject* ConfigObject::findObjectWithId(const std::string& id) const
@@ -348,49 +504,12 @@ ConfigObject* ConfigObject::findObjectWithId(const std::string& id) const
         return nullptr;
     }
 
-    auto result = std::find_if(m_objects.begin(), m_objects.end(),
-        [&id](const ConfigObject& p)
-    {
-        auto s = p.getId();
-        return (!s.empty() && s == id);
-    });
-
-    if (result != m_objects.end())
-    {
-        return const_cast<ConfigObject*>(&*result);
-    }
-    
-    //recurse
-    for (auto& o : m_objects)
-    {
-        auto p = o.findObjectWithId(id);
-        if (p) return p;
-    }
-
-    return nullptr;
+    return findObjectWithId(id, hashName(id));
 }
 
 ConfigObject* ConfigObject::findObjectWithName(const std::string& name) const
 {
-    auto result = std::find_if(m_objects.begin(), m_objects.end(),
-        [&name](const ConfigObject& p)
-    {
-        return (p.getName() == name);
-    });
-
-    if (result != m_objects.end())
-    {
-        return const_cast<ConfigObject*>(&*result);
-    }
-
-    //recurse
-    for (auto& o : m_objects)
-    {
-        auto p = o.findObjectWithName(name);
-        if (p) return p;
-    }
-
-    return nullptr;
+    return findObjectWithName(name, hashName(name));
 }
 
 const std::vector<ConfigProperty>& ConfigObject::getProperties() const
@@ -435,10 +554,11 @@ ConfigObject* ConfigObject::addObject(const std::string& name, const std::string
 
 void ConfigObject::removeProperty(const std::string& name)
 {
+    const auto hash = hashName(name);
     auto result = std::find_if(m_properties.begin(), m_properties.end(),
-        [&name](const ConfigProperty& p)
+        [&name, hash](const ConfigProperty& p)
     {
-        return (p.getName() == name);
+        return (p.m_nameHash == hash && p.getName() == name);
     });
 
     if (result != m_properties.end()) m_properties.erase(result);
@@ -446,10 +566,11 @@ void ConfigObject::removeProperty(const std::string& name)
 
 ConfigObject ConfigObject::removeObject(const std::string& name)
 {
+    const auto hash = hashName(name);
     auto result = std::find_if(m_objects.begin(), m_objects.end(),
-        [&name](const ConfigObject& p)
+        [&name, hash](const ConfigObject& p)
     {
-        return (p.getName() == name);
+        return (p.m_nameHash == hash && p.getName() == name);
     });
 
     if (result != m_objects.end())
@@ -463,95 +584,357 @@ ConfigObject ConfigObject::removeObject(const std::string& name)
     return {};
 }
 
-ConfigObject::NameValue ConfigObject::getObjectName(const std::string& line)
+//private
+ConfigProperty* ConfigObject::findProperty(std::string_view name, std::uint64_t hash) const
 {
-    auto result = line.find_first_of(' ');
-    if (result != std::string::npos)
+    //hashes are compared first so the string comparison
+    //is only made once we're (almost) certain of a match
+    auto result = std::find_if(m_properties.begin(), m_properties.end(),
+        [name, hash](const ConfigProperty& p)
     {
-        std::string first = line.substr(0, result);
-        std::string second = line.substr(result + 1);
-        //make sure id has no spaces by truncating it
-        result = second.find_first_of(' ');
-        if (result != std::string::npos)
-            second = second.substr(0, result);
+        return (p.m_nameHash == hash && p.getName() == name);
+    });
 
-        return std::make_pair(first, second);
+    if (result != m_properties.end())
+    {
+        return const_cast<ConfigProperty*>(&*result);
     }
-    return std::make_pair(line, "");
+    //recurse
+    for (auto& o : m_objects)
+    {
+        auto p = o.findProperty(name, hash);
+        if (p) return p;
+    }
+
+    return nullptr;
 }
 
-ConfigObject::NameValue ConfigObject::getPropertyName(const std::string& line)
+ConfigObject* ConfigObject::findObjectWithId(std::string_view id, std::uint64_t hash) const
 {
-    auto result = line.find_first_of("=");
-    assert(result != std::string::npos);
-
-    std::string first = line.substr(0, result);
-    Util::String::removeChar(first, ' ');
+    auto result = std::find_if(m_objects.begin(), m_objects.end(),
+        [id, hash](const ConfigObject& p)
+    {
+        return (p.m_idHash == hash && p.getId() == id);
+    });
 
-    std::string second = line.substr(result + 1);
+    if (result != m_objects.end())
+    {
+        return const_cast<ConfigObject*>(&*result);
+    }
     
-    //check for string literal
-    result = second.find_first_of("\"");
-    if (result != std::string::npos)
+    //recurse
+    for (auto& o : m_objects)
+    {
+        auto p = o.findObjectWithId(id, hash);
+        if (p) return p;
+    }
+
+    return nullptr;
+}
+
+ConfigObject* ConfigObject::findObjectWithName(std::string_view name, std::uint64_t hash) const
+{
+    auto result = std::find_if(m_objects.begin(), m_objects.end(),
+        [name, hash](const ConfigObject& p)
+    {
+        return (p.m_nameHash == hash && p.getName() == name);
+    });
+
+    if (result != m_objects.end())
+    {
+        return const_cast<ConfigObject*>(&*result);
+    }
+
+    //recurse
+    for (auto& o : m_objects)
+    {
+        auto p = o.findObjectWithName(name, hash);
+        if (p) return p;
+    }
+
+    return nullptr;
+}
+
+bool ConfigObject::parseText(std::string_view data, const std::string& path)
+{
+    LineReader reader(data);
+
+    //remove any opening comments
+    std::string_view line;
+    while (line.empty() && !reader.atEnd())
+    {
+        line = reader.next();
+    }
+
+    //check config is not opened with a property
+    if (isProperty(line))
+    {
+        Logger::log(path + ": Cannot start configuration file with a property", Logger::Type::Error);
+        return false;
+    }
+
+    //make sure next line is a brace to ensure we have an object
+    //(copied because the next line may overwrite the reader's scratch buffer)
+    const auto objectName = getObjectName(line);
+    line = reader.next();
+
+    //tracks brace balance
+    std::vector<ConfigObject*> objStack;
+
+    if (!objectName.first.empty()
+        && !line.empty() && line[0] == '{')
+    {
+        //we have our opening object
+        setName(objectName.first);
+        setId(objectName.second);
+
+        objStack.push_back(this);
+    }
+    else
+    {
+        Logger::log(path + " Invalid configuration header (missing '{' ?)", Logger::Type::Error);
+        return false;
+    }
+
+    while (!reader.atEnd())
     {
-        auto otherResult = second.find_last_of("\"");
-        if (otherResult != std::string::npos
-            && otherResult != result)
+        line = reader.next();
+        if (!line.empty())
         {
-            second = second.substr(result, otherResult);
-            Util::String::removeChar(second, '\"');
-            if (second[0] == '/') second = second.substr(1);
+            if (line[0] == '}')
+            {
+                //close current object and move to parent
+                objStack.pop_back();
+                if (objStack.empty())
+                {
+                    //anything after the root object is ignored
+                    break;
+                }
+            }
+            else if (isProperty(line))
+            {
+                //insert name / value property into current object
+                auto prop = getPropertyName(line);
+                //TODO need to reinstate this and create a property
+                //capable of storing arrays
+                /*if (currentObject->findProperty(prop.first))
+                {
+                    Logger::log("Property \'" + prop.first + "\' already exists in \'" + currentObject->getName() + "\', skipping entry...", Logger::Type::Warning);
+                    continue;
+                }*/
+
+                if (prop.second.empty())
+                {
+                    Logger::log("\'" + objStack.back()->getName() + "\' property \'" + prop.first + "\' has no valid value", Logger::Type::Warning);
+                    continue;
+                }
+                auto* parent = objStack.back();
+                parent->m_properties.emplace_back(std::move(prop.first), std::move(prop.second));
+                parent->m_properties.back().setParent(parent);
+            }
+            else
+            {
+                //add a new object and make it current
+                auto name = getObjectName(line);
+                line = reader.next();
+                if (!line.empty() && line[0] == '{')
+                {
+                    //TODO we have to allow mutliple objects with the same name in this instance
+                    //as a model may have multiple material defs.
+                    auto* parent = objStack.back();
+                    parent->m_objects.emplace_back(std::move(name.first), std::move(name.second));
+                    parent->m_objects.back().setParent(parent);
+                    objStack.push_back(&parent->m_objects.back());
+                }
+                else //last line was probably garbage or nothing but spaces
+                {
+                    continue;
+                }
+            }
         }
-        else
+    }
+
+    if (!objStack.empty())
+    {
+        Logger::log("Brace count not at 0 after parsing \'" + path + "\'. Config data may not be correct.", Logger::Type::Warning);
+    }
+    return true;
+}
+
+bool ConfigObject::loadFromCache(const std::string& path)
+{
+    std::string cachePath;
+    {
+        std::scoped_lock l(cacheState.mutex);
+        if (cacheState.directory.empty())
         {
-            Logger::log("String property \'" + first + "\' has missing \'\"\', value may not be as expected", Logger::Type::Warning);
+            return false;
         }
+        cachePath = getCachePath(cacheState.directory, path);
     }
-    else
+
+    std::int64_t timestamp = 0;
+    std::uint64_t fileSize = 0;
+    if (!getFileStats(path, timestamp, fileSize))
     {
-        Util::String::removeChar(second, ' ');
+        return false;
     }
 
-    return std::make_pair(first, second);
+    std::vector<std::uint8_t> buffer;
+    {
+        std::scoped_lock l(cacheState.mutex);
+        RaiiRWops file;
+        file.file = SDL_RWFromFile(cachePath.c_str(), "rb");
+        if (!file.file)
+        {
+            return false;
+        }
+
+        CacheHeader header;
+        if (SDL_RWread(file.file, &header, sizeof(header), 1) != 1
+            || header.magic != CacheMagic
+            || header.version != CacheVersion
+            || header.timestamp != timestamp
+            || header.fileSize != fileSize
+            || header.pathSize != path.size())
+        {
+            return false;
+        }
+
+        std::string cachedPath(header.pathSize, '\0');
+        if (!cachedPath.empty() 
+            && (SDL_RWread(file.file, cachedPath.data(), cachedPath.size(), 1) != 1
+            || cachedPath != path))
+        {
+            //hash collision
+            return false;
+        }
+
+        buffer.resize(header.dataSize);
+        if (buffer.empty()
+            || SDL_RWread(file.file, buffer.data(), buffer.size(), 1) != 1)
+        {
+            return false;
+        }
+    }
+
+    const auto* data = buffer.data();
+    if (!readBinary(data, buffer.data() + buffer.size()))
+    {
+        LogW << cachePath << ": corrupt config cache, reparsing " << path << std::endl;
+        setId("");
+        setName("");
+        m_properties.clear();
+        m_objects.clear();
+        return false;
+    }
+    return true;
 }
 
-bool ConfigObject::isProperty(const std::string& line)
+void ConfigObject::writeCache(const std::string& path) const
 {
-    auto pos = line.find('=');
-    return(pos != std::string::npos && pos > 1 && line.length() > 5);
+    std::string cachePath;
+    {
+        std::scoped_lock l(cacheState.mutex);
+        if (cacheState.directory.empty())
+        {
+            return;
+        }
+        cachePath = getCachePath(cacheState.directory, path);
+    }
+
+    CacheHeader header;
+    if (!getFileStats(path, header.timestamp, header.fileSize))
+    {
+        return;
+    }
+
+    std::vector<std::uint8_t> data;
+    writeBinary(data);
+    header.dataSize = data.size();
+    header.pathSize = path.size();
+
+    std::scoped_lock l(cacheState.mutex);
+    RaiiRWops file;
+    file.file = SDL_RWFromFile(cachePath.c_str(), "wb");
+    if (!file.file
+        || SDL_RWwrite(file.file, &header, sizeof(header), 1) != 1
+        || SDL_RWwrite(file.file, path.data(), path.size(), 1) != 1
+        || SDL_RWwrite(file.file, data.data(), data.size(), 1) != 1)
+    {
+        LogW << "Failed writing config cache " << cachePath << std::endl;
+    }
 }
 
-void ConfigObject::removeComment(std::string& line)
+bool ConfigObject::readBinary(const std::uint8_t*& data, const std::uint8_t* end)
 {
-    auto result = line.find_first_of("//");
+    std::string name;
+    std::string id;
+    if (!readString(data, end, name)
+        || !readString(data, end, id))
+    {
+        return false;
+    }
+    setName(name);
+    setId(id);
+
+    std::uint32_t count = 0;
+    if (!readUint32(data, end, count))
+    {
+        return false;
+    }
+
+    m_properties.reserve(count);
+    for (auto i = 0u; i < count; ++i)
+    {
+        std::string value;
+        if (!readString(data, end, name)
+            || !readString(data, end, value))
+        {
+            return false;
+        }
+        m_properties.emplace_back(std::move(name), std::move(value));
+        m_properties.back().setParent(this);
+    }
+
+    if (!readUint32(data, end, count))
+    {
+        return false;
+    }
 
-    //make sure to only crop comments outside of string literals
-    //for some reason it appears result also matches '/' so unquoted paths get truncated
-    if (result < line.size() - 1 && line[result + 1] == '/')
+    m_objects.reserve(count);
+    for (auto i = 0u; i < count; ++i)
     {
-        auto otherResult = line.find_last_of('\"');
-        if (result != std::string::npos && (result > otherResult || otherResult == std::string::npos))
+        auto& obj = m_objects.emplace_back();
+        obj.setParent(this);
+        if (!obj.readBinary(data, end))
         {
-            line = line.substr(0, result);
+            return false;
         }
     }
+    return true;
+}
 
-    //remove any tabs while we're at it
-    Util::String::removeChar(line, '\t');
-    //Util::String::removeChar(line, ' ');
+void ConfigObject::writeBinary(std::vector<std::uint8_t>& dst) const
+{
+    writeString(dst, getName());
+    writeString(dst, m_id);
 
-    //and preceding spaces
-    auto start = line.find_first_not_of(' ');
-    if (start != std::string::npos)
+    auto count = static_cast<std::uint32_t>(m_properties.size());
+    auto* countPtr = reinterpret_cast<const std::uint8_t*>(&count);
+    dst.insert(dst.end(), countPtr, countPtr + sizeof(count));
+    for (const auto& prop : m_properties)
     {
-        line = line.substr(start);
+        writeString(dst, prop.getName());
+        writeString(dst, prop.m_value);
     }
 
-    if (line.find(';') != std::string::npos)
+    count = static_cast<std::uint32_t>(m_objects.size());
+    dst.insert(dst.end(), countPtr, countPtr + sizeof(count));
+    for (const auto& obj : m_objects)
     {
-        LogW << "Line " << currentLine << " contains semi-colon, is this intentional?" << std::endl;
+        obj.writeBinary(dst);
     }
-    currentLine++;
 }
 
 bool ConfigObject::parseAsJson(SDL_RWops* file)
@@ -747,9 +1130,10 @@ std::size_t ConfigObject::write(SDL_RWops* file, std::uint16_t depth)
 }
 
 //--------------------//
-ConfigItem::ConfigItem(const std::string& name)
+ConfigItem::ConfigItem(std::string name)
     : m_parent  (nullptr),
-    m_name      (name){}
+    m_name      (std::move(name)),
+    m_nameHash  (hashName(m_name)){}
 
 ConfigItem* ConfigItem::getParent() const
 {
@@ -769,4 +1153,5 @@ void ConfigItem::setParent(ConfigItem* parent)
 void ConfigItem::setName(const std::string& name)
 {
     m_name = name;
-}
+    m_nameHash = hashName(m_name);
+}
\ No newline at end of file
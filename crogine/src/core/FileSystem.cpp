@@ -33,6 +33,10 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 #include <crogine/core/Log.hpp>
 
+#include "../detail/AssetArchive.hpp"
+
+#include <SDL_rwops.h>
+
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -40,6 +44,9 @@ source distribution.
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <atomic>
 
 //TODO check this macro works on all windows compilers
 //(only tested in VC right now)
@@ -89,6 +96,28 @@ namespace
         }
         return retVal;
     }
+
+    //archives may be read from AsyncLoader worker threads
+    struct ArchiveState final
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<cro::Detail::AssetArchive>> archives;
+        std::atomic_bool looseFileOverride = true;
+        std::atomic_bool hasArchives = false;
+    }archiveState;
+
+    //archive entries are stored relative to the resource directory
+    std::string getArchivePath(const std::string& path)
+    {
+        auto retVal = cro::Detail::AssetArchive::normalisePath(path);
+        auto root = cro::Detail::AssetArchive::normalisePath(cro::FileSystem::getResourcePath());
+        if (!root.empty()
+            && retVal.find(root) == 0)
+        {
+            retVal = retVal.substr(root.size());
+        }
+        return retVal;
+    }
 }
 
 using namespace cro;
@@ -234,6 +263,20 @@ std::string FileSystem::getFilePath(const std::string& path)
 
 bool FileSystem::fileExists(const std::string& path)
 {
+    if (archiveState.hasArchives)
+    {
+        const auto archivePath = getArchivePath(path);
+
+        std::scoped_lock l(archiveState.mutex);
+        for (const auto& archive : archiveState.archives)
+        {
+            if (archive->contains(archivePath))
+            {
+                return true;
+            }
+        }
+    }
+
     std::ifstream file(path);
     bool exists = (file.is_open() && file.good());
     file.close();
@@ -662,6 +705,90 @@ void FileSystem::setResourceDirectory(const std::string& path)
     }
 }
 
+bool FileSystem::mountArchive(const std::string& path)
+{
+    auto archive = std::make_unique<Detail::AssetArchive>();
+    if (!archive->open(path))
+    {
+        return false;
+    }
+
+    std::scoped_lock l(archiveState.mutex);
+    auto result = std::find_if(archiveState.archives.begin(), archiveState.archives.end(),
+        [&path](const std::unique_ptr<Detail::AssetArchive>& a)
+        {
+            return a->getPath() == path;
+        });
+
+    if (result != archiveState.archives.end())
+    {
+        LogW << path << ": archive already mounted" << std::endl;
+        return true;
+    }
+
+    //most recent first so newer archives take priority
+    archiveState.archives.insert(archiveState.archives.begin(), std::move(archive));
+    archiveState.hasArchives = true;
+
+    return true;
+}
+
+void FileSystem::unmountArchive(const std::string& path)
+{
+    std::scoped_lock l(archiveState.mutex);
+    archiveState.archives.erase(std::remove_if(archiveState.archives.begin(), archiveState.archives.end(),
+        [&path](const std::unique_ptr<Detail::AssetArchive>& a)
+        {
+            return a->getPath() == path;
+        }), archiveState.archives.end());
+
+    archiveState.hasArchives = !archiveState.archives.empty();
+}
+
+void FileSystem::setLooseFileOverride(bool enabled)
+{
+    archiveState.looseFileOverride = enabled;
+}
+
+SDL_RWops* FileSystem::openResource(const std::string& path)
+{
+    if (!archiveState.hasArchives)
+    {
+        return SDL_RWFromFile(path.c_str(), "rb");
+    }
+
+    const bool looseOverride = archiveState.looseFileOverride;
+    if (looseOverride)
+    {
+        auto* file = SDL_RWFromFile(path.c_str(), "rb");
+        if (file)
+        {
+            return file;
+        }
+    }
+
+    const auto archivePath = getArchivePath(path);
+    {
+        std::scoped_lock l(archiveState.mutex);
+        for (const auto& archive : archiveState.archives)
+        {
+            std::uint64_t size = 0;
+            const auto* data = archive->find(archivePath, size);
+            if (data)
+            {
+                return SDL_RWFromConstMem(data, static_cast<int>(size));
+            }
+        }
+    }
+
+    return looseOverride ? nullptr : SDL_RWFromFile(path.c_str(), "rb");
+}
+
+bool FileSystem::createArchive(const std::string& sourceDirectory, const std::string& outputPath)
+{
+    return Detail::AssetArchive::pack(sourceDirectory, outputPath);
+}
+
 bool FileSystem::showMessageBox(const std::string& title, const std::string& message, ButtonType buttonType, IconType iconType)
 {
     std::string button;
@@ -0,0 +1,513 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "AssetArchive.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    static_assert(sizeof(AssetArchive::Header) == 32, "");
+    static_assert(sizeof(AssetArchive::Entry) == 32, "");
+
+    //entries are opened with SDL_RWFromConstMem() which takes an int size
+    constexpr std::uint64_t MaxEntrySize = static_cast<std::uint64_t>(std::numeric_limits<std::int32_t>::max());
+
+    //returns an absolute path with any . or .. segments removed, so
+    //that different paths to the same file can be compared
+    std::string getAbsolutePath(std::string path)
+    {
+        std::replace(path.begin(), path.end(), '\\', '/');
+
+        const bool absolute = (!path.empty() && path[0] == '/')
+            || (path.size() > 1 && path[1] == ':');
+        if (!absolute)
+        {
+            path = FileSystem::getCurrentDirectory() + "/" + path;
+            std::replace(path.begin(), path.end(), '\\', '/');
+        }
+
+        //don't remove a windows drive letter
+        const std::size_t minSegments = (path.size() > 1 && path[1] == ':') ? 1 : 0;
+
+        std::vector<std::string> segments;
+        std::stringstream ss(path);
+        std::string segment;
+        while (std::getline(ss, segment, '/'))
+        {
+            if (segment == "..")
+            {
+                if (segments.size() > minSegments)
+                {
+                    segments.pop_back();
+                }
+            }
+            else if (!segment.empty()
+                && segment != ".")
+            {
+                segments.push_back(segment);
+            }
+        }
+
+        std::string retVal;
+#ifndef _WIN32
+        retVal = "/";
+#endif
+        for (const auto& s : segments)
+        {
+            retVal += s + "/";
+        }
+
+        if (retVal.size() > 1)
+        {
+            retVal.pop_back();
+        }
+
+#ifdef _WIN32
+        //windows paths are not case sensitive
+        std::transform(retVal.begin(), retVal.end(), retVal.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+#endif
+        return retVal;
+    }
+
+    void listFilesRecursive(const std::string& root, const std::string& subDir, std::vector<std::string>& output)
+    {
+        const auto path = root + subDir;
+        auto files = FileSystem::listFiles(path);
+        for (const auto& file : files)
+        {
+            output.push_back(subDir + file);
+        }
+
+        auto dirs = FileSystem::listDirectories(path);
+        for (const auto& dir : dirs)
+        {
+            listFilesRecursive(root, subDir + dir + "/", output);
+        }
+    }
+
+    template <typename T>
+    void write(std::ofstream& file, const T& data)
+    {
+        file.write(reinterpret_cast<const char*>(&data), sizeof(T));
+    }
+}
+
+AssetArchive::~AssetArchive()
+{
+    close();
+}
+
+//public
+bool AssetArchive::open(const std::string& path)
+{
+    close();
+
+#ifdef _WIN32
+    auto* file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LogE << "Failed opening archive " << path << std::endl;
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)
+        || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Header)))
+    {
+        LogE << path << ": invalid archive size" << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    auto* mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        LogE << "Failed mapping archive " << path << std::endl;
+        CloseHandle(file);
+        return false;
+    }
+
+    auto* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        LogE << "Failed mapping archive " << path << std::endl;
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = static_cast<std::uint64_t>(fileSize.QuadPart);
+#else
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        LogE << "Failed opening archive " << path << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == -1
+        || st.st_size < static_cast<off_t>(sizeof(Header)))
+    {
+        LogE << path << ": invalid archive size" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    auto* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        LogE << "Failed mapping archive " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    m_fileDescriptor = fd;
+    m_data = static_cast<const std::uint8_t*>(data);
+    m_size = static_cast<std::uint64_t>(st.st_size);
+#endif
+
+    m_path = path;
+
+    Header header;
+    std::memcpy(&header, m_data, sizeof(Header));
+
+    if (header.magic != Magic
+        || header.version != Version)
+    {
+        LogE << path << ": not a valid asset archive" << std::endl;
+        close();
+        return false;
+    }
+
+    const auto tocEnd = header.tocOffset + (static_cast<std::uint64_t>(header.entryCount) * sizeof(Entry));
+    if (tocEnd > m_size
+        || header.stringOffset > m_size
+        || (header.tocOffset % alignof(Entry)) != 0)
+    {
+        LogE << path << ": archive index is corrupt" << std::endl;
+        close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const Entry*>(m_data + header.tocOffset);
+    m_entryCount = header.entryCount;
+    m_strings = reinterpret_cast<const char*>(m_data + header.stringOffset);
+
+    for (auto i = 0u; i < m_entryCount; ++i)
+    {
+        const auto& entry = m_entries[i];
+        if (entry.offset + entry.size > m_size
+            || header.stringOffset + entry.nameOffset + entry.nameLength > m_size)
+        {
+            LogE << path << ": archive entry " << i << " is out of bounds" << std::endl;
+            close();
+            return false;
+        }
+
+        if (entry.size > MaxEntrySize)
+        {
+            LogE << path << ": archive entry " << i << " is larger than 2GB" << std::endl;
+            close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AssetArchive::close()
+{
+    if (m_data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mappingHandle);
+        CloseHandle(m_fileHandle);
+        m_mappingHandle = nullptr;
+        m_fileHandle = nullptr;
+#else
+        munmap(const_cast<std::uint8_t*>(m_data), m_size);
+        ::close(m_fileDescriptor);
+        m_fileDescriptor = -1;
+#endif
+    }
+
+    m_data = nullptr;
+    m_size = 0;
+    m_entries = nullptr;
+    m_entryCount = 0;
+    m_strings = nullptr;
+    m_path.clear();
+}
+
+const std::uint8_t* AssetArchive::find(const std::string& path, std::uint64_t& size) const
+{
+    const auto* entry = findEntry(normalisePath(path));
+    if (entry)
+    {
+        size = entry->size;
+        return m_data + entry->offset;
+    }
+    size = 0;
+    return nullptr;
+}
+
+bool AssetArchive::contains(const std::string& path) const
+{
+    return findEntry(normalisePath(path)) != nullptr;
+}
+
+std::string AssetArchive::normalisePath(const std::string& path)
+{
+    std::string retVal(path);
+    std::replace(retVal.begin(), retVal.end(), '\\', '/');
+
+    while (retVal.size() > 1
+        && retVal[0] == '.' && retVal[1] == '/')
+    {
+        retVal = retVal.substr(2);
+    }
+
+    return retVal;
+}
+
+std::uint64_t AssetArchive::hashPath(const std::string& path)
+{
+    //FNV-1a
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto c : path)
+    {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+
+bool AssetArchive::pack(const std::string& sourceDirectory, const std::string& outputPath)
+{
+    auto root = normalisePath(sourceDirectory);
+    if (!root.empty() && root.back() != '/')
+    {
+        root.push_back('/');
+    }
+
+    if (!FileSystem::directoryExists(root))
+    {
+        LogE << "Cannot pack " << sourceDirectory << ": directory not found" << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> files;
+    listFilesRecursive(root, "", files);
+
+    //don't try to pack the output into itself
+    const auto output = getAbsolutePath(outputPath);
+    const auto absoluteRoot = getAbsolutePath(root);
+    files.erase(std::remove_if(files.begin(), files.end(), 
+        [&](const std::string& f)
+        {
+            return getAbsolutePath(absoluteRoot + "/" + f) == output;
+        }), files.end());
+
+    if (files.empty())
+    {
+        LogW << "No files found in " << sourceDirectory << ", no archive was created" << std::endl;
+        return false;
+    }
+
+    struct Source final
+    {
+        std::string name;
+        Entry entry;
+    };
+    std::vector<Source> sources;
+    sources.reserve(files.size());
+
+    std::uint32_t stringSize = 0;
+    for (const auto& file : files)
+    {
+        auto& source = sources.emplace_back();
+        source.name = file;
+        source.entry.hash = hashPath(file);
+        source.entry.nameOffset = stringSize;
+        source.entry.nameLength = static_cast<std::uint32_t>(file.size());
+        stringSize += source.entry.nameLength;
+    }
+
+    std::sort(sources.begin(), sources.end(),
+        [](const Source& a, const Source& b)
+        {
+            return a.entry.hash < b.entry.hash;
+        });
+
+    Header header;
+    header.entryCount = static_cast<std::uint32_t>(sources.size());
+    header.tocOffset = sizeof(Header);
+    header.stringOffset = header.tocOffset + (sources.size() * sizeof(Entry));
+
+    const auto align = [](std::uint64_t v)
+    {
+        return (v + (DataAlignment - 1)) & ~(DataAlignment - 1);
+    };
+
+    //read the file sizes first so the index can be written in one go
+    std::uint64_t dataOffset = align(header.stringOffset + stringSize);
+    for (auto& source : sources)
+    {
+        std::ifstream file(root + source.name, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+        {
+            LogE << "Failed opening " << root << source.name << " for packing" << std::endl;
+            return false;
+        }
+        source.entry.size = static_cast<std::uint64_t>(file.tellg());
+        if (source.entry.size > MaxEntrySize)
+        {
+            LogE << "Cannot pack " << root << source.name << ": files must be smaller than 2GB" << std::endl;
+            return false;
+        }
+        source.entry.offset = dataOffset;
+        dataOffset = align(dataOffset + source.entry.size);
+    }
+
+    std::ofstream outFile(outputPath, std::ios::binary);
+    if (!outFile.is_open())
+    {
+        LogE << "Failed opening " << outputPath << " for writing" << std::endl;
+        return false;
+    }
+
+    write(outFile, header);
+    for (const auto& source : sources)
+    {
+        write(outFile, source.entry);
+    }
+
+    //string offsets were assigned in directory order so write them in the same order
+    std::vector<const Source*> nameOrder(sources.size());
+    std::transform(sources.begin(), sources.end(), nameOrder.begin(), [](const Source& s) { return &s; });
+    std::sort(nameOrder.begin(), nameOrder.end(), 
+        [](const Source* a, const Source* b)
+        {
+            return a->entry.nameOffset < b->entry.nameOffset;
+        });
+
+    for (const auto* source : nameOrder)
+    {
+        outFile.write(source->name.data(), source->name.size());
+    }
+
+    std::vector<char> buffer;
+    const auto pad = [&outFile](std::uint64_t target)
+    {
+        static const char zero[DataAlignment] = {};
+        const auto current = static_cast<std::uint64_t>(outFile.tellp());
+        if (target > current)
+        {
+            outFile.write(zero, target - current);
+        }
+    };
+
+    for (const auto& source : sources)
+    {
+        pad(source.entry.offset);
+
+        std::ifstream file(root + source.name, std::ios::binary);
+        buffer.resize(source.entry.size);
+        file.read(buffer.data(), buffer.size());
+        outFile.write(buffer.data(), buffer.size());
+    }
+
+    if (!outFile.good())
+    {
+        LogE << "Failed writing archive " << outputPath << std::endl;
+        return false;
+    }
+
+    LogI << "Packed " << sources.size() << " files into " << outputPath << std::endl;
+    return true;
+}
+
+//private
+const AssetArchive::Entry* AssetArchive::findEntry(const std::string& path) const
+{
+    if (!m_entries)
+    {
+        return nullptr;
+    }
+
+    const auto hash = hashPath(path);
+    const auto* end = m_entries + m_entryCount;
+    auto* result = std::lower_bound(m_entries, end, hash,
+        [](const Entry& e, std::uint64_t h)
+        {
+            return e.hash < h;
+        });
+
+    //compare the names in case of collision
+    for (; result != end && result->hash == hash; ++result)
+    {
+        if (result->nameLength == path.size()
+            && std::memcmp(m_strings + result->nameOffset, path.data(), path.size()) == 0)
+        {
+            return result;
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,127 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/Config.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cro::Detail
+{
+    /*
+    Packed asset archives store a table of contents sorted by the
+    hash of each entry's normalised path, followed by the names and
+    the uncompressed file data. The archive is memory mapped when it
+    is opened so reading an entry is just a pointer into the mapping.
+
+    Layout:
+    Header
+    Entry[entryCount] (sorted by hash)
+    name strings (not null terminated)
+    file data (each entry aligned to DataAlignment)
+    */
+    class AssetArchive final
+    {
+    public:
+        static constexpr std::uint32_t Magic = 0x4B415043; //'CPAK'
+        static constexpr std::uint32_t Version = 1;
+        static constexpr std::uint64_t DataAlignment = 16;
+
+        struct Header final
+        {
+            std::uint32_t magic = Magic;
+            std::uint32_t version = Version;
+            std::uint32_t entryCount = 0;
+            std::uint32_t padding = 0;
+            std::uint64_t tocOffset = 0;
+            std::uint64_t stringOffset = 0;
+        };
+
+        struct Entry final
+        {
+            std::uint64_t hash = 0;
+            std::uint64_t offset = 0;
+            std::uint64_t size = 0;
+            std::uint32_t nameOffset = 0;
+            std::uint32_t nameLength = 0;
+        };
+
+        AssetArchive() = default;
+        ~AssetArchive();
+
+        AssetArchive(const AssetArchive&) = delete;
+        AssetArchive(AssetArchive&&) = delete;
+        AssetArchive& operator = (const AssetArchive&) = delete;
+        AssetArchive& operator = (AssetArchive&&) = delete;
+
+        //maps the archive at the given path and validates the index
+        bool open(const std::string& path);
+
+        void close();
+
+        //returns a pointer into the mapped data for the given entry
+        //and sets size, or nullptr if the entry doesn't exist
+        const std::uint8_t* find(const std::string& path, std::uint64_t& size) const;
+
+        bool contains(const std::string& path) const;
+
+        const std::string& getPath() const { return m_path; }
+
+        //converts backslashes to forward slashes and removes any ./ prefix
+        static std::string normalisePath(const std::string& path);
+
+        static std::uint64_t hashPath(const std::string& normalisedPath);
+
+        //packs all the files found recursively in sourceDirectory into an
+        //archive at outputPath. Entry names are relative to sourceDirectory
+        static bool pack(const std::string& sourceDirectory, const std::string& outputPath);
+
+    private:
+        std::string m_path;
+
+        const std::uint8_t* m_data = nullptr;
+        std::uint64_t m_size = 0;
+        const Entry* m_entries = nullptr;
+        std::uint32_t m_entryCount = 0;
+        const char* m_strings = nullptr;
+
+#ifdef _WIN32
+        void* m_fileHandle = nullptr;
+        void* m_mappingHandle = nullptr;
+#else
+        std::int32_t m_fileDescriptor = -1;
+#endif
+
+        const Entry* findEntry(const std::string& normalisedPath) const;
+    };
+}
@@ -0,0 +1,202 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "AsyncLoader.hpp"
+
+#include <crogine/core/HiResTimer.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr std::size_t MaxWorkerThreads = 4;
+
+    struct LoaderState final
+    {
+        std::vector<std::unique_ptr<std::thread>> workerThreads;
+        std::atomic_bool threadsRunning = false;
+
+        std::mutex jobMutex;
+        std::condition_variable jobCondition;
+        std::deque<std::function<void()>> jobs;
+        std::size_t activeJobs = 0;
+
+        std::mutex uploadMutex;
+        std::deque<std::function<void()>> uploads;
+    }state;
+
+    void threadFunc()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock(state.jobMutex);
+                state.jobCondition.wait(lock, []() {return !state.jobs.empty() || !state.threadsRunning; });
+
+                //pending jobs are finished before quitting so
+                //that any waiting on their results are completed
+                if (state.jobs.empty())
+                {
+                    break;
+                }
+
+                job = std::move(state.jobs.front());
+                state.jobs.pop_front();
+                state.activeJobs++;
+            }
+
+            job();
+
+            std::scoped_lock lock(state.jobMutex);
+            state.activeJobs--;
+        }
+    }
+}
+
+void AsyncLoader::queueJob(std::function<void()> job)
+{
+    CRO_ASSERT(job, "");
+
+    {
+        std::scoped_lock lock(state.jobMutex);
+
+        //threads are started on demand so there's no
+        //overhead for applications which don't load async
+        if (state.workerThreads.empty())
+        {
+            const auto threadCount = std::clamp(static_cast<std::size_t>(std::thread::hardware_concurrency()) - 1, std::size_t(1), MaxWorkerThreads);
+
+            state.threadsRunning = true;
+            for (auto i = 0u; i < threadCount; ++i)
+            {
+                state.workerThreads.emplace_back(std::make_unique<std::thread>(&threadFunc));
+            }
+        }
+
+        state.jobs.push_back(std::move(job));
+    }
+    state.jobCondition.notify_one();
+}
+
+void AsyncLoader::queueUpload(std::function<void()> upload)
+{
+    CRO_ASSERT(upload, "");
+
+    std::scoped_lock lock(state.uploadMutex);
+    state.uploads.push_back(std::move(upload));
+}
+
+void AsyncLoader::processUploads(float budget)
+{
+    HiResTimer timer;
+    float elapsed = 0.f;
+    budget /= 1000.f;
+
+    do
+    {
+        std::function<void()> upload;
+        {
+            std::scoped_lock lock(state.uploadMutex);
+            if (state.uploads.empty())
+            {
+                return;
+            }
+            upload = std::move(state.uploads.front());
+            state.uploads.pop_front();
+        }
+
+        //uploads may queue further uploads, so don't hold the lock
+        upload();
+        elapsed += timer.restart();
+
+    } while (elapsed < budget);
+}
+
+std::size_t AsyncLoader::getPendingCount()
+{
+    std::size_t count = 0;
+    {
+        std::scoped_lock lock(state.jobMutex);
+        count += state.jobs.size() + state.activeJobs;
+    }
+
+    std::scoped_lock lock(state.uploadMutex);
+    return count + state.uploads.size();
+}
+
+void AsyncLoader::shutdown()
+{
+    //workers finish any queued jobs before they exit
+    {
+        std::scoped_lock lock(state.jobMutex);
+        state.threadsRunning = false;
+    }
+    state.jobCondition.notify_all();
+
+    std::vector<std::unique_ptr<std::thread>> threads;
+    {
+        std::scoped_lock lock(state.jobMutex);
+        threads.swap(state.workerThreads);
+    }
+
+    for (auto& thread : threads)
+    {
+        thread->join();
+    }
+
+    //then run the remaining uploads, including any queued by those
+    //jobs, so that nothing is left waiting on a broken promise
+    while (true)
+    {
+        std::function<void()> upload;
+        {
+            std::scoped_lock lock(state.uploadMutex);
+            if (state.uploads.empty())
+            {
+                break;
+            }
+            upload = std::move(state.uploads.front());
+            state.uploads.pop_front();
+        }
+        upload();
+    }
+}
@@ -0,0 +1,63 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <functional>
+
+namespace cro::Detail
+{
+    /*
+    Runs resource decoding jobs on a small pool of worker threads.
+    Jobs which need to create GL or AL objects queue an upload which
+    is run on the main thread by the App, each frame, until the upload
+    budget is used. At least one upload is always processed per frame
+    so that large uploads can't stall the queue.
+    */
+    class AsyncLoader final
+    {
+    public:
+        //queues a job to be run on a worker thread
+        static void queueJob(std::function<void()>);
+
+        //queues a job to be run on the main thread - may be called from any thread
+        static void queueUpload(std::function<void()>);
+
+        //runs queued uploads until the budget, in milliseconds, is used.
+        static void processUploads(float budget);
+
+        //returns the number of jobs and uploads which have yet to complete
+        static std::size_t getPendingCount();
+
+        //completes any pending jobs and uploads then stops the worker threads.
+        //this must be called from the main thread while the GL context is valid
+        static void shutdown();
+    };
+}
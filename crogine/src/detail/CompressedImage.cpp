@@ -0,0 +1,570 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "CompressedImage.hpp"
+#include "GLCheck.hpp"
+
+#include <crogine/core/FileSystem.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <SDL_rwops.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+
+//S3TC is an extension rather than core so isn't in our loader
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RED_RGTC1
+#define GL_COMPRESSED_RED_RGTC1 0x8DBB
+#define GL_COMPRESSED_RG_RGTC2 0x8DBD
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#define GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2 0x9276
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    constexpr std::uint32_t DDSMagic = makeFourCC('D', 'D', 'S', ' ');
+    constexpr std::uint32_t DDSFourCCFlag = 0x4;
+
+    //DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_LINEARSIZE
+    constexpr std::uint32_t DDSRequiredFlags = 0x1 | 0x2 | 0x4 | 0x1000 | 0x80000;
+    constexpr std::uint32_t DDSMipMapCountFlag = 0x20000;
+    constexpr std::uint32_t DDSCapsTexture = 0x1000;
+    constexpr std::uint32_t DDSCapsMipMap = 0x400000 | 0x8; //DDSCAPS_MIPMAP | DDSCAPS_COMPLEX
+
+    struct DDSHeader final
+    {
+        std::uint32_t size = 0;
+        std::uint32_t flags = 0;
+        std::uint32_t height = 0;
+        std::uint32_t width = 0;
+        std::uint32_t pitchOrLinearSize = 0;
+        std::uint32_t depth = 0;
+        std::uint32_t mipMapCount = 0;
+        std::uint32_t reserved1[11] = {};
+        struct
+        {
+            std::uint32_t size = 0;
+            std::uint32_t flags = 0;
+            std::uint32_t fourCC = 0;
+            std::uint32_t rgbBitCount = 0;
+            std::uint32_t masks[4] = {};
+        }pixelFormat;
+        std::uint32_t caps[4] = {};
+        std::uint32_t reserved2 = 0;
+    };
+    static_assert(sizeof(DDSHeader) == 124, "Incorrect DDS header size");
+
+    struct DDSHeaderDX10 final
+    {
+        std::uint32_t dxgiFormat = 0;
+        std::uint32_t resourceDimension = 0;
+        std::uint32_t miscFlag = 0;
+        std::uint32_t arraySize = 0;
+        std::uint32_t miscFlags2 = 0;
+    };
+
+    constexpr std::array<std::uint8_t, 12u> KTX2Identifier =
+    {
+        0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+    };
+
+    struct KTX2Header final
+    {
+        std::uint8_t identifier[12] = {};
+        std::uint32_t vkFormat = 0;
+        std::uint32_t typeSize = 0;
+        std::uint32_t pixelWidth = 0;
+        std::uint32_t pixelHeight = 0;
+        std::uint32_t pixelDepth = 0;
+        std::uint32_t layerCount = 0;
+        std::uint32_t faceCount = 0;
+        std::uint32_t levelCount = 0;
+        std::uint32_t supercompressionScheme = 0;
+        std::uint32_t dfdByteOffset = 0;
+        std::uint32_t dfdByteLength = 0;
+        std::uint32_t kvdByteOffset = 0;
+        std::uint32_t kvdByteLength = 0;
+        std::uint64_t sgdByteOffset = 0;
+        std::uint64_t sgdByteLength = 0;
+    };
+    static_assert(sizeof(KTX2Header) == 80, "Incorrect KTX2 header size");
+
+    struct KTX2Level final
+    {
+        std::uint64_t byteOffset = 0;
+        std::uint64_t byteLength = 0;
+        std::uint64_t uncompressedByteLength = 0;
+    };
+
+    //all colour textures are sampled as linear data by crogine (as are
+    //those loaded from png/jpg) so sRGB variants map to their UNORM
+    //equivalents to keep compressed and uncompressed textures consistent
+    std::uint32_t formatFromFourCC(std::uint32_t fourCC, ImageFormat::Type& format)
+    {
+        switch (fourCC)
+        {
+        default: return 0;
+        case makeFourCC('D', 'X', 'T', '1'):
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case makeFourCC('D', 'X', 'T', '3'):
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case makeFourCC('D', 'X', 'T', '5'):
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case makeFourCC('A', 'T', 'I', '1'):
+        case makeFourCC('B', 'C', '4', 'U'):
+            format = ImageFormat::A;
+            return GL_COMPRESSED_RED_RGTC1;
+        case makeFourCC('A', 'T', 'I', '2'):
+        case makeFourCC('B', 'C', '5', 'U'):
+            format = ImageFormat::RGB;
+            return GL_COMPRESSED_RG_RGTC2;
+        }
+    }
+
+    std::uint32_t formatFromDXGI(std::uint32_t dxgi, ImageFormat::Type& format)
+    {
+        switch (dxgi)
+        {
+        default: return 0;
+        case 71: //BC1_UNORM
+        case 72: //BC1_UNORM_SRGB
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case 74: //BC2
+        case 75:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case 77: //BC3
+        case 78:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case 80: //BC4_UNORM
+            format = ImageFormat::A;
+            return GL_COMPRESSED_RED_RGTC1;
+        case 83: //BC5_UNORM
+            format = ImageFormat::RGB;
+            return GL_COMPRESSED_RG_RGTC2;
+        case 98: //BC7_UNORM
+        case 99: //BC7_UNORM_SRGB
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        }
+    }
+
+    std::uint32_t formatFromVulkan(std::uint32_t vkFormat, ImageFormat::Type& format)
+    {
+        switch (vkFormat)
+        {
+        default: return 0;
+        case 131: //VK_FORMAT_BC1_RGB_UNORM_BLOCK
+        case 132: //VK_FORMAT_BC1_RGB_SRGB_BLOCK
+            format = ImageFormat::RGB;
+            return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        case 133: //VK_FORMAT_BC1_RGBA_UNORM_BLOCK
+        case 134:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case 135: //VK_FORMAT_BC2_UNORM_BLOCK
+        case 136:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+        case 137: //VK_FORMAT_BC3_UNORM_BLOCK
+        case 138:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case 139: //VK_FORMAT_BC4_UNORM_BLOCK
+            format = ImageFormat::A;
+            return GL_COMPRESSED_RED_RGTC1;
+        case 141: //VK_FORMAT_BC5_UNORM_BLOCK
+            format = ImageFormat::RGB;
+            return GL_COMPRESSED_RG_RGTC2;
+        case 145: //VK_FORMAT_BC7_UNORM_BLOCK
+        case 146:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case 147: //VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+        case 148:
+            format = ImageFormat::RGB;
+            return GL_COMPRESSED_RGB8_ETC2;
+        case 149: //VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK
+        case 150:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2;
+        case 151: //VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+        case 152:
+            format = ImageFormat::RGBA;
+            return GL_COMPRESSED_RGBA8_ETC2_EAC;
+        }
+    }
+
+    std::size_t getBlockSize(std::uint32_t glFormat)
+    {
+        switch (glFormat)
+        {
+        default: return 16;
+        case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+        case GL_COMPRESSED_RED_RGTC1:
+        case GL_COMPRESSED_RGB8_ETC2:
+        case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            return 8;
+        }
+    }
+
+    std::size_t getLevelSize(std::uint32_t glFormat, std::uint32_t width, std::uint32_t height)
+    {
+        return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(glFormat);
+    }
+
+    bool parseDDS(std::vector<std::uint8_t>& fileData, CompressedImageData& dst)
+    {
+        if (fileData.size() < sizeof(DDSMagic) + sizeof(DDSHeader))
+        {
+            LogE << "DDS file too small" << std::endl;
+            return false;
+        }
+
+        DDSHeader header;
+        std::memcpy(&header, fileData.data() + sizeof(DDSMagic), sizeof(header));
+        std::size_t offset = sizeof(DDSMagic) + sizeof(DDSHeader);
+
+        if (header.size != sizeof(DDSHeader)
+            || (header.pixelFormat.flags & DDSFourCCFlag) == 0)
+        {
+            LogE << "DDS file is not block compressed" << std::endl;
+            return false;
+        }
+
+        if (header.pixelFormat.fourCC == makeFourCC('D', 'X', '1', '0'))
+        {
+            DDSHeaderDX10 dx10;
+            if (fileData.size() < offset + sizeof(dx10))
+            {
+                LogE << "DDS file missing DX10 header" << std::endl;
+                return false;
+            }
+            std::memcpy(&dx10, fileData.data() + offset, sizeof(dx10));
+            offset += sizeof(dx10);
+
+            if (dx10.arraySize > 1)
+            {
+                LogE << "DDS texture arrays are not supported" << std::endl;
+                return false;
+            }
+            dst.glFormat = formatFromDXGI(dx10.dxgiFormat, dst.format);
+        }
+        else
+        {
+            dst.glFormat = formatFromFourCC(header.pixelFormat.fourCC, dst.format);
+        }
+
+        if (dst.glFormat == 0)
+        {
+            LogE << "Unsupported DDS pixel format" << std::endl;
+            return false;
+        }
+
+        //cubemaps and volumes are stored after the first face so
+        //we'll just read the first face and ignore anything else
+        auto width = header.width;
+        auto height = header.height;
+        const auto levelCount = std::max(1u, header.mipMapCount);
+        for (auto i = 0u; i < levelCount; ++i)
+        {
+            auto& level = dst.levels.emplace_back();
+            level.offset = offset;
+            level.size = getLevelSize(dst.glFormat, width, height);
+            level.width = width;
+            level.height = height;
+
+            offset += level.size;
+            width = std::max(1u, width / 2);
+            height = std::max(1u, height / 2);
+        }
+
+        if (offset > fileData.size())
+        {
+            LogE << "DDS file is truncated" << std::endl;
+            return false;
+        }
+
+        dst.data.swap(fileData);
+        return true;
+    }
+
+    bool parseKTX2(std::vector<std::uint8_t>& fileData, CompressedImageData& dst)
+    {
+        if (fileData.size() < sizeof(KTX2Header))
+        {
+            LogE << "KTX2 file too small" << std::endl;
+            return false;
+        }
+
+        KTX2Header header;
+        std::memcpy(&header, fileData.data(), sizeof(header));
+
+        if (header.supercompressionScheme != 0)
+        {
+            LogE << "Supercompressed KTX2 files are not supported" << std::endl;
+            return false;
+        }
+
+        if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1)
+        {
+            LogE << "KTX2 file must contain a single 2D texture" << std::endl;
+            return false;
+        }
+
+        dst.glFormat = formatFromVulkan(header.vkFormat, dst.format);
+        if (dst.glFormat == 0)
+        {
+            LogE << "Unsupported KTX2 format: " << header.vkFormat << std::endl;
+            return false;
+        }
+
+        const auto levelCount = std::max(1u, header.levelCount);
+        if (fileData.size() < sizeof(KTX2Header) + (sizeof(KTX2Level) * levelCount))
+        {
+            LogE << "KTX2 level index is truncated" << std::endl;
+            return false;
+        }
+
+        auto width = header.pixelWidth;
+        auto height = header.pixelHeight;
+        for (auto i = 0u; i < levelCount; ++i)
+        {
+            KTX2Level levelIndex;
+            std::memcpy(&levelIndex, fileData.data() + sizeof(KTX2Header) + (sizeof(KTX2Level) * i), sizeof(KTX2Level));
+
+            if (levelIndex.byteOffset + levelIndex.byteLength > fileData.size()
+                || levelIndex.byteLength < getLevelSize(dst.glFormat, width, height))
+            {
+                LogE << "KTX2 file is truncated" << std::endl;
+                return false;
+            }
+
+            auto& level = dst.levels.emplace_back();
+            level.offset = static_cast<std::size_t>(levelIndex.byteOffset);
+            level.size = getLevelSize(dst.glFormat, width, height);
+            level.width = width;
+            level.height = height;
+
+            width = std::max(1u, width / 2);
+            height = std::max(1u, height / 2);
+        }
+
+        dst.data.swap(fileData);
+        return true;
+    }
+}
+
+bool Detail::isCompressedImagePath(const std::string& path)
+{
+    auto ext = FileSystem::getFileExtension(path);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) {return static_cast<char>(std::tolower(c)); });
+    return ext == ".dds" || ext == ".ktx2";
+}
+
+bool Detail::loadCompressedImage(const std::string& path, CompressedImageData& dst)
+{
+    dst = {};
+
+    RaiiRWops file;
+    file.file = FileSystem::openResource(path);
+    if (!file.file)
+    {
+        LogE << "Failed opening " << path << std::endl;
+        return false;
+    }
+
+    auto size = SDL_RWsize(file.file);
+    if (size < 4)
+    {
+        LogE << path << ": invalid file size" << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> fileData(static_cast<std::size_t>(size));
+    if (SDL_RWread(file.file, fileData.data(), fileData.size(), 1) != 1)
+    {
+        LogE << "Failed reading " << path << std::endl;
+        return false;
+    }
+
+    bool result = false;
+    std::uint32_t magic = 0;
+    std::memcpy(&magic, fileData.data(), sizeof(magic));
+    if (magic == DDSMagic)
+    {
+        result = parseDDS(fileData, dst);
+    }
+    else if (fileData.size() >= KTX2Identifier.size()
+        && std::memcmp(fileData.data(), KTX2Identifier.data(), KTX2Identifier.size()) == 0)
+    {
+        result = parseKTX2(fileData, dst);
+    }
+    else
+    {
+        LogE << path << ": not a DDS or KTX2 file" << std::endl;
+    }
+
+    if (!result)
+    {
+        LogE << "Failed loading " << path << std::endl;
+        dst = {};
+    }
+    return result;
+}
+
+bool Detail::writeDDS(const std::string& path, std::uint32_t fourCC, std::uint32_t width, std::uint32_t height,
+    const std::vector<std::vector<std::uint8_t>>& levels)
+{
+    CRO_ASSERT(!levels.empty(), "No image data");
+
+    DDSHeader header;
+    header.size = sizeof(DDSHeader);
+    header.flags = DDSRequiredFlags;
+    header.width = width;
+    header.height = height;
+    header.pitchOrLinearSize = static_cast<std::uint32_t>(levels[0].size());
+    header.pixelFormat.size = sizeof(header.pixelFormat);
+    header.pixelFormat.flags = DDSFourCCFlag;
+    header.pixelFormat.fourCC = fourCC;
+    header.caps[0] = DDSCapsTexture;
+
+    if (levels.size() > 1)
+    {
+        header.flags |= DDSMipMapCountFlag;
+        header.mipMapCount = static_cast<std::uint32_t>(levels.size());
+        header.caps[0] |= DDSCapsMipMap;
+    }
+
+    RaiiRWops file;
+    file.file = SDL_RWFromFile(path.c_str(), "wb");
+    if (!file.file)
+    {
+        LogE << "Failed opening " << path << " for writing" << std::endl;
+        return false;
+    }
+
+    bool result = SDL_RWwrite(file.file, &DDSMagic, sizeof(DDSMagic), 1) == 1
+        && SDL_RWwrite(file.file, &header, sizeof(header), 1) == 1;
+
+    for (const auto& level : levels)
+    {
+        result = result && SDL_RWwrite(file.file, level.data(), level.size(), 1) == 1;
+    }
+
+    if (!result)
+    {
+        LogE << "Failed writing " << path << std::endl;
+    }
+    return result;
+}
+
+bool Detail::isCompressedFormatSupported(std::uint32_t glFormat)
+{
+    static std::once_flag queryFlag;
+    static std::vector<GLint> supportedFormats;
+    static GLint glVersion = 0;
+
+    std::call_once(queryFlag, []()
+        {
+            GLint count = 0;
+            glCheck(glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count));
+            if (count > 0)
+            {
+                supportedFormats.resize(count);
+                glCheck(glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, supportedFormats.data()));
+            }
+
+            GLint major = 0;
+            GLint minor = 0;
+            glCheck(glGetIntegerv(GL_MAJOR_VERSION, &major));
+            glCheck(glGetIntegerv(GL_MINOR_VERSION, &minor));
+            glVersion = (major * 10) + minor;
+        });
+
+    if (std::find(supportedFormats.begin(), supportedFormats.end(), static_cast<GLint>(glFormat)) != supportedFormats.end())
+    {
+        return true;
+    }
+
+    //drivers aren't required to list formats which aren't 'general purpose'
+    //in GL_COMPRESSED_TEXTURE_FORMATS so fall back to the core version
+#ifdef PLATFORM_DESKTOP
+    switch (glFormat)
+    {
+    default: return false;
+    case GL_COMPRESSED_RED_RGTC1:
+    case GL_COMPRESSED_RG_RGTC2:
+        return glVersion >= 30;
+    case GL_COMPRESSED_RGBA_BPTC_UNORM:
+        return glVersion >= 42;
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        return glVersion >= 43;
+    }
+#else
+    switch (glFormat)
+    {
+    default: return false;
+    case GL_COMPRESSED_RGB8_ETC2:
+    case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+    case GL_COMPRESSED_RGBA8_ETC2_EAC:
+        return glVersion >= 30;
+    }
+#endif
+}
@@ -0,0 +1,82 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/detail/Types.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cro::Detail
+{
+    //block compressed image data read from a .dds or .ktx2
+    //container, ready to be uploaded with glCompressedTexImage2D.
+    //Parsing happens without a GL context so it is safe to call
+    //from the async loader's worker thread.
+    struct CompressedImageData final
+    {
+        struct Level final
+        {
+            std::size_t offset = 0;
+            std::size_t size = 0;
+            std::uint32_t width = 0;
+            std::uint32_t height = 0;
+        };
+
+        std::uint32_t glFormat = 0;
+        ImageFormat::Type format = ImageFormat::None; //closest uncompressed equivalent
+        std::vector<Level> levels;
+        std::vector<std::uint8_t> data;
+    };
+
+    constexpr std::uint32_t makeFourCC(char a, char b, char c, char d)
+    {
+        return static_cast<std::uint32_t>(a)
+            | (static_cast<std::uint32_t>(b) << 8)
+            | (static_cast<std::uint32_t>(c) << 16)
+            | (static_cast<std::uint32_t>(d) << 24);
+    }
+
+    //returns true if the file extension is one of the supported containers
+    bool isCompressedImagePath(const std::string& path);
+
+    //reads the given file via FileSystem::openResource() and parses it
+    bool loadCompressedImage(const std::string& path, CompressedImageData& dst);
+
+    //writes a legacy (non-DX10) DDS file with the given FourCC code.
+    //Levels are expected largest first, each one half the size of the last
+    bool writeDDS(const std::string& path, std::uint32_t fourCC, std::uint32_t width, std::uint32_t height,
+        const std::vector<std::vector<std::uint8_t>>& levels);
+
+    //requires a valid GL context. Results are cached after the first query
+    bool isCompressedFormatSupported(std::uint32_t glFormat);
+}
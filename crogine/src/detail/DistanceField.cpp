@@ -29,6 +29,8 @@ source distribution.
 
 #include "DistanceField.hpp"
 
+#include <crogine/detail/Assert.hpp>
+
 #include <cmath>
 #include <climits>
 #include <cstring>
@@ -66,6 +68,54 @@ std::vector<std::uint8_t> DistanceField::toDF(const SDL_Surface* input)
     return toBytes(floatData);
 }
 
+std::vector<std::uint8_t> DistanceField::toSignedDF(const std::vector<std::uint8_t>& coverage, std::int32_t width, std::int32_t height, float spread)
+{
+    CRO_ASSERT(coverage.size() == static_cast<std::size_t>(width * height), "");
+    CRO_ASSERT(spread > 0, "");
+
+    std::vector<std::uint8_t> retVal(coverage.size());
+
+    //distance to the nearest pixel inside the shape, and the nearest pixel outside
+    std::vector<float> outside(coverage.size());
+    std::vector<float> inside(coverage.size());
+    std::size_t insideCount = 0;
+    for (auto i = 0u; i < coverage.size(); ++i)
+    {
+        if (coverage[i] > 127)
+        {
+            outside[i] = 0.f;
+            inside[i] = INF;
+            insideCount++;
+        }
+        else
+        {
+            outside[i] = INF;
+            inside[i] = 0.f;
+        }
+    }
+
+    //the transform is undefined if there are no seed pixels
+    if (insideCount == 0
+        || insideCount == coverage.size())
+    {
+        std::memset(retVal.data(), insideCount == 0 ? 0 : 255, retVal.size());
+        return retVal;
+    }
+
+    twoD(outside, width, height);
+    twoD(inside, width, height);
+
+    for (auto i = 0u; i < retVal.size(); ++i)
+    {
+        //offset by half a pixel so the edge lies between pixels
+        float dist = (inside[i] != 0) ? std::sqrt(inside[i]) - 0.5f : 0.5f - std::sqrt(outside[i]);
+        float value = std::clamp(0.5f + (dist / (spread * 2.f)), 0.f, 1.f);
+        retVal[i] = static_cast<std::uint8_t>(value * 255.f);
+    }
+
+    return retVal;
+}
+
 //private
 void DistanceField::twoD(std::vector<float>& floatData, std::int32_t width, std::int32_t height)
 {
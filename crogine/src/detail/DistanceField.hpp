@@ -46,6 +46,14 @@ namespace cro
         public:
             static std::vector<std::uint8_t> toDF(const SDL_Surface* input);
 
+            /*
+            Creates a signed distance field from an 8 bit coverage buffer, such
+            as a rasterised glyph. Edges lie at a value of 127, with values
+            increasing inside the shape. spread is the distance in pixels
+            which maps to the full 0 - 255 range either side of the edge.
+            */
+            static std::vector<std::uint8_t> toSignedDF(const std::vector<std::uint8_t>& coverage, std::int32_t width, std::int32_t height, float spread);
+
         private:
             static void twoD(std::vector<float>&, std::int32_t, std::int32_t);
             static std::vector<float> oneD(const std::vector<float>&, std::size_t);
@@ -0,0 +1,63 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/graphics/MeshData.hpp>
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+namespace cro::Detail
+{
+    /*
+    Mesh builders can't create GL buffers on a worker thread, so
+    when a mesh is built asynchronously the buffer data is recorded
+    in a MeshUpload and the buffers created later on the main thread.
+    */
+    struct MeshUpload final
+    {
+        std::vector<std::uint8_t> vertexData;
+        std::array<std::vector<std::uint8_t>, Mesh::IndexData::MaxBuffers> indexData;
+
+        //set on a worker thread for the duration of MeshBuilder::build()
+        static thread_local MeshUpload* active;
+
+        //creates the recorded buffers - must be called on the main thread
+        void createBuffers(Mesh::Data&) const;
+    };
+
+    //creates a VBO for the mesh data, or records the data if a MeshUpload is active
+    void createVertexBuffer(Mesh::Data&, const void* data, std::size_t size);
+
+    //creates an IBO at the given index, or records the data if a MeshUpload is active
+    void createIndexBuffer(Mesh::Data&, std::size_t index, const void* data, std::size_t size);
+}
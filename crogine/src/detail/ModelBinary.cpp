@@ -28,27 +28,65 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "GLCheck.hpp"
+#include "VertexFormat.hpp"
 
 #include <crogine/detail/ModelBinary.hpp>
+#include <crogine/core/FileSystem.hpp>
 #include <crogine/graphics/MeshBuilder.hpp>
+#include <crogine/graphics/MeshOptimiser.hpp>
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/ecs/components/Skeleton.hpp>
 
 using namespace cro;
 
-bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path, bool includeSkeleton)
+namespace
+{
+    //number of floats used by each attribute in version 1 and 2 files
+    std::size_t getFloatSize(std::uint32_t attribute)
+    {
+        switch (attribute)
+        {
+        default:
+        case Mesh::Attribute::Bitangent:
+            return 0;
+        case Mesh::Attribute::Position:
+        case Mesh::Attribute::Normal:
+            return 3;
+        case Mesh::Attribute::UV0:
+        case Mesh::Attribute::UV1:
+            return 2;
+        case Mesh::Attribute::Colour:
+        case Mesh::Attribute::Tangent:
+        case Mesh::Attribute::BlendIndices:
+        case Mesh::Attribute::BlendWeights:
+            return 4;
+        }
+    }
+
+    //pads the component count so the attribute is a multiple of 4 bytes
+    std::uint8_t getPaddedSize(std::size_t size, std::uint8_t format)
+    {
+        const auto componentSize = Mesh::getAttributeFormatSize(format);
+        const auto byteSize = ((size * componentSize) + 3) & ~std::size_t(3);
+        return static_cast<std::uint8_t>(byteSize / componentSize);
+    }
+}
+
+bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path, bool includeSkeleton, bool quantise, bool optimise)
 {
     bool retVal = false;
 
-    Detail::ModelBinary::HeaderV2 header;
+    Detail::ModelBinary::HeaderV3 header;
     std::uint32_t skelOffset = sizeof(header);
 
     //if these are not empty after processing
     //then they'll be written to the file
     Detail::ModelBinary::MeshHeader meshHeader;
+    Detail::ModelBinary::MeshFormatV3 meshFormat;
     std::vector<std::uint32_t> outIndexSizes;
     std::vector<float> outVertexData;
-    std::vector<std::uint32_t> outIndexData;
+    std::vector<std::uint8_t> outBytes;
+    std::vector<std::uint8_t> outIndexData;
 
     if (entity.hasComponent<Model>())
     {
@@ -56,52 +94,11 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
 
         const auto& meshData = entity.getComponent<Model>().getMeshData();
 
-        //download the mesh data from vbo/ibo
+        //download the mesh data from vbo/ibo - quantised
+        //attributes and indices are converted by readVertexData()
         std::vector<float> vertexData;
         std::vector<std::vector<std::uint32_t>> indexData;
-
-        vertexData.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, vertexData.data()));
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-        indexData.resize(meshData.submeshCount);
-
-        for (auto i = 0u; i < meshData.submeshCount; ++i)
-        {
-            indexData[i].resize(meshData.indexData[i].indexCount);
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-
-            //fudgy kludge for different index types
-            switch (meshData.indexData[i].format)
-            {
-            default: break;
-            case GL_UNSIGNED_BYTE:
-            {
-                std::vector<std::uint8_t> temp(meshData.indexData[i].indexCount);
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount, temp.data()));
-                for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-                {
-                    indexData[i][j] = temp[j];
-                }
-            }
-            break;
-            case GL_UNSIGNED_SHORT:
-            {
-                std::vector<std::uint16_t> temp(meshData.indexData[i].indexCount);
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint16_t), temp.data()));
-                for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-                {
-                    indexData[i][j] = temp[j];
-                }
-            }
-            break;
-            case GL_UNSIGNED_INT:
-                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint32_t), indexData[i].data()));
-                break;
-            }
-        }
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+        Mesh::readVertexData(meshData, vertexData, indexData);
 
         //parse the vertex data and correct the colour for missing
         //alpha channel, and setup the tangent value to compensate
@@ -225,7 +222,116 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
             }
         }
 
+        //choose the storage format of each attribute
+        std::size_t outStride = 0;
+        for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+        {
+            if (meshHeader.flags & (1 << i))
+            {
+                outStride += getFloatSize(i);
+                meshFormat.attributeFormats[i] = Mesh::AttributeFormat::Float;
+                meshFormat.attributeSizes[i] = static_cast<std::uint8_t>(getFloatSize(i));
+            }
+        }
 
+        //reorder for the vertex cache - only triangle lists are supported
+        if (optimise && outStride != 0
+            && std::all_of(meshData.indexData.begin(), meshData.indexData.begin() + meshData.submeshCount,
+                [](const Mesh::IndexData& id) { return id.primitiveType == GL_TRIANGLES; }))
+        {
+            auto report = MeshOptimiser::optimise(outVertexData, outStride, indexData);
+            LogI << "Optimised mesh for " << path << std::endl;
+            report.log();
+        }
+
+        if (quantise)
+        {
+            float maxPosition = 0.f;
+            float maxBlendIndex = 0.f;
+            for (auto i = 0ull; i < outVertexData.size(); i += outStride)
+            {
+                std::size_t offset = 0;
+                for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+                {
+                    if (meshHeader.flags & (1 << j))
+                    {
+                        if (j == Mesh::Attribute::Position)
+                        {
+                            for (auto k = 0u; k < 3u; ++k)
+                            {
+                                maxPosition = std::max(maxPosition, std::abs(outVertexData[i + offset + k]));
+                            }
+                        }
+                        else if (j == Mesh::Attribute::BlendIndices)
+                        {
+                            for (auto k = 0u; k < 4u; ++k)
+                            {
+                                maxBlendIndex = std::max(maxBlendIndex, outVertexData[i + offset + k]);
+                            }
+                        }
+                        offset += getFloatSize(j);
+                    }
+                }
+            }
+
+            auto setFormat = [&](std::uint32_t attrib, std::uint8_t format)
+            {
+                if (meshHeader.flags & (1 << attrib))
+                {
+                    meshFormat.attributeFormats[attrib] = format;
+                    meshFormat.attributeSizes[attrib] = getPaddedSize(getFloatSize(attrib), format);
+                }
+            };
+
+            if (maxPosition <= MaxHalfPosition)
+            {
+                setFormat(Mesh::Attribute::Position, Mesh::AttributeFormat::HalfFloat);
+            }
+            setFormat(Mesh::Attribute::Colour, Mesh::AttributeFormat::UNorm8);
+            setFormat(Mesh::Attribute::Normal, Mesh::AttributeFormat::SNorm8);
+            setFormat(Mesh::Attribute::Tangent, Mesh::AttributeFormat::SNorm8);
+            setFormat(Mesh::Attribute::UV0, Mesh::AttributeFormat::HalfFloat);
+            setFormat(Mesh::Attribute::UV1, Mesh::AttributeFormat::HalfFloat);
+            if (maxBlendIndex < 256.f)
+            {
+                setFormat(Mesh::Attribute::BlendIndices, Mesh::AttributeFormat::UInt8);
+            }
+            setFormat(Mesh::Attribute::BlendWeights, Mesh::AttributeFormat::UNorm8);
+        }
+
+        //encode the vertex data in the selected formats
+        for (auto i = 0ull; i < outVertexData.size(); i += outStride)
+        {
+            std::size_t offset = 0;
+            for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+            {
+                if (meshHeader.flags & (1 << j))
+                {
+                    const auto format = meshFormat.attributeFormats[j];
+                    const auto componentSize = Mesh::getAttributeFormatSize(format);
+                    const auto floatSize = getFloatSize(j);
+
+                    for (auto k = 0u; k < meshFormat.attributeSizes[j]; ++k)
+                    {
+                        //padding component, w is 1 for positions
+                        float value = (j == Mesh::Attribute::Position) ? 1.f : 0.f;
+                        if (k < floatSize)
+                        {
+                            value = outVertexData[i + offset + k];
+                        }
+
+                        auto pos = outBytes.size();
+                        outBytes.resize(pos + componentSize);
+                        Detail::encodeComponent(value, format, &outBytes[pos]);
+                    }
+                    offset += floatSize;
+                }
+            }
+        }
+
+        //use 16 bit indices if we can
+        std::size_t vertexCount = outStride ? outVertexData.size() / outStride : 0;
+        meshFormat.indexSize = vertexCount <= std::numeric_limits<std::uint16_t>::max() + 1 ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
 
         //copy index data
         for (const auto& data : indexData)
@@ -233,7 +339,17 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
             outIndexSizes.push_back(static_cast<std::uint32_t>(data.size()));
             for (auto d : data)
             {
-                outIndexData.push_back(d);
+                auto pos = outIndexData.size();
+                outIndexData.resize(pos + meshFormat.indexSize);
+                if (meshFormat.indexSize == sizeof(std::uint16_t))
+                {
+                    auto idx = static_cast<std::uint16_t>(d);
+                    std::memcpy(&outIndexData[pos], &idx, sizeof(idx));
+                }
+                else
+                {
+                    std::memcpy(&outIndexData[pos], &d, sizeof(d));
+                }
             }
         }
 
@@ -242,12 +358,13 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
         meshHeader.indexArrayCount = static_cast<std::uint16_t>(indexData.size());
         meshHeader.indexArrayOffset = header.meshOffset
             + static_cast<std::uint32_t>(sizeof(meshHeader)
+            + sizeof(meshFormat)
             + (outIndexSizes.size() * sizeof(std::uint32_t))
-            + (outVertexData.size() * sizeof(float)));
+            + outBytes.size());
 
         //update the skeleton offset with the size of the mesh data
         skelOffset = meshHeader.indexArrayOffset
-            + static_cast<std::uint32_t>(outIndexData.size() * sizeof(std::uint32_t));
+            + static_cast<std::uint32_t>(outIndexData.size());
 
         retVal = true;
     }
@@ -321,9 +438,10 @@ bool cro::Detail::ModelBinary::write(cro::Entity entity, const std::string& path
             {
                 //write mesh data
                 SDL_RWwrite(file, &meshHeader, sizeof(meshHeader), 1);
+                SDL_RWwrite(file, &meshFormat, sizeof(meshFormat), 1);
                 SDL_RWwrite(file, outIndexSizes.data(), sizeof(std::uint32_t), outIndexSizes.size());
-                SDL_RWwrite(file, outVertexData.data(), sizeof(float), outVertexData.size());
-                SDL_RWwrite(file, outIndexData.data(), sizeof(std::uint32_t), outIndexData.size());
+                SDL_RWwrite(file, outBytes.data(), 1, outBytes.size());
+                SDL_RWwrite(file, outIndexData.data(), 1, outIndexData.size());
             }
 
             if (header.skeletonOffset)
@@ -358,7 +476,7 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
     cro::Mesh::Data meshData;
 
     cro::RaiiRWops file;
-    file.file = SDL_RWFromFile(binPath.c_str(), "rb");
+    file.file = FileSystem::openResource(binPath);
     if (file.file)
     {
         cro::Detail::ModelBinary::Header header;
@@ -382,69 +500,21 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
         if (header.meshOffset)
         {
             cro::Detail::ModelBinary::MeshHeader meshHeader;
-            SDL_RWread(file.file, &meshHeader, sizeof(meshHeader), 1);
-
-            if ((meshHeader.flags & cro::VertexProperty::Position) == 0)
+            cro::Detail::ModelBinary::MeshFormatV3 meshFormat;
+            if (!readMesh(file.file, header, meshHeader, meshFormat, dstVert, dstIdx))
             {
-                LogE << "No position data in mesh" << std::endl;
+                LogE << "Failed reading mesh data from " << binPath << std::endl;
                 return {};
             }
-            std::vector<std::uint32_t> sizes(meshHeader.indexArrayCount);
-            dstIdx.resize(meshHeader.indexArrayCount);
-
-            SDL_RWread(file.file, sizes.data(), meshHeader.indexArrayCount * sizeof(std::uint32_t), 1);
 
-            std::uint32_t vertStride = 0;
             for (auto i = 0u; i < cro::Mesh::Attribute::Total; ++i)
             {
                 if (meshHeader.flags & (1 << i))
                 {
-                    switch (i)
-                    {
-                    default:
-                    case cro::Mesh::Attribute::Bitangent:
-                        break;
-                    case cro::Mesh::Attribute::Position:
-                        vertStride += 3;
-                        meshData.attributes[i] = 3;
-                        break;
-                    case cro::Mesh::Attribute::Colour:
-                        vertStride += 4;
-                        meshData.attributes[i] = 4;
-                        break;
-                    case cro::Mesh::Attribute::Normal:
-                        vertStride += 3;
-                        meshData.attributes[i] = 3;
-                        break;
-                    case cro::Mesh::Attribute::UV0:
-                    case cro::Mesh::Attribute::UV1:
-                        vertStride += 2;
-                        meshData.attributes[i] = 2;
-                        break;
-                    case cro::Mesh::Attribute::Tangent:
-                    case cro::Mesh::Attribute::BlendIndices:
-                    case cro::Mesh::Attribute::BlendWeights:
-                        vertStride += 4;
-                        meshData.attributes[i] = 4;
-                        break;
-                    }
+                    meshData.attributes[i] = getFloatSize(i);
                 }
             }
 
-            auto pos = SDL_RWtell(file.file);
-            auto vertSize = meshHeader.indexArrayOffset - pos;
-
-            std::vector<float> tempVerts(vertSize / sizeof(float));
-            SDL_RWread(file.file, tempVerts.data(), vertSize, 1);
-            CRO_ASSERT(tempVerts.size() % vertStride == 0, "");
-
-            for (auto i = 0u; i < meshHeader.indexArrayCount; ++i)
-            {
-                dstIdx[i].resize(sizes[i]);
-                SDL_RWread(file.file, dstIdx[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
-            }
-
-            dstVert.swap(tempVerts);
             meshData.attributeFlags = meshHeader.flags;
             meshData.primitiveType = GL_TRIANGLES;
 
@@ -505,4 +575,143 @@ cro::Mesh::Data cro::Detail::ModelBinary::read(const std::string& binPath, std::
         return {};
     }
     return meshData;
-}
\ No newline at end of file
+}
+
+bool cro::Detail::ModelBinary::readMesh(SDL_RWops* file, const Header& header, MeshHeader& meshHeader, MeshFormatV3& meshFormat,
+    std::vector<float>& dstVert, std::vector<std::vector<std::uint32_t>>& dstIdx)
+{
+    dstVert.clear();
+    dstIdx.clear();
+
+    SDL_RWread(file, &meshHeader, sizeof(meshHeader), 1);
+
+    if ((meshHeader.flags & VertexProperty::Position) == 0)
+    {
+        LogE << "No position data in mesh" << std::endl;
+        return false;
+    }
+
+    if (header.magic == MAGIC
+        && header.version > 2)
+    {
+        SDL_RWread(file, &meshFormat, sizeof(meshFormat), 1);
+
+        if (meshFormat.indexSize != sizeof(std::uint16_t)
+            && meshFormat.indexSize != sizeof(std::uint32_t))
+        {
+            LogE << "Invalid index size " << meshFormat.indexSize << std::endl;
+            return false;
+        }
+    }
+    else
+    {
+        //older versions are always float/uint32
+        meshFormat = {};
+        for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+        {
+            meshFormat.attributeFormats[i] = Mesh::AttributeFormat::Float;
+            meshFormat.attributeSizes[i] = static_cast<std::uint8_t>(getFloatSize(i));
+        }
+        meshFormat.indexSize = sizeof(std::uint32_t);
+    }
+
+    std::vector<std::uint32_t> sizes(meshHeader.indexArrayCount);
+    SDL_RWread(file, sizes.data(), meshHeader.indexArrayCount * sizeof(std::uint32_t), 1);
+
+    std::size_t vertStride = 0; //in bytes
+    std::size_t floatStride = 0;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (meshHeader.flags & (1 << i))
+        {
+            if (meshFormat.attributeFormats[i] >= Mesh::AttributeFormat::Count)
+            {
+                LogE << "Invalid attribute format " << static_cast<std::int32_t>(meshFormat.attributeFormats[i]) << std::endl;
+                return false;
+            }
+
+            vertStride += meshFormat.attributeSizes[i] * Mesh::getAttributeFormatSize(meshFormat.attributeFormats[i]);
+            floatStride += getFloatSize(i);
+        }
+    }
+
+    if (vertStride == 0)
+    {
+        LogE << "Invalid vertex size" << std::endl;
+        return false;
+    }
+
+    auto pos = SDL_RWtell(file);
+    auto vertSize = static_cast<std::int64_t>(meshHeader.indexArrayOffset) - pos;
+    if (vertSize < 0
+        || vertSize % vertStride != 0)
+    {
+        LogE << "Invalid vertex data size" << std::endl;
+        return false;
+    }
+    const auto vertexCount = static_cast<std::size_t>(vertSize) / vertStride;
+
+    std::vector<std::uint8_t> tempVerts(static_cast<std::size_t>(vertSize));
+    SDL_RWread(file, tempVerts.data(), tempVerts.size(), 1);
+
+    //convert to the float layout used by older versions
+    dstVert.resize(vertexCount * floatStride);
+    if (vertStride == floatStride * sizeof(float))
+    {
+        //already float, so straight copy
+        std::memcpy(dstVert.data(), tempVerts.data(), tempVerts.size());
+    }
+    else
+    {
+        const auto* src = tempVerts.data();
+        auto* dst = dstVert.data();
+        for (auto v = 0u; v < vertexCount; ++v)
+        {
+            for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+            {
+                if (meshHeader.flags & (1 << i))
+                {
+                    const auto format = meshFormat.attributeFormats[i];
+                    const auto componentSize = Mesh::getAttributeFormatSize(format);
+                    const auto floatSize = getFloatSize(i);
+                    for (auto j = 0u; j < std::max<std::size_t>(floatSize, meshFormat.attributeSizes[i]); ++j)
+                    {
+                        if (j < meshFormat.attributeSizes[i])
+                        {
+                            auto value = Detail::decodeComponent(src, format);
+                            src += componentSize;
+
+                            if (j < floatSize)
+                            {
+                                *dst++ = value;
+                            }
+                        }
+                        else
+                        {
+                            //missing colour alpha defaults to 1
+                            *dst++ = (i == Mesh::Attribute::Colour) ? 1.f : 0.f;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    dstIdx.resize(meshHeader.indexArrayCount);
+    for (auto i = 0u; i < meshHeader.indexArrayCount; ++i)
+    {
+        dstIdx[i].resize(sizes[i]);
+        if (meshFormat.indexSize == sizeof(std::uint16_t))
+        {
+            std::vector<std::uint16_t> temp(sizes[i]);
+            SDL_RWread(file, temp.data(), sizes[i] * sizeof(std::uint16_t), 1);
+            std::copy(temp.begin(), temp.end(), dstIdx[i].begin());
+        }
+        else
+        {
+            SDL_RWread(file, dstIdx[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
+        }
+    }
+
+    return true;
+}
@@ -30,6 +30,7 @@ source distribution.
 #include "StaticMeshFile.hpp"
 
 #include <crogine/core/Log.hpp>
+#include <crogine/core/FileSystem.hpp>
 
 #include <SDL_rwops.h>
 
@@ -37,7 +38,7 @@ namespace cro::Detail
 {
     bool readCMF(const std::string& path, MeshFile& output)
     {
-        auto* file = SDL_RWFromFile(path.c_str(), "rb");
+        auto* file = FileSystem::openResource(path);
 
         if (!file)
         {
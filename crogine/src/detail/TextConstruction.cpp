@@ -30,6 +30,7 @@ source distribution.
 #include "TextConstruction.hpp"
 
 #include <crogine/ecs/components/Text.hpp>
+#include <crogine/detail/HashCombine.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
 
 using namespace cro;
@@ -57,69 +58,141 @@ void Detail::Text::addQuad(std::vector<Vertex2D>& vertices, glm::vec2 position,
     vertices.emplace_back(glm::vec2(position.x + right + outlineThickness, position.y + bottom - outlineThickness), glm::vec2(u2, v2), colour);
 }
 
-FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext& context)
+std::size_t Detail::Text::hashStyle(const TextContext& context)
+{
+    std::size_t seed = 0;
+    hash_combine(seed, reinterpret_cast<std::uintptr_t>(context.font));
+    hash_combine(seed, context.charSize);
+    hash_combine(seed, context.verticalSpacing);
+    hash_combine(seed, context.outlineThickness);
+    hash_combine(seed, context.shadowOffset.x);
+    hash_combine(seed, context.shadowOffset.y);
+    hash_combine(seed, context.bold);
+    hash_combine(seed, context.alignment);
+    return seed;
+}
+
+std::size_t Detail::Text::hashString(const String& string)
+{
+    //FNV-1a
+    std::uint64_t hash = 0xcbf29ce484222325;
+    for (auto i = 0u; i < string.size(); ++i)
+    {
+        hash ^= string[i];
+        hash *= 0x100000001b3;
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+void Detail::Text::updateLayout(Layout& layout, const TextContext& context)
 {
-    std::vector<Vertex2D> outlineVerts;
-    std::vector<Vertex2D> shadowVerts;
-    std::vector<Vertex2D> characterVerts;
+    CRO_ASSERT(context.font, "no font has been assigned");
 
-    std::size_t rowStart = 0; //index of first vert in current row
-    const auto realign = [&](float diff)
+    const auto& string = context.string;
+    const auto styleHash = hashStyle(context);
+
+    //find the first line which is affected by any changes
+    //to the string - lines before this remain untouched
+    Layout::Line line;
+    if (layout.styleHash == styleHash
+        && !layout.lines.empty())
     {
-        for (auto i = rowStart; i < characterVerts.size(); ++i)
+        std::size_t firstDiff = 0;
+        const auto maxLength = std::min(string.size(), layout.string.size());
+        while (firstDiff < maxLength
+            && string[firstDiff] == layout.string[firstDiff])
         {
-            characterVerts[i].position.x -= diff;
+            firstDiff++;
+        }
 
-            if (context.outlineThickness != 0)
+        if (firstDiff == string.size()
+            && firstDiff == layout.string.size())
+        {
+            //nothing changed
+            return;
+        }
+
+        std::size_t lineIndex = 0;
+        while (lineIndex + 1 < layout.lines.size()
+            && layout.lines[lineIndex + 1].firstChar <= firstDiff)
+        {
+            lineIndex++;
+        }
+
+        line = layout.lines[lineIndex];
+        layout.lines.resize(lineIndex);
+    }
+    else
+    {
+        layout.lines.clear();
+    }
+    layout.effectVerts.resize(line.firstVertex);
+    layout.characterVerts.resize(line.firstVertex);
+    layout.string = string;
+    layout.styleHash = styleHash;
+
+    line.minBounds = glm::vec2(std::numeric_limits<float>::max());
+    line.maxBounds = glm::vec2(std::numeric_limits<float>::lowest());
+
+    //distance field fonts draw outlines and shadows in the shader
+    const bool distanceField = context.font->isDistanceField();
+    const bool hasOutline = !distanceField && context.outlineThickness != 0;
+    const bool hasShadow = !distanceField && !hasOutline && glm::length2(context.shadowOffset) != 0;
+
+    auto& characterVerts = layout.characterVerts;
+    auto& effectVerts = layout.effectVerts;
+    const auto endLine = [&]()
+    {
+        if (line.firstVertex < characterVerts.size())
+        {
+            float diff = 0.f;
+            if (context.alignment == std::int32_t(cro::Text::Alignment::Centre))
             {
-                outlineVerts[i].position.x -= diff;
+                diff = std::floor((characterVerts.back().position.x - characterVerts[line.firstVertex].position.x) / 2.f);
+            }
+            else if (context.alignment == std::int32_t(cro::Text::Alignment::Right))
+            {
+                diff = std::floor(characterVerts.back().position.x - characterVerts[line.firstVertex].position.x);
             }
 
-            if (glm::length2(context.shadowOffset) != 0)
+            if (diff != 0)
             {
-                shadowVerts[i].position.x -= diff;
+                for (auto i = line.firstVertex; i < characterVerts.size(); ++i)
+                {
+                    characterVerts[i].position.x -= diff;
+
+                    if (hasOutline || hasShadow)
+                    {
+                        effectVerts[i].position.x -= diff;
+                    }
+                }
             }
         }
-    };
-    const auto eol = [&]()
-    {
-        if (context.alignment == std::int32_t(cro::Text::Alignment::Centre))
-        {
-            float diff = std::floor((characterVerts.back().position.x - characterVerts[rowStart].position.x) / 2.f);
-            realign(diff);
-        }
-        else if (context.alignment == std::int32_t(cro::Text::Alignment::Right))
-        {
-            float diff = std::floor(characterVerts.back().position.x - characterVerts[rowStart].position.x);
-            realign(diff);
-        }
+        layout.lines.push_back(line);
     };
 
-    const auto& texture = context.font->getTexture(context.charSize);
-    float xOffset = static_cast<float>(context.font->getGlyph(L' ', context.charSize, context.bold, context.outlineThickness).advance);
-    float yOffset = static_cast<float>(context.font->getLineHeight(context.charSize));
-    float x = 0.f;
-    float y = 0.f;// static_cast<float>(m_charSize);
+    //texture coords are kept in pixels until the final vertices are built
+    const glm::vec2 textureSize(1.f);
 
-    float minX = x;
-    float minY = y;
-    float maxX = 0.f;
-    float maxY = 0.f;
+    const auto& font = *context.font;
+    float xOffset = static_cast<float>(font.getGlyph(L' ', context.charSize, context.bold, context.outlineThickness).advance);
+    float yOffset = static_cast<float>(font.getLineHeight(context.charSize));
+    float x = 0.f;
+    float y = line.y;
 
-    std::uint32_t prevChar = 0;
-    const auto& string = context.string;
-    for (auto i = 0u; i < string.size(); ++i)
+    std::uint32_t prevChar = line.firstChar == 0 ? 0 : string[line.firstChar - 1];
+    for (auto i = line.firstChar; i < string.size(); ++i)
     {
         std::uint32_t currChar = string[i];
 
-        x += context.font->getKerning(prevChar, currChar, context.charSize);
+        x += font.getKerning(prevChar, currChar, context.charSize);
         prevChar = currChar;
 
         //whitespace chars
         if (currChar == ' ' || currChar == '\t' || currChar == '\n')
         {
-            minX = std::min(minX, x);
-            minY = std::min(minY, y);
+            line.minBounds.x = std::min(line.minBounds.x, x);
+            line.minBounds.y = std::min(line.minBounds.y, y);
 
             switch (currChar)
             {
@@ -133,84 +206,93 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
             case '\n':
                 y -= yOffset + context.verticalSpacing;
                 x = 0.f;
-
-                eol();
-
-                rowStart = characterVerts.size();
                 break;
             }
 
-            maxX = std::max(maxX, x);
-            maxY = std::max(maxY, y);
+            line.maxBounds.x = std::max(line.maxBounds.x, x);
+            line.maxBounds.y = std::max(line.maxBounds.y, y);
+
+            if (currChar == '\n')
+            {
+                endLine();
+
+                line = Layout::Line();
+                line.firstChar = i + 1;
+                line.firstVertex = characterVerts.size();
+                line.y = y;
+                line.minBounds = glm::vec2(std::numeric_limits<float>::max());
+                line.maxBounds = glm::vec2(std::numeric_limits<float>::lowest());
+            }
 
             continue; //skip quad for whitespace
         }
 
         //create the quads.
-        auto addOutline = [&]()
-        {
-            const auto& glyph = context.font->getGlyph(currChar, context.charSize, context.bold, context.outlineThickness);
-
-            //TODO mental jiggery to figure out why these cause an alignment
-            //offset - although it's not important, it just means the localBounds
-            //won't include any outline.
-            /*float left = glyph.bounds.left;
-            float top = glyph.bounds.bottom + glyph.bounds.height;
-            float right = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.bottom;*/
-
-            //add the outline glyph to the vertices
-            Detail::Text::addQuad(outlineVerts, glm::vec2(x, y), context.outlineColour, glyph, texture.getSize(), context.outlineThickness);
-
-            /*minX = std::min(minX, x + left - m_outlineThickness);
-            maxX = std::max(maxX, x + right + m_outlineThickness);
-            minY = std::min(minY, y + bottom - m_outlineThickness);
-            maxY = std::max(maxY, y + top + m_outlineThickness);*/
-        };
-
-        const auto& glyph = context.font->getGlyph(currChar, context.charSize, context.bold, 0.f);
+        const auto& glyph = font.getGlyph(currChar, context.charSize, context.bold, 0.f);
 
         //if outline is larger, add first
-        if (context.outlineThickness != 0)
+        if (hasOutline)
         {
-            addOutline();
+            const auto& outlineGlyph = font.getGlyph(currChar, context.charSize, context.bold, context.outlineThickness);
+            Detail::Text::addQuad(effectVerts, glm::vec2(x, y), context.outlineColour, outlineGlyph, textureSize, context.outlineThickness);
         }
-        else if (glm::length2(context.shadowOffset) != 0)
+        else if (hasShadow)
         {
             //add a shadow if only no outline
-            Detail::Text::addQuad(shadowVerts, glm::vec2(x, y) + context.shadowOffset, context.shadowColour, glyph, texture.getSize());
+            Detail::Text::addQuad(effectVerts, glm::vec2(x, y) + context.shadowOffset, context.shadowColour, glyph, textureSize);
         }
-        Detail::Text::addQuad(characterVerts, glm::vec2(x, y), context.fillColour, glyph, texture.getSize());
+        Detail::Text::addQuad(characterVerts, glm::vec2(x, y), context.fillColour, glyph, textureSize);
 
-        //only do this if not outlined
-        //if (context.outlineThickness == 0)
-        {
-            float left = glyph.bounds.left;
-            float top = glyph.bounds.bottom + glyph.bounds.height;
-            float right = glyph.bounds.left + glyph.bounds.width;
-            float bottom = glyph.bounds.bottom;
-
-            minX = std::min(minX, x + left);
-            maxX = std::max(maxX, x + right);
-            minY = std::min(minY, y + bottom);
-            maxY = std::max(maxY, y + top);
-        }
+        float left = glyph.bounds.left;
+        float top = glyph.bounds.bottom + glyph.bounds.height;
+        float right = glyph.bounds.left + glyph.bounds.width;
+        float bottom = glyph.bounds.bottom;
+
+        line.minBounds.x = std::min(line.minBounds.x, x + left);
+        line.maxBounds.x = std::max(line.maxBounds.x, x + right);
+        line.minBounds.y = std::min(line.minBounds.y, y + bottom);
+        line.maxBounds.y = std::max(line.maxBounds.y, y + top);
 
         x += glyph.advance;
     }
-    //update alignment if there is no newline at the end
-    if (rowStart != characterVerts.size())
-    {
-        eol();
-    }
+    endLine();
+}
 
+FloatRect Detail::Text::buildVertices(std::vector<Vertex2D>& dst, const Layout& layout, const TextContext& context)
+{
+    //the layout may have been created before the font texture was resized
+    //so texture coords are normalised with the current texture size
+    const auto textureSize = glm::vec2(context.font->getTexture(context.charSize).getSize());
+    const auto effectColour = context.outlineThickness != 0 ? context.outlineColour : context.shadowColour;
 
     //ensures the outline/shadow is always drawn first
-    outlineVerts.insert(outlineVerts.end(), shadowVerts.begin(), shadowVerts.end());
-    outlineVerts.insert(outlineVerts.end(), characterVerts.begin(), characterVerts.end());
-    dst.swap(outlineVerts);
+    dst.clear();
+    dst.reserve(layout.effectVerts.size() + layout.characterVerts.size());
+    for (auto v : layout.effectVerts)
+    {
+        v.UV /= textureSize;
+        v.colour = effectColour;
+        dst.push_back(v);
+    }
 
+    for (auto v : layout.characterVerts)
+    {
+        v.UV /= textureSize;
+        v.colour = context.fillColour;
+        dst.push_back(v);
+    }
 
+    float minX = 0.f;
+    float minY = 0.f;
+    float maxX = 0.f;
+    float maxY = 0.f;
+    for (const auto& line : layout.lines)
+    {
+        minX = std::min(minX, line.minBounds.x);
+        minY = std::min(minY, line.minBounds.y);
+        maxX = std::max(maxX, line.maxBounds.x);
+        maxY = std::max(maxY, line.maxBounds.y);
+    }
 
     FloatRect localBounds;
     localBounds.left = minX;
@@ -231,4 +313,83 @@ FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext&
     localBounds.left -= offset;
 
     return localBounds;
-}
\ No newline at end of file
+}
+
+Detail::Text::DistanceFieldProperties Detail::Text::getDistanceFieldProperties(const TextContext& context)
+{
+    CRO_ASSERT(context.font, "no font has been assigned");
+
+    //one screen pixel in atlas pixels, and the range covered by the field
+    const float pixelSize = static_cast<float>(Font::DistanceFieldSize) / std::max(1u, context.charSize);
+    const float range = static_cast<float>(Font::DistanceFieldSpread) * 2.f;
+
+    DistanceFieldProperties retVal;
+    retVal.smoothing = std::min(0.5f, (pixelSize * 0.5f) / range);
+
+    if (context.outlineThickness != 0)
+    {
+        retVal.outlineThickness = std::clamp((context.outlineThickness * pixelSize) / range, 0.f, 0.5f - retVal.smoothing);
+        retVal.outlineColour = context.outlineColour;
+    }
+    else
+    {
+        //stops the edges being tinted
+        retVal.outlineColour = context.fillColour;
+
+        if (glm::length2(context.shadowOffset) != 0)
+        {
+            //texture coords are flipped vertically relative to the quads
+            const auto textureSize = glm::vec2(context.font->getTexture(context.charSize).getSize());
+            retVal.shadowOffset = (glm::vec2(context.shadowOffset.x, -context.shadowOffset.y) * pixelSize) / textureSize;
+            retVal.shadowColour = context.shadowColour;
+        }
+    }
+
+    return retVal;
+}
+
+void Detail::Text::updateColours(std::vector<Vertex2D>& verts, const TextContext& context)
+{
+    CRO_ASSERT(context.font, "no font has been assigned");
+
+    //distance field effects are coloured by the shader
+    auto secondColour = cro::Colour::Transparent;
+    if (!context.font->isDistanceField())
+    {
+        if (context.outlineThickness != 0)
+        {
+            secondColour = context.outlineColour;
+        }
+        else if (glm::length2(context.shadowOffset) != 0)
+        {
+            secondColour = context.shadowColour;
+        }
+    }
+
+    if (secondColour.getAlpha() != 0)
+    {
+        for (auto i = 0u; i < verts.size() / 2; ++i)
+        {
+            verts[i].colour = secondColour;
+        }
+
+        for (auto i = verts.size() / 2; i < verts.size(); ++i)
+        {
+            verts[i].colour = context.fillColour;
+        }
+    }
+    else
+    {
+        for (auto& v : verts)
+        {
+            v.colour = context.fillColour;
+        }
+    }
+}
+
+FloatRect Detail::Text::updateVertices(std::vector<Vertex2D>& dst, TextContext& context)
+{
+    Layout layout;
+    updateLayout(layout, context);
+    return buildVertices(dst, layout, context);
+}
@@ -35,6 +35,63 @@ source distribution.
 
 namespace cro::Detail::Text
 {
+    /*
+    Glyph quads laid out for a string with a given font and style.
+    Texture coordinates are stored in pixels so that the layout
+    remains valid if the font's page texture is resized, and colours
+    are applied only when the final vertex data is built. The start
+    of each line is recorded so that editing the end of a string only
+    requires the affected lines to be laid out again.
+    */
+    struct Layout final
+    {
+        struct Line final
+        {
+            std::size_t firstChar = 0; //index into the string
+            std::size_t firstVertex = 0; //index into the vertex arrays
+            float y = 0.f;
+            glm::vec2 minBounds = glm::vec2(0.f);
+            glm::vec2 maxBounds = glm::vec2(0.f);
+        };
+
+        String string;
+        std::size_t styleHash = 0;
+        std::vector<Line> lines;
+        std::vector<Vertex2D> effectVerts; //outline or shadow, one quad for each character quad
+        std::vector<Vertex2D> characterVerts;
+
+        std::uint32_t lastUsed = 0; //used by the TextSystem cache
+    };
+
+    //hashes the properties of the context which affect the layout - excluding the string
+    std::size_t hashStyle(const TextContext&);
+
+    //hashes the string of the context
+    std::size_t hashString(const String&);
+
+    //updates the layout with the context's string. If the layout was previously
+    //created with the same style only lines after the first change are rebuilt
+    void updateLayout(Layout& layout, const TextContext& ctx);
+
+    //creates the final vertex data from the layout and returns the local bounds
+    FloatRect buildVertices(std::vector<Vertex2D>& dst, const Layout& layout, const TextContext& ctx);
+
+    //uniform values used by the distance field shader. Distances are
+    //normalised to the range stored in the font's distance field
+    struct DistanceFieldProperties final
+    {
+        float smoothing = 0.f;
+        float outlineThickness = 0.f;
+        Colour outlineColour;
+        Colour shadowColour = Colour::Transparent;
+        glm::vec2 shadowOffset = glm::vec2(0.f);
+    };
+    DistanceFieldProperties getDistanceFieldProperties(const TextContext&);
+
+    //updates the colour of existing vertices without rebuilding them. Outline
+    //or shadow quads make up the first half of the array, when they exist
+    void updateColours(std::vector<Vertex2D>& vertices, const TextContext& ctx);
+
     void addQuad(std::vector<Vertex2D>& vertices, glm::vec2 position, Colour colour, const Glyph& glyph, glm::vec2 textureSize, float outlineThickness = 0.f);
 
     FloatRect updateVertices(std::vector<Vertex2D>& dst, TextContext& ctx);
@@ -0,0 +1,80 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/graphics/TextureMemory.hpp>
+
+#include <cstdint>
+#include <functional>
+
+namespace cro::Detail
+{
+    /*
+    Records the size of every texture and renderbuffer allocation, along with
+    the frame in which textures were last bound. Textures which can be reloaded
+    provide callbacks to release and restore their storage, which are used to
+    keep the total under the budget set with TextureMemory::setBudget().
+    All functions must be called from the thread owning the GL context.
+    */
+    class TextureRegistry final
+    {
+    public:
+        //adds or updates the size of the given texture. Existing
+        //textures keep their category, and are marked as resident.
+        static void addTexture(std::uint32_t handle, std::size_t bytes, TextureMemory::Category = TextureMemory::Texture);
+        static void removeTexture(std::uint32_t handle);
+        static void setCategory(std::uint32_t handle, TextureMemory::Category);
+
+        //renderbuffers share the category totals but are never evicted
+        static void addRenderbuffer(std::uint32_t handle, std::size_t bytes, TextureMemory::Category);
+        static void removeRenderbuffer(std::uint32_t handle);
+
+        //evict should release the texture's storage without deleting its handle, and
+        //restore should eventually call addTexture() once the texture is reloaded
+        static void setEvictable(std::uint32_t handle, std::function<void()> evict, std::function<void()> restore);
+
+        //clears the evict and restore callbacks, eg when the texture is modified
+        static void clearEvictable(std::uint32_t handle);
+
+        //marks the texture as used this frame, restoring it if it was evicted
+        static void markUsed(std::uint32_t handle);
+
+        //returns a texture which failed to be restored to the evicted
+        //state, so that it is restored again when it is next used
+        static void restoreFailed(std::uint32_t handle);
+
+        //called once per frame by the App to evict textures when over budget
+        static void update();
+
+        //estimates the size of a texture with the given properties
+        static std::size_t estimateSize(std::uint32_t width, std::uint32_t height, std::uint32_t bytesPerPixel, bool mipmapped = false);
+    };
+}
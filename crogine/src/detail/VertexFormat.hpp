@@ -0,0 +1,54 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#pragma once
+
+#include <crogine/graphics/MeshData.hpp>
+
+#include <cstdint>
+#include <vector>
+
+//these are implemented in MeshData.cpp
+namespace cro::Detail
+{
+    //GL type and normalisation flag passed to glVertexAttribPointer
+    //for the given Mesh::AttributeFormat
+    std::uint32_t getAttributeType(std::uint8_t format);
+    std::uint8_t isAttributeNormalised(std::uint8_t format);
+
+    //converts a single component to or from the given Mesh::AttributeFormat.
+    //values outside the range of normalised formats are clamped.
+    float decodeComponent(const std::uint8_t* src, std::uint8_t format);
+    void encodeComponent(float value, std::uint8_t format, std::uint8_t* dst);
+
+    //converts raw vertex data laid out as described by meshData to floats.
+    //the output has a stride of the sum of meshData.attributes
+    void decodeVertexData(const Mesh::Data& meshData, const std::uint8_t* src, std::vector<float>& dst);
+}
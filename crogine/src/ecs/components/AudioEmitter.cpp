@@ -46,7 +46,13 @@ AudioEmitter::AudioEmitter()
     m_rolloff           (1.f),
     m_velocity          (0.f),
     m_mixerChannel      (0),
+    m_priority          (0),
+    m_playTime          (0.f),
+    m_age               (0.f),
+    m_duration          (0.f),
     m_transportFlags    (0),
+    m_dirtyFlags        (DirtyAll),
+    m_lastPosition      (0.f),
     m_newDataSource     (false),
     m_ID                (-1),
     m_dataSourceID      (-1),
@@ -62,7 +68,13 @@ AudioEmitter::AudioEmitter(const AudioSource& dataSource)
     m_rolloff           (1.f),
     m_velocity          (0.f),
     m_mixerChannel      (0),
+    m_priority          (0),
+    m_playTime          (0.f),
+    m_age               (0.f),
+    m_duration          (0.f),
     m_transportFlags    (0),
+    m_dirtyFlags        (DirtyAll),
+    m_lastPosition      (0.f),
     m_newDataSource     (true),
     m_ID                (-1),
     m_dataSourceID      (dataSource.getID()),
@@ -86,12 +98,18 @@ AudioEmitter::AudioEmitter(AudioEmitter&& other) noexcept
 {
     m_newDataSource = true;
     other.m_newDataSource = true;
+    m_dirtyFlags = DirtyAll;
+    other.m_dirtyFlags = DirtyAll;
 
     std::swap(m_pitch, other.m_pitch);
     std::swap(m_volume, other.m_volume);
     std::swap(m_rolloff, other.m_rolloff);
     std::swap(m_velocity, other.m_velocity);
     std::swap(m_mixerChannel, other.m_mixerChannel);
+    std::swap(m_priority, other.m_priority);
+    std::swap(m_playTime, other.m_playTime);
+    std::swap(m_age, other.m_age);
+    std::swap(m_duration, other.m_duration);
     std::swap(m_ID, other.m_ID);
     std::swap(m_dataSourceID, other.m_dataSourceID);
     std::swap(m_sourceType, other.m_sourceType);
@@ -105,12 +123,18 @@ AudioEmitter& AudioEmitter::operator=(AudioEmitter&& other) noexcept
     {
         m_newDataSource = true;
         other.m_newDataSource = true;
+        m_dirtyFlags = DirtyAll;
+        other.m_dirtyFlags = DirtyAll;
 
         std::swap(m_pitch, other.m_pitch);
         std::swap(m_volume, other.m_volume);
         std::swap(m_rolloff, other.m_rolloff);
         std::swap(m_velocity, other.m_velocity);
         std::swap(m_mixerChannel, other.m_mixerChannel);
+        std::swap(m_priority, other.m_priority);
+        std::swap(m_playTime, other.m_playTime);
+        std::swap(m_age, other.m_age);
+        std::swap(m_duration, other.m_duration);
         std::swap(m_ID, other.m_ID);
         std::swap(m_dataSourceID, other.m_dataSourceID);
         std::swap(m_sourceType, other.m_sourceType);
@@ -145,6 +169,13 @@ void AudioEmitter::play()
     */
     if (m_state != State::Playing)
     {
+        //paused emitters resume, else we start from the beginning
+        if (m_state == State::Stopped)
+        {
+            m_playTime = 0.f;
+            m_age = 0.f;
+        }
+
         m_transportFlags |= Play;
         m_state = State::Playing;
     }
@@ -160,6 +191,7 @@ void AudioEmitter::stop()
 {
     m_transportFlags |= Stop;
     m_state = State::Stopped;
+    m_playTime = 0.f;
 }
 
 void AudioEmitter::setPlayingOffset(Time offset)
@@ -183,25 +215,30 @@ void AudioEmitter::setLooped(bool looped)
 void AudioEmitter::setPitch(float pitch)
 {
     m_pitch = std::max(0.f, pitch);
+    m_dirtyFlags |= DirtyPitch;
 }
 
 void AudioEmitter::setVolume(float volume)
 {
     m_volume = std::max(0.f, volume);
+    m_dirtyFlags |= DirtyVolume;
 }
 
 void AudioEmitter::setRolloff(float rolloff)
 {
     m_rolloff = std::max(0.f, rolloff);
+    m_dirtyFlags |= DirtyRolloff;
 }
 
 void AudioEmitter::setVelocity(glm::vec3 velocity)
 {
     m_velocity = velocity;
+    m_dirtyFlags |= DirtyVelocity;
 }
 
 void AudioEmitter::setMixerChannel(std::uint8_t channel)
 {
     CRO_ASSERT(channel < AudioMixer::MaxChannels, "Channel value out of range");
     m_mixerChannel = channel; 
+    m_dirtyFlags |= DirtyVolume;
 }
\ No newline at end of file
@@ -30,6 +30,7 @@ source distribution.
 #include <crogine/ecs/components/Model.hpp>
 #include <crogine/detail/Assert.hpp>
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/VertexFormat.hpp"
 
 #include <crogine/detail/glm/gtc/matrix_inverse.hpp>
 
@@ -389,7 +390,8 @@ void Model::bindMaterial(Material::Data& material)
             material.attribs[i][Material::Data::Size] = static_cast<std::int32_t>(m_meshData.attributes[i]);
 
             //calc the pointer offset for each attrib
-            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(pointerOffset * sizeof(float));
+            material.attribs[i][Material::Data::Offset] = static_cast<std::int32_t>(pointerOffset);
+            material.attribs[i][Material::Data::Format] = m_meshData.attributeFormats[i];
         }
         else
         {
@@ -397,14 +399,16 @@ void Model::bindMaterial(Material::Data& material)
             //with a new shader
             material.attribs[i][Material::Data::Size] = 0;
             material.attribs[i][Material::Data::Offset] = 0;
+            material.attribs[i][Material::Data::Format] = Mesh::AttributeFormat::Float;
         }
-        pointerOffset += m_meshData.attributes[i]; //count the offset regardless as the mesh may have more attributes than material
+        //count the offset regardless as the mesh may have more attributes than material
+        pointerOffset += m_meshData.attributes[i] * Mesh::getAttributeFormatSize(m_meshData.attributeFormats[i]);
     }
 
     //sort by size
     std::sort(std::begin(material.attribs), std::end(material.attribs),
-        [](const std::array<std::int32_t, 3>& ip,
-            const std::array<std::int32_t, 3>& op)
+        [](const std::array<std::int32_t, 4>& ip,
+            const std::array<std::int32_t, 4>& op)
         {
             return ip[Material::Data::Size] > op[Material::Data::Size];
         });
@@ -461,9 +465,10 @@ void Model::updateVAO(std::size_t idx, std::int32_t passIndex)
     const auto& attribs = m_materials[passIndex][idx].attribs;
     for (auto j = 0u; j < m_materials[passIndex][idx].attribCount; ++j)
     {
+        const auto format = static_cast<std::uint8_t>(attribs[j][Material::Data::Format]);
         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
         glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(m_meshData.vertexSize),
+            Detail::getAttributeType(format), Detail::isAttributeNormalised(format), static_cast<GLsizei>(m_meshData.vertexSize),
             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
     }
     
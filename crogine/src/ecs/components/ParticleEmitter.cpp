@@ -37,11 +37,18 @@ using namespace cro;
 ParticleEmitter::ParticleEmitter()
     : m_vbo             (0),
     m_vao               (0),
+    m_ibo               (0),
     m_nextFreeParticle  (0),
     m_running           (false),
     m_visible           (true),
     m_renderFlags       (std::numeric_limits<std::uint64_t>::max()),
-    m_releaseCount      (-1)
+    m_releaseCount      (-1),
+    m_framesHidden      (0),
+    m_sleeping          (false),
+    m_sleepTime         (0.f),
+    m_sleepLifetime     (0.f),
+    m_sleepMaxSpeed     (0.f),
+    m_sleepEmitCount    (0)
 {
 
 }
@@ -124,6 +131,10 @@ bool EmitterSettings::loadFromFile(const std::string& path, cro::TextureResource
                     blendmode = EmitterSettings::Alpha;
                 }
             }
+            else if (name == "depth_sort")
+            {
+                depthSort = p.getValue<bool>();
+            }
             else if (name == "acceleration")
             {
                 acceleration = p.getValue<float>();
@@ -285,6 +296,7 @@ bool EmitterSettings::saveToFile(const std::string& path)
     {
         cfg.addProperty("blendmode", "alpha");
     }
+    cfg.addProperty("depth_sort").setValue(depthSort);
 
     cfg.addProperty("acceleration").setValue(acceleration);
     cfg.addProperty("gravity").setValue(gravity);
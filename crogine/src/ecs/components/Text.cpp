@@ -71,7 +71,7 @@ void Text::setString(const String& str)
     if (m_context.string != str)
     {
         m_context.string = str;
-        m_dirtyFlags |= DirtyFlags::All;
+        m_dirtyFlags |= DirtyFlags::String;
     }
 }
 
@@ -190,36 +190,17 @@ FloatRect Text::getLocalBounds(Entity entity)
         //check if only the colour needs updating
         if (text.m_dirtyFlags == DirtyFlags::Colour)
         {
-            auto& verts = drawable.getVertexData();
-
-            if (text.m_context.outlineThickness == 0)
-            {
-                for (auto v : verts)
-                {
-                    v.colour = text.m_context.fillColour;
-                }
-            }
-            else
-            {
-                for (auto i = 0u; i < verts.size(); ++i)
-                {
-                    if (i < verts.size() / 2)
-                    {
-                        verts[i].colour = text.m_context.outlineColour;
-                    }
-                    else
-                    {
-                        verts[i].colour = text.m_context.fillColour;
-                    }
-                }
-            }
+            Detail::Text::updateColours(drawable.getVertexData(), text.m_context);
         }
         else
         {
             text.updateVertices(drawable);
             drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
             drawable.setPrimitiveType(GL_TRIANGLES);
-            text.m_dirtyFlags = 0;
+
+            //leaves the TextSystem to apply the distance field
+            //shader and its uniforms, which it does for any update
+            text.m_dirtyFlags = DirtyFlags::Colour;
         }
     }
     return drawable.getLocalBounds();
@@ -236,6 +217,16 @@ void Text::setAlignment(Text::Alignment alignment)
 
 //private
 void Text::updateVertices(Drawable2D& drawable)
+{
+    Detail::Text::Layout layout;
+    if (m_context.font && !m_context.string.empty())
+    {
+        Detail::Text::updateLayout(layout, m_context);
+    }
+    updateVertices(drawable, layout);
+}
+
+void Text::updateVertices(Drawable2D& drawable, const Detail::Text::Layout& layout)
 {
     m_dirtyFlags = 0;
 
@@ -250,7 +241,7 @@ void Text::updateVertices(Drawable2D& drawable)
     
     //update glyphs
     auto& vertices = drawable.getVertexData();
-    localBounds = Detail::Text::updateVertices(vertices, m_context);
+    localBounds = Detail::Text::buildVertices(vertices, layout, m_context);
 
     auto maxY = localBounds.bottom + localBounds.height;
 
@@ -40,20 +40,54 @@ source distribution.
 #include <crogine/core/App.hpp>
 #include <crogine/util/Matrix.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace cro;
 
+namespace
+{
+    constexpr std::uint32_t DefaultMaxVoices = 64;
+
+    //emitters quieter than this at the listener are always virtualised
+    constexpr float MinAudibleGain = 0.001f;
+
+    //scoring weights. Priority outweighs any volume, while age
+    //and hysteresis only break near ties between similar sounds
+    constexpr float PriorityWeight = 100.f;
+    constexpr float AgeWeight = 0.01f;
+    constexpr float MaxAgePenalty = 0.1f;
+    constexpr float VoiceHysteresis = 0.05f;
+
+    //streams can't be tracked virtually so always win
+    constexpr float StreamBonus = 1000000.f;
+
+    //matches the inverse distance clamped model used by the renderers
+    float getAttenuation(float distance, float rolloff)
+    {
+        return 1.f / (1.f + (rolloff * (std::max(distance, 1.f) - 1.f)));
+    }
+}
+
 AudioSystem::AudioSystem(MessageBus& mb)
-    : System(mb, typeid(AudioSystem))
+    : System            (mb, typeid(AudioSystem)),
+    m_maxVoices         (DefaultMaxVoices),
+    m_realVoiceCount    (0),
+    m_virtualVoiceCount (0)
 {
     requireComponent<AudioEmitter>();
+    m_channelVolumes.fill(-1.f);
 }
 
+AudioSystem::~AudioSystem() = default;
+
 //public
-void AudioSystem::process(float)
+void AudioSystem::process(float dt)
 {
     //update the scene's listener details
     const auto& listener = getScene()->getActiveListener();
-    AudioRenderer::setListenerVolume(listener.getComponent<AudioListener>().getVolume() * AudioMixer::m_masterVol);
+    const auto listenerVolume = listener.getComponent<AudioListener>().getVolume() * AudioMixer::m_masterVol;
+    AudioRenderer::setListenerVolume(listenerVolume);
     AudioRenderer::setListenerVelocity(listener.getComponent<AudioListener>().getVelocity());
     
     const auto& tx = listener.getComponent<Transform>();
@@ -65,6 +99,23 @@ void AudioSystem::process(float)
     AudioRenderer::setListenerOrientation(Util::Matrix::getForwardVector(worldTx), Util::Matrix::getUpVector(worldTx));
     //DPRINT("Listener Position", std::to_string(worldPos.x) + ", " + std::to_string(worldPos.y) + ", " + std::to_string(worldPos.z));
 
+    //mixer channels are global so any changes need
+    //to be applied to all the emitters on the channel
+    std::uint32_t changedChannels = 0;
+    for (auto i = 0u; i < m_channelVolumes.size(); ++i)
+    {
+        const auto volume = AudioMixer::m_channels[i] * AudioMixer::m_prefadeChannels[i];
+        if (volume != m_channelVolumes[i])
+        {
+            m_channelVolumes[i] = volume;
+            changedChannels |= (1 << i);
+        }
+    }
+
+    m_candidates.clear();
+    m_idleVoices.clear();
+    std::uint32_t voiceCount = 0;
+
     //for each entity
     auto& entities = getEntities();
     for (auto& entity : entities)
@@ -76,87 +127,303 @@ void AudioSystem::process(float)
             continue;
         }
 
+        const bool streaming = (audioSource.m_sourceType == AudioSource::Type::Stream);
+
+        if (changedChannels & (1 << audioSource.m_mixerChannel))
+        {
+            audioSource.m_dirtyFlags |= AudioEmitter::DirtyVolume;
+        }
+
         //check its flags and update
         if (audioSource.m_newDataSource)
         {
-            if (audioSource.m_ID < 1)
-            {
-                //request a new source if this emitter is not yet used
-                audioSource.m_ID = AudioRenderer::requestAudioSource(audioSource.m_dataSourceID, (audioSource.m_sourceType == AudioSource::Type::Stream));
-            }
-            else
+            //new sources are requested when the emitter is given a voice
+            if (audioSource.m_ID > 0)
             {
                 //update the existing source
-                AudioRenderer::updateAudioSource(audioSource.m_ID, audioSource.m_dataSourceID, (audioSource.m_sourceType == AudioSource::Type::Stream));
+                AudioRenderer::updateAudioSource(audioSource.m_ID, audioSource.m_dataSourceID, streaming);
             }
+            audioSource.m_duration = streaming ? 0.f : AudioRenderer::getBufferDuration(audioSource.m_dataSourceID).asSeconds();
             audioSource.m_newDataSource = false;
         }
 
-
-        if ((audioSource.m_transportFlags & AudioEmitter::Play)
-            /*&& audioSource.m_state != AudioEmitter::State::Playing*/)
-        {
-            bool loop = (audioSource.m_transportFlags & AudioEmitter::Looped);
-            AudioRenderer::playSource(audioSource.m_ID, loop);
-        }
-        else if (audioSource.m_transportFlags & AudioEmitter::Pause)
-        {
-            AudioRenderer::pauseSource(audioSource.m_ID);
-        }
-        else if (audioSource.m_transportFlags & AudioEmitter::Stop)
+        const bool looped = (audioSource.m_transportFlags & AudioEmitter::Looped);
+        if (audioSource.m_transportFlags & AudioEmitter::GotoOffset)
         {
-            AudioRenderer::stopSource(audioSource.m_ID);
+            audioSource.m_playTime = audioSource.m_playingOffset.asSeconds();
         }
 
-        if (audioSource.m_transportFlags & AudioEmitter::GotoOffset)
+        if (audioSource.m_ID > 0)
         {
-            AudioRenderer::setPlayingOffset(audioSource.m_ID, audioSource.m_playingOffset);
+            if ((audioSource.m_transportFlags & AudioEmitter::Play)
+                /*&& audioSource.m_state != AudioEmitter::State::Playing*/)
+            {
+                AudioRenderer::playSource(audioSource.m_ID, looped);
+            }
+            else if (audioSource.m_transportFlags & AudioEmitter::Pause)
+            {
+                AudioRenderer::pauseSource(audioSource.m_ID);
+            }
+            else if (audioSource.m_transportFlags & AudioEmitter::Stop)
+            {
+                AudioRenderer::stopSource(audioSource.m_ID);
+            }
+
+            if (audioSource.m_transportFlags & AudioEmitter::GotoOffset)
+            {
+                AudioRenderer::setPlayingOffset(audioSource.m_ID, audioSource.m_playingOffset);
+            }
+
+            //check the actual state as we may have stopped...
+            audioSource.m_state = static_cast<AudioEmitter::State>(AudioRenderer::getSourceState(audioSource.m_ID));
+            voiceCount++;
         }
+        //else virtual emitters keep the state set by the emitter
+
+        //sounds started this frame have not played yet, so their play time
+        //is not advanced, else the deferred start below would skip ahead
+        const bool started = (audioSource.m_transportFlags & AudioEmitter::Play);
 
         //reset all flags, but preserve Loop flag
         audioSource.m_transportFlags &= AudioEmitter::Looped;
-        //check the actual state as we may have stopped...
-        audioSource.m_state = static_cast<AudioEmitter::State>(AudioRenderer::getSourceState(audioSource.m_ID));
 
 
-        //check properties such as pitch and gain
         if (audioSource.m_state == AudioEmitter::State::Playing)
         {
-            //hmm these are static funcs so could be called directly by component setters, no?
-            AudioRenderer::setSourcePitch(audioSource.m_ID, audioSource.m_pitch);
-            AudioRenderer::setSourceVolume(audioSource.m_ID, audioSource.m_volume * AudioMixer::m_channels[audioSource.m_mixerChannel] * AudioMixer::m_prefadeChannels[audioSource.m_mixerChannel]);
-            AudioRenderer::setSourceRolloff(audioSource.m_ID, audioSource.m_rolloff);
-            AudioRenderer::setSourceVelocity(audioSource.m_ID, audioSource.m_velocity);
+            //track the play position so we know where to
+            //resume should we be virtualised, or promoted
+            if (!started)
+            {
+                audioSource.m_playTime += dt * audioSource.m_pitch;
+            }
+            audioSource.m_age += dt;
+
+            if (audioSource.m_duration > 0)
+            {
+                if (audioSource.m_playTime >= audioSource.m_duration)
+                {
+                    if (looped)
+                    {
+                        audioSource.m_playTime = std::fmod(audioSource.m_playTime, audioSource.m_duration);
+                    }
+                    else if (audioSource.m_ID < 1)
+                    {
+                        //virtual sounds end here, real ones when the renderer says so
+                        audioSource.m_state = AudioEmitter::State::Stopped;
+                        audioSource.m_playTime = 0.f;
+                        continue;
+                    }
+                }
+            }
+            else if (!streaming
+                && audioSource.m_ID < 1
+                && !looped)
+            {
+                //we can't tell when this would have ended, so it might
+                //as well end now rather than resume at the wrong place
+                if (audioSource.m_playTime > 0)
+                {
+                    audioSource.m_state = AudioEmitter::State::Stopped;
+                    audioSource.m_playTime = 0.f;
+                    continue;
+                }
+            }
 
-            //check its position and update
+            //score the emitter by how much it matters right now
+            auto& candidate = m_candidates.emplace_back();
+            candidate.emitter = &audioSource;
             if (entity.hasComponent<Transform>())
             {
-                //set position
-                auto pos = entity.getComponent<Transform>().getWorldPosition();
-                AudioRenderer::setSourcePosition(audioSource.m_ID, pos);
+                candidate.position = entity.getComponent<Transform>().getWorldPosition();
             }
+
+            const auto gain = audioSource.m_volume * m_channelVolumes[audioSource.m_mixerChannel] * listenerVolume
+                * getAttenuation(glm::length(candidate.position - worldPos), audioSource.m_rolloff);
+
+            candidate.audible = gain > MinAudibleGain;
+            candidate.score = (static_cast<float>(audioSource.m_priority) * PriorityWeight) + gain
+                - std::min(audioSource.m_age * AgeWeight, MaxAgePenalty);
+
+            if (audioSource.m_ID > 0)
+            {
+                candidate.score += VoiceHysteresis;
+            }
+
+            if (streaming)
+            {
+                candidate.score += StreamBonus;
+                candidate.audible = true;
+            }
+        }
+        else if (audioSource.m_ID > 0)
+        {
+            //voices which can be taken if they're needed
+            m_idleVoices.push_back(&audioSource);
         }
     }
-}
 
-//private
-void AudioSystem::onEntityAdded(Entity entity)
-{
-    //check if buffer already added and summon new audio source
-    auto& audioSource = entity.getComponent<AudioEmitter>();
-    if(AudioRenderer::isValid())
+    //sort so the first m_maxVoices emitters are the ones which get voices
+    const auto realCount = std::min(static_cast<std::size_t>(m_maxVoices), m_candidates.size());
+    std::partial_sort(m_candidates.begin(), m_candidates.begin() + realCount, m_candidates.end(),
+        [](const Candidate& a, const Candidate& b)
+        {
+            return a.score > b.score;
+        });
+
+    //free the voices of those which missed out first
+    m_virtualVoiceCount = 0;
+    for (auto i = 0u; i < m_candidates.size(); ++i)
     {
-        if (audioSource.m_newDataSource)
+        auto& candidate = m_candidates[i];
+        if (i >= realCount || !candidate.audible)
         {
-            if (audioSource.m_ID < 1)
+            if (candidate.emitter->m_ID > 0)
             {
-                //request a new source if this emitter is not yet used
-                audioSource.m_ID = AudioRenderer::requestAudioSource(audioSource.m_dataSourceID, (audioSource.m_sourceType == AudioSource::Type::Stream));
+                demote(*candidate.emitter);
+                voiceCount--;
             }
-            audioSource.m_newDataSource = false;
+            m_virtualVoiceCount++;
         }
     }
-    else
+
+    //then give voices to those which need them
+    m_realVoiceCount = 0;
+    for (auto i = 0u; i < realCount; ++i)
+    {
+        auto& candidate = m_candidates[i];
+        if (!candidate.audible)
+        {
+            continue;
+        }
+
+        auto& emitter = *candidate.emitter;
+        if (emitter.m_ID < 1)
+        {
+            //take a voice from an idle emitter if we're at the limit
+            if (voiceCount >= m_maxVoices
+                && !m_idleVoices.empty())
+            {
+                demote(*m_idleVoices.back());
+                m_idleVoices.pop_back();
+                voiceCount--;
+            }
+
+            if (voiceCount < m_maxVoices)
+            {
+                promote(emitter);
+            }
+
+            if (emitter.m_ID > 0)
+            {
+                voiceCount++;
+            }
+            else
+            {
+                //the renderer may have run out
+                m_virtualVoiceCount++;
+                continue;
+            }
+        }
+
+        updateSource(emitter, candidate.position);
+        m_realVoiceCount++;
+    }
+
+    AudioRenderer::updateSources(m_sourceUpdates);
+    m_sourceUpdates.clear();
+
+    //only start new voices once their properties are set
+    //so that nothing is heard in the wrong place
+    for (auto* emitter : m_promoted)
+    {
+        const bool streaming = (emitter->m_sourceType == AudioSource::Type::Stream);
+        AudioRenderer::playSource(emitter->m_ID, emitter->m_transportFlags & AudioEmitter::Looped);
+        if (emitter->m_playTime > 0
+            && !streaming)
+        {
+            AudioRenderer::setPlayingOffset(emitter->m_ID, cro::seconds(emitter->m_playTime));
+        }
+    }
+    m_promoted.clear();
+}
+
+//private
+void AudioSystem::promote(AudioEmitter& emitter)
+{
+    const bool streaming = (emitter.m_sourceType == AudioSource::Type::Stream);
+    emitter.m_ID = AudioRenderer::requestAudioSource(emitter.m_dataSourceID, streaming);
+
+    if (emitter.m_ID > 0)
+    {
+        //the new source needs all its properties set
+        emitter.m_dirtyFlags = AudioEmitter::DirtyAll;
+        m_promoted.push_back(&emitter);
+    }
+}
+
+void AudioSystem::demote(AudioEmitter& emitter)
+{
+    //the emitter state is left as is, so playing emitters continue virtually
+    AudioRenderer::stopSource(emitter.m_ID);
+    AudioRenderer::deleteAudioSource(emitter.m_ID);
+    emitter.m_ID = -1;
+}
+
+void AudioSystem::updateSource(AudioEmitter& audioSource, glm::vec3 position)
+{
+    //position is taken from the world transform, which
+    //doesn't tell us when it changes, so compare it
+    if (position != audioSource.m_lastPosition)
+    {
+        audioSource.m_dirtyFlags |= AudioEmitter::DirtyPosition;
+    }
+
+    if (audioSource.m_dirtyFlags == 0)
+    {
+        return;
+    }
+
+    auto& update = m_sourceUpdates.emplace_back();
+    update.source = audioSource.m_ID;
+
+    if (audioSource.m_dirtyFlags & AudioEmitter::DirtyPosition)
+    {
+        update.flags |= AudioSourceUpdate::Position;
+        update.position = position;
+        audioSource.m_lastPosition = position;
+    }
+
+    if (audioSource.m_dirtyFlags & AudioEmitter::DirtyVelocity)
+    {
+        update.flags |= AudioSourceUpdate::Velocity;
+        update.velocity = audioSource.m_velocity;
+    }
+
+    if (audioSource.m_dirtyFlags & AudioEmitter::DirtyPitch)
+    {
+        update.flags |= AudioSourceUpdate::Pitch;
+        update.pitch = audioSource.m_pitch;
+    }
+
+    if (audioSource.m_dirtyFlags & AudioEmitter::DirtyVolume)
+    {
+        update.flags |= AudioSourceUpdate::Volume;
+        update.volume = audioSource.m_volume * m_channelVolumes[audioSource.m_mixerChannel];
+    }
+
+    if (audioSource.m_dirtyFlags & AudioEmitter::DirtyRolloff)
+    {
+        update.flags |= AudioSourceUpdate::Rolloff;
+        update.rolloff = audioSource.m_rolloff;
+    }
+
+    audioSource.m_dirtyFlags = 0;
+}
+
+void AudioSystem::onEntityAdded(Entity entity)
+{
+    //sources are requested when the emitter is first given a voice
+    if (!AudioRenderer::isValid())
     {
         getEntities().pop_back(); //no entity for you!
     }
@@ -37,6 +37,81 @@ source distribution.
 
 using namespace cro;
 
+namespace
+{
+    constexpr std::size_t MinBufferCapacity = 16; //quads
+    constexpr std::size_t IndicesPerQuad = 6;
+    constexpr std::size_t VerticesPerQuad = 4;
+
+    void addQuadVertices(const Billboard& quad, std::vector<float>& vertexData)
+    {
+        //the base position of the quad is stored in the vertex Normal data
+        //rather than any actual normal data.
+        const std::array<glm::vec2, VerticesPerQuad> corners =
+        {
+            glm::vec2(0.f), glm::vec2(1.f, 0.f), glm::vec2(1.f), glm::vec2(0.f, 1.f)
+        };
+
+        for (auto corner : corners)
+        {
+            //position
+            vertexData.push_back(-quad.origin.x + (quad.size.x * corner.x));
+            vertexData.push_back(-quad.origin.y + (quad.size.y * corner.y));
+            vertexData.push_back(0.f);
+
+            //colour
+            vertexData.push_back(quad.colour.getRed());
+            vertexData.push_back(quad.colour.getGreen());
+            vertexData.push_back(quad.colour.getBlue());
+            vertexData.push_back(quad.colour.getAlpha());
+
+            //normal (actually root position)
+            vertexData.push_back(quad.position.x);
+            vertexData.push_back(quad.position.y);
+            vertexData.push_back(quad.position.z);
+
+            //tex coords
+            vertexData.push_back(quad.textureRect.left + (quad.textureRect.width * corner.x));
+            vertexData.push_back(quad.textureRect.bottom + (quad.textureRect.height * corner.y));
+
+            //quad size (used when billboards are fixed to screen size)
+            vertexData.push_back(quad.size.x);
+            vertexData.push_back(quad.size.y);
+        }
+    }
+
+    void updateBounds(const Billboard& quad, Mesh::Data& meshData)
+    {
+        //min point - not strictly accurate but enough to encompass the bounds
+        if (meshData.boundingBox[0].x > quad.position.x - quad.size.x)
+        {
+            meshData.boundingBox[0].x = quad.position.x - quad.size.x;
+        }
+        if (meshData.boundingBox[0].y > quad.position.y - quad.size.y)
+        {
+            meshData.boundingBox[0].y = quad.position.y - quad.size.y;
+        }
+        if (meshData.boundingBox[0].z > quad.position.z)
+        {
+            meshData.boundingBox[0].z = quad.position.z;
+        }
+
+        //maxpoint
+        if (meshData.boundingBox[1].x < quad.position.x + quad.size.x)
+        {
+            meshData.boundingBox[1].x = quad.position.x + quad.size.x;
+        }
+        if (meshData.boundingBox[1].y < quad.position.y + quad.size.y)
+        {
+            meshData.boundingBox[1].y = quad.position.y + quad.size.y;
+        }
+        if (meshData.boundingBox[1].z < quad.position.z)
+        {
+            meshData.boundingBox[1].z = quad.position.z;
+        }
+    }
+}
+
 BillboardSystem::BillboardSystem(MessageBus& mb)
     : System(mb, typeid(BillboardSystem))
 {
@@ -52,172 +127,75 @@ void BillboardSystem::process(float)
         auto& bbc = entity.getComponent<BillboardCollection>();
         if (bbc.m_dirty)
         {
-            //update the model data
-            std::vector<float> vertexData;
-            std::vector<std::uint32_t> indexData;
             auto& meshData = entity.getComponent<cro::Model>().getMeshData();
+            const auto& quads = bbc.m_billboards;
+            const auto quadSize = meshData.vertexSize * VerticesPerQuad;
 
-            //boundingbox
-            meshData.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
-            meshData.boundingBox[1] = glm::vec3(std::numeric_limits<float>::lowest());
+            //boundingbox - removing billboards doesn't shrink this
+            //but it remains large enough to encompass the geometry
+            if (bbc.m_resetBounds)
+            {
+                meshData.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
+                meshData.boundingBox[1] = glm::vec3(std::numeric_limits<float>::lowest());
+                bbc.m_resetBounds = false;
+            }
 
-            const auto& quads = bbc.m_billboards;
-            for (const auto& quad : quads)
+            glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+
+            //grow the buffers if needed, in which case everything needs uploading
+            if (quads.size() > bbc.m_bufferCapacity)
             {
-                //the base position of the quad is stored in the vertex Normal data
-                //rather than any actual normal data.
-                auto baseIndex = static_cast<std::uint32_t>(vertexData.size() / (meshData.vertexSize / sizeof(float)));
-
-                //position
-                vertexData.push_back(-quad.origin.x);
-                vertexData.push_back(-quad.origin.y);
-                vertexData.push_back(0.f);
-
-                //colour
-                vertexData.push_back(quad.colour.getRed());
-                vertexData.push_back(quad.colour.getGreen());
-                vertexData.push_back(quad.colour.getBlue());
-                vertexData.push_back(quad.colour.getAlpha());
-
-                //normal (actually root position)
-                vertexData.push_back(quad.position.x);
-                vertexData.push_back(quad.position.y);
-                vertexData.push_back(quad.position.z);
-
-                //tex coords
-                vertexData.push_back(quad.textureRect.left);
-                vertexData.push_back(quad.textureRect.bottom);
-
-                //quad size (used when billboards are fixed to screen size)
-                vertexData.push_back(quad.size.x);
-                vertexData.push_back(quad.size.y);
-
-                //--------------------
-
-                //position
-                vertexData.push_back(-quad.origin.x + quad.size.x);
-                vertexData.push_back(-quad.origin.y);
-                vertexData.push_back(0.f);
-
-                //colour
-                vertexData.push_back(quad.colour.getRed());
-                vertexData.push_back(quad.colour.getGreen());
-                vertexData.push_back(quad.colour.getBlue());
-                vertexData.push_back(quad.colour.getAlpha());
-
-                //normal (actually root position)
-                vertexData.push_back(quad.position.x);
-                vertexData.push_back(quad.position.y);
-                vertexData.push_back(quad.position.z);
-
-                //tex coords
-                vertexData.push_back(quad.textureRect.left + quad.textureRect.width);
-                vertexData.push_back(quad.textureRect.bottom);
-
-                //quad size (used when billboards are fixed to screen size)
-                vertexData.push_back(quad.size.x);
-                vertexData.push_back(quad.size.y);
-
-                //--------------------
-
-                //position
-                vertexData.push_back(-quad.origin.x + quad.size.x);
-                vertexData.push_back(-quad.origin.y + quad.size.y);
-                vertexData.push_back(0.f);
-
-                //colour
-                vertexData.push_back(quad.colour.getRed());
-                vertexData.push_back(quad.colour.getGreen());
-                vertexData.push_back(quad.colour.getBlue());
-                vertexData.push_back(quad.colour.getAlpha());
-
-                //normal (actually root position)
-                vertexData.push_back(quad.position.x);
-                vertexData.push_back(quad.position.y);
-                vertexData.push_back(quad.position.z);
-
-                //tex coords
-                vertexData.push_back(quad.textureRect.left + quad.textureRect.width);
-                vertexData.push_back(quad.textureRect.bottom + quad.textureRect.height);
-
-                //quad size (used when billboards are fixed to screen size)
-                vertexData.push_back(quad.size.x);
-                vertexData.push_back(quad.size.y);
-
-                //-------------------
-
-                //position
-                vertexData.push_back(-quad.origin.x);
-                vertexData.push_back(-quad.origin.y + quad.size.y);
-                vertexData.push_back(0.f);
-
-                //colour
-                vertexData.push_back(quad.colour.getRed());
-                vertexData.push_back(quad.colour.getGreen());
-                vertexData.push_back(quad.colour.getBlue());
-                vertexData.push_back(quad.colour.getAlpha());
-
-                //normal (actually root position)
-                vertexData.push_back(quad.position.x);
-                vertexData.push_back(quad.position.y);
-                vertexData.push_back(quad.position.z);
-
-                //tex coords
-                vertexData.push_back(quad.textureRect.left);
-                vertexData.push_back(quad.textureRect.bottom + quad.textureRect.height);
-
-                //quad size (used when billboards are fixed to screen size)
-                vertexData.push_back(quad.size.x);
-                vertexData.push_back(quad.size.y);
-
-                //min point - not strictly accurate but enough to encompass the bounds
-                if (meshData.boundingBox[0].x > quad.position.x - quad.size.x)
-                {
-                    meshData.boundingBox[0].x = quad.position.x - quad.size.x;
-                }
-                if (meshData.boundingBox[0].y > quad.position.y - quad.size.y)
-                {
-                    meshData.boundingBox[0].y = quad.position.y - quad.size.y;
-                }
-                if (meshData.boundingBox[0].z > quad.position.z)
-                {
-                    meshData.boundingBox[0].z = quad.position.z;
-                }
+                bbc.m_bufferCapacity = std::max(MinBufferCapacity, std::max(bbc.m_bufferCapacity * 2, quads.size()));
+                glCheck(glBufferData(GL_ARRAY_BUFFER, bbc.m_bufferCapacity * quadSize, nullptr, GL_DYNAMIC_DRAW));
+                std::fill(bbc.m_dirtyFlags.begin(), bbc.m_dirtyFlags.end(), 1);
 
-                //maxpoint
-                if (meshData.boundingBox[1].x < quad.position.x + quad.size.x)
+                //the index data is the same for any collection so we
+                //only need to generate more if this is the largest so far
+                for (auto i = m_indexData.size() / IndicesPerQuad; i < bbc.m_bufferCapacity; ++i)
                 {
-                    meshData.boundingBox[1].x = quad.position.x + quad.size.x;
+                    auto baseIndex = static_cast<std::uint32_t>(i * VerticesPerQuad);
+
+                    //two tris
+                    m_indexData.push_back(baseIndex);
+                    m_indexData.push_back(baseIndex + 2);
+                    m_indexData.push_back(baseIndex + 3);
+
+                    m_indexData.push_back(baseIndex + 2);
+                    m_indexData.push_back(baseIndex);
+                    m_indexData.push_back(baseIndex + 1);
                 }
-                if (meshData.boundingBox[1].y < quad.position.y + quad.size.y)
+
+                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[0].ibo));
+                glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, bbc.m_bufferCapacity * IndicesPerQuad * sizeof(std::uint32_t), m_indexData.data(), GL_STATIC_DRAW));
+                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+            }
+
+            //upload each contiguous run of modified quads
+            std::size_t i = 0;
+            while (i < quads.size())
+            {
+                if (!bbc.m_dirtyFlags[i])
                 {
-                    meshData.boundingBox[1].y = quad.position.y + quad.size.y;
+                    i++;
+                    continue;
                 }
-                if (meshData.boundingBox[1].z < quad.position.z)
+
+                const auto start = i;
+                m_vertexData.clear();
+                while (i < quads.size() && bbc.m_dirtyFlags[i])
                 {
-                    meshData.boundingBox[1].z = quad.position.z;
+                    addQuadVertices(quads[i], m_vertexData);
+                    updateBounds(quads[i], meshData);
+                    bbc.m_dirtyFlags[i] = 0;
+                    i++;
                 }
 
-
-                //two tris
-                indexData.push_back(baseIndex);
-                indexData.push_back(baseIndex + 2);
-                indexData.push_back(baseIndex + 3);
-
-                indexData.push_back(baseIndex + 2);
-                indexData.push_back(baseIndex);
-                indexData.push_back(baseIndex + 1);
-
+                glCheck(glBufferSubData(GL_ARRAY_BUFFER, start * quadSize, m_vertexData.size() * sizeof(float), m_vertexData.data()));
             }
-
-            meshData.vertexCount = vertexData.size() / (meshData.vertexSize / sizeof(float));
-            glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-            glCheck(glBufferData(GL_ARRAY_BUFFER, vertexData.size() * sizeof(float), vertexData.data(), GL_DYNAMIC_DRAW));
             glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
-            meshData.indexData[0].indexCount = static_cast<std::uint32_t>(indexData.size());
-            glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[0].ibo));
-            glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size() * sizeof(std::uint32_t), indexData.data(), GL_DYNAMIC_DRAW));
+            meshData.vertexCount = quads.size() * VerticesPerQuad;
+            meshData.indexData[0].indexCount = static_cast<std::uint32_t>(quads.size() * IndicesPerQuad);
 
             //update bounding sphere
             auto rad = (meshData.boundingBox[1] - meshData.boundingBox[0]) / 2.f;
@@ -227,4 +205,4 @@ void BillboardSystem::process(float)
             bbc.m_dirty = false;
         }
     }
-}
\ No newline at end of file
+}
@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/App.hpp>
 #include <crogine/core/Console.hpp>
+#include <crogine/graphics/TextureMemory.hpp>
 
 using namespace cro;
 
@@ -59,4 +60,21 @@ void DebugInfo::process(float)
 
         Console::printStat("Entity " + std::to_string(e.getIndex()), op);
     }
+
+    static constexpr float MB = 1024.f * 1024.f;
+    const auto stats = TextureMemory::getStats();
+
+    std::string mem = std::to_string(static_cast<float>(stats.total) / MB) + "MB";
+    if (stats.budget)
+    {
+        mem += " / " + std::to_string(static_cast<float>(stats.budget) / MB) + "MB";
+    }
+    mem += " (" + std::to_string(stats.evictedCount) + " evicted)";
+    Console::printStat("Texture Memory", mem);
+
+    for (auto i = 0u; i < TextureMemory::Count; ++i)
+    {
+        const auto cat = static_cast<TextureMemory::Category>(i);
+        Console::printStat(std::string("  ") + TextureMemory::getCategoryName(cat), std::to_string(static_cast<float>(stats.categoryTotals[i]) / MB) + "MB");
+    }
 }
\ No newline at end of file
@@ -28,6 +28,8 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextureRegistry.hpp"
+#include "../../detail/VertexFormat.hpp"
 
 #include <crogine/core/Clock.hpp>
 #include <crogine/core/Console.hpp>
@@ -206,9 +208,10 @@ void ModelRenderer::render(Entity camera, const RenderTarget& rt)
                 const auto& attribs = model.m_materials[Mesh::IndexData::Final][i].attribs;
                 for (auto j = 0u; j < model.m_materials[Mesh::IndexData::Final][i].attribCount; ++j)
                 {
+                    const auto format = static_cast<std::uint8_t>(attribs[j][Material::Data::Format]);
                     glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
                     glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                        GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                        Detail::getAttributeType(format), Detail::isAttributeNormalised(format), static_cast<GLsizei>(model.m_meshData.vertexSize),
                         reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
                 }
 
@@ -525,6 +528,7 @@ void ModelRenderer::applyProperties(const Material::Data& material, const Model&
             //TODO textures need to track which unit they're currently bound
             //to so that they don't get bound to multiple units
             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
+            Detail::TextureRegistry::markUsed(prop.second.second.textureID);
             glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
             glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
             break;
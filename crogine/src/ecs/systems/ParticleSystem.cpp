@@ -41,6 +41,7 @@ source distribution.
 #include <crogine/util/Constants.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextureRegistry.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtx/norm.hpp>
@@ -169,6 +170,43 @@ namespace
     const std::size_t MinParticleSystems = 4; //min amount before resizing - this many added on resize (so don't make too large!!)
     const std::size_t VertexSize = 10 * sizeof(float); //pos, colour, rotation/scale vert attribs
 
+    const std::uint32_t DefaultSleepFrameCount = 30;
+    const std::size_t MaxWorkerThreads = 4;
+    const std::size_t MinParallelEmitters = 8; //below this it's not worth waking the workers
+
+
+    //sorts indices by key with an LSD radix sort, one byte at a time.
+    //keys and indices are sorted in place, using the temp buffers as scratch
+    void radixSort(std::vector<std::uint16_t>& keys, std::vector<std::uint16_t>& indices,
+        std::vector<std::uint16_t>& tempKeys, std::vector<std::uint16_t>& tempIndices, std::size_t count)
+    {
+        for (auto shift = 0u; shift < 16u; shift += 8u)
+        {
+            std::array<std::size_t, 256u> offsets = {};
+            for (auto i = 0u; i < count; ++i)
+            {
+                offsets[(keys[i] >> shift) & 0xff]++;
+            }
+
+            std::size_t total = 0;
+            for (auto& offset : offsets)
+            {
+                auto c = offset;
+                offset = total;
+                total += c;
+            }
+
+            for (auto i = 0u; i < count; ++i)
+            {
+                auto dst = offsets[(keys[i] >> shift) & 0xff]++;
+                tempKeys[dst] = keys[i];
+                tempIndices[dst] = indices[i];
+            }
+
+            keys.swap(tempKeys);
+            indices.swap(tempIndices);
+        }
+    }
 
     bool inFrustum(const Frustum& frustum, const ParticleEmitter& emitter)
     {
@@ -186,11 +224,17 @@ namespace
 ParticleSystem::ParticleSystem(MessageBus& mb)
     : System            (mb, typeid(ParticleSystem)),
     m_drawLists         (1),
-    m_dataBuffer        (MaxVertData),
     m_vboIDs            (MaxParticleSystems),
     m_vaoIDs            (MaxParticleSystems),
+    m_iboIDs            (MaxParticleSystems),
     m_nextBuffer        (0),
-    m_bufferCount       (0)
+    m_bufferCount       (0),
+    m_sleepFrameCount   (DefaultSleepFrameCount),
+    m_nextJob           (0),
+    m_pendingWorkers    (0),
+    m_workGeneration    (0),
+    m_threadsRunning    (true),
+    m_frameTime         (0.f)
 {
     for (auto& vbo : m_vboIDs)
     {
@@ -203,6 +247,17 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
         vao = 0;
     }
 
+    for (auto& ibo : m_iboIDs)
+    {
+        ibo = 0;
+    }
+
+    m_sortDepths.resize(ParticleEmitter::MaxParticles);
+    m_sortKeys.resize(ParticleEmitter::MaxParticles);
+    m_sortIndices.resize(ParticleEmitter::MaxParticles);
+    m_sortKeysTemp.resize(ParticleEmitter::MaxParticles);
+    m_sortIndicesTemp.resize(ParticleEmitter::MaxParticles);
+
     requireComponent<Transform>();
     requireComponent<ParticleEmitter>();
 
@@ -263,10 +318,29 @@ ParticleSystem::ParticleSystem(MessageBus& mb)
     cro::Image img;
     img.create(2, 2, cro::Colour::White);
     m_fallbackTexture.loadFromImage(img);
+
+    //the thread calling process() also simulates emitters
+    //so leave one core for it
+    const std::size_t threadCount = std::min(static_cast<std::size_t>(std::thread::hardware_concurrency()), MaxWorkerThreads + 1);
+    for (auto i = 1u; i < threadCount; ++i)
+    {
+        m_workerThreads.emplace_back(std::make_unique<std::thread>(&ParticleSystem::threadFunc, this));
+    }
 }
 
 ParticleSystem::~ParticleSystem()
 {
+    {
+        std::lock_guard<std::mutex> lock(m_workMutex);
+        m_threadsRunning = false;
+    }
+    m_workCondition.notify_all();
+
+    for (auto& thread : m_workerThreads)
+    {
+        thread->join();
+    }
+
     //delete VBOs
     for (auto vbo : m_vboIDs)
     {
@@ -275,6 +349,14 @@ ParticleSystem::~ParticleSystem()
             glCheck(glDeleteBuffers(1, &vbo));
         }
     }
+
+    for (auto ibo : m_iboIDs)
+    {
+        if (ibo)
+        {
+            glCheck(glDeleteBuffers(1, &ibo));
+        }
+    }
 #ifdef PLATFORM_DESKTOP
     for (auto vao : m_vaoIDs)
     {
@@ -308,14 +390,37 @@ void ParticleSystem::updateDrawList(Entity cameraEnt)
         for (auto i = 0; i < passCount; ++i)
         {
             const auto& frustum = cam.getPass(i).getFrustum();
-            if (emitter.m_nextFreeParticle > 0 && inFrustum(frustum, emitter))
+            if (inFrustum(frustum, emitter))
             {
+                //wakes the emitter if it's sleeping - but it won't
+                //be drawn until process() has brought it up to date
                 emitter.m_visible = true;
-                drawlist[i].push_back(entity);
+
+                if (emitter.m_nextFreeParticle > 0
+                    && !emitter.m_sleeping)
+                {
+                    const auto& viewMat = cam.getPass(i).viewMatrix;
+                    float depth = viewMat[0][2] * emitter.m_bounds.centre.x
+                        + viewMat[1][2] * emitter.m_bounds.centre.y
+                        + viewMat[2][2] * emitter.m_bounds.centre.z
+                        + viewMat[3][2];
+
+                    drawlist[i].emplace_back(entity, depth);
+                }
             }
         }
     }
 
+    //sort emitters back to front - view space looks down -z
+    for (auto i = 0; i < passCount; ++i)
+    {
+        std::sort(drawlist[i].begin(), drawlist[i].end(),
+            [](const std::pair<Entity, float>& a, const std::pair<Entity, float>& b)
+            {
+                return a.second < b.second;
+            });
+    }
+
     DPRINT("Visible particle Systems", std::to_string(drawlist[0].size()));
 }
 
@@ -326,191 +431,107 @@ void ParticleSystem::process(float dt)
         handle.boundThisFrame = false;
     }
 
+    m_activeEmitters.clear();
+
+    //spawning, sleeping and waking happen on this thread
+    //as they rely on the Transform and Random generator
     auto& entities = getEntities();
     for (auto& e : entities)
     {
-        //TODO this would be better to iterate over the list of
-        //visible entities and only update those, however for
-        //the visibility check to work every entity needs
-        //updating at least once so we have a calculated bounds
-        //with which to perform a visibility check...
-
-        //check each emitter to see if it should spawn a new particle
         auto& emitter = e.getComponent<ParticleEmitter>();
-        if (emitter.m_running &&
-            emitter.m_emissionClock.elapsed().asSeconds() > (1.f / emitter.settings.emitRate))
-        {
-            //make sure not to update this again unless it gets marked as visible next frame
-            emitter.m_visible = false;
-            
-            //apply fallback texture if one doesn't exist
-            //this would be speedier to do once when adding the emitter to the system
-            //but the texture may change at runtime.
-            if (emitter.settings.textureID == 0)
-            {
-                emitter.settings.textureID = m_fallbackTexture.getGLHandle();
-            }
+        const auto& tx = e.getComponent<Transform>();
 
-            emitter.m_emissionClock.restart();
-            static const float epsilon = 0.0001f;
-            auto emitCount = emitter.settings.emitCount;
-            while (emitCount--)
-            {
-                if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
-                {
-                    auto& tx = e.getComponent<Transform>();
-                    glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
-
-                    const auto& settings = emitter.settings;
-                    CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
-                    CRO_ASSERT(settings.lifetime > 0, "Lifetime must be greater than 0");
-                    auto& p = emitter.m_particles[emitter.m_nextFreeParticle];
-                    p.colour = settings.colour;
-                    p.gravity = settings.gravity;
-                    p.lifetime = settings.lifetime + cro::Util::Random::value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
-                    p.maxLifeTime = p.lifetime;
-
-                    auto randRot = glm::rotate(rotation, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
-                    randRot = glm::rotate(randRot, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
-
-                    auto worldScale = tx.getWorldScale();
-
-                    p.velocity = randRot * settings.initialVelocity;
-                    p.rotation = (settings.randomInitialRotation) ? Util::Random::value(-Util::Const::PI, Util::Const::PI) : 0.f;
-                    p.scale = std::abs((worldScale.x + worldScale.y) / 2.f);// 1.f;
-                    p.acceleration = settings.acceleration;
-                    p.frameID = (settings.useRandomFrame && settings.frameCount > 1) ? cro::Util::Random::value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
-                    p.frameTime = 0.f;
-                    p.loopCount = settings.loopCount;
-
-                    //spawn particle in world position
-                    auto basePosition = tx.getWorldPosition();
-                    p.position = basePosition;
-
-                    //add random radius placement - TODO how to do with a position table? CAN'T HAVE +- 0!!
-                    p.position.x += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
-                    p.position.y += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
-                    p.position.z += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
-
-                    if (emitter.settings.inheritRotation)
-                    {
-                        /*p.position -= basePosition;
-                        p.position = rotation * glm::vec4(p.position, 1.f);
-                        p.position += basePosition;*/
-                        p.velocity = glm::vec3(tx.getWorldTransform() * glm::vec4(p.velocity, 0.0));
-                    }
-
-                    auto offset = settings.spawnOffset;
-                    offset *= worldScale;
-                    p.position += offset;
-
-                    emitter.m_nextFreeParticle++;
-                    if (emitter.m_releaseCount > 0)
-                    {
-                        emitter.m_releaseCount--;
-                    }
-                }
-            }
+        //apply fallback texture if one doesn't exist
+        //this would be speedier to do once when adding the emitter to the system
+        //but the texture may change at runtime.
+        if (emitter.settings.textureID == 0)
+        {
+            emitter.settings.textureID = m_fallbackTexture.getGLHandle();
         }
 
-        if (emitter.m_releaseCount == 0)
+        //visibility is set by updateDrawList() if the emitter
+        //was in the frustum of any camera since we last checked
+        if (emitter.m_visible)
         {
-            emitter.stop();
+            emitter.m_framesHidden = 0;
         }
-
-        //update each particle
-        glm::vec3 minBounds(std::numeric_limits<float>::max());
-        glm::vec3 maxBounds(0.f);
-
-        float framerate = 1.f / emitter.settings.framerate;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        else if (emitter.m_framesHidden < std::numeric_limits<std::uint32_t>::max())
         {
-            auto& p = emitter.m_particles[i];
+            emitter.m_framesHidden++;
+        }
+        emitter.m_visible = false;
 
-            p.velocity += p.gravity * dt;
-            for (auto f : emitter.settings.forces)
+        if (m_sleepFrameCount != 0
+            && emitter.m_framesHidden > m_sleepFrameCount)
+        {
+            if (!emitter.m_sleeping)
             {
-                p.velocity += f * dt;
+                sleep(emitter);
             }
-            p.position += p.velocity * dt;            
-           
-            p.lifetime -= dt;
-            p.colour.setAlpha(std::max(p.lifetime / p.maxLifeTime, 0.f));
+            updateSleeping(emitter, tx, dt);
+            continue;
+        }
 
-            p.rotation += emitter.settings.rotationSpeed * dt;
-            p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+        if (emitter.m_sleeping)
+        {
+            wake(emitter, tx);
+        }
 
-            if (emitter.settings.animate)
+        //check each emitter to see if it should spawn a new particle
+        if (emitter.m_running &&
+            emitter.m_emissionClock.elapsed().asSeconds() > (1.f / emitter.settings.emitRate))
+        {
+            emitter.m_emissionClock.restart();
+            auto emitCount = emitter.settings.emitCount;
+            while (emitCount--)
             {
-                p.frameTime += dt;
-                if (p.frameTime > framerate)
-                {
-                    p.frameID++;
-                    if (p.frameID == emitter.settings.frameCount
-                        && p.loopCount)
-                    {
-                        p.loopCount--;
-                        p.frameID = 0;
-                    }
-                    p.frameTime -= framerate;
-                }
+                spawnParticle(emitter, tx);
             }
-
-            //update bounds for culling
-            if (p.position.x < minBounds.x) minBounds.x = p.position.x;
-            if (p.position.y < minBounds.y) minBounds.y = p.position.y;
-            if (p.position.z < minBounds.z) minBounds.z = p.position.z;
-
-            if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
-            if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
-            if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
         }
-        auto dist = (maxBounds - minBounds) / 2.f;
-        emitter.m_bounds.centre = dist + minBounds;
-        emitter.m_bounds.radius = glm::length(dist);
 
-        //go over again and remove dead particles with pop/swap
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+        if (emitter.m_releaseCount == 0)
         {
-            if (emitter.m_particles[i].lifetime < 0
-                || ((emitter.m_particles[i].frameID == emitter.settings.frameCount)
-                    && (emitter.m_particles[i].loopCount == 0)))
-            {
-                emitter.m_nextFreeParticle--;
-                std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
-            }
+            emitter.stop();
         }
-        //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
 
-        //TODO sort verts by depth? should be drawing back to front for transparency really.
+        m_activeEmitters.push_back(&emitter);
+    }
 
-        //update VBO
-        std::size_t idx = 0;
-        for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    //update the particles of awake emitters in parallel
+    m_frameTime = dt;
+    m_nextJob = 0;
+
+    if (m_workerThreads.empty()
+        || m_activeEmitters.size() < MinParallelEmitters)
+    {
+        runJobs();
+    }
+    else
+    {
         {
-            const auto& p = emitter.m_particles[i];
+            std::lock_guard<std::mutex> lock(m_workMutex);
+            m_pendingWorkers = m_workerThreads.size();
+            m_workGeneration++;
+        }
+        m_workCondition.notify_all();
 
-            //position
-            m_dataBuffer[idx++] = p.position.x;
-            m_dataBuffer[idx++] = p.position.y;
-            m_dataBuffer[idx++] = p.position.z;
+        //this thread also does its share
+        runJobs();
 
-            //colour
-            m_dataBuffer[idx++] = p.colour.getRed();
-            m_dataBuffer[idx++] = p.colour.getGreen();
-            m_dataBuffer[idx++] = p.colour.getBlue();
-            m_dataBuffer[idx++] = p.colour.getAlpha();
+        std::unique_lock<std::mutex> lock(m_workMutex);
+        m_completeCondition.wait(lock, [&]() { return m_pendingWorkers == 0; });
+    }
 
-            //rotation/size/animation
-            m_dataBuffer[idx++] = p.rotation * Util::Const::degToRad;
-            m_dataBuffer[idx++] = p.scale;
-            m_dataBuffer[idx++] = static_cast<float>(p.frameID);
-        }
-        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
-        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, idx * sizeof(float), m_dataBuffer.data()));
+    //and upload the results - this has to be on the GL thread
+    for (const auto* emitter : m_activeEmitters)
+    {
+        glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter->m_vbo));
+        glCheck(glBufferSubData(GL_ARRAY_BUFFER, 0, emitter->m_nextFreeParticle * VertexSize, emitter->m_vertexData.data()));
     }
 
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+
+    DPRINT("Awake particle Systems", std::to_string(m_activeEmitters.size()));
 }
 
 void ParticleSystem::render(Entity camera, const RenderTarget& rt)
@@ -563,7 +584,7 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
 
 
         const auto& entities = m_drawLists[cam.getDrawListIndex()][cam.getActivePassIndex()];
-        for (auto entity : entities)
+        for (auto [entity, depth] : entities)
         {
             //it's possible an entity might be destroyed between adding to the 
             //draw list and render time - hum.
@@ -598,12 +619,25 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
             }
 
             //bind emitter texture
+            Detail::TextureRegistry::markUsed(emitter.settings.textureID);
             glCheck(glBindTexture(GL_TEXTURE_2D, emitter.settings.textureID));
 
+            //other blend modes are order independent
+            const bool sorted = emitter.settings.depthSort
+                && emitter.settings.blendmode == EmitterSettings::Alpha
+                && emitter.m_nextFreeParticle > 1;
 
 #ifdef PLATFORM_DESKTOP
             glCheck(glBindVertexArray(emitter.m_vao));
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
+            if (sorted)
+            {
+                sortParticles(emitter, pass.viewMatrix);
+                glCheck(glDrawElements(GL_POINTS, static_cast<GLsizei>(emitter.m_nextFreeParticle), GL_UNSIGNED_SHORT, 0));
+            }
+            else
+            {
+                glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
+            }
 #else
             //bind emitter vbo
             glCheck(glBindBuffer(GL_ARRAY_BUFFER, emitter.m_vbo));
@@ -618,7 +652,16 @@ void ParticleSystem::render(Entity camera, const RenderTarget& rt)
             }
 
             //draw
-            glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
+            if (sorted)
+            {
+                sortParticles(emitter, pass.viewMatrix);
+                glCheck(glDrawElements(GL_POINTS, static_cast<GLsizei>(emitter.m_nextFreeParticle), GL_UNSIGNED_SHORT, 0));
+                glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+            }
+            else
+            {
+                glCheck(glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(emitter.m_nextFreeParticle)));
+            }
 
             //unbind attribs
             for (auto j = 0u; j < m_shaderHandles[0].attribData.size(); ++j)
@@ -662,6 +705,7 @@ void ParticleSystem::onEntityAdded(Entity entity)
 
     entity.getComponent<ParticleEmitter>().m_vbo = m_vboIDs[m_nextBuffer];
     entity.getComponent<ParticleEmitter>().m_vao = m_vaoIDs[m_nextBuffer];
+    entity.getComponent<ParticleEmitter>().m_ibo = m_iboIDs[m_nextBuffer];
     m_nextBuffer++;
 }
 
@@ -669,7 +713,11 @@ void ParticleSystem::onEntityRemoved(Entity entity)
 {
     auto vboID = entity.getComponent<ParticleEmitter>().m_vbo;
     auto vaoID = entity.getComponent<ParticleEmitter>().m_vao;
-    
+    auto iboID = entity.getComponent<ParticleEmitter>().m_ibo;
+
+    //swap with the last buffer in use so it's returned to the free pool
+    m_nextBuffer--;
+
     //update available VBOs
     std::size_t idx = 0;
     while (m_vboIDs[idx] != vboID) { idx++; }
@@ -682,7 +730,11 @@ void ParticleSystem::onEntityRemoved(Entity entity)
 
     std::swap(m_vaoIDs[idx], m_vaoIDs[m_nextBuffer]);
 
-    m_nextBuffer--;
+    //and ibos
+    idx = 0;
+    while (m_iboIDs[idx] != iboID) { idx++; }
+
+    std::swap(m_iboIDs[idx], m_iboIDs[m_nextBuffer]);
 }
 
 void ParticleSystem::allocateBuffer()
@@ -698,6 +750,11 @@ void ParticleSystem::allocateBuffer()
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, m_vboIDs[m_bufferCount]));
     glCheck(glBufferData(GL_ARRAY_BUFFER, MaxVertData * sizeof(float), nullptr, GL_DYNAMIC_DRAW));
 
+    //only used when depth sorting - on desktop this becomes part of the VAO state
+    glCheck(glGenBuffers(1, &m_iboIDs[m_bufferCount]));
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_iboIDs[m_bufferCount]));
+    glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, ParticleEmitter::MaxParticles * sizeof(std::uint16_t), nullptr, GL_DYNAMIC_DRAW));
+
 #ifdef PLATFORM_DESKTOP
     //HMMMMMMM this only works because all the shaders use the same vertex shader
     for(auto [index, attribSize, offset] : m_shaderHandles[0].attribData)
@@ -709,9 +766,459 @@ void ParticleSystem::allocateBuffer()
     }
 
     glCheck(glBindVertexArray(0));
+#else
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
 #endif //PLATFORM
 
     glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
     m_bufferCount++;
 }
+
+void ParticleSystem::spawnParticle(ParticleEmitter& emitter, const Transform& tx)
+{
+    static const float epsilon = 0.0001f;
+
+    if (emitter.m_nextFreeParticle < emitter.m_particles.size() - 1)
+    {
+        glm::quat rotation = glm::quat_cast(tx.getLocalTransform());
+
+        const auto& settings = emitter.settings;
+        CRO_ASSERT(settings.emitRate > 0, "Emit rate must be grater than 0");
+        CRO_ASSERT(settings.lifetime > 0, "Lifetime must be greater than 0");
+        auto& p = emitter.m_particles[emitter.m_nextFreeParticle];
+        p.colour = settings.colour;
+        p.gravity = settings.gravity;
+        p.lifetime = settings.lifetime + cro::Util::Random::value(-settings.lifetimeVariance, settings.lifetimeVariance + epsilon);
+        p.maxLifeTime = p.lifetime;
+
+        auto randRot = glm::rotate(rotation, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::X_AXIS);
+        randRot = glm::rotate(randRot, Util::Random::value(-settings.spread, (settings.spread + epsilon)) * Util::Const::degToRad, Transform::Z_AXIS);
+
+        auto worldScale = tx.getWorldScale();
+
+        p.velocity = randRot * settings.initialVelocity;
+        p.rotation = (settings.randomInitialRotation) ? Util::Random::value(-Util::Const::PI, Util::Const::PI) : 0.f;
+        p.scale = std::abs((worldScale.x + worldScale.y) / 2.f);// 1.f;
+        p.acceleration = settings.acceleration;
+        p.frameID = (settings.useRandomFrame && settings.frameCount > 1) ? cro::Util::Random::value(0, static_cast<std::int32_t>(settings.frameCount) - 1) : 0;
+        p.frameTime = 0.f;
+        p.loopCount = settings.loopCount;
+
+        //spawn particle in world position
+        auto basePosition = tx.getWorldPosition();
+        p.position = basePosition;
+
+        //add random radius placement - TODO how to do with a position table? CAN'T HAVE +- 0!!
+        p.position.x += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+        p.position.y += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+        p.position.z += Util::Random::value(-settings.spawnRadius, settings.spawnRadius + epsilon);
+
+        if (emitter.settings.inheritRotation)
+        {
+            /*p.position -= basePosition;
+            p.position = rotation * glm::vec4(p.position, 1.f);
+            p.position += basePosition;*/
+            p.velocity = glm::vec3(tx.getWorldTransform() * glm::vec4(p.velocity, 0.0));
+        }
+
+        auto offset = settings.spawnOffset;
+        offset *= worldScale;
+        p.position += offset;
+
+        emitter.m_nextFreeParticle++;
+        if (emitter.m_releaseCount > 0)
+        {
+            emitter.m_releaseCount--;
+        }
+    }
+}
+
+void ParticleSystem::sleep(ParticleEmitter& emitter)
+{
+    emitter.m_sleeping = true;
+    emitter.m_sleepTime = 0.f;
+    emitter.m_sleepEmitCount = 0;
+    emitter.m_sleepBounds = emitter.m_bounds;
+
+    //store enough to estimate the bounds
+    //of the existing particles while asleep
+    emitter.m_sleepLifetime = 0.f;
+    emitter.m_sleepMaxSpeed = 0.f;
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        const auto& p = emitter.m_particles[i];
+        emitter.m_sleepLifetime = std::max(emitter.m_sleepLifetime, p.lifetime);
+        emitter.m_sleepMaxSpeed = std::max(emitter.m_sleepMaxSpeed, glm::length2(p.velocity));
+    }
+    emitter.m_sleepMaxSpeed = std::sqrt(emitter.m_sleepMaxSpeed);
+}
+
+void ParticleSystem::updateSleeping(ParticleEmitter& emitter, const Transform& tx, float dt)
+{
+    emitter.m_sleepTime += dt;
+
+    //keep emitting virtually so that release counts and
+    //the emission clock behave as if the emitter were awake
+    if (emitter.m_running &&
+        emitter.m_emissionClock.elapsed().asSeconds() > (1.f / emitter.settings.emitRate))
+    {
+        emitter.m_emissionClock.restart();
+
+        auto emitCount = emitter.settings.emitCount;
+        if (emitter.m_releaseCount > 0)
+        {
+            emitCount = std::min(emitCount, static_cast<std::uint32_t>(emitter.m_releaseCount));
+            emitter.m_releaseCount -= emitCount;
+        }
+        emitter.m_sleepEmitCount += emitCount;
+    }
+
+    if (emitter.m_releaseCount == 0)
+    {
+        emitter.stop();
+    }
+
+    //once the longest lived particle has expired there's nothing left to draw
+    if (emitter.m_sleepTime > emitter.m_sleepLifetime)
+    {
+        emitter.m_nextFreeParticle = 0;
+    }
+
+    //estimate the bounds from the furthest any particle could have travelled
+    const auto& settings = emitter.settings;
+    auto acceleration = settings.gravity;
+    for (auto f : settings.forces)
+    {
+        acceleration += f;
+    }
+    const float accel = glm::length(acceleration) * 0.5f;
+
+    Sphere bounds;
+    bool hasBounds = false;
+    if (emitter.m_nextFreeParticle != 0)
+    {
+        const float t = std::min(emitter.m_sleepTime, emitter.m_sleepLifetime);
+        bounds = emitter.m_sleepBounds;
+        bounds.radius += (emitter.m_sleepMaxSpeed * t) + (accel * t * t);
+        hasBounds = true;
+    }
+
+    if (emitter.m_sleepEmitCount != 0)
+    {
+        const auto worldScale = glm::abs(tx.getWorldScale());
+        const float scale = std::max(worldScale.x, std::max(worldScale.y, worldScale.z));
+        const float t = settings.lifetime + settings.lifetimeVariance;
+
+        Sphere emission;
+        emission.centre = tx.getWorldPosition() + (settings.spawnOffset * worldScale);
+        emission.radius = (settings.spawnRadius * 1.733f) + (glm::length(settings.initialVelocity) * scale * t) + (accel * t * t);
+
+        if (hasBounds)
+        {
+            //merge the two spheres
+            auto diff = emission.centre - bounds.centre;
+            const float dist = glm::length(diff);
+            if (dist + emission.radius <= bounds.radius)
+            {
+                //emission is already contained
+            }
+            else if (dist + bounds.radius <= emission.radius)
+            {
+                bounds = emission;
+            }
+            else
+            {
+                const float radius = (dist + bounds.radius + emission.radius) / 2.f;
+                bounds.centre += diff * ((radius - bounds.radius) / dist);
+                bounds.radius = radius;
+            }
+        }
+        else
+        {
+            bounds = emission;
+        }
+        hasBounds = true;
+    }
+
+    if (hasBounds)
+    {
+        emitter.m_bounds = bounds;
+    }
+}
+
+void ParticleSystem::wake(ParticleEmitter& emitter, const Transform& tx)
+{
+    const auto& settings = emitter.settings;
+    const float frameDuration = 1.f / settings.framerate;
+
+    auto acceleration = settings.gravity;
+    for (auto f : settings.forces)
+    {
+        acceleration += f;
+    }
+
+    //moves a particle along its path assuming constant acceleration
+    const auto advance = [&](Particle& p, float t)
+    {
+        const auto accel = acceleration - settings.gravity + p.gravity;
+        p.position += (p.velocity * t) + (accel * 0.5f * t * t);
+        p.velocity += accel * t;
+
+        p.lifetime -= t;
+        p.colour.setAlpha(std::max(p.lifetime / p.maxLifeTime, 0.f));
+
+        p.rotation += settings.rotationSpeed * t;
+        p.scale *= std::exp(settings.scaleModifier * t);
+
+        if (settings.animate)
+        {
+            p.frameTime += t;
+            auto frameCount = static_cast<std::uint32_t>(p.frameTime / frameDuration);
+            p.frameTime -= frameDuration * frameCount;
+
+            while (frameCount--
+                && (p.frameID < settings.frameCount || p.loopCount))
+            {
+                p.frameID++;
+                if (p.frameID == settings.frameCount
+                    && p.loopCount)
+                {
+                    p.loopCount--;
+                    p.frameID = 0;
+                }
+            }
+        }
+    };
+
+    const auto dead = [&](const Particle& p)
+    {
+        return p.lifetime < 0
+            || (p.frameID == settings.frameCount && p.loopCount == 0);
+    };
+
+    //bring existing particles up to date
+    for (auto i = 0u; i < emitter.m_nextFreeParticle;)
+    {
+        auto& p = emitter.m_particles[i];
+        advance(p, emitter.m_sleepTime);
+
+        if (dead(p))
+        {
+            emitter.m_nextFreeParticle--;
+            std::swap(p, emitter.m_particles[emitter.m_nextFreeParticle]);
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    //and fill in any which would have been emitted
+    //recently enough to still be alive
+    if (emitter.m_sleepEmitCount != 0)
+    {
+        const float window = std::min(emitter.m_sleepTime, settings.lifetime + settings.lifetimeVariance);
+        auto count = static_cast<std::uint32_t>(window * settings.emitRate) * settings.emitCount;
+        count = std::min(count, emitter.m_sleepEmitCount);
+
+        //don't let spawnParticle() count these against the release count twice
+        const auto releaseCount = emitter.m_releaseCount;
+        emitter.m_releaseCount = -1;
+
+        for (auto i = 0u; i < count; ++i)
+        {
+            const auto idx = emitter.m_nextFreeParticle;
+            spawnParticle(emitter, tx);
+
+            if (idx == emitter.m_nextFreeParticle)
+            {
+                //emitter is full
+                break;
+            }
+
+            auto& p = emitter.m_particles[idx];
+            advance(p, window * (static_cast<float>(i) / count));
+
+            if (dead(p))
+            {
+                emitter.m_nextFreeParticle--;
+            }
+        }
+        emitter.m_releaseCount = releaseCount;
+    }
+
+    emitter.m_sleeping = false;
+    emitter.m_sleepTime = 0.f;
+    emitter.m_sleepEmitCount = 0;
+}
+
+void ParticleSystem::simulate(ParticleEmitter& emitter, float dt)
+{
+    //update each particle
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(0.f);
+
+    float framerate = 1.f / emitter.settings.framerate;
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        auto& p = emitter.m_particles[i];
+
+        p.velocity += p.gravity * dt;
+        for (auto f : emitter.settings.forces)
+        {
+            p.velocity += f * dt;
+        }
+        p.position += p.velocity * dt;            
+       
+        p.lifetime -= dt;
+        p.colour.setAlpha(std::max(p.lifetime / p.maxLifeTime, 0.f));
+
+        p.rotation += emitter.settings.rotationSpeed * dt;
+        p.scale += ((p.scale * emitter.settings.scaleModifier) * dt);
+
+        if (emitter.settings.animate)
+        {
+            p.frameTime += dt;
+            if (p.frameTime > framerate)
+            {
+                p.frameID++;
+                if (p.frameID == emitter.settings.frameCount
+                    && p.loopCount)
+                {
+                    p.loopCount--;
+                    p.frameID = 0;
+                }
+                p.frameTime -= framerate;
+            }
+        }
+
+        //update bounds for culling
+        if (p.position.x < minBounds.x) minBounds.x = p.position.x;
+        if (p.position.y < minBounds.y) minBounds.y = p.position.y;
+        if (p.position.z < minBounds.z) minBounds.z = p.position.z;
+
+        if (p.position.x > maxBounds.x) maxBounds.x = p.position.x;
+        if (p.position.y > maxBounds.y) maxBounds.y = p.position.y;
+        if (p.position.z > maxBounds.z) maxBounds.z = p.position.z;
+    }
+    auto dist = (maxBounds - minBounds) / 2.f;
+    emitter.m_bounds.centre = dist + minBounds;
+    emitter.m_bounds.radius = glm::length(dist);
+
+    //go over again and remove dead particles with pop/swap
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        if (emitter.m_particles[i].lifetime < 0
+            || ((emitter.m_particles[i].frameID == emitter.settings.frameCount)
+                && (emitter.m_particles[i].loopCount == 0)))
+        {
+            emitter.m_nextFreeParticle--;
+            std::swap(emitter.m_particles[i], emitter.m_particles[emitter.m_nextFreeParticle]);                
+        }
+    }
+    //DPRINT("Next free Particle", std::to_string(emitter.m_nextFreeParticle));
+
+    //depth sorting, if enabled, is done per camera pass at render time
+    //as it depends on the view - see sortParticles()
+
+    //update vertex data
+    const auto vertSize = emitter.m_nextFreeParticle * (VertexSize / sizeof(float));
+    if (emitter.m_vertexData.size() < vertSize)
+    {
+        emitter.m_vertexData.resize(vertSize);
+    }
+
+    std::size_t idx = 0;
+    auto& vertexData = emitter.m_vertexData;
+    for (auto i = 0u; i < emitter.m_nextFreeParticle; ++i)
+    {
+        const auto& p = emitter.m_particles[i];
+
+        //position
+        vertexData[idx++] = p.position.x;
+        vertexData[idx++] = p.position.y;
+        vertexData[idx++] = p.position.z;
+
+        //colour
+        vertexData[idx++] = p.colour.getRed();
+        vertexData[idx++] = p.colour.getGreen();
+        vertexData[idx++] = p.colour.getBlue();
+        vertexData[idx++] = p.colour.getAlpha();
+
+        //rotation/size/animation
+        vertexData[idx++] = p.rotation * Util::Const::degToRad;
+        vertexData[idx++] = p.scale;
+        vertexData[idx++] = static_cast<float>(p.frameID);
+    }
+}
+
+void ParticleSystem::threadFunc()
+{
+    std::uint32_t generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_workMutex);
+            m_workCondition.wait(lock, [&]() { return !m_threadsRunning || m_workGeneration != generation; });
+
+            if (!m_threadsRunning)
+            {
+                return;
+            }
+            generation = m_workGeneration;
+        }
+
+        runJobs();
+
+        {
+            std::lock_guard<std::mutex> lock(m_workMutex);
+            m_pendingWorkers--;
+        }
+        m_completeCondition.notify_one();
+    }
+}
+
+void ParticleSystem::runJobs()
+{
+    auto i = m_nextJob++;
+    while (i < m_activeEmitters.size())
+    {
+        simulate(*m_activeEmitters[i], m_frameTime);
+        i = m_nextJob++;
+    }
+}
+
+void ParticleSystem::sortParticles(const ParticleEmitter& emitter, const glm::mat4& viewMatrix)
+{
+    const auto count = emitter.m_nextFreeParticle;
+
+    //only the view space z is needed, which is looking down -z
+    //so the furthest particles have the smallest value
+    float minDepth = std::numeric_limits<float>::max();
+    float maxDepth = std::numeric_limits<float>::lowest();
+    auto& depths = m_sortDepths;
+    for (auto i = 0u; i < count; ++i)
+    {
+        const auto& pos = emitter.m_particles[i].position;
+        depths[i] = viewMatrix[0][2] * pos.x + viewMatrix[1][2] * pos.y + viewMatrix[2][2] * pos.z + viewMatrix[3][2];
+
+        minDepth = std::min(minDepth, depths[i]);
+        maxDepth = std::max(maxDepth, depths[i]);
+    }
+
+    //quantise to 16 bit over the depth range of the emitter
+    const float range = maxDepth - minDepth;
+    const float scale = range > 0.f ? static_cast<float>(std::numeric_limits<std::uint16_t>::max()) / range : 0.f;
+    for (auto i = 0u; i < count; ++i)
+    {
+        m_sortKeys[i] = static_cast<std::uint16_t>((depths[i] - minDepth) * scale);
+        m_sortIndices[i] = static_cast<std::uint16_t>(i);
+    }
+
+    radixSort(m_sortKeys, m_sortIndices, m_sortKeysTemp, m_sortIndicesTemp, count);
+
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, emitter.m_ibo));
+    glCheck(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, count * sizeof(std::uint16_t), m_sortIndices.data()));
+}
@@ -39,6 +39,7 @@ source distribution.
 #include <crogine/core/Console.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextureRegistry.hpp"
 #include "../../graphics/shaders/Sprite.hpp"
 
 #include <string>
@@ -246,6 +247,7 @@ void RenderSystem2D::render(Entity cameraEntity, const RenderTarget& rt)
                 if (drawable.m_texture)
                 {
                     glCheck(glActiveTexture(GL_TEXTURE0));
+                    Detail::TextureRegistry::markUsed(drawable.m_texture->getGLHandle());
                     glCheck(glBindTexture(GL_TEXTURE_2D, drawable.m_texture->getGLHandle()));
                     glCheck(glUniform1i(drawable.m_textureUniform, 0));
                 }
@@ -255,6 +257,7 @@ void RenderSystem2D::render(Entity cameraEntity, const RenderTarget& rt)
                 for (const auto& [uniform, value] : drawable.m_textureBindings)
                 {
                     glCheck(glActiveTexture(GL_TEXTURE0 + j));
+                    Detail::TextureRegistry::markUsed(value->getGLHandle());
                     glCheck(glBindTexture(GL_TEXTURE_2D, value->getGLHandle()));
                     glCheck(glUniform1i(uniform, j));
                 }
@@ -41,6 +41,8 @@ source distribution.
 #include <crogine/util/Frustum.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextureRegistry.hpp"
+#include "../../detail/VertexFormat.hpp"
 
 #include <crogine/detail/glm/gtc/type_ptr.hpp>
 #include <crogine/detail/glm/gtc/matrix_transform.hpp>
@@ -352,6 +354,7 @@ void ShadowMapRenderer::render()
                         default: break;
                         case Material::Property::Texture:
                             glCheck(glActiveTexture(GL_TEXTURE0 + currentTextureUnit));
+                            Detail::TextureRegistry::markUsed(prop.second.second.textureID);
                             glCheck(glBindTexture(GL_TEXTURE_2D, prop.second.second.textureID));
                             glCheck(glUniform1i(prop.second.first, currentTextureUnit++));
                             break;
@@ -378,9 +381,10 @@ void ShadowMapRenderer::render()
                     const auto& attribs = mat.attribs;
                     for (auto j = 0u; j < mat.attribCount; ++j)
                     {
+                        const auto format = static_cast<std::uint8_t>(attribs[j][Material::Data::Format]);
                         glCheck(glEnableVertexAttribArray(attribs[j][Material::Data::Index]));
                         glCheck(glVertexAttribPointer(attribs[j][Material::Data::Index], attribs[j][Material::Data::Size],
-                            GL_FLOAT, GL_FALSE, static_cast<GLsizei>(model.m_meshData.vertexSize),
+                            Detail::getAttributeType(format), Detail::isAttributeNormalised(format), static_cast<GLsizei>(model.m_meshData.vertexSize),
                             reinterpret_cast<void*>(static_cast<intptr_t>(attribs[j][Material::Data::Offset]))));
                     }
 
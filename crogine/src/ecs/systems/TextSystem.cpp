@@ -32,22 +32,46 @@ source distribution.
 #include <crogine/ecs/components/Transform.hpp>
 #include <crogine/ecs/components/Drawable2D.hpp>
 #include <crogine/graphics/Font.hpp>
+#include <crogine/detail/HashCombine.hpp>
 
 #include "../../detail/GLCheck.hpp"
+#include "../../detail/TextConstruction.hpp"
+#include "../../graphics/shaders/Sprite.hpp"
 
 using namespace cro;
 
+namespace
+{
+    //long strings such as logs are better served by
+    //updating the layout in place than by caching
+    constexpr std::size_t MaxCachedLength = 256;
+    constexpr std::size_t MaxCacheSize = 1024;
+
+    //layouts not used for this many frames are evicted
+    constexpr std::uint32_t CacheLifetime = 600;
+}
+
 TextSystem::TextSystem(MessageBus& mb)
-    : System(mb, typeid(TextSystem))
+    : System    (mb, typeid(TextSystem)),
+    m_frameCount(0)
 {
     requireComponent<Drawable2D>();
     requireComponent<Text>();
     requireComponent<Transform>();
+
+    m_distanceFieldShader.loadFromString(Shaders::Sprite::Vertex, Shaders::Text::SDFFragment, "#define TEXTURED\n");
+}
+
+TextSystem::~TextSystem()
+{
+
 }
 
 void TextSystem::process(float)
 {
-    auto entities = getEntities();
+    m_frameCount++;
+
+    auto& entities = getEntities();
     for (auto entity : entities)
     {
         auto& drawable = entity.getComponent<Drawable2D>();
@@ -57,49 +81,34 @@ void TextSystem::process(float)
         bool isPageUpdate = text.m_context.font->pageUpdated(text.getCharacterSize());
         if (text.m_dirtyFlags || isPageUpdate)
         {
-            if (text.m_dirtyFlags == Text::DirtyFlags::Colour)
+            if (text.m_dirtyFlags == Text::DirtyFlags::Colour
+                && !isPageUpdate)
             {
                 //don't rebuild the entire array
-                auto& verts = drawable.getVertexData();
-
-                auto secondColour = cro::Colour::Transparent;
-                if (text.m_context.outlineThickness != 0)
-                {
-                    secondColour = text.m_context.outlineColour;
-                }
-                else if (glm::length(text.m_context.shadowOffset) != 0)
-                {
-                    secondColour = text.m_context.shadowColour;
-                }
-
-                if (secondColour.getAlpha() != 0)
-                {
-                    for (auto i = 0u; i < verts.size() / 2; ++i)
-                    {
-                        verts[i].colour = secondColour;
-                    }
-
-                    for (auto i = verts.size() / 2; i < verts.size(); ++i)
-                    {
-                        verts[i].colour = text.m_context.fillColour;
-                    }
-                }
-                else
-                {
-                    for (auto& v : verts)
-                    {
-                        v.colour = text.m_context.fillColour;
-                    }
-                }
+                Detail::Text::updateColours(drawable.getVertexData(), text.m_context);
             }
             else
             {
-                text.updateVertices(drawable);
+                //if only the font page was updated this reuses the existing
+                //layout and just recalculates the texture coordinates
+                text.updateVertices(drawable, fetchLayout(entity, text.m_context));
                 drawable.setTexture(&text.getFont()->getTexture(text.getCharacterSize()));
                 drawable.setPrimitiveType(GL_TRIANGLES);
                 m_readPages.push_back({ text.getFont(), text.getCharacterSize() }); //font needs its pages marked as read
             }
 
+            //Text::getLocalBounds() may have rebuilt the vertices, so
+            //the shader is always checked here rather than on rebuild
+            if (text.m_context.font->isDistanceField())
+            {
+                applyDistanceField(drawable, text.m_context);
+            }
+            else if (drawable.getShader() == &m_distanceFieldShader)
+            {
+                //font was changed, so return to the default shader
+                drawable.setShader(nullptr);
+            }
+
             text.m_dirtyFlags = 0;
         }
     }
@@ -113,4 +122,105 @@ void TextSystem::process(float)
         font->markPageRead(charSize);
     }
     m_readPages.clear();
+
+    //remove any stale layouts from the cache
+    if (m_frameCount % CacheLifetime == 0)
+    {
+        for (auto it = m_layoutCache.begin(); it != m_layoutCache.end();)
+        {
+            if (m_frameCount - it->second->lastUsed > CacheLifetime)
+            {
+                it = m_layoutCache.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+//private
+const Detail::Text::Layout& TextSystem::fetchLayout(Entity entity, const TextContext& context)
+{
+    const auto index = entity.getIndex();
+    if (index >= m_layouts.size())
+    {
+        m_layouts.resize(index + 1);
+    }
+
+    if (!m_layouts[index])
+    {
+        m_layouts[index] = std::make_unique<Detail::Text::Layout>();
+    }
+    auto& layout = *m_layouts[index];
+
+    if (!context.font || context.string.empty())
+    {
+        return layout;
+    }
+
+    const auto styleHash = Detail::Text::hashStyle(context);
+    if (layout.styleHash == styleHash
+        && layout.string == context.string)
+    {
+        //up to date
+        return layout;
+    }
+
+    if (context.string.size() > MaxCachedLength)
+    {
+        Detail::Text::updateLayout(layout, context);
+        return layout;
+    }
+
+    auto key = styleHash;
+    hash_combine(key, Detail::Text::hashString(context.string));
+
+    if (auto result = m_layoutCache.find(key); result != m_layoutCache.end())
+    {
+        auto& cached = *result->second;
+        if (cached.styleHash == styleHash
+            && cached.string == context.string)
+        {
+            cached.lastUsed = m_frameCount;
+            layout = cached;
+            return layout;
+        }
+    }
+
+    Detail::Text::updateLayout(layout, context);
+
+    if (m_layoutCache.size() < MaxCacheSize)
+    {
+        auto& cached = m_layoutCache[key];
+        cached = std::make_unique<Detail::Text::Layout>(layout);
+        cached->lastUsed = m_frameCount;
+    }
+
+    return layout;
+}
+
+void TextSystem::applyDistanceField(Drawable2D& drawable, const TextContext& context)
+{
+    if (drawable.getShader() != &m_distanceFieldShader)
+    {
+        drawable.setShader(&m_distanceFieldShader);
+    }
+
+    const auto properties = Detail::Text::getDistanceFieldProperties(context);
+    drawable.bindUniform("u_smoothing", properties.smoothing);
+    drawable.bindUniform("u_outlineThickness", properties.outlineThickness);
+    drawable.bindUniform("u_outlineColour", properties.outlineColour);
+    drawable.bindUniform("u_shadowColour", properties.shadowColour);
+    drawable.bindUniform("u_shadowOffset", properties.shadowOffset);
+}
+
+void TextSystem::onEntityRemoved(Entity entity)
+{
+    const auto index = entity.getIndex();
+    if (index < m_layouts.size())
+    {
+        m_layouts[index].reset();
+    }
 }
\ No newline at end of file
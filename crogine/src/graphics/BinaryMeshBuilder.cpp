@@ -33,6 +33,10 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/MeshUpload.hpp"
+#include "../detail/VertexFormat.hpp"
+
+#include <algorithm>
 
 using namespace cro;
 
@@ -68,7 +72,7 @@ Mesh::Data BinaryMeshBuilder::build() const
     Mesh::Data meshData;
 
     RaiiRWops file;
-    file.file = SDL_RWFromFile(m_path.c_str(), "rb");
+    file.file = FileSystem::openResource(m_path);
     if (file.file)    
     {
         Detail::ModelBinary::Header header;
@@ -92,20 +96,16 @@ Mesh::Data BinaryMeshBuilder::build() const
         if (header.meshOffset)
         {
             Detail::ModelBinary::MeshHeader meshHeader;
-            SDL_RWread(file.file, &meshHeader, sizeof(meshHeader), 1);
+            Detail::ModelBinary::MeshFormatV3 meshFormat;
+            std::vector<float> tempVerts;
+            std::vector<std::vector<std::uint32_t>> indexData;
 
-            if ((meshHeader.flags & VertexProperty::Position) == 0)
+            if (!Detail::ModelBinary::readMesh(file.file, header, meshHeader, meshFormat, tempVerts, indexData))
             {
-                LogE << "No position data in mesh" << std::endl;
+                LogE << "Failed reading mesh data from " << m_path << std::endl;
                 return {};
             }
 
-            std::vector<float> tempVerts;
-            std::vector<std::uint32_t> sizes(meshHeader.indexArrayCount);
-            std::vector<std::vector<std::uint32_t>> indexData(meshHeader.indexArrayCount);
-
-            SDL_RWread(file.file, sizes.data(), meshHeader.indexArrayCount * sizeof(std::uint32_t), 1);
-
             std::uint32_t vertStride = 0;
             for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
             {
@@ -146,18 +146,7 @@ Mesh::Data BinaryMeshBuilder::build() const
                     }
                 }
             }
-
-            auto pos = SDL_RWtell(file.file);
-            auto vertSize = meshHeader.indexArrayOffset - pos;
-            tempVerts.resize(vertSize / sizeof(float));
-            SDL_RWread(file.file, tempVerts.data(), vertSize, 1);
             CRO_ASSERT(tempVerts.size() % vertStride == 0, "");
-            
-            for (auto i = 0u; i < meshHeader.indexArrayCount; ++i)
-            {
-                indexData[i].resize(sizes[i]);
-                SDL_RWread(file.file, indexData[i].data(), sizes[i] * sizeof(std::uint32_t), 1);
-            }
 
             //process vertex data
             std::vector<float> vertData;
@@ -252,22 +241,42 @@ Mesh::Data BinaryMeshBuilder::build() const
             meshData.primitiveType = GL_TRIANGLES;
             meshData.vertexSize = getVertexSize(meshData.attributes);
             meshData.vertexCount = vertData.size() / (meshData.vertexSize / sizeof(float));
-            createVBO(meshData, vertData);
+            const auto floatStride = meshData.vertexSize / sizeof(float);
+
+            if (std::any_of(std::begin(meshFormat.attributeFormats), std::end(meshFormat.attributeFormats),
+                [](std::uint8_t f) { return f != Mesh::AttributeFormat::Float; }))
+            {
+                //upload quantised attributes in the format they were stored
+                createQuantisedVBO(meshData, vertData, meshFormat);
+            }
+            else
+            {
+                createVBO(meshData, vertData);
+            }
 
             meshData.submeshCount = meshHeader.indexArrayCount;
             for (auto i = 0u; i < meshData.submeshCount; ++i)
             {
-                meshData.indexData[i].format = GL_UNSIGNED_INT;
                 meshData.indexData[i].primitiveType = meshData.primitiveType;
                 meshData.indexData[i].indexCount = static_cast<std::uint32_t>(indexData[i].size());
 
-                createIBO(meshData, indexData[i].data(), i, sizeof(std::uint32_t));
+                if (meshFormat.indexSize == sizeof(std::uint16_t))
+                {
+                    std::vector<std::uint16_t> shortIndices(indexData[i].begin(), indexData[i].end());
+                    meshData.indexData[i].format = GL_UNSIGNED_SHORT;
+                    createIBO(meshData, shortIndices.data(), i, sizeof(std::uint16_t));
+                }
+                else
+                {
+                    meshData.indexData[i].format = GL_UNSIGNED_INT;
+                    createIBO(meshData, indexData[i].data(), i, sizeof(std::uint32_t));
+                }
             }
 
             //boundingbox / sphere
             meshData.boundingBox[0] = glm::vec3(std::numeric_limits<float>::max());
             meshData.boundingBox[1] = glm::vec3(std::numeric_limits<float>::lowest());
-            for (std::size_t i = 0; i < vertData.size(); i += (meshData.vertexSize / sizeof(float)))
+            for (std::size_t i = 0; i < vertData.size(); i += floatStride)
             {
                 //min point
                 if (meshData.boundingBox[0].x > vertData[i])
@@ -389,4 +398,55 @@ Mesh::Data BinaryMeshBuilder::build() const
     }
 
     return meshData;
-}
\ No newline at end of file
+}
+
+//private
+void BinaryMeshBuilder::createQuantisedVBO(Mesh::Data& meshData, const std::vector<float>& vertData, const Detail::ModelBinary::MeshFormatV3& format) const
+{
+    //bitangents are generated from the tangent so share its format
+    auto formats = meshData.attributeFormats;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        formats[i] = (i == Mesh::Attribute::Bitangent) ? format.attributeFormats[Mesh::Attribute::Tangent] : format.attributeFormats[i];
+    }
+
+    //pad each attribute to a multiple of 4 bytes
+    const auto floatSizes = meshData.attributes;
+    std::size_t vertexSize = 0;
+    for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+    {
+        if (floatSizes[i] != 0)
+        {
+            const auto componentSize = Mesh::getAttributeFormatSize(formats[i]);
+            const auto byteSize = ((floatSizes[i] * componentSize) + 3) & ~std::size_t(3);
+            meshData.attributes[i] = byteSize / componentSize;
+            meshData.attributeFormats[i] = formats[i];
+            vertexSize += byteSize;
+        }
+    }
+
+    std::vector<std::uint8_t> output(vertexSize * meshData.vertexCount);
+    auto* dst = output.data();
+    const auto* src = vertData.data();
+    for (auto v = 0u; v < meshData.vertexCount; ++v)
+    {
+        for (auto i = 0u; i < Mesh::Attribute::Total; ++i)
+        {
+            const auto componentSize = Mesh::getAttributeFormatSize(formats[i]);
+            for (auto j = 0u; j < meshData.attributes[i]; ++j)
+            {
+                //position w is 1 when padded
+                float value = (i == Mesh::Attribute::Position) ? 1.f : 0.f;
+                if (j < floatSizes[i])
+                {
+                    value = *src++;
+                }
+                Detail::encodeComponent(value, formats[i], dst);
+                dst += componentSize;
+            }
+        }
+    }
+
+    meshData.vertexSize = vertexSize;
+    Detail::createVertexBuffer(meshData, output.data(), output.size());
+}
@@ -32,6 +32,7 @@ source distribution.
 #include <crogine/core/ConfigFile.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 using namespace cro;
 
@@ -59,6 +60,7 @@ CubemapTexture::~CubemapTexture()
 {
     if (m_handle)
     {
+        Detail::TextureRegistry::removeTexture(m_handle);
         glCheck(glDeleteTextures(1, &m_handle));
     }
 }
@@ -128,6 +130,7 @@ bool CubemapTexture::loadFromFile(const std::string& path)
 
         Image* currImage = &fallback;
         GLenum format = GL_RGB;
+        std::size_t byteCount = 0;
         for (auto i = 0u; i < 6u; i++)
         {
             if (side.loadFromFile(paths[i]))
@@ -155,7 +158,9 @@ bool CubemapTexture::loadFromFile(const std::string& path)
 
             auto size = currImage->getSize();
             glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, size.x, size.y, 0, format, GL_UNSIGNED_BYTE, currImage->getPixelData());
+            byteCount += Detail::TextureRegistry::estimateSize(size.x, size.y, format == GL_RGBA ? 4 : 3);
         }
+        Detail::TextureRegistry::addTexture(m_handle, byteCount);
         glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
         glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -30,6 +30,7 @@ source distribution.
 #include <crogine/graphics/DepthTexture.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 using namespace cro;
 
@@ -58,6 +59,7 @@ DepthTexture::~DepthTexture()
 
     if (m_textureID)
     {
+        Detail::TextureRegistry::removeTexture(m_textureID);
         glCheck(glDeleteTextures(1, &m_textureID));
     }
 }
@@ -104,6 +106,7 @@ DepthTexture& DepthTexture::operator=(DepthTexture&& other) noexcept
 
         if (m_textureID)
         {
+            Detail::TextureRegistry::removeTexture(m_textureID);
             glCheck(glDeleteTextures(1, &m_textureID));
         }
 
@@ -143,6 +146,7 @@ bool DepthTexture::create(std::uint32_t width, std::uint32_t height, std::uint32
         //resize the buffer
         glCheck(glBindTexture(GL_TEXTURE_2D_ARRAY, m_textureID));
         glCheck(glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT, width, height, layers, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL));
+        Detail::TextureRegistry::addTexture(m_textureID, Detail::TextureRegistry::estimateSize(width, height, 4 * layers), TextureMemory::DepthTarget);
 
         setViewport({ 0, 0, static_cast<std::int32_t>(width), static_cast<std::int32_t>(height) });
         setView(FloatRect(getViewport()));
@@ -152,6 +156,7 @@ bool DepthTexture::create(std::uint32_t width, std::uint32_t height, std::uint32
         return true;
 #else
         //else we have to regenerate it as it's immutable
+        Detail::TextureRegistry::removeTexture(m_textureID);
         glCheck(glDeleteTextures(1, &m_textureID));
 #endif
     }
@@ -169,6 +174,7 @@ bool DepthTexture::create(std::uint32_t width, std::uint32_t height, std::uint32
 #else
     glCheck(glTexStorage3D(GL_TEXTURE_2D_ARRAY, 1, GL_DEPTH_COMPONENT24, width, height, layers));
 #endif
+    Detail::TextureRegistry::addTexture(m_textureID, Detail::TextureRegistry::estimateSize(width, height, 4 * layers), TextureMemory::DepthTarget);
     glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
     glCheck(glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER));
@@ -30,6 +30,7 @@ source distribution.
 #include "../detail/stb_image.h"
 #include "../detail/SDLImageRead.hpp"
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 #include <crogine/core/FileSystem.hpp>
 #include <crogine/core/Log.hpp>
@@ -124,6 +125,10 @@ EnvironmentMap::~EnvironmentMap()
 {
     if (m_textures[Skybox])
     {
+        for (auto t : m_textures)
+        {
+            Detail::TextureRegistry::removeTexture(t);
+        }
         glCheck(glDeleteTextures(4, m_textures.data()));
     }
     deleteCube();
@@ -145,7 +150,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
         return false;
     }
 
-    auto* file = SDL_RWFromFile(path.c_str(), "rb");
+    auto* file = FileSystem::openResource(path);
     if (!file)
     {
         LogE << "SDLRW_ops Failed opening " << filePath << std::endl;
@@ -161,7 +166,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
 
     TempTexture tempTexture;
 
-    stbi_set_flip_vertically_on_load(1);
+    stbi_set_flip_vertically_on_load_thread(1);
     auto* data = stbi_loadf_from_callbacks(&io.stb_cbs, &io, &width, &height, &componentCount, 0);
     if (data)
     {
@@ -183,7 +188,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
         
         return false;
     }
-    stbi_set_flip_vertically_on_load(0);
+    stbi_set_flip_vertically_on_load_thread(0);
     SDL_RWclose(file);
 
     //create a temp render buffer/frame buffer to render the sides with
@@ -221,6 +226,7 @@ bool EnvironmentMap::loadFromFile(const std::string& filePath)
     {
         glCheck(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, CubemapSize, CubemapSize, 0, GL_RGB, GL_FLOAT, nullptr));
     }
+    Detail::TextureRegistry::addTexture(m_textures[Skybox], Detail::TextureRegistry::estimateSize(CubemapSize, CubemapSize, 6 * 6, true), TextureMemory::EnvironmentMap);
 
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
@@ -307,6 +313,7 @@ void EnvironmentMap::renderIrradianceMap(std::uint32_t fbo, std::uint32_t rbo, S
     {
         glCheck(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, IrradianceMapSize, IrradianceMapSize, 0, GL_RGB, GL_FLOAT, nullptr));
     }
+    Detail::TextureRegistry::addTexture(m_textures[Irradiance], Detail::TextureRegistry::estimateSize(IrradianceMapSize, IrradianceMapSize, 6 * 6), TextureMemory::EnvironmentMap);
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
@@ -350,6 +357,7 @@ void EnvironmentMap::renderPrefilterMap(std::uint32_t fbo, std::uint32_t rbo, Sh
     {
         glCheck(glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB16F, PrefilterMapSize, PrefilterMapSize, 0, GL_RGB, GL_FLOAT, nullptr));
     }
+    Detail::TextureRegistry::addTexture(m_textures[Prefilter], Detail::TextureRegistry::estimateSize(PrefilterMapSize, PrefilterMapSize, 6 * 6, true), TextureMemory::EnvironmentMap);
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE));
@@ -400,6 +408,7 @@ void EnvironmentMap::renderBRDFMap(std::uint32_t fbo, std::uint32_t rbo, Shader&
 {
     glCheck(glBindTexture(GL_TEXTURE_2D, m_textures[BRDF]));
     glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, CubemapSize, CubemapSize, 0, GL_RG, GL_FLOAT, 0));
+    Detail::TextureRegistry::addTexture(m_textures[BRDF], Detail::TextureRegistry::estimateSize(CubemapSize, CubemapSize, 4), TextureMemory::EnvironmentMap);
 
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
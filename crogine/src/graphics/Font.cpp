@@ -33,6 +33,7 @@ by Laurent Gomila et al https://github.com/SFML/SFML/blob/master/src/SFML/Graphi
 */
 
 #include "../detail/DistanceField.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 #include <crogine/graphics/Font.hpp>
 #include <crogine/graphics/Image.hpp>
@@ -70,10 +71,113 @@ namespace
     {
         return (static_cast<std::uint64_t>(reinterpret<std::uint32_t>(outlineThickness)) << 32) | (static_cast<std::uint64_t>(bold) << 31) | index;
     }
+
+    //rasterises a glyph at the face's current size and converts it to a
+    //signed distance field, stored in the alpha channel of the output pixels.
+    //glyph bounds include the padding so the quad covers the entire field.
+    bool rasteriseDistanceField(FT_Face face, FT_Library library, std::uint32_t codepoint, bool bold,
+        Glyph& glyph, std::uint32_t& width, std::uint32_t& height, std::vector<std::uint8_t>& pixels)
+    {
+        if (FT_Load_Char(face, codepoint, FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT) != 0)
+        {
+            return false;
+        }
+
+        FT_Glyph glyphDesc;
+        if (FT_Get_Glyph(face->glyph, &glyphDesc) != 0)
+        {
+            return false;
+        }
+
+        //glyphs are scaled down from the reference size, so embolden
+        //by 2px at 48px to match the weight of the bitmap glyphs
+        const FT_Pos weight = (1 << 6) * 2;
+        const bool outline = (glyphDesc->format == FT_GLYPH_FORMAT_OUTLINE);
+        if (bold && outline)
+        {
+            FT_OutlineGlyph outlineGlyph = (FT_OutlineGlyph)glyphDesc;
+            FT_Outline_Embolden(&outlineGlyph->outline, weight);
+        }
+
+        if (FT_Glyph_To_Bitmap(&glyphDesc, FT_RENDER_MODE_NORMAL, 0, 1) != 0)
+        {
+            FT_Done_Glyph(glyphDesc);
+            return false;
+        }
+        auto bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyphDesc);
+        FT_Bitmap& bitmap = bitmapGlyph->bitmap;
+
+        if (bold && !outline)
+        {
+            FT_Bitmap_Embolden(library, &bitmap, weight, weight);
+        }
+
+        glyph = {};
+        glyph.advance = static_cast<float>(face->glyph->metrics.horiAdvance) / MagicNumber;
+        if (bold)
+        {
+            glyph.advance += static_cast<float>(weight) / MagicNumber;
+        }
+
+        width = 0;
+        height = 0;
+        pixels.clear();
+
+        if (bitmap.width > 0 && bitmap.rows > 0)
+        {
+            const std::int32_t padding = Font::DistanceFieldSpread;
+            const std::int32_t w = bitmap.width + (padding * 2);
+            const std::int32_t h = bitmap.rows + (padding * 2);
+
+            std::vector<std::uint8_t> coverage(w * h, 0);
+            const auto* src = bitmap.buffer;
+            for (auto y = 0u; y < bitmap.rows; ++y)
+            {
+                for (auto x = 0u; x < bitmap.width; ++x)
+                {
+                    std::size_t index = (x + padding) + ((y + padding) * w);
+                    if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
+                    {
+                        coverage[index] = (src[x / 8] & (1 << (7 - (x % 8)))) ? 255 : 0;
+                    }
+                    else
+                    {
+                        coverage[index] = src[x];
+                    }
+                }
+                src += bitmap.pitch;
+            }
+
+            auto field = Detail::DistanceField::toSignedDF(coverage, w, h, static_cast<float>(padding));
+
+            pixels.resize(field.size() * 4);
+            for (auto i = 0u; i < field.size(); ++i)
+            {
+                pixels[i * 4] = 255;
+                pixels[i * 4 + 1] = 255;
+                pixels[i * 4 + 2] = 255;
+                pixels[i * 4 + 3] = field[i];
+            }
+
+            glyph.bounds.left = static_cast<float>(bitmapGlyph->left - padding);
+            glyph.bounds.bottom = static_cast<float>(bitmapGlyph->top - static_cast<std::int32_t>(bitmap.rows) - padding);
+            glyph.bounds.width = static_cast<float>(w);
+            glyph.bounds.height = static_cast<float>(h);
+
+            width = w;
+            height = h;
+        }
+
+        FT_Done_Glyph(glyphDesc);
+        return true;
+    }
 }
 
 Font::Font()
-    : m_useSmoothing(false)
+    : m_useSmoothing    (false),
+    m_distanceField     (false),
+    m_threadRunning     (false),
+    m_resultsReady      (false)
 {
 
 }
@@ -102,7 +206,7 @@ bool Font::loadFromFile(const std::string& filePath)
 
     //load the face
     RaiiRWops fontFile;
-    fontFile.file = SDL_RWFromFile(path.c_str(), "r");
+    fontFile.file = FileSystem::openResource(path);
     if (!fontFile.file)
     {
         Logger::log("Failed opening " + path, Logger::Type::Error);
@@ -146,12 +250,24 @@ bool Font::loadFromFile(const std::string& filePath)
     m_face = std::make_any<FT_Face>(face);
     m_stroker = std::make_any<FT_Stroker>(stroker);
 
+    if (m_distanceField)
+    {
+        startDistanceFieldThread();
+        preloadGlyphs(32, 126);
+    }
+
     return true;
 }
 
 Glyph Font::getGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold, float outlineThickness) const
 {
-    auto& currentGlyphs = m_pages[charSize].glyphs;
+    if (m_distanceField)
+    {
+        //outlines are drawn by the shader in distance field mode
+        return getDistanceFieldGlyph(codepoint, charSize, bold);
+    }
+
+    auto& currentGlyphs = getPage(charSize).glyphs;
 
     auto key = combine(outlineThickness, bold, FT_Get_Char_Index(std::any_cast<FT_Face>(m_face), codepoint));
 
@@ -175,7 +291,7 @@ const Texture& Font::getTexture(std::uint32_t charSize) const
     //TODO this may return an invalid texture if the
     //current charSize is not inserted in the page map
     //and is automatically created
-    return m_pages[charSize].texture;
+    return getPage(charSize).texture;
 }
 
 float Font::getLineHeight(std::uint32_t charSize) const
@@ -235,9 +351,49 @@ void Font::setSmooth(bool smooth)
 
         for (auto& page : m_pages)
         {
-            page.second.texture.setSmooth(smooth);
+            //distance fields rely on linear filtering
+            page.second.texture.setSmooth(smooth || m_distanceField);
+        }
+    }
+}
+
+void Font::setDistanceField(bool enabled)
+{
+    if (enabled != m_distanceField)
+    {
+        stopDistanceFieldThread();
+        m_pages.clear();
+
+        m_distanceField = enabled;
+
+        if (enabled)
+        {
+            startDistanceFieldThread();
+            preloadGlyphs(32, 126);
+        }
+        else
+        {
+            std::scoped_lock lock(m_distanceFieldMutex);
+            m_distanceFieldQueue.clear();
+        }
+    }
+}
+
+void Font::preloadGlyphs(std::uint32_t first, std::uint32_t last, bool bold)
+{
+    if (!m_distanceField)
+    {
+        return;
+    }
+
+    {
+        std::scoped_lock lock(m_distanceFieldMutex);
+        for (auto i = first; i <= last; ++i)
+        {
+            m_distanceFieldQueue.emplace_back(i, bold);
         }
     }
+    m_distanceFieldCondition.notify_one();
 }
 
 //private
@@ -326,7 +482,7 @@ Glyph Font::loadGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold
         height += 2 * padding;
 
         //get the current page
-        auto& page = m_pages[charSize];
+        auto& page = getPage(charSize);
         page.texture.setSmooth(m_useSmoothing);
 
         //find somewhere to insert the glyph
@@ -446,6 +602,7 @@ FloatRect Font::getGlyphRect(Page& page, std::uint32_t width, std::uint32_t heig
                 Texture texture;
                 texture.create(texWidth * 2, texHeight * 2);
                 texture.setSmooth(true);
+                Detail::TextureRegistry::setCategory(texture.getGLHandle(), TextureMemory::Font);
                 texture.update(page.texture);
                 page.texture.swap(texture);
                 page.updated = true;
@@ -499,8 +656,188 @@ bool Font::setCurrentCharacterSize(std::uint32_t size) const
     return true;
 }
 
+Font::Page& Font::getPage(std::uint32_t charSize) const
+{
+    return m_pages[m_distanceField ? 0 : charSize];
+}
+
+void Font::startDistanceFieldThread()
+{
+    if (!m_face.has_value()
+        || m_distanceFieldThread)
+    {
+        return;
+    }
+
+    m_threadRunning = true;
+    m_distanceFieldThread = std::make_unique<std::thread>(&Font::distanceFieldThreadFunc, this);
+}
+
+void Font::stopDistanceFieldThread()
+{
+    if (m_distanceFieldThread)
+    {
+        {
+            std::scoped_lock lock(m_distanceFieldMutex);
+            m_threadRunning = false;
+        }
+        m_distanceFieldCondition.notify_all();
+
+        m_distanceFieldThread->join();
+        m_distanceFieldThread.reset();
+    }
+
+    //any pending glyphs belong to the outgoing face
+    std::scoped_lock lock(m_distanceFieldMutex);
+    m_distanceFieldResults.clear();
+    m_resultsReady = false;
+}
+
+void Font::distanceFieldThreadFunc()
+{
+    //FreeType faces can't be shared between threads
+    //so the worker creates its own from the font data
+    FT_Library library;
+    if (FT_Init_FreeType(&library) != 0)
+    {
+        LogE << "Distance field worker failed to init freetype" << std::endl;
+        return;
+    }
+
+    FT_Face face = nullptr;
+    if (FT_New_Memory_Face(library, m_buffer.data(), static_cast<FT_Long>(m_buffer.size()), 0, &face) != 0
+        || FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0
+        || FT_Set_Pixel_Sizes(face, 0, DistanceFieldSize) != 0)
+    {
+        LogE << "Distance field worker failed to create font face" << std::endl;
+        FT_Done_FreeType(library);
+        return;
+    }
+
+    while (m_threadRunning)
+    {
+        std::pair<std::uint32_t, bool> job;
+        {
+            std::unique_lock lock(m_distanceFieldMutex);
+            m_distanceFieldCondition.wait(lock, [&]() {return !m_distanceFieldQueue.empty() || !m_threadRunning; });
+
+            if (!m_threadRunning)
+            {
+                break;
+            }
+
+            job = m_distanceFieldQueue.back();
+            m_distanceFieldQueue.pop_back();
+        }
+
+        DistanceFieldGlyph result;
+        result.key = combine(0.f, job.second, FT_Get_Char_Index(face, job.first));
+        if (rasteriseDistanceField(face, library, job.first, job.second, result.glyph, result.width, result.height, result.pixels))
+        {
+            std::scoped_lock lock(m_distanceFieldMutex);
+            m_distanceFieldResults.push_back(std::move(result));
+            m_resultsReady = true;
+        }
+    }
+
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+}
+
+Glyph Font::getDistanceFieldGlyph(std::uint32_t codepoint, std::uint32_t charSize, bool bold) const
+{
+    if (!m_face.has_value())
+    {
+        return {};
+    }
+
+    flushDistanceFieldGlyphs();
+
+    auto face = std::any_cast<FT_Face>(m_face);
+    auto& glyphs = getPage(charSize).glyphs;
+    auto key = combine(0.f, bold, FT_Get_Char_Index(face, codepoint));
+
+    const Glyph* glyph = nullptr;
+    if (auto result = glyphs.find(key); result != glyphs.end())
+    {
+        glyph = &result->second;
+    }
+    else
+    {
+        //not generated by the worker yet, so create it now.
+        //failed glyphs are still stored so we don't try again
+        DistanceFieldGlyph dfGlyph;
+        dfGlyph.key = key;
+        if (setCurrentCharacterSize(DistanceFieldSize))
+        {
+            rasteriseDistanceField(face, std::any_cast<FT_Library>(m_library), codepoint, bold,
+                dfGlyph.glyph, dfGlyph.width, dfGlyph.height, dfGlyph.pixels);
+        }
+        glyph = &addDistanceFieldGlyph(dfGlyph);
+    }
+
+    //scale the metrics from the reference size - texture bounds remain in atlas pixels
+    const float scale = static_cast<float>(charSize) / DistanceFieldSize;
+
+    Glyph retVal = *glyph;
+    retVal.advance *= scale;
+    retVal.bounds.left *= scale;
+    retVal.bounds.bottom *= scale;
+    retVal.bounds.width *= scale;
+    retVal.bounds.height *= scale;
+
+    return retVal;
+}
+
+void Font::flushDistanceFieldGlyphs() const
+{
+    if (m_resultsReady)
+    {
+        std::vector<DistanceFieldGlyph> results;
+        {
+            std::scoped_lock lock(m_distanceFieldMutex);
+            results.swap(m_distanceFieldResults);
+            m_resultsReady = false;
+        }
+
+        const auto& glyphs = getPage(0).glyphs;
+        for (const auto& result : results)
+        {
+            //may have already been created on demand
+            if (glyphs.count(result.key) == 0)
+            {
+                addDistanceFieldGlyph(result);
+            }
+        }
+    }
+}
+
+const Glyph& Font::addDistanceFieldGlyph(const DistanceFieldGlyph& dfGlyph) const
+{
+    auto& page = getPage(0);
+    page.texture.setSmooth(true);
+
+    Glyph glyph = dfGlyph.glyph;
+    if (dfGlyph.width > 0 && dfGlyph.height > 0)
+    {
+        glyph.textureBounds = getGlyphRect(page, dfGlyph.width, dfGlyph.height);
+
+        //the rect is smaller than the glyph if the atlas is full
+        if (glyph.textureBounds.width == dfGlyph.width)
+        {
+            auto x = static_cast<std::uint32_t>(glyph.textureBounds.left);
+            auto y = static_cast<std::uint32_t>(glyph.textureBounds.bottom);
+            page.texture.update(dfGlyph.pixels.data(), false, { x, y, dfGlyph.width, dfGlyph.height });
+        }
+    }
+
+    return page.glyphs.insert(std::make_pair(dfGlyph.key, glyph)).first->second;
+}
+
 void Font::cleanup()
 {
+    stopDistanceFieldThread();
+
     if (m_stroker.has_value())
     {
         auto stroker = std::any_cast<FT_Stroker>(m_stroker);
@@ -538,12 +875,12 @@ void Font::cleanup()
 
 bool Font::pageUpdated(std::uint32_t charSize) const
 {
-    return m_pages[charSize].updated;
+    return getPage(charSize).updated;
 }
 
 void Font::markPageRead(std::uint32_t charSize) const
 {
-    m_pages[charSize].updated = false;
+    getPage(charSize).updated = false;
 }
 
 Font::Page::Page()
@@ -552,4 +889,5 @@ Font::Page::Page()
     img.create(128, 128, Colour(1.f, 1.f, 1.f, 0.f));
     texture.create(128, 128);
     texture.update(img.getPixelData());
+    Detail::TextureRegistry::setCategory(texture.getGLHandle(), TextureMemory::Font);
 }
\ No newline at end of file
@@ -39,11 +39,249 @@ source distribution.
 #include <crogine/core/FileSystem.hpp>
 #include <crogine/core/Log.hpp>
 
+#include "../detail/AsyncLoader.hpp"
+
 #include <array>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <memory>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CRO_IMAGE_SSE2
+#include <emmintrin.h>
+#if defined(__SSSE3__) || defined(__AVX__)
+#define CRO_IMAGE_SSSE3
+#include <tmmintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CRO_IMAGE_NEON
+#include <arm_neon.h>
+#endif
 
 using namespace cro;
 
+namespace
+{
+    std::int32_t getPixelWidth(ImageFormat::Type format)
+    {
+        switch (format)
+        {
+        default: return 0;
+        case ImageFormat::A: return 1;
+        case ImageFormat::RGB: return 3;
+        case ImageFormat::RGBA: return 4;
+        }
+    }
+
+    void swapRows(std::uint8_t* a, std::uint8_t* b, std::size_t size)
+    {
+        std::size_t i = 0;
+#if defined(CRO_IMAGE_SSE2)
+        for (; i + 16 <= size; i += 16)
+        {
+            auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(a + i), vb);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(b + i), va);
+        }
+#elif defined(CRO_IMAGE_NEON)
+        for (; i + 16 <= size; i += 16)
+        {
+            auto va = vld1q_u8(a + i);
+            auto vb = vld1q_u8(b + i);
+            vst1q_u8(a + i, vb);
+            vst1q_u8(b + i, va);
+        }
+#endif
+        std::swap_ranges(a + i, a + size, b + i);
+    }
+
+    void expandRGB(const std::uint8_t* src, std::uint8_t* dst, std::size_t pixelCount)
+    {
+        std::size_t i = 0;
+#if defined(CRO_IMAGE_SSSE3)
+        //each iteration reads 16 bytes but only consumes 12
+        //so stop while there's still enough input remaining
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const auto alpha = _mm_set1_epi32(0xff000000);
+        for (; i + 6 <= pixelCount; i += 4)
+        {
+            auto rgb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i * 3)));
+            auto rgba = _mm_or_si128(_mm_shuffle_epi8(rgb, shuffle), alpha);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i * 4)), rgba);
+        }
+#elif defined(CRO_IMAGE_NEON)
+        for (; i + 16 <= pixelCount; i += 16)
+        {
+            auto rgb = vld3q_u8(src + (i * 3));
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + (i * 4), rgba);
+        }
+#endif
+        for (; i < pixelCount; ++i)
+        {
+            dst[i * 4] = src[i * 3];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
+        }
+    }
+
+    void stripAlpha(const std::uint8_t* src, std::uint8_t* dst, std::size_t pixelCount)
+    {
+        std::size_t i = 0;
+#if defined(CRO_IMAGE_SSSE3)
+        //each iteration writes 16 bytes but only 12 are valid
+        //so stop while there's still enough output remaining
+        const auto shuffle = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        for (; i + 6 <= pixelCount; i += 4)
+        {
+            auto rgba = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (i * 4)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + (i * 3)), _mm_shuffle_epi8(rgba, shuffle));
+        }
+#elif defined(CRO_IMAGE_NEON)
+        for (; i + 16 <= pixelCount; i += 16)
+        {
+            auto rgba = vld4q_u8(src + (i * 4));
+            uint8x16x3_t rgb;
+            rgb.val[0] = rgba.val[0];
+            rgb.val[1] = rgba.val[1];
+            rgb.val[2] = rgba.val[2];
+            vst3q_u8(dst + (i * 3), rgb);
+        }
+#endif
+        for (; i < pixelCount; ++i)
+        {
+            dst[i * 3] = src[i * 4];
+            dst[i * 3 + 1] = src[i * 4 + 1];
+            dst[i * 3 + 2] = src[i * 4 + 2];
+        }
+    }
+
+    //x * a / 255, rounded. All paths use the same approximation
+    //so results are identical regardless of the platform.
+    constexpr std::uint8_t mulDiv255(std::uint32_t x, std::uint32_t a)
+    {
+        const auto t = (x * a) + 128;
+        return static_cast<std::uint8_t>((t + (t >> 8)) >> 8);
+    }
+
+    void premultiply(std::uint8_t* data, std::size_t pixelCount)
+    {
+        std::size_t i = 0;
+#if defined(CRO_IMAGE_SSE2)
+        const auto zero = _mm_setzero_si128();
+        const auto rgbMask = _mm_setr_epi16(-1, -1, -1, 0, -1, -1, -1, 0);
+        const auto alphaOne = _mm_setr_epi16(0, 0, 0, 255, 0, 0, 0, 255);
+        const auto round = _mm_set1_epi16(128);
+
+        const auto multiply = [&](__m128i px)
+        {
+            auto alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(px, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+            alpha = _mm_or_si128(_mm_and_si128(alpha, rgbMask), alphaOne);
+
+            auto t = _mm_add_epi16(_mm_mullo_epi16(px, alpha), round);
+            return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+        };
+
+        for (; i + 4 <= pixelCount; i += 4)
+        {
+            auto* ptr = reinterpret_cast<__m128i*>(data + (i * 4));
+            auto px = _mm_loadu_si128(ptr);
+            auto lo = multiply(_mm_unpacklo_epi8(px, zero));
+            auto hi = multiply(_mm_unpackhi_epi8(px, zero));
+            _mm_storeu_si128(ptr, _mm_packus_epi16(lo, hi));
+        }
+#elif defined(CRO_IMAGE_NEON)
+        const auto multiply = [](uint8x16_t c, uint8x16_t a)
+        {
+            auto lo = vmull_u8(vget_low_u8(c), vget_low_u8(a));
+            auto hi = vmull_u8(vget_high_u8(c), vget_high_u8(a));
+            return vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8),
+                               vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8));
+        };
+
+        for (; i + 16 <= pixelCount; i += 16)
+        {
+            auto px = vld4q_u8(data + (i * 4));
+            px.val[0] = multiply(px.val[0], px.val[3]);
+            px.val[1] = multiply(px.val[1], px.val[3]);
+            px.val[2] = multiply(px.val[2], px.val[3]);
+            vst4q_u8(data + (i * 4), px);
+        }
+#endif
+        for (; i < pixelCount; ++i)
+        {
+            auto* px = data + (i * 4);
+            px[0] = mulDiv255(px[0], px[3]);
+            px[1] = mulDiv255(px[1], px[3]);
+            px[2] = mulDiv255(px[2], px[3]);
+        }
+    }
+
+    //there are only 256 possible inputs so a table lookup is
+    //far cheaper than evaluating the transfer function per pixel
+    using ColourTable = std::array<std::uint8_t, 256>;
+
+    const ColourTable& getLinearTable()
+    {
+        static const ColourTable table = []()
+        {
+            ColourTable t = {};
+            for (auto i = 0u; i < t.size(); ++i)
+            {
+                const float c = static_cast<float>(i) / 255.f;
+                const float l = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+                t[i] = static_cast<std::uint8_t>(std::round(l * 255.f));
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    const ColourTable& getSRGBTable()
+    {
+        static const ColourTable table = []()
+        {
+            ColourTable t = {};
+            for (auto i = 0u; i < t.size(); ++i)
+            {
+                const float l = static_cast<float>(i) / 255.f;
+                const float c = l <= 0.0031308f ? l * 12.92f : (1.055f * std::pow(l, 1.f / 2.4f)) - 0.055f;
+                t[i] = static_cast<std::uint8_t>(std::round(c * 255.f));
+            }
+            return t;
+        }();
+        return table;
+    }
+
+    void applyTable(std::uint8_t* data, std::size_t pixelCount, std::size_t pixelWidth, const ColourTable& table)
+    {
+        if (pixelWidth == 4)
+        {
+            for (auto i = 0u; i < pixelCount; ++i)
+            {
+                auto* px = data + (i * 4);
+                px[0] = table[px[0]];
+                px[1] = table[px[1]];
+                px[2] = table[px[2]];
+            }
+        }
+        else
+        {
+            for (auto i = 0u; i < pixelCount * 3; ++i)
+            {
+                data[i] = table[data[i]];
+            }
+        }
+    }
+}
+
 Image::Image(bool flipOnLoad)
     : m_format  (ImageFormat::None),
     m_flipped   (false),
@@ -90,14 +328,15 @@ bool Image::loadFromFile(const std::string& filePath)
 {
     auto path = FileSystem::getResourcePath() + filePath;
 
-    auto* file = SDL_RWFromFile(path.c_str(), "rb");
+    auto* file = FileSystem::openResource(path);
     if (!file)
     {
         Logger::log("Failed opening " + path, Logger::Type::Error);
         return false;
     }
 
-    stbi_set_flip_vertically_on_load(m_flipOnLoad ? 1 : 0);
+    //thread local so images can be loaded by AsyncLoader workers
+    stbi_set_flip_vertically_on_load_thread(m_flipOnLoad ? 1 : 0);
 
     STBIMG_stbio_RWops io;
     stbi_callback_from_RW(file, &io);
@@ -126,7 +365,7 @@ bool Image::loadFromFile(const std::string& filePath)
         stbi_image_free(img);
         SDL_RWclose(file);
 
-        stbi_set_flip_vertically_on_load(0);
+        stbi_set_flip_vertically_on_load_thread(0);
 
         return result;
     }
@@ -135,7 +374,7 @@ bool Image::loadFromFile(const std::string& filePath)
         Logger::log("failed to open image: " + path, Logger::Type::Error);
         SDL_RWclose(file);
 
-        stbi_set_flip_vertically_on_load(0);
+        stbi_set_flip_vertically_on_load_thread(0);
 
         return false;
     }
@@ -219,6 +458,21 @@ void image_writer_func(void* context, void* data, int size)
     SDL_RWwrite(file, data, size, 1);
 }
 
+namespace
+{
+    bool writePNG(const std::string& path, const std::uint8_t* data, glm::uvec2 size, std::int32_t pixelWidth)
+    {
+        RaiiRWops out;
+        out.file = SDL_RWFromFile(path.c_str(), "wb");
+        if (!out.file)
+        {
+            LogE << "Failed opening " << path << " for writing" << std::endl;
+            return false;
+        }
+        return stbi_write_png_to_func(image_writer_func, out.file, size.x, size.y, pixelWidth, data, size.x * pixelWidth) != 0;
+    }
+}
+
 bool Image::write(const std::string& path)
 {
     if (cro::FileSystem::getFileExtension(path) != ".png")
@@ -227,31 +481,128 @@ bool Image::write(const std::string& path)
         return false;
     }
 
-    std::int32_t pixelWidth = 0;
-    if (m_format == ImageFormat::RGB)
+    auto pixelWidth = getPixelWidth(m_format);
+    if (pixelWidth == 0)
     {
-        pixelWidth = 3;
+        Logger::log("Only RGB and RGBA format images currently supported", Logger::Type::Error);
+        return false;
     }
-    else if (m_format == ImageFormat::RGBA)
+
+    //stbi_flip_vertically_on_write() is global state which isn't
+    //safe to use if writeAsync() is running so flip a copy instead
+    if (m_flipped)
     {
-        pixelWidth = 4;
+        auto temp = *this;
+        temp.flipVertically();
+        return writePNG(path, temp.m_data.data(), m_size, pixelWidth);
     }
-    else if (m_format == ImageFormat::A)
+    return writePNG(path, m_data.data(), m_size, pixelWidth);
+}
+
+std::future<bool> Image::writeAsync(const std::string& path) const
+{
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result = promise->get_future();
+
+    if (cro::FileSystem::getFileExtension(path) != ".png")
     {
-        pixelWidth = 1;
+        Logger::log("Only png files currently supported", Logger::Type::Error);
+        promise->set_value(false);
+        return result;
     }
 
-    if (pixelWidth == 0)
+    auto pixelWidth = getPixelWidth(m_format);
+    if (pixelWidth == 0 || m_data.empty())
     {
         Logger::log("Only RGB and RGBA format images currently supported", Logger::Type::Error);
+        promise->set_value(false);
+        return result;
+    }
+
+    auto image = std::make_shared<Image>(*this);
+    if (image->m_flipped)
+    {
+        image->flipVertically();
+    }
+
+    Detail::AsyncLoader::queueJob([image, path, pixelWidth, promise]()
+        {
+            promise->set_value(writePNG(path, image->m_data.data(), image->m_size, pixelWidth));
+        });
+
+    return result;
+}
+
+void Image::flipVertically()
+{
+    if (m_data.empty())
+    {
+        return;
+    }
+
+    const std::size_t rowSize = m_size.x * getPixelWidth(m_format);
+    auto* top = m_data.data();
+    auto* bottom = m_data.data() + (rowSize * (m_size.y - 1));
+    while (top < bottom)
+    {
+        swapRows(top, bottom, rowSize);
+        top += rowSize;
+        bottom -= rowSize;
+    }
+}
+
+bool Image::convert(ImageFormat::Type format)
+{
+    if ((format != ImageFormat::RGB && format != ImageFormat::RGBA)
+        || (m_format != ImageFormat::RGB && m_format != ImageFormat::RGBA))
+    {
+        LogE << "Image conversion only supported between RGB and RGBA formats" << std::endl;
         return false;
     }
 
-    stbi_flip_vertically_on_write(m_flipped ? 1 : 0);
+    if (format == m_format)
+    {
+        return true;
+    }
+
+    const std::size_t pixelCount = m_size.x * m_size.y;
+    std::vector<std::uint8_t> data(pixelCount * getPixelWidth(format));
+    if (format == ImageFormat::RGBA)
+    {
+        expandRGB(m_data.data(), data.data(), pixelCount);
+    }
+    else
+    {
+        stripAlpha(m_data.data(), data.data(), pixelCount);
+    }
+
+    m_data.swap(data);
+    m_format = format;
+    return true;
+}
+
+void Image::premultiplyAlpha()
+{
+    if (m_format == ImageFormat::RGBA)
+    {
+        premultiply(m_data.data(), m_size.x * m_size.y);
+    }
+}
 
-    RaiiRWops out;
-    out.file = SDL_RWFromFile(path.c_str(), "wb");
-    return stbi_write_png_to_func(image_writer_func, out.file, m_size.x, m_size.y, pixelWidth, m_data.data(), m_size.x * pixelWidth) != 0;
+void Image::convertToLinear()
+{
+    if (m_format == ImageFormat::RGB || m_format == ImageFormat::RGBA)
+    {
+        applyTable(m_data.data(), m_size.x * m_size.y, getPixelWidth(m_format), getLinearTable());
+    }
+}
+
+void Image::convertToSRGB()
+{
+    if (m_format == ImageFormat::RGB || m_format == ImageFormat::RGBA)
+    {
+        applyTable(m_data.data(), m_size.x * m_size.y, getPixelWidth(m_format), getSRGBTable());
+    }
 }
 
 void Image::setPixel(std::size_t x, std::size_t y, cro::Colour colour)
@@ -28,7 +28,9 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/graphics/IqmBuilder.hpp>
+#include <crogine/core/FileSystem.hpp>
 #include "../detail/GLCheck.hpp"
+#include "../detail/MeshUpload.hpp"
 
 #include <crogine/detail/glm/mat4x4.hpp>
 #include <crogine/detail/glm/gtc/quaternion.hpp>
@@ -88,7 +90,7 @@ cro::Mesh::Data IqmBuilder::build() const
     cro::Mesh::Data returnData;
     returnData.primitiveType = GL_TRIANGLES;
     
-    m_file = SDL_RWFromFile(m_path.c_str(), "rb");
+    m_file = FileSystem::openResource(m_path);
     if (m_file)
     {
         //do some file checks
@@ -281,10 +283,7 @@ void loadVertexData(const Iqm::Header& header, char* data, const std::string& st
         out.indexData[i].indexCount = static_cast<std::uint32_t>(indices.size());
         out.submeshCount++;
 
-        glCheck(glGenBuffers(1, &out.indexData[i].ibo));
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, out.indexData[i].ibo));
-        glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, out.indexData[i].indexCount * sizeof(std::uint16_t), indices.data(), GL_STATIC_DRAW));
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+        Detail::createIndexBuffer(out, i, indices.data(), out.indexData[i].indexCount * sizeof(std::uint16_t));
     }
 
 
@@ -501,10 +500,7 @@ void loadVertexData(const Iqm::Header& header, char* data, const std::string& st
     out.vertexCount = header.vertexCount;
     out.vertexSize = vertexSize * sizeof(float);
     
-    glCheck(glGenBuffers(1, &out.vbo));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, out.vbo));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, out.vertexSize * out.vertexCount, vertexData.data(), GL_STATIC_DRAW));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    Detail::createVertexBuffer(out, vertexData.data(), out.vertexSize * out.vertexCount);
 }
 
 void loadAnimationData(const Iqm::Header& header, char* data, const std::string& strings, cro::Skeleton& out)
@@ -246,4 +246,33 @@ void MeshBatch::updateMeshData(Mesh::Data& data) const
         data.boundingSphere.centre = data.boundingBox[0] + rad;
         data.boundingSphere.radius = glm::length(rad);
     }
-}
\ No newline at end of file
+}
+
+MeshOptimiser::Report MeshBatch::optimise()
+{
+    //cmf files don't contain blend data
+    std::uint32_t stride = 0;
+    for (auto i = 0u; i < Mesh::Attribute::BlendIndices; ++i)
+    {
+        if (m_flags & (1 << i))
+        {
+            stride += (i == Mesh::UV0 || i == Mesh::UV1) ? 2 : 3;
+        }
+    }
+
+    std::vector<std::vector<std::uint32_t>> indices(m_indexData.size());
+    for (auto i = 0u; i < m_indexData.size(); ++i)
+    {
+        indices[i].swap(m_indexData[i]);
+    }
+
+    CRO_ASSERT(m_vertexData.size() % stride == 0, "Incorrect stride");
+    auto report = MeshOptimiser::optimise(m_vertexData, stride, indices);
+
+    for (auto i = 0u; i < m_indexData.size(); ++i)
+    {
+        m_indexData[i].swap(indices[i]);
+    }
+
+    return report;
+}
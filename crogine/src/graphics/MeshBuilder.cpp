@@ -30,9 +30,60 @@ source distribution.
 #include <crogine/graphics/MeshBuilder.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/MeshUpload.hpp"
+
+#include <cstring>
 
 using namespace cro;
 
+thread_local Detail::MeshUpload* Detail::MeshUpload::active = nullptr;
+
+void Detail::MeshUpload::createBuffers(Mesh::Data& meshData) const
+{
+    //no upload is active on the main thread so these create the buffers
+    if (!vertexData.empty())
+    {
+        createVertexBuffer(meshData, vertexData.data(), vertexData.size());
+    }
+
+    for (auto i = 0u; i < meshData.submeshCount; ++i)
+    {
+        createIndexBuffer(meshData, i, indexData[i].data(), indexData[i].size());
+    }
+}
+
+void Detail::createVertexBuffer(Mesh::Data& meshData, const void* data, std::size_t size)
+{
+    if (MeshUpload::active)
+    {
+        auto& dst = MeshUpload::active->vertexData;
+        dst.resize(size);
+        std::memcpy(dst.data(), data, size);
+        return;
+    }
+
+    glCheck(glGenBuffers(1, &meshData.vbo));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
+    glCheck(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+}
+
+void Detail::createIndexBuffer(Mesh::Data& meshData, std::size_t index, const void* data, std::size_t size)
+{
+    if (MeshUpload::active)
+    {
+        auto& dst = MeshUpload::active->indexData[index];
+        dst.resize(size);
+        std::memcpy(dst.data(), data, size);
+        return;
+    }
+
+    glCheck(glGenBuffers(1, &meshData.indexData[index].ibo));
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[index].ibo));
+    glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
+    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
 std::size_t MeshBuilder::getAttributeSize(const std::array<std::size_t, Mesh::Attribute::Total>& attrib)
 {
     std::size_t size = 0;
@@ -50,16 +101,10 @@ std::size_t MeshBuilder::getVertexSize(const std::array<std::size_t, Mesh::Attri
 
 void MeshBuilder::createVBO(Mesh::Data& meshData, const std::vector<float>& vertexData)
 {
-    glCheck(glGenBuffers(1, &meshData.vbo));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-    glCheck(glBufferData(GL_ARRAY_BUFFER, meshData.vertexSize * meshData.vertexCount, vertexData.data(), GL_STATIC_DRAW));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    Detail::createVertexBuffer(meshData, vertexData.data(), meshData.vertexSize * meshData.vertexCount);
 }
 
 void MeshBuilder::createIBO(Mesh::Data& meshData, const void* idxData, std::size_t idx, std::int32_t dataSize)
 {
-    glCheck(glGenBuffers(1, &meshData.indexData[idx].ibo));
-    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[idx].ibo));
-    glCheck(glBufferData(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[idx].indexCount * dataSize, idxData, GL_STATIC_DRAW));
-    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    Detail::createIndexBuffer(meshData, idx, idxData, meshData.indexData[idx].indexCount * dataSize);
 }
\ No newline at end of file
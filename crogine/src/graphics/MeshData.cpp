@@ -28,10 +28,15 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/graphics/MeshData.hpp>
+#include <crogine/detail/glm/gtc/packing.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/VertexFormat.hpp"
 
 #include <type_traits>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
 
 /*
 OK So this is basically esoteric template specialisation
@@ -49,25 +54,89 @@ namespace
             || std::is_same<T, std::uint16_t>::value
             || std::is_same<T, std::uint32_t>::value, "must be uint8, uint16 or uint32");
 
-        destVerts.clear();
-        destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+        std::vector<std::uint8_t> vertexData(meshData.vertexCount * meshData.vertexSize);
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
+        glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, vertexData.size(), vertexData.data()));
         glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
 
+        cro::Detail::decodeVertexData(meshData, vertexData.data(), destVerts);
+
         destIndices.clear();
         destIndices.resize(meshData.submeshCount);
 
         for (auto i = 0u; i < meshData.submeshCount; ++i)
         {
-            destIndices[i].resize(meshData.indexData[i].indexCount);
+            const auto indexCount = meshData.indexData[i].indexCount;
+            destIndices[i].resize(indexCount);
             glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(T), destIndices[i].data()));
+
+            //convert the index type if it doesn't match the stored format
+            switch (meshData.indexData[i].format)
+            {
+            default:
+                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(T), destIndices[i].data()));
+                break;
+            case GL_UNSIGNED_BYTE:
+            {
+                std::vector<std::uint8_t> temp(indexCount);
+                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount, temp.data()));
+                std::copy(temp.begin(), temp.end(), destIndices[i].begin());
+            }
+                break;
+            case GL_UNSIGNED_SHORT:
+            {
+                std::vector<std::uint16_t> temp(indexCount);
+                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(std::uint16_t), temp.data()));
+                std::transform(temp.begin(), temp.end(), destIndices[i].begin(), [](std::uint16_t v) { return static_cast<T>(v); });
+            }
+                break;
+            case GL_UNSIGNED_INT:
+            {
+                std::vector<std::uint32_t> temp(indexCount);
+                glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indexCount * sizeof(std::uint32_t), temp.data()));
+                std::transform(temp.begin(), temp.end(), destIndices[i].begin(), [](std::uint32_t v) { return static_cast<T>(v); });
+            }
+                break;
+            }
         }
         glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
     }
 }
 
+std::size_t cro::Mesh::getAttributeFormatSize(std::uint8_t format)
+{
+    switch (format)
+    {
+    default:
+    case AttributeFormat::Float:
+        return sizeof(float);
+    case AttributeFormat::HalfFloat:
+    case AttributeFormat::SNorm16:
+    case AttributeFormat::UNorm16:
+        return sizeof(std::uint16_t);
+    case AttributeFormat::SNorm8:
+    case AttributeFormat::UNorm8:
+    case AttributeFormat::UInt8:
+        return sizeof(std::uint8_t);
+    }
+}
+
+std::size_t cro::Mesh::getFloatVertexSize(const Data& meshData)
+{
+    //unquantised data is copied as-is
+    if (std::all_of(meshData.attributeFormats.begin(), meshData.attributeFormats.end(),
+        [](std::uint8_t f) {return f == AttributeFormat::Float; }))
+    {
+        return meshData.vertexSize;
+    }
+
+    std::size_t floatCount = 0;
+    for (auto a : meshData.attributes)
+    {
+        floatCount += a;
+    }
+    return floatCount * sizeof(float);
+}
 
 void cro::Mesh::readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint8_t>>& destIndices)
 {
@@ -82,4 +151,148 @@ void cro::Mesh::readVertexData(const Data& meshData, std::vector<float>& destVer
 void cro::Mesh::readVertexData(const Data& meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint32_t>>& destIndices)
 {
     read(meshData, destVerts, destIndices);
-}
\ No newline at end of file
+}
+
+std::uint32_t cro::Detail::getAttributeType(std::uint8_t format)
+{
+    switch (format)
+    {
+    default:
+    case AttributeFormat::Float:
+        return GL_FLOAT;
+    case AttributeFormat::HalfFloat:
+        return GL_HALF_FLOAT;
+    case AttributeFormat::SNorm16:
+        return GL_SHORT;
+    case AttributeFormat::UNorm16:
+        return GL_UNSIGNED_SHORT;
+    case AttributeFormat::SNorm8:
+        return GL_BYTE;
+    case AttributeFormat::UNorm8:
+    case AttributeFormat::UInt8:
+        return GL_UNSIGNED_BYTE;
+    }
+}
+
+std::uint8_t cro::Detail::isAttributeNormalised(std::uint8_t format)
+{
+    switch (format)
+    {
+    default:
+        return GL_FALSE;
+    case AttributeFormat::SNorm16:
+    case AttributeFormat::UNorm16:
+    case AttributeFormat::SNorm8:
+    case AttributeFormat::UNorm8:
+        return GL_TRUE;
+    }
+}
+
+float cro::Detail::decodeComponent(const std::uint8_t* src, std::uint8_t format)
+{
+    switch (format)
+    {
+    default:
+    case AttributeFormat::Float:
+    {
+        float f = 0.f;
+        std::memcpy(&f, src, sizeof(f));
+        return f;
+    }
+    case AttributeFormat::HalfFloat:
+    {
+        std::uint16_t h = 0;
+        std::memcpy(&h, src, sizeof(h));
+        return glm::unpackHalf1x16(h);
+    }
+    case AttributeFormat::SNorm16:
+    {
+        std::int16_t s = 0;
+        std::memcpy(&s, src, sizeof(s));
+        return std::max(-1.f, static_cast<float>(s) / 32767.f);
+    }
+    case AttributeFormat::UNorm16:
+    {
+        std::uint16_t s = 0;
+        std::memcpy(&s, src, sizeof(s));
+        return static_cast<float>(s) / 65535.f;
+    }
+    case AttributeFormat::SNorm8:
+        return std::max(-1.f, static_cast<float>(static_cast<std::int8_t>(*src)) / 127.f);
+    case AttributeFormat::UNorm8:
+        return static_cast<float>(*src) / 255.f;
+    case AttributeFormat::UInt8:
+        return static_cast<float>(*src);
+    }
+}
+
+void cro::Detail::encodeComponent(float value, std::uint8_t format, std::uint8_t* dst)
+{
+    switch (format)
+    {
+    default:
+    case AttributeFormat::Float:
+        std::memcpy(dst, &value, sizeof(value));
+        break;
+    case AttributeFormat::HalfFloat:
+    {
+        auto h = glm::packHalf1x16(value);
+        std::memcpy(dst, &h, sizeof(h));
+    }
+        break;
+    case AttributeFormat::SNorm16:
+    {
+        auto s = static_cast<std::int16_t>(std::round(std::clamp(value, -1.f, 1.f) * 32767.f));
+        std::memcpy(dst, &s, sizeof(s));
+    }
+        break;
+    case AttributeFormat::UNorm16:
+    {
+        auto s = static_cast<std::uint16_t>(std::round(std::clamp(value, 0.f, 1.f) * 65535.f));
+        std::memcpy(dst, &s, sizeof(s));
+    }
+        break;
+    case AttributeFormat::SNorm8:
+        *dst = static_cast<std::uint8_t>(static_cast<std::int8_t>(std::round(std::clamp(value, -1.f, 1.f) * 127.f)));
+        break;
+    case AttributeFormat::UNorm8:
+        *dst = static_cast<std::uint8_t>(std::round(std::clamp(value, 0.f, 1.f) * 255.f));
+        break;
+    case AttributeFormat::UInt8:
+        *dst = static_cast<std::uint8_t>(std::clamp(std::round(value), 0.f, 255.f));
+        break;
+    }
+}
+
+void cro::Detail::decodeVertexData(const Mesh::Data& meshData, const std::uint8_t* src, std::vector<float>& dst)
+{
+    dst.clear();
+
+    if (std::all_of(meshData.attributeFormats.begin(), meshData.attributeFormats.end(), 
+        [](std::uint8_t f) {return f == AttributeFormat::Float; }))
+    {
+        dst.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
+        std::memcpy(dst.data(), src, dst.size() * sizeof(float));
+        return;
+    }
+
+    const auto floatStride = Mesh::getFloatVertexSize(meshData) / sizeof(float);
+    dst.resize(meshData.vertexCount * floatStride);
+
+    for (auto i = 0u; i < meshData.vertexCount; ++i)
+    {
+        const auto* vertex = src + (i * meshData.vertexSize);
+        auto* output = dst.data() + (i * floatStride);
+
+        for (auto j = 0u; j < Mesh::Attribute::Total; ++j)
+        {
+            const auto format = meshData.attributeFormats[j];
+            const auto componentSize = getAttributeFormatSize(format);
+            for (auto k = 0u; k < meshData.attributes[j]; ++k)
+            {
+                *output++ = decodeComponent(vertex, format);
+                vertex += componentSize;
+            }
+        }
+    }
+}
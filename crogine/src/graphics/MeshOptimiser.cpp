@@ -0,0 +1,578 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/graphics/MeshOptimiser.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <crogine/detail/glm/vec3.hpp>
+#include <crogine/detail/glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <unordered_map>
+
+using namespace cro;
+using namespace cro::MeshOptimiser;
+
+namespace
+{
+    //Forsyth scoring constants. The cache size used for scoring is
+    //larger than the measured FIFO cache, as suggested in the original paper
+    constexpr std::size_t ScoringCacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.f;
+    constexpr float ValenceBoostPower = 0.5f;
+
+    constexpr std::size_t CacheLineSize = 64;
+    constexpr std::size_t FetchCacheLines = 64;
+
+    float vertexScore(std::int32_t cachePosition, std::uint32_t remainingTris)
+    {
+        if (remainingTris == 0)
+        {
+            return -1.f;
+        }
+
+        float score = 0.f;
+        if (cachePosition > -1)
+        {
+            if (cachePosition < 3)
+            {
+                //used by the last triangle so it doesn't matter
+                //which of these we use next
+                score = LastTriScore;
+            }
+            else
+            {
+                const float scaler = 1.f / static_cast<float>(ScoringCacheSize - 3);
+                score = 1.f - (static_cast<float>(cachePosition - 3) * scaler);
+                score = std::pow(score, CacheDecayPower);
+            }
+        }
+
+        //boost vertices with few remaining triangles so they're
+        //cleared up rather than left as lone triangles
+        score += ValenceBoostScale * std::pow(static_cast<float>(remainingTris), -ValenceBoostPower);
+        return score;
+    }
+
+    //returns the number of cache misses of a FIFO cache
+    std::size_t simulateCache(const std::vector<std::uint32_t>& indices, std::size_t vertexCount, std::vector<std::size_t>& timestamps, std::size_t& time)
+    {
+        //a vertex is in the cache if it was added within the last CacheSize misses
+        std::size_t misses = 0;
+        for (auto idx : indices)
+        {
+            CRO_ASSERT(idx < vertexCount, "index out of range");
+            if (time - timestamps[idx] >= CacheSize)
+            {
+                timestamps[idx] = time++;
+                misses++;
+            }
+        }
+        return misses;
+    }
+
+    float calcACMR(const std::vector<std::uint32_t>& indices, std::size_t vertexCount)
+    {
+        if (indices.size() < 3)
+        {
+            return 0.f;
+        }
+
+        std::vector<std::size_t> timestamps(vertexCount, 0);
+        std::size_t time = CacheSize + 1;
+        auto misses = simulateCache(indices, vertexCount, timestamps, time);
+        return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    }
+}
+
+void Report::log() const
+{
+    static const std::array<std::string, Pass::Count> PassNames =
+    {
+        "Original", "Deduplicate", "Vertex Cache", "Overdraw", "Vertex Fetch"
+    };
+
+    for (auto i = 0u; i < Pass::Count; ++i)
+    {
+        LogI << PassNames[i] << ": " << passes[i].vertexCount << " vertices, " << passes[i].triangleCount << " triangles"
+            << ", ACMR " << passes[i].acmr << ", ATVR " << passes[i].atvr << ", overfetch " << passes[i].overfetch << std::endl;
+    }
+}
+
+Stats MeshOptimiser::analyse(const std::vector<std::vector<std::uint32_t>>& indices, std::size_t vertexCount, std::size_t vertexSize)
+{
+    Stats stats;
+    stats.vertexCount = vertexCount;
+
+    if (vertexCount == 0)
+    {
+        return stats;
+    }
+
+    //vertex cache - sub-meshes are drawn separately so the cache is flushed in between
+    std::vector<std::size_t> timestamps(vertexCount, 0);
+    std::size_t time = CacheSize + 1;
+    std::size_t misses = 0;
+    for (const auto& arr : indices)
+    {
+        stats.triangleCount += arr.size() / 3;
+        misses += simulateCache(arr, vertexCount, timestamps, time);
+        time += CacheSize;
+    }
+
+    if (stats.triangleCount != 0)
+    {
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(stats.triangleCount);
+    }
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+
+    //vertex fetch - count the cache lines read from a small FIFO memory cache
+    if (vertexSize != 0)
+    {
+        const auto lineCount = ((vertexCount * vertexSize) + CacheLineSize - 1) / CacheLineSize;
+        std::vector<std::size_t> lineStamps(lineCount, 0);
+        std::size_t lineTime = FetchCacheLines + 1;
+        std::size_t linesFetched = 0;
+
+        for (const auto& arr : indices)
+        {
+            for (auto idx : arr)
+            {
+                const auto first = (idx * vertexSize) / CacheLineSize;
+                const auto last = (((idx + 1) * vertexSize) - 1) / CacheLineSize;
+                for (auto line = first; line <= last; ++line)
+                {
+                    if (lineTime - lineStamps[line] >= FetchCacheLines)
+                    {
+                        lineStamps[line] = lineTime++;
+                        linesFetched++;
+                    }
+                }
+            }
+        }
+        stats.overfetch = static_cast<float>(linesFetched * CacheLineSize) / static_cast<float>(vertexCount * vertexSize);
+    }
+
+    return stats;
+}
+
+std::size_t MeshOptimiser::deduplicateVertices(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices)
+{
+    CRO_ASSERT(stride != 0 && vertices.size() % stride == 0, "");
+    const auto vertexCount = vertices.size() / stride;
+
+    //vertices are compared bitwise, so hash the raw bytes
+    struct VertexHash final
+    {
+        const float* data = nullptr;
+        std::size_t stride = 0;
+        std::size_t operator()(std::uint32_t v) const
+        {
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(data + (v * stride));
+            std::size_t hash = 0xcbf29ce484222325;
+            for (auto i = 0u; i < stride * sizeof(float); ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 0x100000001b3;
+            }
+            return hash;
+        }
+    };
+
+    struct VertexEqual final
+    {
+        const float* data = nullptr;
+        std::size_t stride = 0;
+        bool operator()(std::uint32_t a, std::uint32_t b) const
+        {
+            return std::memcmp(data + (a * stride), data + (b * stride), stride * sizeof(float)) == 0;
+        }
+    };
+
+    std::unordered_map<std::uint32_t, std::uint32_t, VertexHash, VertexEqual> uniqueVertices(vertexCount,
+        VertexHash({ vertices.data(), stride }), VertexEqual({ vertices.data(), stride }));
+
+    std::vector<std::uint32_t> remap(vertexCount);
+    std::vector<float> output;
+    output.reserve(vertices.size());
+
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        auto [result, inserted] = uniqueVertices.insert(std::make_pair(i, static_cast<std::uint32_t>(output.size() / stride)));
+        if (inserted)
+        {
+            output.insert(output.end(), vertices.begin() + (i * stride), vertices.begin() + ((i + 1) * stride));
+        }
+        remap[i] = result->second;
+    }
+
+    for (auto& arr : indices)
+    {
+        for (auto& idx : arr)
+        {
+            idx = remap[idx];
+        }
+    }
+
+    const auto removed = vertexCount - (output.size() / stride);
+    vertices.swap(output);
+
+    return removed;
+}
+
+void MeshOptimiser::optimiseVertexCache(std::vector<std::uint32_t>& indices, std::size_t vertexCount)
+{
+    CRO_ASSERT(indices.size() % 3 == 0, "must be a triangle list");
+    const auto triangleCount = indices.size() / 3;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    //build vertex -> triangle adjacency
+    std::vector<std::uint32_t> remainingTris(vertexCount, 0);
+    for (auto idx : indices)
+    {
+        remainingTris[idx]++;
+    }
+
+    std::vector<std::uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + remainingTris[i];
+    }
+
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        std::vector<std::uint32_t> counts(vertexCount, 0);
+        for (auto i = 0u; i < indices.size(); ++i)
+        {
+            const auto v = indices[i];
+            adjacency[adjacencyOffsets[v] + counts[v]++] = i / 3;
+        }
+    }
+
+    std::vector<std::int32_t> cachePositions(vertexCount, -1);
+    std::vector<float> vertexScores(vertexCount);
+    for (auto i = 0u; i < vertexCount; ++i)
+    {
+        vertexScores[i] = vertexScore(-1, remainingTris[i]);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    for (auto i = 0u; i < triangleCount; ++i)
+    {
+        triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> newCache;
+    cache.reserve(ScoringCacheSize + 3);
+    newCache.reserve(ScoringCacheSize + 3);
+
+    std::int64_t bestTriangle = std::distance(triangleScores.begin(), std::max_element(triangleScores.begin(), triangleScores.end()));
+    std::size_t scanPosition = 0;
+
+    for (auto t = 0u; t < triangleCount; ++t)
+    {
+        if (bestTriangle < 0)
+        {
+            //nothing adjacent to the cache so pick the next unused triangle
+            while (emitted[scanPosition])
+            {
+                scanPosition++;
+            }
+            bestTriangle = static_cast<std::int64_t>(scanPosition);
+        }
+
+        const auto tri = static_cast<std::size_t>(bestTriangle);
+        emitted[tri] = true;
+
+        newCache.clear();
+        for (auto i = 0u; i < 3u; ++i)
+        {
+            const auto v = indices[(tri * 3) + i];
+            output.push_back(v);
+            newCache.push_back(v);
+
+            //remove the triangle from the vertex's adjacency
+            auto* begin = &adjacency[adjacencyOffsets[v]];
+            auto* end = begin + remainingTris[v];
+            auto* result = std::find(begin, end, static_cast<std::uint32_t>(tri));
+            CRO_ASSERT(result != end, "");
+            std::swap(*result, *(end - 1));
+            remainingTris[v]--;
+        }
+
+        //most recently used vertices move to the front
+        for (auto v : cache)
+        {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+            {
+                newCache.push_back(v);
+            }
+        }
+
+        //update the scores of vertices in the cache, and any which dropped out
+        for (auto i = 0u; i < newCache.size(); ++i)
+        {
+            const auto v = newCache[i];
+            cachePositions[v] = (i < ScoringCacheSize) ? static_cast<std::int32_t>(i) : -1;
+            vertexScores[v] = vertexScore(cachePositions[v], remainingTris[v]);
+        }
+
+        //and find the best triangle using those vertices
+        bestTriangle = -1;
+        float bestScore = -1.f;
+        for (auto v : newCache)
+        {
+            for (auto i = 0u; i < remainingTris[v]; ++i)
+            {
+                const auto adjTri = adjacency[adjacencyOffsets[v] + i];
+                const auto score = vertexScores[indices[adjTri * 3]] + vertexScores[indices[adjTri * 3 + 1]] + vertexScores[indices[adjTri * 3 + 2]];
+                triangleScores[adjTri] = score;
+
+                if (score > bestScore)
+                {
+                    bestScore = score;
+                    bestTriangle = adjTri;
+                }
+            }
+        }
+
+        if (newCache.size() > ScoringCacheSize)
+        {
+            newCache.resize(ScoringCacheSize);
+        }
+        cache.swap(newCache);
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimiser::optimiseOverdraw(std::vector<std::uint32_t>& indices, const std::vector<float>& vertices, std::size_t stride, float threshold)
+{
+    CRO_ASSERT(indices.size() % 3 == 0, "must be a triangle list");
+    CRO_ASSERT(stride >= 3, "vertices require a position");
+
+    const auto triangleCount = indices.size() / 3;
+    const auto vertexCount = vertices.size() / stride;
+    if (triangleCount < 2)
+    {
+        return;
+    }
+
+    //split into clusters where the FIFO cache would be flushed
+    //(ie all three vertices of a triangle miss) so that reordering
+    //clusters has little effect on the cache efficiency
+    std::vector<std::size_t> clusters; //start triangle of each cluster
+    {
+        std::vector<std::size_t> timestamps(vertexCount, 0);
+        std::size_t time = CacheSize + 1;
+        for (auto i = 0u; i < triangleCount; ++i)
+        {
+            std::size_t misses = 0;
+            for (auto j = 0u; j < 3u; ++j)
+            {
+                const auto v = indices[(i * 3) + j];
+                if (time - timestamps[v] >= CacheSize)
+                {
+                    timestamps[v] = time++;
+                    misses++;
+                }
+            }
+
+            if (misses == 3)
+            {
+                clusters.push_back(i);
+            }
+        }
+    }
+
+    if (clusters.size() < 2)
+    {
+        return;
+    }
+
+    auto position = [&](std::uint32_t idx)
+    {
+        const auto* v = &vertices[idx * stride];
+        return glm::vec3(v[0], v[1], v[2]);
+    };
+
+    //mesh centroid
+    glm::vec3 meshCentre(0.f);
+    float meshArea = 0.f;
+
+    struct Cluster final
+    {
+        std::size_t start = 0;
+        std::size_t end = 0;
+        glm::vec3 centroid = glm::vec3(0.f);
+        glm::vec3 normal = glm::vec3(0.f);
+        float sortKey = 0.f;
+    };
+    std::vector<Cluster> clusterData(clusters.size());
+
+    for (auto i = 0u; i < clusters.size(); ++i)
+    {
+        auto& cluster = clusterData[i];
+        cluster.start = clusters[i];
+        cluster.end = (i + 1 < clusters.size()) ? clusters[i + 1] : triangleCount;
+
+        float clusterArea = 0.f;
+        for (auto t = cluster.start; t < cluster.end; ++t)
+        {
+            const auto a = position(indices[t * 3]);
+            const auto b = position(indices[t * 3 + 1]);
+            const auto c = position(indices[t * 3 + 2]);
+
+            //area weighted normal
+            const auto n = glm::cross(b - a, c - a);
+            const auto area = glm::length(n);
+            const auto centre = (a + b + c) / 3.f;
+
+            cluster.centroid += centre * area;
+            cluster.normal += n;
+            clusterArea += area;
+        }
+
+        meshCentre += cluster.centroid;
+        meshArea += clusterArea;
+
+        if (clusterArea > 0)
+        {
+            cluster.centroid /= clusterArea;
+        }
+
+        const auto len = glm::length(cluster.normal);
+        if (len > 0)
+        {
+            cluster.normal /= len;
+        }
+    }
+
+    if (meshArea > 0)
+    {
+        meshCentre /= meshArea;
+    }
+
+    //clusters facing away from the centre are most likely to
+    //occlude others, so draw them first
+    for (auto& cluster : clusterData)
+    {
+        cluster.sortKey = glm::dot(cluster.centroid - meshCentre, cluster.normal);
+    }
+
+    std::stable_sort(clusterData.begin(), clusterData.end(),
+        [](const Cluster& a, const Cluster& b)
+        {
+            return a.sortKey > b.sortKey;
+        });
+
+    std::vector<std::uint32_t> output;
+    output.reserve(indices.size());
+    for (const auto& cluster : clusterData)
+    {
+        output.insert(output.end(), indices.begin() + (cluster.start * 3), indices.begin() + (cluster.end * 3));
+    }
+
+    //only keep the result if the cache efficiency is mostly preserved
+    if (calcACMR(output, vertexCount) <= calcACMR(indices, vertexCount) * threshold)
+    {
+        indices.swap(output);
+    }
+}
+
+void MeshOptimiser::optimiseVertexFetch(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices)
+{
+    CRO_ASSERT(stride != 0 && vertices.size() % stride == 0, "");
+    const auto vertexCount = vertices.size() / stride;
+
+    static constexpr std::uint32_t Unused = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> remap(vertexCount, Unused);
+    std::vector<float> output;
+    output.reserve(vertices.size());
+
+    for (auto& arr : indices)
+    {
+        for (auto& idx : arr)
+        {
+            if (remap[idx] == Unused)
+            {
+                remap[idx] = static_cast<std::uint32_t>(output.size() / stride);
+                output.insert(output.end(), vertices.begin() + (idx * stride), vertices.begin() + ((idx + 1) * stride));
+            }
+            idx = remap[idx];
+        }
+    }
+
+    vertices.swap(output);
+}
+
+Report MeshOptimiser::optimise(std::vector<float>& vertices, std::size_t stride, std::vector<std::vector<std::uint32_t>>& indices)
+{
+    CRO_ASSERT(stride != 0 && vertices.size() % stride == 0, "");
+    const auto vertexSize = stride * sizeof(float);
+
+    Report report;
+    report.passes[Report::Original] = analyse(indices, vertices.size() / stride, vertexSize);
+
+    deduplicateVertices(vertices, stride, indices);
+    report.passes[Report::Deduplicate] = analyse(indices, vertices.size() / stride, vertexSize);
+
+    for (auto& arr : indices)
+    {
+        optimiseVertexCache(arr, vertices.size() / stride);
+    }
+    report.passes[Report::VertexCache] = analyse(indices, vertices.size() / stride, vertexSize);
+
+    for (auto& arr : indices)
+    {
+        optimiseOverdraw(arr, vertices, stride);
+    }
+    report.passes[Report::Overdraw] = analyse(indices, vertices.size() / stride, vertexSize);
+
+    optimiseVertexFetch(vertices, stride, indices);
+    report.passes[Report::VertexFetch] = analyse(indices, vertices.size() / stride, vertexSize);
+
+    return report;
+}
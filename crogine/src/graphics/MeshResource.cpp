@@ -32,6 +32,8 @@ source distribution.
 #include <crogine/graphics/MeshBuilder.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/AsyncLoader.hpp"
+#include "../detail/MeshUpload.hpp"
 
 #include <limits>
 
@@ -43,6 +45,7 @@ namespace
 }
 
 MeshResource::MeshResource()
+    : m_asyncHandle(std::make_shared<MeshResource*>(this))
 {
 
 }
@@ -112,6 +115,85 @@ std::size_t MeshResource::loadMesh(const MeshBuilder& mb, bool forceReload)
     return 0;
 }
 
+std::future<std::size_t> MeshResource::loadMeshAsync(std::unique_ptr<MeshBuilder> mb)
+{
+    CRO_ASSERT(mb, "");
+
+    auto promise = std::make_shared<std::promise<std::size_t>>();
+    auto result = promise->get_future();
+
+    std::size_t id = mb->getUID();
+    if (id != 0
+        && m_meshData.count(id) != 0)
+    {
+        promise->set_value(id);
+        return result;
+    }
+
+    if (id == 0)
+    {
+        id = autoID--;
+    }
+
+    std::shared_ptr<MeshBuilder> builder = std::move(mb);
+    std::weak_ptr<MeshResource*> handle = m_asyncHandle;
+
+    Detail::AsyncLoader::queueJob([handle, builder, promise, id]()
+        {
+            if (handle.expired())
+            {
+                promise->set_value(0);
+                return;
+            }
+
+            //the builder records its buffer data rather than creating the buffers
+            auto upload = std::make_shared<Detail::MeshUpload>();
+            Detail::MeshUpload::active = upload.get();
+            auto meshData = builder->build();
+            Detail::MeshUpload::active = nullptr;
+
+            auto skeleton = builder->getSkeleton();
+
+            Detail::AsyncLoader::queueUpload([handle, upload, meshData, skeleton, promise, id]() mutable
+                {
+                    auto resource = handle.lock();
+                    if (!resource)
+                    {
+                        promise->set_value(0);
+                        return;
+                    }
+
+                    auto& meshes = (*resource)->m_meshData;
+                    if (meshes.count(id) != 0)
+                    {
+                        //the same mesh was requested more than once
+                        promise->set_value(id);
+                        return;
+                    }
+
+                    if (upload->vertexData.empty()
+                        || meshData.submeshCount == 0)
+                    {
+                        LOG("Invalid mesh data was returned from MeshBuilder", Logger::Type::Error);
+                        promise->set_value(0);
+                        return;
+                    }
+
+                    upload->createBuffers(meshData);
+                    meshes.insert(std::make_pair(id, meshData));
+
+                    if (skeleton)
+                    {
+                        (*resource)->m_skeletalData.insert(std::make_pair(id, skeleton));
+                    }
+
+                    promise->set_value(id);
+                });
+        });
+
+    return result;
+}
+
 const Mesh::Data& MeshResource::getMesh(std::size_t id) const
 {
     CRO_ASSERT(m_meshData.count(id) != 0, "Mesh not found");
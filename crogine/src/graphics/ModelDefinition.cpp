@@ -49,8 +49,28 @@ source distribution.
 #include <crogine/ecs/components/BillboardCollection.hpp>
 #include <crogine/ecs/Entity.hpp>
 
+#include "../detail/AsyncLoader.hpp"
+
+#include <chrono>
+#include <future>
+#include <sstream>
+#include <thread>
+
 using namespace cro;
 
+struct ModelDefinition::PendingLoad final
+{
+    std::string path;
+    std::string cacheKey;
+    bool instanced = false;
+    bool useDeferredShaders = false;
+
+    std::unique_ptr<MeshBuilder> meshBuilder;
+    std::vector<ConfigObject> materials;
+    bool lockRotation = false;
+    bool lockScale = false;
+};
+
 namespace
 {
     std::array<std::string, 4u> materialTypes =
@@ -96,6 +116,13 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
     }
     m_instanced = instanced;
 
+    const auto cacheKey = getCacheKey(path, instanced, useDeferredShaders);
+    if (!forceReload
+        && loadFromCache(cacheKey))
+    {
+        return true;
+    }
+
     if (FileSystem::getFileExtension(path) != ".cmt")
     {
         Logger::log(path + ": unusual file extension...", Logger::Type::Warning);
@@ -108,74 +135,178 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
         return false;
     }
 
-    if (Util::String::toLower(cfg.getName()) != "model")
+    PendingLoad pending;
+    pending.path = path;
+    pending.cacheKey = cacheKey;
+    pending.instanced = instanced;
+    pending.useDeferredShaders = useDeferredShaders;
+    if (!prepareLoad(cfg, pending))
     {
-        Logger::log("No model object found in model definition " + path, Logger::Type::Error);
         return false;
     }
 
-    auto meshPath = cfg.findProperty("mesh");
-    if (!meshPath)
+    //do all the resource loading last when we know properties are valid,
+    //to prevent partially loading a model and wasting resources.
+    return finishLoad(pending, m_resources.meshes.loadMesh(*pending.meshBuilder, forceReload));
+}
+
+std::size_t ModelDefinition::loadFromFiles(const std::vector<std::pair<ModelDefinition*, std::string>>& definitions, bool instanced, bool useDeferredShaders)
+{
+#ifdef PLATFORM_MOBILE
+    instanced = false;
+#endif
+
+    struct ListItem final
     {
-        Logger::log(path + ": Model node contains no mesh value", Logger::Type::Error);
-        return false;
-    }
+        ModelDefinition* definition = nullptr;
+        PendingLoad pending;
+        ConfigFile cfg;
+        std::future<bool> parsed;
+        std::future<std::size_t> meshID;
+        bool cached = false;
+    };
+    std::vector<std::unique_ptr<ListItem>> items;
 
-    std::string meshValue = meshPath->getValue<std::string>();
-    std::replace(meshValue.begin(), meshValue.end(), '\\', '/');
-    auto ext = FileSystem::getFileExtension(meshValue);
-    std::unique_ptr<MeshBuilder> meshBuilder;
+    //parse the definition files in parallel
+    for (const auto& [definition, path] : definitions)
+    {
+        CRO_ASSERT(definition, "");
+        auto& item = items.emplace_back(std::make_unique<ListItem>());
+        item->definition = definition;
+        item->pending.path = path;
+        item->pending.cacheKey = definition->getCacheKey(path, instanced, useDeferredShaders);
+        item->pending.instanced = instanced;
+        item->pending.useDeferredShaders = useDeferredShaders;
+
+        if (definition->m_modelLoaded)
+        {
+            definition->reset();
+        }
+        definition->m_instanced = instanced;
 
-    bool lockRotation = false;
-    bool lockScale = false;
+        if (definition->loadFromCache(item->pending.cacheKey))
+        {
+            item->cached = true;
+            continue;
+        }
 
-    //if there's an empty working path this checks to see if we have a model file
-    //in the same dir as the definition without a full path
-    auto updateLocalPath = [&](std::string& filePath) 
+        auto promise = std::make_shared<std::promise<bool>>();
+        item->parsed = promise->get_future();
+
+        //the item is heap allocated so this pointer remains valid while we wait
+        auto* cfg = &item->cfg;
+        Detail::AsyncLoader::queueJob([cfg, path, promise]()
+            {
+                promise->set_value(cfg->loadFromFile(path));
+            });
+    }
+
+    //create the mesh builders and queue the meshes to be built, also in parallel
+    for (auto& item : items)
     {
-        auto pos = filePath.find_last_of('/');
-        if (pos == std::string::npos)
+        if (item->cached)
+        {
+            continue;
+        }
+
+        if (!item->parsed.get())
+        {
+            Logger::log("Failed loading ModelDefinition " + item->pending.path, Logger::Type::Error);
+            continue;
+        }
+
+        if (item->definition->prepareLoad(item->cfg, item->pending))
         {
-            pos = path.find_last_of('/');
-            if (pos != std::string::npos)
+            if (item->definition->m_billboard)
             {
-                filePath = path.substr(0, path.find_last_of('/')) + "/" + filePath;
+                //dynamic meshes create their buffers directly so can't be loaded async
+                std::promise<std::size_t> promise;
+                item->meshID = promise.get_future();
+                promise.set_value(item->definition->m_resources.meshes.loadMesh(*item->pending.meshBuilder));
             }
             else
             {
-                filePath = m_workingDir + filePath;
+                item->meshID = item->definition->m_resources.meshes.loadMeshAsync(std::move(item->pending.meshBuilder));
             }
         }
-        else
+    }
+
+    //mesh buffers are created by the upload queue, which we have
+    //to process ourselves as we're blocking the main thread
+    std::size_t count = 0;
+    for (auto& item : items)
+    {
+        if (item->cached)
         {
-            filePath = m_workingDir + filePath;
+            count++;
+            continue;
         }
-    };
+
+        if (!item->meshID.valid())
+        {
+            continue;
+        }
+
+        while (item->meshID.wait_for(std::chrono::milliseconds(0)) != std::future_status::ready)
+        {
+            Detail::AsyncLoader::processUploads(10.f);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        //the same file may appear in the list more than once
+        if (item->definition->loadFromCache(item->pending.cacheKey)
+            || item->definition->finishLoad(item->pending, item->meshID.get()))
+        {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool ModelDefinition::prepareLoad(const ConfigObject& cfg, PendingLoad& pending)
+{
+    if (Util::String::toLower(cfg.getName()) != "model")
+    {
+        Logger::log("No model object found in model definition " + pending.path, Logger::Type::Error);
+        return false;
+    }
+
+    auto meshPath = cfg.findProperty("mesh");
+    if (!meshPath)
+    {
+        Logger::log(pending.path + ": Model node contains no mesh value", Logger::Type::Error);
+        return false;
+    }
+
+    std::string meshValue = meshPath->getValue<std::string>();
+    std::replace(meshValue.begin(), meshValue.end(), '\\', '/');
+    auto ext = FileSystem::getFileExtension(meshValue);
 
     if (ext == ".cmf")
     {
         //we have a static mesh
-        updateLocalPath(meshValue);
-        meshBuilder = std::make_unique<StaticMeshBuilder>(meshValue);
+        updateLocalPath(meshValue, pending.path);
+        pending.meshBuilder = std::make_unique<StaticMeshBuilder>(meshValue);
     }
     else if (ext == ".cmb")
     {
         //binary model
-        updateLocalPath(meshValue);
-        meshBuilder = std::make_unique<BinaryMeshBuilder>(meshValue);
+        updateLocalPath(meshValue, pending.path);
+        pending.meshBuilder = std::make_unique<BinaryMeshBuilder>(meshValue);
     }
     else if (ext == ".iqm")
     {
         //use iqm loader
-        updateLocalPath(meshValue);
-        meshBuilder = std::make_unique<IqmBuilder>(meshValue);
+        updateLocalPath(meshValue, pending.path);
+        pending.meshBuilder = std::make_unique<IqmBuilder>(meshValue);
     }
     else if (Util::String::toLower(meshValue) == "sphere")
     {
         if (auto* prop = cfg.findProperty("radius"))
         {
             float rad = std::max(0.001f, prop->getValue<float>());
-            meshBuilder = std::make_unique<SphereBuilder>(rad, 8);
+            pending.meshBuilder = std::make_unique<SphereBuilder>(rad, 8);
         }
     }
     else if (Util::String::toLower(meshValue) == "cube")
@@ -190,7 +321,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             }
         }
 
-        meshBuilder = std::make_unique<CubeBuilder>(size);
+        pending.meshBuilder = std::make_unique<CubeBuilder>(size);
     }
     else if (Util::String::toLower(meshValue) == "circle")
     {
@@ -206,7 +337,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             pointCount = std::max(pointCount, pCount->getValue<std::uint32_t>());
         }
 
-        meshBuilder = std::make_unique<CircleMeshBuilder>(radius, pointCount);
+        pending.meshBuilder = std::make_unique<CircleMeshBuilder>(radius, pointCount);
     }
     else if (Util::String::toLower(meshValue) == "quad")
     {
@@ -221,13 +352,13 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             glm::vec2 size = prop->getValue<glm::vec2>();
             size.x = std::max(0.001f, size.x);
             size.y = std::max(0.001f, size.y);
-            meshBuilder = std::make_unique<QuadBuilder>(size, uv);
+            pending.meshBuilder = std::make_unique<QuadBuilder>(size, uv);
         }
     }
     else if (Util::String::toLower(meshValue) == "billboard")
     {
         auto flags = VertexProperty::Position | VertexProperty::Normal | VertexProperty::Colour | VertexProperty::UV0 | VertexProperty::UV1;
-        meshBuilder = std::make_unique<DynamicMeshBuilder>(flags, 1, GL_TRIANGLES);
+        pending.meshBuilder = std::make_unique<DynamicMeshBuilder>(flags, 1, GL_TRIANGLES);
         m_billboard = true;
 
 #ifdef CRO_DEBUG_
@@ -240,12 +371,12 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
 
         if (auto* prop = cfg.findProperty("lock_rotation"); prop != nullptr)
         {
-            lockRotation = prop->getValue<bool>();
+            pending.lockRotation = prop->getValue<bool>();
         }
 
         if (auto* prop = cfg.findProperty("lock_scale"); prop != nullptr)
         {
-            lockScale = prop->getValue<bool>();
+            pending.lockScale = prop->getValue<bool>();
         }
     }
     else
@@ -256,15 +387,14 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
     }
 
     //check builder was created OK
-    if (!meshBuilder)
+    if (!pending.meshBuilder)
     {
-        Logger::log(path + ": could not create mesh builder instance", Logger::Type::Error);
+        Logger::log(pending.path + ": could not create mesh builder instance", Logger::Type::Error);
         return false;
     }
 
     //check we have at least one material with a valid shader type
     const auto& objs = cfg.getObjects();
-    std::vector<ConfigObject> materials;
     for (const auto& obj : objs)
     {
         auto type = std::find(std::begin(materialTypes), std::end(materialTypes), obj.getId());
@@ -272,13 +402,13 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
         if (Util::String::toLower(obj.getName()) == "material"
             && type != materialTypes.end())
         {
-            materials.push_back(obj);
+            pending.materials.push_back(obj);
         }
     }
 
-    if (materials.empty())
+    if (pending.materials.empty())
     {
-        Logger::log(path + ": no materials found.", Logger::Type::Error);
+        Logger::log(pending.path + ": no materials found.", Logger::Type::Error);
         return false;
     }
 
@@ -289,12 +419,15 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
         m_castShadows = shadowProp->getValue<bool>();
     }
 
-    //do all the resource loading last when we know properties are valid,
-    //to prevent partially loading a model and wasting resources.
-    m_meshID = m_resources.meshes.loadMesh(*meshBuilder.get(), forceReload);
+    return true;
+}
+
+bool ModelDefinition::finishLoad(PendingLoad& pending, std::size_t meshID)
+{
+    m_meshID = meshID;
     if (m_meshID == 0)
     {
-        Logger::log(path + ": preloading mesh failed", Logger::Type::Error);
+        Logger::log(pending.path + ": preloading mesh failed", Logger::Type::Error);
         Logger::log("Check model path in model definition file?", Logger::Type::Error);
         return false;
     }
@@ -305,9 +438,9 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
         m_skeleton = skel;
     }
 
-    for (auto& mat : materials)
+    for (auto& mat : pending.materials)
     {
-        ShaderResource::BuiltIn shaderType = useDeferredShaders ? ShaderResource::UnlitDeferred : ShaderResource::Unlit;
+        ShaderResource::BuiltIn shaderType = pending.useDeferredShaders ? ShaderResource::UnlitDeferred : ShaderResource::Unlit;
         if (mat.getId() == "VertexLit")
         {
             if (m_billboard)
@@ -316,7 +449,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             }
             else
             {
-                shaderType = useDeferredShaders ? ShaderResource::VertexLitDeferred : ShaderResource::VertexLit;
+                shaderType = pending.useDeferredShaders ? ShaderResource::VertexLitDeferred : ShaderResource::VertexLit;
             }
         }
         else if (mat.getId() == "PBR")
@@ -331,7 +464,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
                 //fall back to vertex lit if no env map is supplied
                 if (m_envMap)
                 {
-                    shaderType = useDeferredShaders ? ShaderResource::PBRDeferred : ShaderResource::PBR;
+                    shaderType = pending.useDeferredShaders ? ShaderResource::PBRDeferred : ShaderResource::PBR;
                 }
             }
         }
@@ -343,7 +476,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
 
         //enable shader attribs based on what the material requests
         //TODO this doesn't check valid combinations
-        std::int32_t flags = instanced ? ShaderResource::Instanced : 0;
+        std::int32_t flags = pending.instanced ? ShaderResource::Instanced : 0;
         bool smoothTextures = false;
         bool repeatTextures = false;
         bool enableDepthTest = true;
@@ -490,12 +623,12 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             }
         }
 
-        if (lockRotation)
+        if (pending.lockRotation)
         {
             flags |= ShaderResource::BuiltInFlags::LockRotation;
         }
 
-        if (lockScale)
+        if (pending.lockScale)
         {
             flags |= ShaderResource::BuiltInFlags::LockScale;
         }
@@ -542,7 +675,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             if (name == "diffuse")
             {
                 auto filepath = p.getValue<std::string>();
-                updateLocalPath(filepath);
+                updateLocalPath(filepath, pending.path);
 
                 auto& tex = m_resources.textures.get(filepath, createMipmaps);
                 tex.setSmooth(smoothTextures);
@@ -554,7 +687,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             else if (name == "mask")
             {
                 auto filepath = p.getValue<std::string>();
-                updateLocalPath(filepath);
+                updateLocalPath(filepath, pending.path);
 
                 auto& tex = m_resources.textures.get(filepath, createMipmaps);
                 tex.setSmooth(smoothTextures);
@@ -564,7 +697,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             else if (name == "normal")
             {
                 auto filepath = p.getValue<std::string>();
-                updateLocalPath(filepath);
+                updateLocalPath(filepath, pending.path);
 
                 auto& tex = m_resources.textures.get(filepath, createMipmaps);
                 tex.setSmooth(smoothTextures);
@@ -574,7 +707,7 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
             else if (name == "lightmap")
             {
                 auto filepath = p.getValue<std::string>();
-                updateLocalPath(filepath);
+                updateLocalPath(filepath, pending.path);
 
                 auto& tex = m_resources.textures.get(filepath, createMipmaps);
                 tex.setSmooth(true);
@@ -689,17 +822,17 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
         if (m_castShadows)
         {
             flags = ShaderResource::DepthMap | (flags & (ShaderResource::Skinning | ShaderResource::AlphaClip | ShaderResource::DiffuseMap));
-            if (instanced)
+            if (pending.instanced)
             {
                 flags |= ShaderResource::Instanced;
             }
 
-            if (lockRotation)
+            if (pending.lockRotation)
             {
                 flags |= ShaderResource::BuiltInFlags::LockRotation;
             }
 
-            if (lockScale)
+            if (pending.lockScale)
             {
                 flags |= ShaderResource::BuiltInFlags::LockScale;
             }
@@ -721,6 +854,19 @@ bool ModelDefinition::loadFromFile(const std::string& path, bool instanced, bool
     }
 
     m_modelLoaded = true;
+
+    //billboards need unique mesh data each time they're loaded
+    if (!m_billboard)
+    {
+        auto& entry = m_resources.modelDefinitions.m_entries[pending.cacheKey];
+        entry.meshID = m_meshID;
+        entry.materialIDs = m_materialIDs;
+        entry.shadowIDs = m_shadowIDs;
+        entry.materialCount = m_materialCount;
+        entry.skeleton = m_skeleton;
+        entry.castShadows = m_castShadows;
+    }
+
     return true;
 }
 
@@ -788,6 +934,54 @@ const Material::Data* ModelDefinition::getMaterial(std::size_t index) const
 }
 
 //private
+std::string ModelDefinition::getCacheKey(const std::string& path, bool instanced, bool useDeferredShaders) const
+{
+    std::stringstream ss;
+    ss << path << "|" << instanced << useDeferredShaders << "|" << m_envMap << "|" << m_workingDir;
+    return ss.str();
+}
+
+bool ModelDefinition::loadFromCache(const std::string& key)
+{
+    const auto& entries = m_resources.modelDefinitions.m_entries;
+    if (auto result = entries.find(key); result != entries.end())
+    {
+        const auto& entry = result->second;
+        m_meshID = entry.meshID;
+        m_materialIDs = entry.materialIDs;
+        m_shadowIDs = entry.shadowIDs;
+        m_materialCount = entry.materialCount;
+        m_skeleton = entry.skeleton;
+        m_castShadows = entry.castShadows;
+        m_modelLoaded = true;
+        return true;
+    }
+    return false;
+}
+
+void ModelDefinition::updateLocalPath(std::string& filePath, const std::string& definitionPath) const
+{
+    //if there's an empty working path this checks to see if we have a model file
+    //in the same dir as the definition without a full path
+    auto pos = filePath.find_last_of('/');
+    if (pos == std::string::npos)
+    {
+        pos = definitionPath.find_last_of('/');
+        if (pos != std::string::npos)
+        {
+            filePath = definitionPath.substr(0, definitionPath.find_last_of('/')) + "/" + filePath;
+        }
+        else
+        {
+            filePath = m_workingDir + filePath;
+        }
+    }
+    else
+    {
+        filePath = m_workingDir + filePath;
+    }
+}
+
 void ModelDefinition::reset()
 {
     m_meshID = 0;
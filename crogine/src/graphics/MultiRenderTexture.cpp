@@ -31,6 +31,7 @@ source distribution.
 #include <crogine/graphics/MultiRenderTexture.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 using namespace cro;
 
@@ -48,6 +49,11 @@ MultiRenderTexture::~MultiRenderTexture()
     if (m_fboID)
     {
         glCheck(glDeleteFramebuffers(1, &m_fboID));
+        for (auto id : m_textureIDs)
+        {
+            Detail::TextureRegistry::removeTexture(id);
+        }
+        Detail::TextureRegistry::removeTexture(m_depthTextureID);
         glCheck(glDeleteTextures(static_cast<GLsizei>(m_textureIDs.size()), m_textureIDs.data()));
         glCheck(glDeleteTextures(1, &m_depthTextureID));
     }
@@ -77,6 +83,11 @@ MultiRenderTexture& MultiRenderTexture::operator=(MultiRenderTexture&& other) no
         if (m_fboID)
         {
             glCheck(glDeleteFramebuffers(1, &m_fboID));
+            for (auto id : m_textureIDs)
+            {
+                Detail::TextureRegistry::removeTexture(id);
+            }
+            Detail::TextureRegistry::removeTexture(m_depthTextureID);
             glCheck(glDeleteTextures(static_cast<GLsizei>(m_textureIDs.size()), m_textureIDs.data()));
             glCheck(glDeleteTextures(1, &m_depthTextureID));
         }
@@ -126,6 +137,7 @@ bool MultiRenderTexture::create(std::uint32_t width, std::uint32_t height, std::
         glCheck(glGenTextures(1, &m_depthTextureID));
         glCheck(glBindTexture(GL_TEXTURE_2D, m_depthTextureID));
         glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL));
+        Detail::TextureRegistry::addTexture(m_depthTextureID, Detail::TextureRegistry::estimateSize(width, height, 4), TextureMemory::DepthTarget);
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER));
@@ -146,10 +158,12 @@ bool MultiRenderTexture::create(std::uint32_t width, std::uint32_t height, std::
         {
             glBindTexture(GL_TEXTURE_2D, id);
             glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+            Detail::TextureRegistry::addTexture(id, Detail::TextureRegistry::estimateSize(width, height, 16), TextureMemory::RenderTarget);
         }
 
         glCheck(glBindTexture(GL_TEXTURE_2D, m_depthTextureID));
         glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT, width, height, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL));
+        Detail::TextureRegistry::addTexture(m_depthTextureID, Detail::TextureRegistry::estimateSize(width, height, 4), TextureMemory::DepthTarget);
 
         setViewport({ 0, 0, static_cast<std::int32_t>(width), static_cast<std::int32_t>(height) });
         setView(FloatRect(getViewport()));
@@ -168,6 +182,7 @@ bool MultiRenderTexture::create(std::uint32_t width, std::uint32_t height, std::
                 glCheck(glGenTextures(1, &id));
                 glCheck(glBindTexture(GL_TEXTURE_2D, id));
                 glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, NULL));
+                Detail::TextureRegistry::addTexture(id, Detail::TextureRegistry::estimateSize(width, height, 16), TextureMemory::RenderTarget);
                 glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
                 glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
                 glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -180,6 +195,7 @@ bool MultiRenderTexture::create(std::uint32_t width, std::uint32_t height, std::
             //remove the difference
             for (auto i = colourCount; i < m_textureIDs.size(); ++i)
             {
+                Detail::TextureRegistry::removeTexture(m_textureIDs[i]);
                 glCheck(glDeleteTextures(1, &m_textureIDs[i]));
             }
 
@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include <crogine/core/Log.hpp>
+#include <crogine/core/FileSystem.hpp>
 #include <crogine/graphics/Palette.hpp>
 
 #include <crogine/detail/Types.hpp>
@@ -132,7 +133,7 @@ bool Palette::loadFromFile(const std::string& path, bool append)
 
     auto fullPath = FileSystem::getResourcePath() + path;
     RaiiRWops file;
-    file.file = SDL_RWFromFile(fullPath.c_str(), "rb");
+    file.file = FileSystem::openResource(fullPath);
 
     auto fileName = FileSystem::getFileName(path);
 
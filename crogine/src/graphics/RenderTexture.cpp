@@ -30,6 +30,7 @@ source distribution.
 #include <crogine/graphics/RenderTexture.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 using namespace cro;
 
@@ -54,6 +55,7 @@ RenderTexture::~RenderTexture()
     }
     if (m_msTextureID)
     {
+        Detail::TextureRegistry::removeTexture(m_msTextureID);
         glCheck(glDeleteTextures(1, &m_msTextureID));
     }
     
@@ -63,6 +65,7 @@ RenderTexture::~RenderTexture()
     }
     if (m_rboID)
     {
+        Detail::TextureRegistry::removeRenderbuffer(m_rboID);
         glCheck(glDeleteRenderbuffers(1, &m_rboID));
     }
 }
@@ -106,6 +109,7 @@ RenderTexture& RenderTexture::operator=(RenderTexture&& other) noexcept
         }
         if (m_msTextureID)
         {
+            Detail::TextureRegistry::removeTexture(m_msTextureID);
             glCheck(glDeleteTextures(1, &m_msTextureID));
         }
 
@@ -115,6 +119,7 @@ RenderTexture& RenderTexture::operator=(RenderTexture&& other) noexcept
         }
         if (m_rboID)
         {
+            Detail::TextureRegistry::removeRenderbuffer(m_rboID);
             glCheck(glDeleteRenderbuffers(1, &m_rboID));
         }
 
@@ -271,6 +276,7 @@ bool RenderTexture::createDefault(std::uint32_t width, std::uint32_t height, boo
         m_fboID = 0;
         m_msfboID = 0;
 
+        Detail::TextureRegistry::removeTexture(m_msTextureID);
         glCheck(glDeleteTextures(1, &m_msTextureID));
         m_msTextureID = 0;
 
@@ -289,12 +295,14 @@ bool RenderTexture::createDefault(std::uint32_t width, std::uint32_t height, boo
             && stencilBuffer == m_hasStencilBuffer)
         {
             m_texture.create(width, height);
+            Detail::TextureRegistry::setCategory(m_texture.getGLHandle(), TextureMemory::RenderTarget);
             if (m_rboID)
             {
                 std::int32_t format = stencilBuffer ? GL_DEPTH24_STENCIL8 : GL_DEPTH_COMPONENT24;
 
                 glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_rboID));
                 glCheck(glRenderbufferStorage(GL_RENDERBUFFER, format, width, height));
+                Detail::TextureRegistry::addRenderbuffer(m_rboID, Detail::TextureRegistry::estimateSize(width, height, 4), TextureMemory::RenderTarget);
                 glCheck(glBindRenderbuffer(GL_RENDERBUFFER, 0));
             }
 
@@ -312,11 +320,13 @@ bool RenderTexture::createDefault(std::uint32_t width, std::uint32_t height, boo
 
     if (m_rboID)
     {
+        Detail::TextureRegistry::removeRenderbuffer(m_rboID);
         glCheck(glDeleteRenderbuffers(1, &m_rboID));
         m_rboID = 0;
     }
 
     m_texture.create(width, height, ImageFormat::RGBA);
+    Detail::TextureRegistry::setCategory(m_texture.getGLHandle(), TextureMemory::RenderTarget);
 
     GLuint fbo;
     glCheck(glGenFramebuffers(1, &fbo));
@@ -357,6 +367,7 @@ bool RenderTexture::createDefault(std::uint32_t width, std::uint32_t height, boo
 
             glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_rboID));
             glCheck(glRenderbufferStorage(GL_RENDERBUFFER, format, width, height));
+            Detail::TextureRegistry::addRenderbuffer(m_rboID, Detail::TextureRegistry::estimateSize(width, height, 4), TextureMemory::RenderTarget);
             glCheck(glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, m_rboID));
             glCheck(glBindRenderbuffer(GL_RENDERBUFFER, 0));
         }
@@ -394,9 +405,11 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
         {
             glCheck(glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_msTextureID));
             glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_samples, GL_RGBA, width, height, GL_TRUE);
+            Detail::TextureRegistry::addTexture(m_msTextureID, Detail::TextureRegistry::estimateSize(width, height, 4 * m_samples), TextureMemory::RenderTarget);
             glCheck(glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0));
 
             m_texture.create(width, height);
+            Detail::TextureRegistry::setCategory(m_texture.getGLHandle(), TextureMemory::RenderTarget);
 
             if (m_rboID)
             {
@@ -404,6 +417,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
 
                 glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_rboID));
                 glCheck(glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_samples, format, width, height));
+                Detail::TextureRegistry::addRenderbuffer(m_rboID, Detail::TextureRegistry::estimateSize(width, height, 4 * m_samples), TextureMemory::RenderTarget);
                 glCheck(glBindRenderbuffer(GL_RENDERBUFFER, 0));
             }
 
@@ -426,6 +440,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
 
     if (m_rboID)
     {
+        Detail::TextureRegistry::removeRenderbuffer(m_rboID);
         glCheck(glDeleteRenderbuffers(1, &m_rboID));
         m_rboID = 0;
     }
@@ -439,6 +454,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
     {
         glCheck(glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, m_msTextureID));
         glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, m_samples, GL_RGBA, width, height, GL_TRUE);
+        Detail::TextureRegistry::addTexture(m_msTextureID, Detail::TextureRegistry::estimateSize(width, height, 4 * m_samples), TextureMemory::RenderTarget);
         glCheck(glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, 0));
     }
     else
@@ -448,6 +464,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
     }
 
     m_texture.create(width, height, ImageFormat::RGBA);
+    Detail::TextureRegistry::setCategory(m_texture.getGLHandle(), TextureMemory::RenderTarget);
 
     GLuint fbos[2] = {};
     glCheck(glGenFramebuffers(2, fbos));
@@ -485,6 +502,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
                 Texture temp;
                 temp.swap(m_texture);
 
+                Detail::TextureRegistry::removeTexture(m_msTextureID);
                 glCheck(glDeleteTextures(1, &m_msTextureID));
                 m_msTextureID = 0;
 
@@ -494,6 +512,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
 
             glCheck(glBindRenderbuffer(GL_RENDERBUFFER, m_rboID));
             glCheck(glRenderbufferStorageMultisample(GL_RENDERBUFFER, m_samples, format, width, height));
+            Detail::TextureRegistry::addRenderbuffer(m_rboID, Detail::TextureRegistry::estimateSize(width, height, 4 * m_samples), TextureMemory::RenderTarget);
             glCheck(glFramebufferRenderbuffer(GL_FRAMEBUFFER, attachment, GL_RENDERBUFFER, m_rboID));
             glCheck(glBindRenderbuffer(GL_RENDERBUFFER, 0));
         }
@@ -515,6 +534,7 @@ bool RenderTexture::createMultiSampled(std::uint32_t width, std::uint32_t height
     glCheck(glBindFramebuffer(GL_FRAMEBUFFER, RenderTarget::getActiveTargetID()));
 
     //remove unused textures cos creating FBOs failed
+    Detail::TextureRegistry::removeTexture(m_msTextureID);
     glCheck(glDeleteTextures(1, &m_msTextureID));
     m_msTextureID = 0;
 
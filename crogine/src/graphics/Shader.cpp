@@ -76,13 +76,15 @@ namespace
 }
 
 Shader::Shader()
-    : m_handle  (0),
-    m_attribMap ({})
+    : m_retrievable (false),
+    m_handle        (0),
+    m_attribMap     ({})
 {
     resetAttribMap();
 }
 
 Shader::Shader(Shader&& other) noexcept
+    : m_retrievable(other.m_retrievable)
 {
     m_handle = other.m_handle;
     m_attribMap = other.m_attribMap;
@@ -102,6 +104,7 @@ Shader& Shader::operator=(Shader&& other) noexcept
         std::swap(m_attribMap, temp.m_attribMap);
         std::swap(m_uniformMap, temp.m_uniformMap);
 
+        m_retrievable = other.m_retrievable;
         m_handle = other.m_handle;
         m_attribMap = other.m_attribMap;
         m_uniformMap = other.m_uniformMap;
@@ -313,6 +316,12 @@ bool Shader::loadFromSource(const char* vertex, const char* geometry, const char
             glCheck(glAttachShader(m_handle, geomID));
         }
         glCheck(glAttachShader(m_handle, fragID));
+#ifdef PLATFORM_DESKTOP
+        if (m_retrievable)
+        {
+            glCheck(glProgramParameteri(m_handle, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+        }
+#endif
         glCheck(glLinkProgram(m_handle));
 
         result = GL_FALSE;
@@ -377,6 +386,62 @@ bool Shader::loadFromSource(const char* vertex, const char* geometry, const char
     return false;
 }
 
+bool Shader::loadFromBinary(std::uint32_t format, const std::vector<std::uint8_t>& data)
+{
+#ifdef PLATFORM_DESKTOP
+    if (m_handle)
+    {
+        glCheck(glDeleteProgram(m_handle));
+        m_handle = 0;
+        resetAttribMap();
+        resetUniformMap();
+    }
+
+    m_handle = glCreateProgram();
+    if (m_handle)
+    {
+        glCheck(glProgramBinary(m_handle, format, data.data(), static_cast<GLsizei>(data.size())));
+
+        //this is expected to fail if the driver was updated
+        //since the binary was created, so don't raise an error
+        GLint result = GL_FALSE;
+        glCheck(glGetProgramiv(m_handle, GL_LINK_STATUS, &result));
+        if (result == GL_FALSE
+            || !fillAttribMap())
+        {
+            glCheck(glDeleteProgram(m_handle));
+            m_handle = 0;
+            resetAttribMap();
+            return false;
+        }
+
+        fillUniformMap();
+        return true;
+    }
+#endif
+    return false;
+}
+
+bool Shader::getBinary(std::uint32_t& format, std::vector<std::uint8_t>& dst) const
+{
+#ifdef PLATFORM_DESKTOP
+    if (m_handle)
+    {
+        GLint length = 0;
+        glCheck(glGetProgramiv(m_handle, GL_PROGRAM_BINARY_LENGTH, &length));
+        if (length > 0)
+        {
+            dst.resize(length);
+            GLenum binaryFormat = 0;
+            glCheck(glGetProgramBinary(m_handle, length, nullptr, &binaryFormat, dst.data()));
+            format = binaryFormat;
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
 bool Shader::fillAttribMap()
 {
     GLint activeAttribs;
@@ -499,7 +564,7 @@ std::string Shader::parseFile(const std::string& path)
 
     //open file and verify
     RaiiRWops file;
-    file.file = SDL_RWFromFile(path.c_str(), "r");
+    file.file = FileSystem::openResource(path);
     if (!file.file)
     {
         Logger::log("Failed opening " + path, Logger::Type::Error);
@@ -40,11 +40,166 @@ source distribution.
 #endif
 #include "../detail/GLCheck.hpp"
 
+#include <crogine/core/FileSystem.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string_view>
+
 using namespace cro;
 
 namespace
 {
     std::int32_t MAX_BONES = 0;
+
+    //FNV-1a, continued from the given hash so multiple strings can be combined
+    std::uint64_t hashSource(std::string_view str, std::uint64_t hash = 0xcbf29ce484222325)
+    {
+        for (auto c : str)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3;
+        }
+        //separate the strings so "ab"+"c" doesn't equal "a"+"bc"
+        hash ^= 0xff;
+        hash *= 0x100000001b3;
+        return hash;
+    }
+
+    constexpr std::uint32_t BinaryMagic = 0x42505343; //CSPB
+    constexpr std::uint32_t BinaryVersion = 1;
+
+    struct BinaryHeader final
+    {
+        std::uint32_t magic = BinaryMagic;
+        std::uint32_t version = BinaryVersion;
+        std::uint64_t sourceHash = 0;
+        std::uint64_t driverHash = 0;
+        std::uint32_t format = 0;
+        std::uint32_t size = 0;
+    };
+
+    struct ProgramCache final
+    {
+        std::string directory;
+
+        //identifies the driver which created the binaries. This
+        //has to be done lazily as we need a valid GL context.
+        std::uint64_t driverHash = 0;
+        bool supported = false;
+        bool initialised = false;
+
+        bool enabled()
+        {
+            if (directory.empty())
+            {
+                return false;
+            }
+
+            if (!initialised)
+            {
+                initialised = true;
+#ifdef PLATFORM_DESKTOP
+                GLint formatCount = 0;
+                glCheck(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount));
+                supported = formatCount > 0;
+
+                if (supported)
+                {
+                    for (auto name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+                    {
+                        const auto* str = reinterpret_cast<const char*>(glGetString(name));
+                        driverHash = hashSource(str ? str : "", driverHash);
+                    }
+                }
+                else
+                {
+                    LogW << "Program binaries are not supported by this driver, program cache disabled" << std::endl;
+                }
+#endif
+            }
+            return supported;
+        }
+
+        std::string getPath(std::uint64_t sourceHash) const
+        {
+            std::stringstream ss;
+            ss << directory << std::hex << sourceHash << ".csb";
+            return ss.str();
+        }
+
+        bool read(std::uint64_t sourceHash, std::uint32_t& format, std::vector<std::uint8_t>& data) const
+        {
+            RaiiRWops file;
+            file.file = SDL_RWFromFile(getPath(sourceHash).c_str(), "rb");
+            if (!file.file)
+            {
+                return false;
+            }
+
+            BinaryHeader header;
+            if (SDL_RWread(file.file, &header, sizeof(header), 1) != 1
+                || header.magic != BinaryMagic
+                || header.version != BinaryVersion
+                || header.sourceHash != sourceHash
+                || header.driverHash != driverHash
+                || header.size == 0)
+            {
+                return false;
+            }
+
+            data.resize(header.size);
+            if (SDL_RWread(file.file, data.data(), data.size(), 1) != 1)
+            {
+                return false;
+            }
+            format = header.format;
+            return true;
+        }
+
+        void write(std::uint64_t sourceHash, std::uint32_t format, const std::vector<std::uint8_t>& data) const
+        {
+            BinaryHeader header;
+            header.sourceHash = sourceHash;
+            header.driverHash = driverHash;
+            header.format = format;
+            header.size = static_cast<std::uint32_t>(data.size());
+
+            auto path = getPath(sourceHash);
+            RaiiRWops file;
+            file.file = SDL_RWFromFile(path.c_str(), "wb");
+            if (!file.file
+                || SDL_RWwrite(file.file, &header, sizeof(header), 1) != 1
+                || SDL_RWwrite(file.file, data.data(), data.size(), 1) != 1)
+            {
+                LogW << "Failed writing program binary " << path << std::endl;
+            }
+        }
+    }programCache;
+
+    std::string readSource(const std::string& path)
+    {
+        RaiiRWops file;
+        file.file = FileSystem::openResource(FileSystem::getResourcePath() + path);
+        if (!file.file)
+        {
+            LogE << "Failed opening " << path << std::endl;
+            return {};
+        }
+
+        std::string retVal;
+        auto size = SDL_RWsize(file.file);
+        if (size > 0)
+        {
+            retVal.resize(static_cast<std::size_t>(size));
+            if (SDL_RWread(file.file, retVal.data(), retVal.size(), 1) != 1)
+            {
+                LogE << "Failed reading " << path << std::endl;
+                return {};
+            }
+        }
+        return retVal;
+    }
 }
 
 ShaderResource::ShaderResource()
@@ -63,14 +218,15 @@ bool ShaderResource::loadFromFile(std::int32_t ID, const std::string& vertex, co
         Logger::log("Shader with this ID already exists!", Logger::Type::Error);
         return false;
     }
-    
-    auto pair = std::make_pair(ID, Shader());
-    if (!pair.second.loadFromFile(vertex, fragment))
+
+    auto vertSource = readSource(vertex);
+    auto fragSource = readSource(fragment);
+    if (vertSource.empty() || fragSource.empty())
     {
         return false;
     }
-    m_shaders.insert(std::move(pair));
-    return true;
+
+    return loadProgram(ID, vertSource, {}, fragSource, {}, false);
 }
 
 bool ShaderResource::loadFromString(std::int32_t ID, const std::string& vertex, const std::string& fragment, const std::string& defines)
@@ -81,26 +237,11 @@ bool ShaderResource::loadFromString(std::int32_t ID, const std::string& vertex,
         return false;
     }
 
-    auto pair = std::make_pair(ID, Shader());
     if (!m_includes.empty())
     {
-        auto v = parseIncludes(vertex);
-        auto f = parseIncludes(fragment);
-
-        if (!pair.second.loadFromString(v, f, defines))
-        {
-            return false;
-        }
+        return loadProgram(ID, parseIncludes(vertex), {}, parseIncludes(fragment), defines, false);
     }
-    else
-    {
-        if (!pair.second.loadFromString(vertex, fragment, defines))
-        {
-            return false;
-        }
-    }
-    m_shaders.insert(std::move(pair));
-    return true;
+    return loadProgram(ID, vertex, {}, fragment, defines, false);
 }
 
 bool ShaderResource::loadFromString(std::int32_t ID, const std::string& vertex, const std::string& geom, const std::string& fragment, const std::string& defines)
@@ -111,27 +252,11 @@ bool ShaderResource::loadFromString(std::int32_t ID, const std::string& vertex,
         return false;
     }
 
-    auto pair = std::make_pair(ID, Shader());
     if (!m_includes.empty())
     {
-        auto v = parseIncludes(vertex);
-        auto g = parseIncludes(geom);
-        auto f = parseIncludes(fragment);
-
-        if (!pair.second.loadFromString(v, g, f, defines))
-        {
-            return false;
-        }
-    }
-    else
-    {
-        if (!pair.second.loadFromString(vertex, geom, fragment, defines))
-        {
-            return false;
-        }
+        return loadProgram(ID, parseIncludes(vertex), parseIncludes(geom), parseIncludes(fragment), defines, true);
     }
-    m_shaders.insert(std::move(pair));
-    return true;
+    return loadProgram(ID, vertex, geom, fragment, defines, true);
 }
 
 std::int32_t ShaderResource::loadBuiltIn(BuiltIn type, std::int32_t flags)
@@ -296,7 +421,7 @@ Shader& ShaderResource::get(std::int32_t ID)
         Logger::log("Could not find shader with ID " + std::to_string(ID) + ", returning default shader", Logger::Type::Warning);
         return m_defaultShader;
     }
-    return m_shaders.at(ID);// .second;
+    return *m_shaders.at(ID);
 }
 
 bool ShaderResource::hasShader(std::int32_t shaderID) const
@@ -313,28 +438,120 @@ void ShaderResource::addInclude(const std::string& include, const char* src)
     m_includes.insert(std::make_pair(include, src));
 }
 
+void ShaderResource::setProgramCacheDirectory(const std::string& path)
+{
+    std::string directory = path;
+    std::replace(directory.begin(), directory.end(), '\\', '/');
+    if (!directory.empty() && directory.back() != '/')
+    {
+        directory.push_back('/');
+    }
+
+    if (!directory.empty()
+        && !FileSystem::directoryExists(directory)
+        && !FileSystem::createDirectory(directory))
+    {
+        LogE << "Failed creating program cache directory " << directory << std::endl;
+        directory.clear();
+    }
+
+    programCache.directory = directory;
+}
+
 //private
+bool ShaderResource::loadProgram(std::int32_t ID, const std::string& vertex, const std::string& geom, const std::string& fragment, const std::string& defines, bool hasGeometry)
+{
+    //the version and precision blocks prepended by the Shader class are the
+    //same for every program, so hashing the remaining source is sufficient
+    auto hash = hashSource(defines);
+    hash = hashSource(vertex, hash);
+    hash = hashSource(geom, hash);
+    hash = hashSource(fragment, hash);
+
+    if (auto result = m_programs.find(hash); result != m_programs.end())
+    {
+        m_shaders.insert(std::make_pair(ID, result->second.get()));
+        m_stats.requested++;
+        m_stats.shared++;
+        return true;
+    }
+
+    auto shader = std::make_unique<Shader>();
+    bool loaded = false;
+
+    const bool useCache = programCache.enabled();
+    if (useCache)
+    {
+        std::uint32_t format = 0;
+        std::vector<std::uint8_t> data;
+        if (programCache.read(hash, format, data)
+            && shader->loadFromBinary(format, data))
+        {
+            m_stats.binariesLoaded++;
+            loaded = true;
+        }
+        else
+        {
+            shader->m_retrievable = true;
+        }
+    }
+
+    if (!loaded)
+    {
+        loaded = hasGeometry ?
+            shader->loadFromString(vertex, geom, fragment, defines) :
+            shader->loadFromString(vertex, fragment, defines);
+
+        if (!loaded)
+        {
+            return false;
+        }
+        m_stats.compiled++;
+
+        std::uint32_t format = 0;
+        std::vector<std::uint8_t> data;
+        if (useCache
+            && shader->getBinary(format, data))
+        {
+            programCache.write(hash, format, data);
+        }
+    }
+
+    m_stats.requested++;
+    m_shaders.insert(std::make_pair(ID, shader.get()));
+    m_programs.insert(std::make_pair(hash, std::move(shader)));
+    return true;
+}
+
 std::string ShaderResource::parseIncludes(const std::string& src) const
 {
     std::string ret;
+    ret.reserve(src.size());
 
-    std::stringstream ss;
-    ss << src;
-
-    for (std::string line; std::getline(ss, line);)
+    std::string_view source(src);
+    std::size_t position = 0;
+    while (position < source.size())
     {
-        if (line.find("#include") != std::string::npos)
+        auto end = source.find('\n', position);
+        if (end == std::string_view::npos)
+        {
+            end = source.size();
+        }
+        auto line = source.substr(position, end - position);
+        position = end + 1;
+
+        if (line.find("#include") != std::string_view::npos)
         {
             auto separator = line.find_last_of(' ');
 
-            if (separator != std::string::npos
+            if (separator != std::string_view::npos
                 && separator != line.size() - 1)
             {
-                auto includeName = line.substr(separator + 1);
-                if (m_includes.count(includeName))
+                std::string includeName(line.substr(separator + 1));
+                if (auto result = m_includes.find(includeName); result != m_includes.end())
                 {
                     ret += "\n";
-                    ret += m_includes.at(includeName);
+                    ret += result->second;
                     ret += "\n";
                 }
                 else
@@ -349,9 +566,10 @@ std::string ShaderResource::parseIncludes(const std::string& src) const
         }
         else
         {
-            ret += line + "\n";
+            ret += line;
+            ret += "\n";
         }
     }
 
     return ret;
-}
\ No newline at end of file
+}
@@ -28,6 +28,7 @@ source distribution.
 -----------------------------------------------------------------------*/
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/TextureRegistry.hpp"
 
 #include <crogine/core/App.hpp>
 
@@ -294,6 +295,21 @@ void SimpleDrawable::setTexture(TextureID texture)
     }
 }
 
+void SimpleDrawable::resetShader()
+{
+    //set shader will reference count outgoing shader
+    if (m_textureID)
+    {
+        increaseTextureShader();
+        setShader(*textureShader);
+    }
+    else
+    {
+        increaseColourShader();
+        setShader(*colourShader);
+    }
+}
+
 void SimpleDrawable::setPrimitiveType(std::uint32_t primitiveType)
 {
     CRO_ASSERT(primitiveType >= GL_POINTS && primitiveType <= GL_TRIANGLE_FAN, "");
@@ -325,6 +341,7 @@ void SimpleDrawable::drawGeometry(const glm::mat4& worldTransform) const
     {
         //bind texture
         glCheck(glActiveTexture(GL_TEXTURE0));
+        Detail::TextureRegistry::markUsed(m_textureID);
         glCheck(glBindTexture(GL_TEXTURE_2D, m_textureID));
 
         glCheck(glUniform1i(m_uniforms.texture, texIndex));
@@ -356,6 +373,7 @@ void SimpleDrawable::drawGeometry(const glm::mat4& worldTransform) const
             break;
         case UniformValue::Texture:
             glCheck(glActiveTexture(GL_TEXTURE0 + texIndex));
+            Detail::TextureRegistry::markUsed(value.textureID);
             glCheck(glBindTexture(GL_TEXTURE_2D, value.textureID));
 
             glCheck(glUniform1i(uid, texIndex));
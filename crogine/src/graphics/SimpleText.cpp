@@ -29,20 +29,76 @@ source distribution.
 
 #include "../detail/TextConstruction.hpp"
 #include "../detail/GLCheck.hpp"
+#include "shaders/Sprite.hpp"
 
 #include <crogine/graphics/SimpleText.hpp>
 #include <crogine/graphics/RenderTarget.hpp>
+#include <crogine/graphics/Shader.hpp>
 
 using namespace cro;
 
+namespace
+{
+    //shared by all SimpleText using distance field fonts
+    std::int32_t activeDistanceFieldShader = 0;
+    std::unique_ptr<Shader> distanceFieldShader;
+
+    const std::string DistanceFieldVertex =
+        R"(
+    ATTRIBUTE vec2 a_position;
+    ATTRIBUTE vec2 a_texCoord0;
+    ATTRIBUTE vec4 a_colour;
+
+    uniform mat4 u_worldMatrix;
+    uniform mat4 u_projectionMatrix;
+
+    VARYING_OUT vec2 v_texCoord;
+    VARYING_OUT LOW vec4 v_colour;
+
+    void main()
+    {
+        gl_Position = u_projectionMatrix * u_worldMatrix * vec4(a_position, 0.0, 1.0);
+        v_texCoord = a_texCoord0;
+        v_colour = a_colour;
+    })";
+
+    void increaseDistanceFieldShader()
+    {
+        if (activeDistanceFieldShader == 0)
+        {
+            distanceFieldShader = std::make_unique<Shader>();
+            distanceFieldShader->loadFromString(DistanceFieldVertex, Shaders::Text::SDFFragment);
+        }
+        activeDistanceFieldShader++;
+    }
+
+    void decreaseDistanceFieldShader()
+    {
+        activeDistanceFieldShader--;
+        if (activeDistanceFieldShader == 0)
+        {
+            distanceFieldShader.reset();
+        }
+    }
+}
+
 SimpleText::SimpleText()
     : m_lastTextureSize (0),
     m_fontTexture       (nullptr),
+    m_distanceField     (false),
     m_dirtyFlags        (DirtyFlags::All)
 {
     setPrimitiveType(GL_TRIANGLES);
 }
 
+SimpleText::~SimpleText()
+{
+    if (m_distanceField)
+    {
+        decreaseDistanceFieldShader();
+    }
+}
+
 SimpleText::SimpleText(const Font& font)
     : SimpleText()
 {
@@ -244,5 +300,31 @@ void SimpleText::updateVertices()
         std::vector<Vertex2D> verts;
         m_localBounds = Detail::Text::updateVertices(verts, m_context);
         setVertexData(verts);
+
+        if (m_context.font->isDistanceField())
+        {
+            if (!m_distanceField)
+            {
+                increaseDistanceFieldShader();
+
+                setShader(*distanceFieldShader);
+                m_distanceField = true;
+            }
+
+            //setting the shader resets the uniforms
+            const auto properties = Detail::Text::getDistanceFieldProperties(m_context);
+            setUniform("u_smoothing", properties.smoothing);
+            setUniform("u_outlineThickness", properties.outlineThickness);
+            setUniform("u_outlineColour", properties.outlineColour.getVec4());
+            setUniform("u_shadowColour", properties.shadowColour.getVec4());
+            setUniform("u_shadowOffset", properties.shadowOffset);
+        }
+        else if (m_distanceField)
+        {
+            //font was changed, so return to the default shader
+            resetShader();
+            decreaseDistanceFieldShader();
+            m_distanceField = false;
+        }
     }
 }
\ No newline at end of file
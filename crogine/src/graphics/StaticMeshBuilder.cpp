@@ -30,6 +30,7 @@ source distribution.
 #include "../detail/StaticMeshFile.hpp"
 
 #include <crogine/graphics/StaticMeshBuilder.hpp>
+#include <crogine/graphics/MeshOptimiser.hpp>
 #include <crogine/detail/OpenGL.hpp>
 
 #include <crogine/detail/glm/geometric.hpp>
@@ -90,6 +91,10 @@ Mesh::Data StaticMeshBuilder::build() const
 
         meshData.primitiveType = GL_TRIANGLES;       
         meshData.vertexSize = getVertexSize(meshData.attributes);
+
+        //cmf files are exported without any reordering so do it here
+        MeshOptimiser::optimise(meshFile.vboData, meshData.vertexSize / sizeof(float), meshFile.indexArrays);
+
         meshData.vertexCount = meshFile.vboData.size() / (meshData.vertexSize / sizeof(float));
         createVBO(meshData, meshFile.vboData);
 
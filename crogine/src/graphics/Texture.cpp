@@ -32,12 +32,16 @@ source distribution.
 #include <crogine/detail/Assert.hpp>
 
 #include "../detail/GLCheck.hpp"
+#include "../detail/CompressedImage.hpp"
+#include "../detail/TextureRegistry.hpp"
 #include "../detail/stb_image.h"
 #include "../detail/stb_image_write.h"
 #include "../detail/SDLImageRead.hpp"
 #include <SDL_rwops.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 using namespace cro;
 
@@ -61,7 +65,8 @@ Texture::Texture()
     m_handle        (0),
     m_smooth        (false),
     m_repeated      (false),
-    m_hasMipMaps    (false)
+    m_hasMipMaps    (false),
+    m_compressed    (false)
 {
 
 }
@@ -72,7 +77,8 @@ Texture::Texture(Texture&& other) noexcept
     m_handle    (other.m_handle),
     m_smooth    (other.m_smooth),
     m_repeated  (other.m_repeated),
-    m_hasMipMaps(other.m_hasMipMaps)
+    m_hasMipMaps(other.m_hasMipMaps),
+    m_compressed(other.m_compressed)
 {
     other.m_size = glm::uvec2(0);
     other.m_format = ImageFormat::None;
@@ -80,6 +86,7 @@ Texture::Texture(Texture&& other) noexcept
     other.m_smooth = false;
     other.m_repeated = false;
     other.m_hasMipMaps = false;
+    other.m_compressed = false;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept
@@ -95,6 +102,7 @@ Texture& Texture::operator=(Texture&& other) noexcept
         m_smooth = other.m_smooth;
         m_repeated = other.m_repeated;
         m_hasMipMaps = other.m_hasMipMaps;
+        m_compressed = other.m_compressed;
 
         other.m_size = glm::uvec2(0);
         other.m_format = ImageFormat::None;
@@ -102,6 +110,7 @@ Texture& Texture::operator=(Texture&& other) noexcept
         other.m_smooth = false;
         other.m_repeated = false;
         other.m_hasMipMaps = false;
+        other.m_compressed = false;
     }
     return *this;
 }
@@ -110,6 +119,7 @@ Texture::~Texture()
 {
     if(m_handle)
     {
+        Detail::TextureRegistry::removeTexture(m_handle);
         glCheck(glDeleteTextures(1, &m_handle));
     }
 }
@@ -126,6 +136,15 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
     width = std::min(width, getMaxTextureSize());
     height = std::min(height, getMaxTextureSize());
 
+    if (m_handle && m_compressed)
+    {
+        //compressed storage may contain mip levels which
+        //would be left orphaned, so start from scratch
+        Detail::TextureRegistry::removeTexture(m_handle);
+        glCheck(glDeleteTextures(1, &m_handle));
+        m_handle = 0;
+    }
+
     if (!m_handle)
     {
         GLuint handle;
@@ -135,6 +154,7 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
 
     m_size = { width, height };
     m_format = format;
+    m_compressed = false;
 
     auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
     auto smooth = m_smooth ? GL_LINEAR : GL_NEAREST;
@@ -171,6 +191,10 @@ void Texture::create(std::uint32_t width, std::uint32_t height, ImageFormat::Typ
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, smooth));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, smooth));
     glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+    //the contents no longer match any file this may have been loaded from
+    Detail::TextureRegistry::addTexture(m_handle, Detail::TextureRegistry::estimateSize(width, height, pixelSize));
+    Detail::TextureRegistry::clearEvictable(m_handle);
 }
 
 bool Texture::loadFromFile(const std::string& filePath, bool createMipMaps)
@@ -196,6 +220,16 @@ bool Texture::loadFromFile(const std::string& filePath, bool createMipMaps)
     //    return loadAsByte(file, createMipMaps);
     //}
 
+    if (Detail::isCompressedImagePath(filePath))
+    {
+        Detail::CompressedImageData data;
+        if (Detail::loadCompressedImage(filePath, data))
+        {
+            return loadFromCompressed(data, createMipMaps);
+        }
+        return false;
+    }
+
     Image image;
     if (image.loadFromFile(filePath))
     {
@@ -221,6 +255,12 @@ bool Texture::loadFromImage(const Image& image, bool createMipMaps)
 
 bool Texture::update(const std::uint8_t* pixels, bool createMipMaps, URect area)
 {
+    if (m_compressed)
+    {
+        LogE << "Failed updating texture, compressed textures are read-only" << std::endl;
+        return false;
+    }
+
     if (area.left + area.width > m_size.x)
     {
         Logger::log("Failed updating image, source pixels too wide", Logger::Type::Error);
@@ -249,6 +289,7 @@ bool Texture::update(const std::uint8_t* pixels, bool createMipMaps, URect area)
 
         glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
         glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.bottom, area.width, area.height, format, GL_UNSIGNED_BYTE, pixels));
+        Detail::TextureRegistry::clearEvictable(m_handle);
         
         //attempt to generate mip maps and set correct filter
         if (m_hasMipMaps || createMipMaps)
@@ -273,7 +314,8 @@ bool Texture::update(const Texture& other, std::uint32_t xPos, std::uint32_t yPo
     CRO_ASSERT(yPos + other.m_size.y <= m_size.y, "Won't fit!");
     CRO_ASSERT(m_format == other.m_format, "Texture formats don't match");
 
-    if (!m_handle || !other.m_handle || (other.m_handle == m_handle))
+    if (!m_handle || !other.m_handle || (other.m_handle == m_handle)
+        || m_compressed)
     {
         return false;
     }
@@ -409,6 +451,7 @@ void Texture::swap(Texture& other)
     std::swap(m_smooth, other.m_smooth);
     std::swap(m_repeated, other.m_repeated);
     std::swap(m_hasMipMaps, other.m_hasMipMaps);
+    std::swap(m_compressed, other.m_compressed);
 }
 
 FloatRect Texture::getNormalisedSubrect(FloatRect rect) const
@@ -442,13 +485,11 @@ bool Texture::saveToFile(const std::string& path) const
     glCheck(glBindTexture(GL_TEXTURE_2D, 0));
 
     //flip row order
-    stbi_flip_vertically_on_write(1);
-
-    RaiiRWops out;
-    out.file = SDL_RWFromFile(filePath.c_str(), "w");
-    auto result = stbi_write_png_to_func(image_write_func, out.file, m_size.x, m_size.y, 4, buffer.data(), m_size.x * 4);
+    Image image;
+    image.loadFromMemory(buffer.data(), m_size.x, m_size.y, ImageFormat::RGBA);
+    image.flipVertically();
 
-    if (result == 0)
+    if (!image.write(filePath))
     {
         LogE << "Failed writing " << path << std::endl;
 
@@ -477,6 +518,74 @@ bool Texture::saveToImage(Image& dst) const
 }
 
 //private
+bool Texture::loadFromCompressed(const Detail::CompressedImageData& data, bool createMipMaps)
+{
+    CRO_ASSERT(!data.levels.empty(), "No image data");
+
+    if (!Detail::isCompressedFormatSupported(data.glFormat))
+    {
+        LogE << "Compressed texture format 0x" << std::hex << data.glFormat << std::dec << " is not supported on this device" << std::endl;
+        return false;
+    }
+
+    const auto& baseLevel = data.levels[0];
+    if (baseLevel.width > getMaxTextureSize() || baseLevel.height > getMaxTextureSize())
+    {
+        LogE << "Compressed texture is larger than maximum texture size" << std::endl;
+        return false;
+    }
+
+    if (!m_handle)
+    {
+        GLuint handle;
+        glCheck(glGenTextures(1, &handle));
+        m_handle = handle;
+    }
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+    for (auto i = 0u; i < data.levels.size(); ++i)
+    {
+        const auto& level = data.levels[i];
+        glCheck(glCompressedTexImage2D(GL_TEXTURE_2D, i, data.glFormat, level.width, level.height, 0,
+            static_cast<GLsizei>(level.size), data.data.data() + level.offset));
+    }
+
+    m_size = { baseLevel.width, baseLevel.height };
+    m_format = data.format;
+    m_compressed = true;
+    m_hasMipMaps = data.levels.size() > 1;
+
+    std::size_t byteSize = 0;
+    for (const auto& level : data.levels)
+    {
+        byteSize += level.size;
+    }
+    Detail::TextureRegistry::addTexture(m_handle, byteSize);
+
+    if (createMipMaps && !m_hasMipMaps)
+    {
+        LogW << "Mipmaps cannot be generated for compressed textures - include them in the file instead" << std::endl;
+    }
+
+    auto wrap = m_repeated ? GL_REPEAT : GL_CLAMP_TO_EDGE;
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(data.levels.size() - 1)));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+    if (m_hasMipMaps)
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST));
+    }
+    else
+    {
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+    }
+    glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+    return true;
+}
+
 bool Texture::isFloat(SDL_RWops* file)
 {
     //TODO figure out why this doesn't work
@@ -494,13 +603,13 @@ bool Texture::loadAsFloat(SDL_RWops* file, bool createMipMaps)
     STBIMG_stbio_RWops io;
     stbi_callback_from_RW(file, &io);
 
-    stbi_set_flip_vertically_on_load(1);
+    stbi_set_flip_vertically_on_load_thread(1);
 
     std::int32_t w, h, fmt;
     auto* img = stbi_loadf_from_callbacks(&io.stb_cbs, &io, &w, &h, &fmt, 0);
     if (img)
     {
-        stbi_set_flip_vertically_on_load(0);
+        stbi_set_flip_vertically_on_load_thread(0);
 
         GLint internalFormat = GL_R32F;
         GLint glFormat = GL_RED;
@@ -565,13 +674,13 @@ bool Texture::loadAsByte(SDL_RWops* file, bool createMipmaps)
     STBIMG_stbio_RWops io;
     stbi_callback_from_RW(file, &io);
 
-    stbi_set_flip_vertically_on_load(1);
+    stbi_set_flip_vertically_on_load_thread(1);
 
     std::int32_t w, h, fmt;
     auto* img = stbi_load_from_callbacks(&io.stb_cbs, &io, &w, &h, &fmt, 0);
     if (img)
     {
-        stbi_set_flip_vertically_on_load(0);
+        stbi_set_flip_vertically_on_load_thread(0);
 
         m_format = ImageFormat::A;
         switch (fmt)
@@ -602,7 +711,7 @@ bool Texture::loadAsByte(SDL_RWops* file, bool createMipmaps)
     else
     {
         SDL_RWclose(file);
-        stbi_set_flip_vertically_on_load(0);
+        stbi_set_flip_vertically_on_load_thread(0);
         return false;
     }
     return false;
@@ -629,5 +738,43 @@ void Texture::generateMipMaps()
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR_MIPMAP_NEAREST));
         m_hasMipMaps = true;
         //LOG("Created Mipmaps", Logger::Type::Warning);
+
+        const std::uint32_t pixelSize = m_format == ImageFormat::RGBA ? 4 : m_format == ImageFormat::RGB ? 3 : 1;
+        Detail::TextureRegistry::addTexture(m_handle, Detail::TextureRegistry::estimateSize(m_size.x, m_size.y, pixelSize, true));
+    }
+}
+
+void Texture::evict()
+{
+    //redefine every level so the driver can release the storage, but
+    //keep the handle so that anything referencing it remains valid.
+    //Don't touch the registry here as this is called from within it.
+    if (m_handle)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, m_handle));
+
+        if (m_hasMipMaps)
+        {
+            auto levelCount = static_cast<std::int32_t>(std::floor(std::log2(std::max(m_size.x, m_size.y)))) + 1;
+            for (auto i = 1; i < levelCount; ++i)
+            {
+                glCheck(glTexImage2D(GL_TEXTURE_2D, i, GL_RGBA, 0, 0, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+            }
+        }
+
+        const std::array<std::uint8_t, 4u> texel = {};
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel.data()));
+
+        //only the base level is required to be complete without mipmap filtering
+        glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_smooth ? GL_LINEAR : GL_NEAREST));
+        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+
+        //the placeholder is uncompressed, so that
+        //create() reuses the handle when restoring
+        m_compressed = false;
+
+        //mipmaps are recreated by the restore callback, which
+        //keeps the value from when the texture was resident
+        m_hasMipMaps = false;
     }
 }
\ No newline at end of file
@@ -0,0 +1,676 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/graphics/TextureCompression.hpp>
+#include <crogine/graphics/Image.hpp>
+#include <crogine/core/Log.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include "../detail/CompressedImage.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+using namespace cro;
+using namespace cro::TextureCompression;
+
+namespace
+{
+    /*
+    Mip filtering
+    */
+    constexpr float FilterRadius = 3.f; //in destination pixels
+    constexpr float KaiserAlpha = 4.f;
+    constexpr float Pi = 3.14159265359f;
+
+    float bessel0(float x)
+    {
+        //power series of the zeroth order modified Bessel function
+        float sum = 1.f;
+        float term = 1.f;
+        const float halfX = x * 0.5f;
+        for (auto k = 1; k < 32 && term > sum * 1e-8f; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            sum += term;
+        }
+        return sum;
+    }
+
+    float kaiserSinc(float t)
+    {
+        t = std::abs(t);
+        if (t >= FilterRadius)
+        {
+            return 0.f;
+        }
+
+        const float sinc = t < 1e-5f ? 1.f : std::sin(Pi * t) / (Pi * t);
+        const float r = t / FilterRadius;
+        return sinc * (bessel0(KaiserAlpha * std::sqrt(1.f - (r * r))) / bessel0(KaiserAlpha));
+    }
+
+    struct Tap final
+    {
+        std::uint32_t index = 0;
+        float weight = 0.f;
+    };
+
+    //precalculates the filter taps for each destination pixel along one axis
+    std::vector<std::vector<Tap>> createTaps(std::uint32_t srcSize, std::uint32_t dstSize, bool repeated)
+    {
+        std::vector<std::vector<Tap>> retVal(dstSize);
+
+        const float scale = static_cast<float>(srcSize) / dstSize;
+        for (auto i = 0u; i < dstSize; ++i)
+        {
+            const float centre = (i + 0.5f) * scale;
+            const auto first = static_cast<std::int32_t>(std::floor(centre - (FilterRadius * scale)));
+            const auto last = static_cast<std::int32_t>(std::ceil(centre + (FilterRadius * scale)));
+
+            float total = 0.f;
+            for (auto s = first; s < last; ++s)
+            {
+                const float weight = kaiserSinc(((s + 0.5f) - centre) / scale);
+                if (weight == 0.f)
+                {
+                    continue;
+                }
+
+                std::int32_t index = s;
+                const auto size = static_cast<std::int32_t>(srcSize);
+                if (repeated)
+                {
+                    index = ((index % size) + size) % size;
+                }
+                else
+                {
+                    index = std::clamp(index, 0, size - 1);
+                }
+
+                retVal[i].push_back({ static_cast<std::uint32_t>(index), weight });
+                total += weight;
+            }
+
+            for (auto& tap : retVal[i])
+            {
+                tap.weight /= total;
+            }
+        }
+
+        return retVal;
+    }
+
+    struct FloatImage final
+    {
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        std::vector<float> pixels; //RGBA
+    };
+
+    FloatImage downsample(const FloatImage& src, bool repeated)
+    {
+        FloatImage horizontal;
+        horizontal.width = std::max(1u, src.width / 2);
+        horizontal.height = src.height;
+        horizontal.pixels.resize(horizontal.width * horizontal.height * 4);
+
+        const auto xTaps = createTaps(src.width, horizontal.width, repeated);
+        for (auto y = 0u; y < horizontal.height; ++y)
+        {
+            for (auto x = 0u; x < horizontal.width; ++x)
+            {
+                auto* dst = &horizontal.pixels[((y * horizontal.width) + x) * 4];
+                for (const auto& tap : xTaps[x])
+                {
+                    const auto* px = &src.pixels[((y * src.width) + tap.index) * 4];
+                    for (auto c = 0; c < 4; ++c)
+                    {
+                        dst[c] += px[c] * tap.weight;
+                    }
+                }
+            }
+        }
+
+        FloatImage retVal;
+        retVal.width = horizontal.width;
+        retVal.height = std::max(1u, src.height / 2);
+        retVal.pixels.resize(retVal.width * retVal.height * 4);
+
+        const auto yTaps = createTaps(horizontal.height, retVal.height, repeated);
+        for (auto y = 0u; y < retVal.height; ++y)
+        {
+            for (const auto& tap : yTaps[y])
+            {
+                const auto* srcRow = &horizontal.pixels[tap.index * horizontal.width * 4];
+                auto* dstRow = &retVal.pixels[y * retVal.width * 4];
+                for (auto i = 0u; i < retVal.width * 4; ++i)
+                {
+                    dstRow[i] += srcRow[i] * tap.weight;
+                }
+            }
+        }
+
+        //the negative lobes of the filter may overshoot
+        for (auto& v : retVal.pixels)
+        {
+            v = std::clamp(v, 0.f, 1.f);
+        }
+
+        return retVal;
+    }
+
+    float toLinear(float v)
+    {
+        return v <= 0.04045f ? v / 12.92f : std::pow((v + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float toSRGB(float v)
+    {
+        return v <= 0.0031308f ? v * 12.92f : (1.055f * std::pow(v, 1.f / 2.4f)) - 0.055f;
+    }
+
+    //converts to premultiplied RGBA float, in linear space if requested
+    FloatImage toFloatImage(const Image& image, bool gammaCorrect)
+    {
+        FloatImage retVal;
+        retVal.width = image.getSize().x;
+        retVal.height = image.getSize().y;
+        retVal.pixels.resize(retVal.width * retVal.height * 4);
+
+        const auto* src = image.getPixelData();
+        const std::size_t pixelCount = retVal.width * retVal.height;
+        for (auto i = 0u; i < pixelCount; ++i)
+        {
+            auto* dst = &retVal.pixels[i * 4];
+            switch (image.getFormat())
+            {
+            default:
+            case ImageFormat::A:
+                dst[0] = dst[1] = dst[2] = src[i] / 255.f;
+                dst[3] = 1.f;
+                break;
+            case ImageFormat::RGB:
+                dst[0] = src[(i * 3)] / 255.f;
+                dst[1] = src[(i * 3) + 1] / 255.f;
+                dst[2] = src[(i * 3) + 2] / 255.f;
+                dst[3] = 1.f;
+                break;
+            case ImageFormat::RGBA:
+                for (auto c = 0; c < 4; ++c)
+                {
+                    dst[c] = src[(i * 4) + c] / 255.f;
+                }
+                break;
+            }
+
+            for (auto c = 0; c < 3; ++c)
+            {
+                if (gammaCorrect)
+                {
+                    dst[c] = toLinear(dst[c]);
+                }
+                //filtering premultiplied colour stops transparent
+                //pixels bleeding into their opaque neighbours
+                dst[c] *= dst[3];
+            }
+        }
+
+        return retVal;
+    }
+
+    std::vector<std::uint8_t> toBytes(const FloatImage& image, bool gammaCorrect)
+    {
+        std::vector<std::uint8_t> retVal(image.pixels.size());
+        for (auto i = 0u; i < image.pixels.size(); i += 4)
+        {
+            const float alpha = image.pixels[i + 3];
+            for (auto c = 0u; c < 3; ++c)
+            {
+                float v = alpha > 0.f ? std::min(1.f, image.pixels[i + c] / alpha) : 0.f;
+                if (gammaCorrect)
+                {
+                    v = toSRGB(v);
+                }
+                retVal[i + c] = static_cast<std::uint8_t>(std::round(v * 255.f));
+            }
+            retVal[i + 3] = static_cast<std::uint8_t>(std::round(alpha * 255.f));
+        }
+        return retVal;
+    }
+
+
+    /*
+    Block encoding
+    */
+    using Block = std::array<std::uint8_t, 16 * 4>; //RGBA
+
+    std::uint16_t to565(const std::array<float, 3>& c)
+    {
+        auto r = static_cast<std::uint16_t>(std::round(std::clamp(c[0], 0.f, 255.f) * 31.f / 255.f));
+        auto g = static_cast<std::uint16_t>(std::round(std::clamp(c[1], 0.f, 255.f) * 63.f / 255.f));
+        auto b = static_cast<std::uint16_t>(std::round(std::clamp(c[2], 0.f, 255.f) * 31.f / 255.f));
+        return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    std::array<float, 3> from565(std::uint16_t c)
+    {
+        const std::uint32_t r = (c >> 11) & 0x1f;
+        const std::uint32_t g = (c >> 5) & 0x3f;
+        const std::uint32_t b = c & 0x1f;
+        return { static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)), static_cast<float>((b << 3) | (b >> 2)) };
+    }
+
+    //selects the palette indices for the given endpoints, returning the total error
+    float fitIndices(const Block& block, std::uint16_t c0, std::uint16_t c1, std::uint32_t& indices)
+    {
+        const auto e0 = from565(c0);
+        const auto e1 = from565(c1);
+
+        std::array<std::array<float, 3>, 4u> palette = {};
+        for (auto c = 0u; c < 3u; ++c)
+        {
+            palette[0][c] = e0[c];
+            palette[1][c] = e1[c];
+            palette[2][c] = ((2.f * e0[c]) + e1[c]) / 3.f;
+            palette[3][c] = (e0[c] + (2.f * e1[c])) / 3.f;
+        }
+
+        indices = 0;
+        float totalError = 0.f;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            float bestError = std::numeric_limits<float>::max();
+            std::uint32_t bestIndex = 0;
+            for (auto p = 0u; p < 4u; ++p)
+            {
+                float error = 0.f;
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    const float d = block[(i * 4) + c] - palette[p][c];
+                    error += d * d;
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    bestIndex = p;
+                }
+            }
+            indices |= bestIndex << (i * 2);
+            totalError += bestError;
+        }
+        return totalError;
+    }
+
+    void writeColourBlock(std::uint16_t c0, std::uint16_t c1, std::uint32_t indices, std::uint8_t* dst)
+    {
+        dst[0] = static_cast<std::uint8_t>(c0 & 0xff);
+        dst[1] = static_cast<std::uint8_t>(c0 >> 8);
+        dst[2] = static_cast<std::uint8_t>(c1 & 0xff);
+        dst[3] = static_cast<std::uint8_t>(c1 >> 8);
+        for (auto i = 0u; i < 4u; ++i)
+        {
+            dst[4 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xff);
+        }
+    }
+
+    //orders the endpoints so the block is always decoded in 4 colour
+    //mode, remapping the indices if the endpoints were swapped
+    float fitEndpoints(const Block& block, std::array<float, 3> e0, std::array<float, 3> e1,
+        std::uint16_t& c0, std::uint16_t& c1, std::uint32_t& indices)
+    {
+        c0 = to565(e0);
+        c1 = to565(e1);
+
+        if (c0 < c1)
+        {
+            std::swap(c0, c1);
+        }
+        else if (c0 == c1)
+        {
+            //a single colour, index 0 is always the endpoint
+            indices = 0;
+            return fitIndices(block, c0, c0, indices);
+        }
+
+        return fitIndices(block, c0, c1, indices);
+    }
+
+    //BC1 colour block. Endpoints are initially chosen by projecting the
+    //pixels onto the principal axis of the block's colour distribution,
+    //then refined with a single least squares pass over the chosen indices
+    void encodeColourBlock(const Block& block, std::uint8_t* dst)
+    {
+        std::array<float, 3> mean = {};
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            for (auto c = 0u; c < 3u; ++c)
+            {
+                mean[c] += block[(i * 4) + c] / 16.f;
+            }
+        }
+
+        std::array<float, 6> covariance = {}; //rr rg rb gg gb bb
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            const float r = block[(i * 4)] - mean[0];
+            const float g = block[(i * 4) + 1] - mean[1];
+            const float b = block[(i * 4) + 2] - mean[2];
+            covariance[0] += r * r;
+            covariance[1] += r * g;
+            covariance[2] += r * b;
+            covariance[3] += g * g;
+            covariance[4] += g * b;
+            covariance[5] += b * b;
+        }
+
+        //power iteration for the dominant eigenvector
+        std::array<float, 3> axis = { 1.f, 1.f, 1.f };
+        for (auto i = 0; i < 8; ++i)
+        {
+            std::array<float, 3> next =
+            {
+                (axis[0] * covariance[0]) + (axis[1] * covariance[1]) + (axis[2] * covariance[2]),
+                (axis[0] * covariance[1]) + (axis[1] * covariance[3]) + (axis[2] * covariance[4]),
+                (axis[0] * covariance[2]) + (axis[1] * covariance[4]) + (axis[2] * covariance[5])
+            };
+            const float len = std::max({ std::abs(next[0]), std::abs(next[1]), std::abs(next[2]) });
+            if (len < 1e-6f)
+            {
+                break;
+            }
+            axis = { next[0] / len, next[1] / len, next[2] / len };
+        }
+
+        float minProj = std::numeric_limits<float>::max();
+        float maxProj = std::numeric_limits<float>::lowest();
+        std::array<float, 3> minColour = {};
+        std::array<float, 3> maxColour = {};
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            std::array<float, 3> colour =
+            {
+                static_cast<float>(block[(i * 4)]),
+                static_cast<float>(block[(i * 4) + 1]),
+                static_cast<float>(block[(i * 4) + 2])
+            };
+            const float proj = (colour[0] * axis[0]) + (colour[1] * axis[1]) + (colour[2] * axis[2]);
+            if (proj < minProj)
+            {
+                minProj = proj;
+                minColour = colour;
+            }
+            if (proj > maxProj)
+            {
+                maxProj = proj;
+                maxColour = colour;
+            }
+        }
+
+        std::uint16_t c0 = 0;
+        std::uint16_t c1 = 0;
+        std::uint32_t indices = 0;
+        const float error = fitEndpoints(block, maxColour, minColour, c0, c1, indices);
+
+        //least squares refinement, solving for the endpoints which
+        //best fit the palette weights of the selected indices
+        if (c0 != c1)
+        {
+            static constexpr std::array<float, 4u> Weights = { 1.f, 0.f, 2.f / 3.f, 1.f / 3.f };
+            float aa = 0.f, ab = 0.f, bb = 0.f;
+            std::array<float, 3> ax = {};
+            std::array<float, 3> bx = {};
+            for (auto i = 0u; i < 16u; ++i)
+            {
+                const float a = Weights[(indices >> (i * 2)) & 0x3];
+                const float b = 1.f - a;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    ax[c] += a * block[(i * 4) + c];
+                    bx[c] += b * block[(i * 4) + c];
+                }
+            }
+
+            const float det = (aa * bb) - (ab * ab);
+            if (std::abs(det) > 1e-6f)
+            {
+                std::array<float, 3> e0 = {};
+                std::array<float, 3> e1 = {};
+                for (auto c = 0u; c < 3u; ++c)
+                {
+                    e0[c] = ((ax[c] * bb) - (bx[c] * ab)) / det;
+                    e1[c] = ((bx[c] * aa) - (ax[c] * ab)) / det;
+                }
+
+                std::uint16_t r0 = 0;
+                std::uint16_t r1 = 0;
+                std::uint32_t refinedIndices = 0;
+                if (fitEndpoints(block, e0, e1, r0, r1, refinedIndices) < error)
+                {
+                    c0 = r0;
+                    c1 = r1;
+                    indices = refinedIndices;
+                }
+            }
+        }
+
+        writeColourBlock(c0, c1, indices, dst);
+    }
+
+    //BC4 block, also used for the alpha of BC3 and each channel of BC5
+    void encodeChannelBlock(const Block& block, std::uint32_t channel, std::uint8_t* dst)
+    {
+        std::uint8_t minVal = 255;
+        std::uint8_t maxVal = 0;
+        for (auto i = 0u; i < 16u; ++i)
+        {
+            minVal = std::min(minVal, block[(i * 4) + channel]);
+            maxVal = std::max(maxVal, block[(i * 4) + channel]);
+        }
+
+        dst[0] = maxVal;
+        dst[1] = minVal;
+
+        std::array<float, 8u> palette = {};
+        palette[0] = maxVal;
+        palette[1] = minVal;
+        for (auto i = 1u; i < 7u; ++i)
+        {
+            palette[i + 1] = (((7.f - i) * maxVal) + (i * minVal)) / 7.f;
+        }
+
+        std::uint64_t indices = 0;
+        if (maxVal != minVal)
+        {
+            for (auto i = 0u; i < 16u; ++i)
+            {
+                const float value = block[(i * 4) + channel];
+                std::uint64_t bestIndex = 0;
+                float bestError = std::numeric_limits<float>::max();
+                for (auto p = 0u; p < 8u; ++p)
+                {
+                    const float error = std::abs(value - palette[p]);
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = p;
+                    }
+                }
+                indices |= bestIndex << (i * 3);
+            }
+        }
+
+        for (auto i = 0u; i < 6u; ++i)
+        {
+            dst[2 + i] = static_cast<std::uint8_t>((indices >> (i * 8)) & 0xff);
+        }
+    }
+
+    std::uint32_t getFourCC(Format format)
+    {
+        switch (format)
+        {
+        default:
+        case Format::BC1: return Detail::makeFourCC('D', 'X', 'T', '1');
+        case Format::BC3: return Detail::makeFourCC('D', 'X', 'T', '5');
+        case Format::BC4: return Detail::makeFourCC('A', 'T', 'I', '1');
+        case Format::BC5: return Detail::makeFourCC('A', 'T', 'I', '2');
+        }
+    }
+}
+
+std::vector<std::uint8_t> TextureCompression::encode(const std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, Format format)
+{
+    CRO_ASSERT(pixels, "");
+    CRO_ASSERT(format != Format::Automatic, "Format must be explicit");
+
+    const std::size_t blockSize = (format == Format::BC1 || format == Format::BC4) ? 8 : 16;
+    const auto blocksX = (width + 3) / 4;
+    const auto blocksY = (height + 3) / 4;
+
+    std::vector<std::uint8_t> retVal(blocksX * blocksY * blockSize);
+    auto* dst = retVal.data();
+
+    Block block = {};
+    for (auto by = 0u; by < blocksY; ++by)
+    {
+        for (auto bx = 0u; bx < blocksX; ++bx)
+        {
+            for (auto y = 0u; y < 4u; ++y)
+            {
+                const auto py = std::min((by * 4) + y, height - 1);
+                for (auto x = 0u; x < 4u; ++x)
+                {
+                    const auto px = std::min((bx * 4) + x, width - 1);
+                    const auto* src = &pixels[((py * width) + px) * 4];
+                    std::copy(src, src + 4, &block[((y * 4) + x) * 4]);
+                }
+            }
+
+            switch (format)
+            {
+            default:
+            case Format::BC1:
+                encodeColourBlock(block, dst);
+                break;
+            case Format::BC3:
+                encodeChannelBlock(block, 3, dst);
+                encodeColourBlock(block, dst + 8);
+                break;
+            case Format::BC4:
+                encodeChannelBlock(block, 0, dst);
+                break;
+            case Format::BC5:
+                encodeChannelBlock(block, 0, dst);
+                encodeChannelBlock(block, 1, dst + 8);
+                break;
+            }
+            dst += blockSize;
+        }
+    }
+
+    return retVal;
+}
+
+bool TextureCompression::compress(const Image& image, const std::string& outputPath, const Settings& settings)
+{
+    if (image.getPixelData() == nullptr)
+    {
+        LogE << "Failed compressing texture: Image is empty." << std::endl;
+        return false;
+    }
+
+    auto format = settings.format;
+    if (format == Format::Automatic)
+    {
+        switch (image.getFormat())
+        {
+        default:
+        case ImageFormat::RGBA:
+            format = Format::BC3;
+            break;
+        case ImageFormat::RGB:
+            format = Format::BC1;
+            break;
+        case ImageFormat::A:
+            format = Format::BC4;
+            break;
+        }
+    }
+
+    //BC4 and BC5 are assumed to be non-colour data
+    const bool gammaCorrect = settings.gammaCorrect && (format == Format::BC1 || format == Format::BC3);
+
+    auto level = toFloatImage(image, gammaCorrect);
+    const auto width = level.width;
+    const auto height = level.height;
+
+    std::vector<std::vector<std::uint8_t>> levels;
+    while (true)
+    {
+        auto bytes = toBytes(level, gammaCorrect);
+        levels.push_back(encode(bytes.data(), level.width, level.height, format));
+
+        if (!settings.generateMipMaps
+            || (level.width == 1 && level.height == 1))
+        {
+            break;
+        }
+        level = downsample(level, settings.repeated);
+    }
+
+    if (Detail::writeDDS(outputPath, getFourCC(format), width, height, levels))
+    {
+        std::size_t size = 0;
+        for (const auto& l : levels)
+        {
+            size += l.size();
+        }
+        LogI << "Wrote " << outputPath << ": " << levels.size() << " levels, " << size << " bytes" << std::endl;
+        return true;
+    }
+    return false;
+}
+
+bool TextureCompression::compress(const std::string& inputPath, const std::string& outputPath, const Settings& settings)
+{
+    Image image;
+    if (!image.loadFromFile(inputPath))
+    {
+        return false;
+    }
+    return compress(image, outputPath, settings);
+}
@@ -0,0 +1,295 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/graphics/TextureMemory.hpp>
+
+#include "../detail/TextureRegistry.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+using namespace cro;
+using namespace cro::Detail;
+
+namespace
+{
+    //texture and renderbuffer names are separate namespaces
+    //so the upper bits of the key mark renderbuffers
+    constexpr std::uint64_t RenderbufferFlag = (1ull << 32);
+
+    //textures bound within this many frames are not evicted
+    constexpr std::uint64_t MinIdleFrames = 2;
+
+    enum class Residency
+    {
+        Resident, Evicted, Restoring
+    };
+
+    struct Entry final
+    {
+        std::size_t bytes = 0;
+        TextureMemory::Category category = TextureMemory::Texture;
+        std::uint64_t lastUsed = 0;
+        Residency residency = Residency::Resident;
+
+        std::function<void()> evict;
+        std::function<void()> restore;
+    };
+
+    struct RegistryState final
+    {
+        std::unordered_map<std::uint64_t, Entry> entries;
+        std::uint64_t frame = 0;
+        std::size_t budget = 0;
+
+        std::size_t evictionCount = 0;
+        std::size_t restoreCount = 0;
+
+        std::size_t getTotal() const
+        {
+            std::size_t total = 0;
+            for (const auto& [_, entry] : entries)
+            {
+                total += entry.bytes;
+            }
+            return total;
+        }
+    }registry;
+
+    void addEntry(std::uint64_t key, std::size_t bytes, TextureMemory::Category category)
+    {
+        if (auto result = registry.entries.find(key); result != registry.entries.end())
+        {
+            auto& entry = result->second;
+            entry.bytes = bytes;
+            entry.lastUsed = registry.frame;
+
+            if (entry.residency == Residency::Restoring)
+            {
+                registry.restoreCount++;
+            }
+            entry.residency = Residency::Resident;
+        }
+        else
+        {
+            auto& entry = registry.entries[key];
+            entry.bytes = bytes;
+            entry.category = category;
+            entry.lastUsed = registry.frame;
+        }
+    }
+}
+
+//public
+void TextureMemory::setBudget(std::size_t bytes)
+{
+    registry.budget = bytes;
+}
+
+std::size_t TextureMemory::getBudget()
+{
+    return registry.budget;
+}
+
+void TextureMemory::markUsed(std::uint32_t handle)
+{
+    TextureRegistry::markUsed(handle);
+}
+
+TextureMemory::Stats TextureMemory::getStats()
+{
+    Stats stats;
+    stats.budget = registry.budget;
+    stats.evictionCount = registry.evictionCount;
+    stats.restoreCount = registry.restoreCount;
+
+    for (const auto& [_, entry] : registry.entries)
+    {
+        stats.total += entry.bytes;
+        stats.categoryTotals[entry.category] += entry.bytes;
+
+        if (entry.residency != Residency::Resident)
+        {
+            stats.evictedCount++;
+        }
+        else if (entry.evict)
+        {
+            stats.evictable += entry.bytes;
+        }
+    }
+    return stats;
+}
+
+const char* TextureMemory::getCategoryName(Category category)
+{
+    switch (category)
+    {
+    default: return "Unknown";
+    case Texture: return "Texture";
+    case Font: return "Font";
+    case RenderTarget: return "Render Target";
+    case DepthTarget: return "Depth Target";
+    case EnvironmentMap: return "Environment Map";
+    }
+}
+
+//detail
+void TextureRegistry::addTexture(std::uint32_t handle, std::size_t bytes, TextureMemory::Category category)
+{
+    addEntry(handle, bytes, category);
+}
+
+void TextureRegistry::removeTexture(std::uint32_t handle)
+{
+    registry.entries.erase(handle);
+}
+
+void TextureRegistry::setCategory(std::uint32_t handle, TextureMemory::Category category)
+{
+    if (auto result = registry.entries.find(handle); result != registry.entries.end())
+    {
+        result->second.category = category;
+    }
+}
+
+void TextureRegistry::addRenderbuffer(std::uint32_t handle, std::size_t bytes, TextureMemory::Category category)
+{
+    addEntry(handle | RenderbufferFlag, bytes, category);
+}
+
+void TextureRegistry::removeRenderbuffer(std::uint32_t handle)
+{
+    registry.entries.erase(handle | RenderbufferFlag);
+}
+
+void TextureRegistry::setEvictable(std::uint32_t handle, std::function<void()> evict, std::function<void()> restore)
+{
+    if (auto result = registry.entries.find(handle); result != registry.entries.end())
+    {
+        result->second.evict = std::move(evict);
+        result->second.restore = std::move(restore);
+    }
+}
+
+void TextureRegistry::clearEvictable(std::uint32_t handle)
+{
+    if (auto result = registry.entries.find(handle); result != registry.entries.end())
+    {
+        result->second.evict = nullptr;
+        result->second.restore = nullptr;
+    }
+}
+
+void TextureRegistry::markUsed(std::uint32_t handle)
+{
+    if (auto result = registry.entries.find(handle); result != registry.entries.end())
+    {
+        auto& entry = result->second;
+        entry.lastUsed = registry.frame;
+
+        if (entry.residency == Residency::Evicted)
+        {
+            entry.residency = Residency::Restoring;
+            if (entry.restore)
+            {
+                //this may call addTexture() immediately
+                //so don't use the entry after this
+                auto restore = entry.restore;
+                restore();
+            }
+        }
+    }
+}
+
+void TextureRegistry::restoreFailed(std::uint32_t handle)
+{
+    if (auto result = registry.entries.find(handle); result != registry.entries.end()
+        && result->second.residency == Residency::Restoring)
+    {
+        result->second.residency = Residency::Evicted;
+    }
+}
+
+void TextureRegistry::update()
+{
+    registry.frame++;
+
+    if (registry.budget == 0)
+    {
+        return;
+    }
+
+    auto total = registry.getTotal();
+    if (total <= registry.budget)
+    {
+        return;
+    }
+
+    std::vector<std::pair<std::uint64_t, Entry*>> candidates;
+    for (auto& [key, entry] : registry.entries)
+    {
+        if (entry.evict
+            && entry.residency == Residency::Resident
+            && entry.lastUsed + MinIdleFrames < registry.frame)
+        {
+            candidates.emplace_back(key, &entry);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+        [](const auto& a, const auto& b)
+        {
+            return a.second->lastUsed < b.second->lastUsed;
+        });
+
+    for (auto& [key, entry] : candidates)
+    {
+        if (total <= registry.budget)
+        {
+            break;
+        }
+
+        //evicting doesn't modify the registry so the pointer remains valid
+        entry->evict();
+        total -= entry->bytes;
+        entry->bytes = 0;
+        entry->residency = Residency::Evicted;
+        registry.evictionCount++;
+    }
+}
+
+std::size_t TextureRegistry::estimateSize(std::uint32_t width, std::uint32_t height, std::uint32_t bytesPerPixel, bool mipmapped)
+{
+    std::size_t size = static_cast<std::size_t>(width) * height * bytesPerPixel;
+
+    //a full mip chain adds roughly a third
+    return mipmapped ? size + (size / 3) : size;
+}
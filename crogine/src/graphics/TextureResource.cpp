@@ -30,6 +30,10 @@ source distribution.
 #include <crogine/graphics/TextureResource.hpp>
 #include <crogine/graphics/Image.hpp>
 
+#include "../detail/AsyncLoader.hpp"
+#include "../detail/CompressedImage.hpp"
+#include "../detail/TextureRegistry.hpp"
+
 using namespace cro;
 
 namespace
@@ -38,7 +42,8 @@ namespace
 }
 
 TextureResource::TextureResource()
-    : m_fallbackColour(Colour::Magenta)
+    : m_fallbackColour  (Colour::Magenta),
+    m_asyncState        (std::make_shared<AsyncState>())
 {
 
 }
@@ -46,6 +51,15 @@ TextureResource::TextureResource()
 //public
 bool TextureResource::load(std::uint32_t id, const std::string& path, bool createMipMaps)
 {
+    flushAsync();
+
+    if (m_asyncState->pending.count(id) != 0)
+    {
+        const auto& currentPath = m_asyncState->pending.at(id);
+        LogI << "Texture ID " << id << " already queued for " << currentPath << std::endl;
+        return path == currentPath;
+    }
+
     if (m_textures.count(id) == 0)
     {
         std::unique_ptr<Texture> tex = std::make_unique<Texture>();
@@ -54,6 +68,7 @@ bool TextureResource::load(std::uint32_t id, const std::string& path, bool creat
             //loadFromFile() should print error message
             return false;
         }
+        setEvictable(m_asyncState, *tex, path);
         m_textures.insert(std::make_pair(id, std::make_pair(path, std::move(tex))));
         return true;
     }
@@ -68,8 +83,95 @@ bool TextureResource::load(std::uint32_t id, const std::string& path, bool creat
     return false;
 }
 
+std::future<bool> TextureResource::loadAsync(std::uint32_t id, const std::string& path, bool createMipMaps)
+{
+    flushAsync();
+
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto result = promise->get_future();
+
+    if (m_textures.count(id) != 0
+        || m_asyncState->pending.count(id) != 0)
+    {
+        //reports the existing mapping
+        promise->set_value(load(id, path, createMipMaps));
+        return result;
+    }
+
+    m_asyncState->pending.insert(std::make_pair(id, path));
+
+    std::weak_ptr<AsyncState> weakState = m_asyncState;
+    Detail::AsyncLoader::queueJob([weakState, promise, id, path, createMipMaps]()
+        {
+            if (weakState.expired())
+            {
+                promise->set_value(false);
+                return;
+            }
+
+            if (Detail::isCompressedImagePath(path))
+            {
+                //block compressed data is parsed here and uploaded as-is
+                auto data = std::make_shared<Detail::CompressedImageData>();
+                Detail::loadCompressedImage(path, *data); //prints any errors
+
+                Detail::AsyncLoader::queueUpload([weakState, promise, data, id, path, createMipMaps]()
+                    {
+                        auto state = weakState.lock();
+                        if (!state)
+                        {
+                            promise->set_value(false);
+                            return;
+                        }
+                        state->pending.erase(id);
+
+                        auto texture = std::make_unique<Texture>();
+                        if (data->levels.empty()
+                            || !texture->loadFromCompressed(*data, createMipMaps))
+                        {
+                            promise->set_value(false);
+                            return;
+                        }
+
+                        state->loaded.insert(std::make_pair(id, std::make_pair(path, std::move(texture))));
+                        promise->set_value(true);
+                    });
+                return;
+            }
+
+            auto image = std::make_shared<Image>();
+            image->loadFromFile(path); //prints any errors
+
+            Detail::AsyncLoader::queueUpload([weakState, promise, image, id, path, createMipMaps]()
+                {
+                    auto state = weakState.lock();
+                    if (!state)
+                    {
+                        promise->set_value(false);
+                        return;
+                    }
+                    state->pending.erase(id);
+
+                    auto texture = std::make_unique<Texture>();
+                    if (image->getPixelData() == nullptr
+                        || !texture->loadFromImage(*image, createMipMaps))
+                    {
+                        promise->set_value(false);
+                        return;
+                    }
+
+                    state->loaded.insert(std::make_pair(id, std::make_pair(path, std::move(texture))));
+                    promise->set_value(true);
+                });
+        });
+
+    return result;
+}
+
 Texture& TextureResource::get(std::uint32_t id)
 {
+    flushAsync();
+
     if (m_textures.count(id) == 0)
     {
         //find the fallback
@@ -114,6 +216,7 @@ Texture& TextureResource::get(const std::string& path, bool useMipMaps)
             return *m_fallbackTextures.at(m_fallbackColour);
         }
 
+        setEvictable(m_asyncState, *tex, path);
         auto id = fallbackID--;
         m_textures.insert(std::make_pair(id, std::make_pair(path, std::move(tex))));
         return *m_textures.at(id).second;
@@ -129,4 +232,88 @@ void TextureResource::setFallbackColour(Colour colour)
 Colour TextureResource::getFallbackColour() const
 {
     return m_fallbackColour;
-}
\ No newline at end of file
+}
+
+//private
+void TextureResource::flushAsync()
+{
+    if (!m_asyncState->loaded.empty())
+    {
+        for (auto& [id, texture] : m_asyncState->loaded)
+        {
+            setEvictable(m_asyncState, *texture.second, texture.first);
+            m_textures.insert(std::make_pair(id, std::move(texture)));
+        }
+        m_asyncState->loaded.clear();
+    }
+}
+
+void TextureResource::setEvictable(std::weak_ptr<AsyncState> weakState, Texture& texture, const std::string& path)
+{
+    //textures are held by pointer so their addresses remain valid for
+    //as long as the resource exists, which is checked via the AsyncState
+    auto* tex = &texture;
+    const bool mipmaps = texture.m_hasMipMaps;
+
+    auto evict = [tex]()
+    {
+        tex->evict();
+    };
+
+    auto restore = [weakState, tex, path, mipmaps]()
+    {
+        Detail::AsyncLoader::queueJob([weakState, tex, path, mipmaps]()
+            {
+                if (weakState.expired())
+                {
+                    return;
+                }
+
+                if (Detail::isCompressedImagePath(path))
+                {
+                    auto data = std::make_shared<Detail::CompressedImageData>();
+                    Detail::loadCompressedImage(path, *data); //prints any errors
+
+                    Detail::AsyncLoader::queueUpload([weakState, tex, data, path, mipmaps]()
+                        {
+                            auto state = weakState.lock();
+                            if (state)
+                            {
+                                if (!data->levels.empty()
+                                    && tex->loadFromCompressed(*data, mipmaps))
+                                {
+                                    setEvictable(state, *tex, path);
+                                }
+                                else
+                                {
+                                    Detail::TextureRegistry::restoreFailed(tex->getGLHandle());
+                                }
+                            }
+                        });
+                    return;
+                }
+
+                auto image = std::make_shared<Image>();
+                image->loadFromFile(path); //prints any errors
+
+                Detail::AsyncLoader::queueUpload([weakState, tex, image, path, mipmaps]()
+                    {
+                        auto state = weakState.lock();
+                        if (state)
+                        {
+                            if (image->getPixelData() != nullptr
+                                && tex->loadFromImage(*image, mipmaps))
+                            {
+                                setEvictable(state, *tex, path);
+                            }
+                            else
+                            {
+                                Detail::TextureRegistry::restoreFailed(tex->getGLHandle());
+                            }
+                        }
+                    });
+            });
+    };
+
+    Detail::TextureRegistry::setEvictable(texture.getGLHandle(), std::move(evict), std::move(restore));
+}
@@ -38,6 +38,7 @@ source distribution.
 #include <crogine/gui/Gui.hpp>
 
 #include <string>
+#include <thread>
 
 namespace
 {
@@ -96,22 +96,38 @@ namespace cro::Shaders::Text
             //FRAG_OUT = v_colour;
         })";
 
+    //used with fonts in distance field mode. Outlines and shadows
+    //are calculated here rather than with additional geometry
     static const std::string SDFFragment = R"(
         uniform sampler2D u_texture;
-                
+        uniform MED float u_smoothing;
+        uniform MED float u_outlineThickness;
+        uniform LOW vec4 u_outlineColour;
+        uniform LOW vec4 u_shadowColour;
+        uniform MED vec2 u_shadowOffset;
+
         VARYING_IN LOW vec4 v_colour;
-        VARYING_IN MED vec2 v_texCoord0;
+        VARYING_IN MED vec2 v_texCoord;
         OUTPUT
 
-        MED float spread = 4.0;
-        MED float scale = 5.0;
-        MED float smoothing = 1.0 / 16.0;
-
         void main()
         {
-            //smoothing = 0.25 / (spread * scale);
-            MED float value = TEXTURE(u_texture, v_texCoord0).r;
-            MED float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, value);
-            FRAG_OUT = vec4(v_colour.rgb, v_colour.a * alpha);
+            MED float dist = TEXTURE(u_texture, v_texCoord).a;
+
+            MED float fillAmount = smoothstep(0.5 - u_smoothing, 0.5 + u_smoothing, dist);
+            MED float edge = 0.5 - u_outlineThickness;
+            MED float outlineAmount = smoothstep(edge - u_smoothing, edge + u_smoothing, dist);
+
+            LOW vec4 textColour = mix(u_outlineColour, v_colour, fillAmount);
+            textColour.a *= outlineAmount;
+
+            MED float shadowDist = TEXTURE(u_texture, v_texCoord - u_shadowOffset).a;
+            LOW vec4 shadowColour = u_shadowColour;
+            shadowColour.a *= smoothstep(0.5 - u_smoothing, 0.5 + u_smoothing, shadowDist) * v_colour.a;
+
+            LOW float alpha = textColour.a + (shadowColour.a * (1.0 - textColour.a));
+            LOW vec3 colour = (textColour.rgb * textColour.a) + (shadowColour.rgb * shadowColour.a * (1.0 - textColour.a));
+
+            FRAG_OUT = vec4(colour / max(alpha, 0.0001), alpha);
         })";
 }
\ No newline at end of file
@@ -0,0 +1,379 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/network/BitStream.hpp>
+#include <crogine/detail/Assert.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+using namespace cro;
+
+namespace
+{
+    //largest possible value of the three smallest components
+    //of a normalised quaternion, 1/sqrt(2)
+    constexpr float QuatRange = 0.7071068f;
+
+    //calculated in double precision as a float can't represent every
+    //step count, and may round up past maxInt when converted
+    std::uint32_t quantiseFloat(float value, float min, float max, std::uint32_t maxInt)
+    {
+        if (std::isnan(value))
+        {
+            return 0;
+        }
+
+        const double normalised = (static_cast<double>(std::clamp(value, min, max)) - min) / (static_cast<double>(max) - min);
+        return static_cast<std::uint32_t>(std::min(std::round(normalised * maxInt), static_cast<double>(maxInt)));
+    }
+
+    float dequantiseFloat(std::uint32_t value, float min, float max, std::uint32_t maxInt)
+    {
+        return static_cast<float>(min + ((static_cast<double>(value) / maxInt) * (static_cast<double>(max) - min)));
+    }
+
+    //the step count is calculated the same way by both the reader and writer
+    //so that the number of bits always match
+    std::uint32_t getStepCount(float min, float max, float precision)
+    {
+        CRO_ASSERT(max > min, "Invalid range");
+        CRO_ASSERT(precision > 0, "Precision must be greater than zero");
+        const double steps = std::ceil(static_cast<double>(max - min) / static_cast<double>(precision));
+        return static_cast<std::uint32_t>(std::min(steps, static_cast<double>(std::numeric_limits<std::uint32_t>::max())));
+    }
+
+    std::uint32_t maxValue(std::uint32_t bitCount)
+    {
+        return bitCount == 32 ? 0xffffffff : (1u << bitCount) - 1;
+    }
+}
+
+//----------------------------//
+BitWriter::BitWriter(std::size_t reserve)
+    : m_bitPosition(0)
+{
+    m_buffer.reserve(reserve);
+}
+
+//public
+void BitWriter::writeBits(std::uint32_t value, std::uint32_t bitCount)
+{
+    CRO_ASSERT(bitCount > 0 && bitCount <= 32, "Bit count must be 1 - 32");
+
+    value &= maxValue(bitCount);
+    m_buffer.resize((m_bitPosition + bitCount + 7) / 8, 0);
+
+    //a value spans at most 5 bytes, so fill each in turn
+    while (bitCount)
+    {
+        const auto byteIndex = m_bitPosition / 8;
+        const auto bitOffset = static_cast<std::uint32_t>(m_bitPosition % 8);
+        const auto bitsThisByte = std::min(8u - bitOffset, bitCount);
+
+        m_buffer[byteIndex] |= static_cast<std::uint8_t>((value & maxValue(bitsThisByte)) << bitOffset);
+
+        value >>= bitsThisByte;
+        bitCount -= bitsThisByte;
+        m_bitPosition += bitsThisByte;
+    }
+}
+
+void BitWriter::writeBool(bool value)
+{
+    writeBits(value ? 1 : 0, 1);
+}
+
+void BitWriter::writeInt(std::int32_t value, std::int32_t min, std::int32_t max)
+{
+    CRO_ASSERT(max > min, "Invalid range");
+
+    const auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min);
+    const auto offset = static_cast<std::uint32_t>(static_cast<std::int64_t>(std::clamp(value, min, max)) - min);
+    writeBits(offset, bitsRequired(range));
+}
+
+void BitWriter::writeVarUInt(std::uint32_t value)
+{
+    //7 bits at a time, with the 8th set if more follow
+    while (value > 0x7f)
+    {
+        writeBits((value & 0x7f) | 0x80, 8);
+        value >>= 7;
+    }
+    writeBits(value, 8);
+}
+
+void BitWriter::writeVarInt(std::int32_t value)
+{
+    //zigzag encoding maps 0, -1, 1, -2... to 0, 1, 2, 3...
+    const auto zigzag = (static_cast<std::uint32_t>(value) << 1) ^ static_cast<std::uint32_t>(value >> 31);
+    writeVarUInt(zigzag);
+}
+
+void BitWriter::writeFloat(float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeBits(bits, 32);
+}
+
+void BitWriter::writeFloat(float value, float min, float max, float precision)
+{
+    const auto steps = getStepCount(min, max, precision);
+    writeBits(quantiseFloat(value, min, max, steps), bitsRequired(steps));
+}
+
+void BitWriter::writeVec3(glm::vec3 value, float min, float max, float precision)
+{
+    writeFloat(value.x, min, max, precision);
+    writeFloat(value.y, min, max, precision);
+    writeFloat(value.z, min, max, precision);
+}
+
+void BitWriter::writeQuat(glm::quat value, std::uint32_t bitsPerComponent)
+{
+    CRO_ASSERT(bitsPerComponent > 1 && bitsPerComponent < 16, "Invalid bit count");
+
+    const float components[] = { value.x, value.y, value.z, value.w };
+    std::uint32_t largest = 0;
+    for (auto i = 1u; i < 4u; ++i)
+    {
+        if (std::abs(components[i]) > std::abs(components[largest]))
+        {
+            largest = i;
+        }
+    }
+
+    //q and -q are the same rotation, so flip the sign if
+    //needed to make sure the omitted component is positive
+    const float sign = components[largest] < 0.f ? -1.f : 1.f;
+    const auto maxInt = maxValue(bitsPerComponent);
+
+    writeBits(largest, 2);
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        if (i != largest)
+        {
+            writeBits(quantiseFloat(components[i] * sign, -QuatRange, QuatRange, maxInt), bitsPerComponent);
+        }
+    }
+}
+
+void BitWriter::writeBytes(const void* data, std::size_t size)
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+    if (m_bitPosition % 8 == 0)
+    {
+        m_buffer.insert(m_buffer.end(), bytes, bytes + size);
+        m_bitPosition += size * 8;
+    }
+    else
+    {
+        for (auto i = 0u; i < size; ++i)
+        {
+            writeBits(bytes[i], 8);
+        }
+    }
+}
+
+void BitWriter::alignToByte()
+{
+    m_bitPosition = m_buffer.size() * 8;
+}
+
+void BitWriter::clear()
+{
+    m_buffer.clear();
+    m_bitPosition = 0;
+}
+
+//----------------------------//
+BitReader::BitReader(const void* data, std::size_t size)
+    : m_data        (static_cast<const std::uint8_t*>(data)),
+    m_size          (size),
+    m_bitPosition   (0),
+    m_overflow      (false)
+{
+    CRO_ASSERT(data || size == 0, "Data is nullptr");
+}
+
+//public
+std::uint32_t BitReader::readBits(std::uint32_t bitCount)
+{
+    CRO_ASSERT(bitCount > 0 && bitCount <= 32, "Bit count must be 1 - 32");
+
+    if (bitCount > getRemainingBits())
+    {
+        m_overflow = true;
+        m_bitPosition = m_size * 8;
+        return 0;
+    }
+
+    std::uint32_t value = 0;
+    std::uint32_t shift = 0;
+    while (bitCount)
+    {
+        const auto byteIndex = m_bitPosition / 8;
+        const auto bitOffset = static_cast<std::uint32_t>(m_bitPosition % 8);
+        const auto bitsThisByte = std::min(8u - bitOffset, bitCount);
+
+        const std::uint32_t bits = (m_data[byteIndex] >> bitOffset) & maxValue(bitsThisByte);
+        value |= bits << shift;
+
+        shift += bitsThisByte;
+        bitCount -= bitsThisByte;
+        m_bitPosition += bitsThisByte;
+    }
+    return value;
+}
+
+bool BitReader::readBool()
+{
+    return readBits(1) != 0;
+}
+
+std::int32_t BitReader::readInt(std::int32_t min, std::int32_t max)
+{
+    CRO_ASSERT(max > min, "Invalid range");
+
+    const auto range = static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min);
+    const auto offset = readBits(bitsRequired(range));
+    return static_cast<std::int32_t>(std::min(static_cast<std::int64_t>(min) + offset, static_cast<std::int64_t>(max)));
+}
+
+std::uint32_t BitReader::readVarUInt()
+{
+    std::uint32_t value = 0;
+    for (auto shift = 0u; shift < 35u; shift += 7)
+    {
+        const auto byte = readBits(8);
+        if (m_overflow)
+        {
+            //don't return part of a truncated value
+            return 0;
+        }
+        value |= (byte & 0x7f) << shift;
+
+        if ((byte & 0x80) == 0)
+        {
+            return value;
+        }
+    }
+
+    //more than 5 bytes is malformed
+    m_overflow = true;
+    return 0;
+}
+
+std::int32_t BitReader::readVarInt()
+{
+    const auto zigzag = readVarUInt();
+    return static_cast<std::int32_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+}
+
+float BitReader::readFloat()
+{
+    const auto bits = readBits(32);
+    float value = 0.f;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+float BitReader::readFloat(float min, float max, float precision)
+{
+    const auto steps = getStepCount(min, max, precision);
+    return dequantiseFloat(std::min(readBits(bitsRequired(steps)), steps), min, max, steps);
+}
+
+glm::vec3 BitReader::readVec3(float min, float max, float precision)
+{
+    glm::vec3 retVal;
+    retVal.x = readFloat(min, max, precision);
+    retVal.y = readFloat(min, max, precision);
+    retVal.z = readFloat(min, max, precision);
+    return retVal;
+}
+
+glm::quat BitReader::readQuat(std::uint32_t bitsPerComponent)
+{
+    CRO_ASSERT(bitsPerComponent > 1 && bitsPerComponent < 16, "Invalid bit count");
+
+    const auto maxInt = maxValue(bitsPerComponent);
+    const auto largest = readBits(2);
+
+    float components[4] = {};
+    float sum = 0.f;
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        if (i != largest)
+        {
+            components[i] = dequantiseFloat(readBits(bitsPerComponent), -QuatRange, QuatRange, maxInt);
+            sum += components[i] * components[i];
+        }
+    }
+    components[largest] = std::sqrt(std::max(0.f, 1.f - sum));
+
+    return glm::normalize(glm::quat(components[3], components[0], components[1], components[2]));
+}
+
+void BitReader::readBytes(void* dst, std::size_t size)
+{
+    auto* bytes = static_cast<std::uint8_t*>(dst);
+
+    if (m_bitPosition % 8 == 0)
+    {
+        if (size * 8 > getRemainingBits())
+        {
+            m_overflow = true;
+            m_bitPosition = m_size * 8;
+            std::memset(dst, 0, size);
+            return;
+        }
+
+        std::memcpy(bytes, m_data + (m_bitPosition / 8), size);
+        m_bitPosition += size * 8;
+    }
+    else
+    {
+        for (auto i = 0u; i < size; ++i)
+        {
+            bytes[i] = static_cast<std::uint8_t>(readBits(8));
+        }
+    }
+}
+
+void BitReader::alignToByte()
+{
+    m_bitPosition = std::min(((m_bitPosition + 7) / 8) * 8, m_size * 8);
+}
@@ -0,0 +1,245 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/network/InterestManager.hpp>
+#include <crogine/detail/Assert.hpp>
+#include <crogine/detail/glm/geometric.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace cro;
+
+InterestManager::InterestManager(float cellSize)
+    : m_cellSize(cellSize)
+{
+    CRO_ASSERT(cellSize > 0, "Cell size must be greater than zero");
+}
+
+//public
+void InterestManager::setEntity(std::uint32_t entityID, glm::vec3 position, std::uint32_t group, float priority)
+{
+    CRO_ASSERT(group < 32, "Group index must be 0 - 31");
+
+    auto& entity = m_entities[entityID];
+    entity.position = position;
+    entity.group = group;
+    entity.priority = priority;
+}
+
+void InterestManager::removeEntity(std::uint32_t entityID)
+{
+    m_entities.erase(entityID);
+    for (auto& peer : m_peers)
+    {
+        peer.priorities.erase(entityID);
+    }
+}
+
+void InterestManager::clearEntities()
+{
+    m_entities.clear();
+    m_cells.clear();
+    for (auto& peer : m_peers)
+    {
+        peer.priorities.clear();
+    }
+}
+
+void InterestManager::setPeer(const NetPeer& peer, const PeerInterest& interest)
+{
+    auto* info = getPeer(peer);
+    if (!info)
+    {
+        info = &m_peers.emplace_back();
+        info->peer = peer;
+    }
+    info->interest = interest;
+}
+
+void InterestManager::removePeer(const NetPeer& peer)
+{
+    m_peers.erase(std::remove_if(m_peers.begin(), m_peers.end(),
+        [&peer](const PeerInfo& info)
+        {
+            return info.peer == peer;
+        }), m_peers.end());
+}
+
+//private
+std::uint64_t InterestManager::getCellKey(std::int32_t x, std::int32_t z) const
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(z);
+}
+
+std::int32_t InterestManager::getCellCoord(float position) const
+{
+    //clamp to the range of the grid, so that very large or
+    //non-finite positions don't overflow when converted
+    const auto coord = std::floor(static_cast<double>(position) / m_cellSize);
+    if (std::isnan(coord))
+    {
+        return 0;
+    }
+    return static_cast<std::int32_t>(std::clamp(coord,
+        static_cast<double>(std::numeric_limits<std::int32_t>::min()),
+        static_cast<double>(std::numeric_limits<std::int32_t>::max())));
+}
+
+void InterestManager::update()
+{
+    //entities may have moved since the last update so rebuild the grid.
+    //cells are emptied rather than erased so their memory is reused,
+    //unless too many empty cells have built up
+    if (m_cells.size() > (m_entities.size() * 4) + 64)
+    {
+        m_cells.clear();
+    }
+    else
+    {
+        for (auto& [key, cell] : m_cells)
+        {
+            cell.clear();
+        }
+    }
+
+    for (const auto& [id, entity] : m_entities)
+    {
+        m_cells[getCellKey(getCellCoord(entity.position.x), getCellCoord(entity.position.z))].push_back(id);
+    }
+
+    for (auto& peer : m_peers)
+    {
+        updatePeer(peer);
+    }
+}
+
+void InterestManager::updatePeer(PeerInfo& peer)
+{
+    peer.relevant.clear();
+
+    const auto& interest = peer.interest;
+    const float radiusSqr = interest.radius * interest.radius;
+    auto isRelevant = [&](const EntityInfo& entity)
+    {
+        if ((interest.groups & (1u << entity.group)) == 0)
+        {
+            return false;
+        }
+
+        const auto diff = entity.position - interest.position;
+        return interest.radius <= 0 || glm::dot(diff, diff) <= radiusSqr;
+    };
+
+    //only search the grid if it covers fewer cells than are
+    //occupied, else it's quicker to test every entity
+    bool useGrid = interest.radius > 0;
+    std::int64_t minX = 0, maxX = 0, minZ = 0, maxZ = 0;
+    if (useGrid)
+    {
+        minX = getCellCoord(interest.position.x - interest.radius);
+        maxX = getCellCoord(interest.position.x + interest.radius);
+        minZ = getCellCoord(interest.position.z - interest.radius);
+        maxZ = getCellCoord(interest.position.z + interest.radius);
+
+        const auto cellCount = static_cast<double>(maxX - minX + 1) * static_cast<double>(maxZ - minZ + 1);
+        useGrid = cellCount <= static_cast<double>(m_cells.size());
+    }
+
+    if (useGrid)
+    {
+        for (auto x = minX; x <= maxX; ++x)
+        {
+            for (auto z = minZ; z <= maxZ; ++z)
+            {
+                auto cell = m_cells.find(getCellKey(static_cast<std::int32_t>(x), static_cast<std::int32_t>(z)));
+                if (cell == m_cells.end())
+                {
+                    continue;
+                }
+
+                for (auto id : cell->second)
+                {
+                    if (isRelevant(m_entities.at(id)))
+                    {
+                        peer.relevant.push_back(id);
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        for (const auto& [id, entity] : m_entities)
+        {
+            if (isRelevant(entity))
+            {
+                peer.relevant.push_back(id);
+            }
+        }
+    }
+
+    std::sort(peer.relevant.begin(), peer.relevant.end());
+}
+
+InterestManager::PeerInfo* InterestManager::getPeer(const NetPeer& peer)
+{
+    auto result = std::find_if(m_peers.begin(), m_peers.end(), [&peer](const PeerInfo& info) {return info.peer == peer; });
+    return result == m_peers.end() ? nullptr : &*result;
+}
+
+bool InterestManager::isRegistered(std::uint32_t entityID) const
+{
+    return m_entities.count(entityID) != 0;
+}
+
+float InterestManager::accumulatePriority(PeerInfo& peer, std::uint32_t entityID) const
+{
+    //unregistered entities are treated as having a priority of 1
+    float weight = 1.f;
+
+    auto entity = m_entities.find(entityID);
+    if (entity != m_entities.end())
+    {
+        weight = entity->second.priority;
+
+        //closer entities accumulate up to twice as quickly
+        if (peer.interest.radius > 0)
+        {
+            const float distance = glm::length(entity->second.position - peer.interest.position);
+            weight *= 2.f - std::min(1.f, distance / peer.interest.radius);
+        }
+    }
+
+    auto& priority = peer.priorities[entityID];
+    priority += weight;
+    return priority;
+}
@@ -229,25 +229,17 @@ void NetClient::sendPacket(std::uint8_t id, const void* data, std::size_t size,
 {
     if (m_peer.m_peer)
     {
-        std::int32_t packetFlags = 0;
-        if (flags == NetFlag::Reliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_RELIABLE;
-        }
-        else if (flags == NetFlag::Unreliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
-        }
-        else if (flags == NetFlag::Unsequenced)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
-        }
-        
-        ENetPacket* packet = enet_packet_create(&id, sizeof(std::uint8_t), packetFlags);
-        enet_packet_resize(packet, sizeof(std::uint8_t) + size);
-        std::memcpy(&packet->data[sizeof(std::uint8_t)], data, size);
+        NetPacket packet(id, size, flags);
+        packet.write(data, size);
+        sendPacket(packet, channel);
+    }
+}
 
-        enet_peer_send(m_peer.m_peer, channel, packet);
+void NetClient::sendPacket(const NetPacket& packet, std::uint8_t channel) const
+{
+    if (m_peer.m_peer && packet.m_packet)
+    {
+        enet_peer_send(m_peer.m_peer, channel, packet.m_packet);
     }
 }
 
@@ -32,14 +32,137 @@ source distribution.
 #include "../detail/enet/enet/enet.h"
 #include <crogine/core/Log.hpp>
 
+#include <array>
+#include <cstdlib>
+#include <mutex>
+
 using namespace cro;
 
+namespace
+{
+    //ENet allocates a packet, its data and the commands which queue it
+    //for every packet sent or received. Small blocks such as these are
+    //recycled through free lists rather than returned to the system.
+    class BlockPool final
+    {
+    public:
+        BlockPool() = default;
+        ~BlockPool()
+        {
+            for (auto& list : m_freeLists)
+            {
+                while (list.head)
+                {
+                    auto* next = *static_cast<void**>(list.head);
+                    std::free(static_cast<std::uint8_t*>(list.head) - HeaderSize);
+                    list.head = next;
+                }
+            }
+        }
+
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator = (const BlockPool&) = delete;
+
+        void* allocate(std::size_t size)
+        {
+            std::size_t index = 0;
+            while (index < BlockSizes.size()
+                && BlockSizes[index] < size)
+            {
+                index++;
+            }
+
+            if (index < BlockSizes.size())
+            {
+                auto& list = m_freeLists[index];
+                std::scoped_lock lock(list.mutex);
+                if (list.head)
+                {
+                    auto* block = list.head;
+                    list.head = *static_cast<void**>(block);
+                    list.count--;
+                    return block;
+                }
+                size = BlockSizes[index];
+            }
+
+            //the header stores which list the block belongs to and is
+            //large enough to keep the returned memory aligned as malloc's
+            auto* memory = static_cast<std::uint8_t*>(std::malloc(size + HeaderSize));
+            if (!memory)
+            {
+                return nullptr;
+            }
+
+            *memory = static_cast<std::uint8_t>(index);
+            return memory + HeaderSize;
+        }
+
+        void free(void* block)
+        {
+            if (!block)
+            {
+                return;
+            }
+
+            auto* memory = static_cast<std::uint8_t*>(block) - HeaderSize;
+            const auto index = *memory;
+
+            if (index < BlockSizes.size())
+            {
+                auto& list = m_freeLists[index];
+                std::scoped_lock lock(list.mutex);
+                if (list.count < MaxFreeBlocks)
+                {
+                    *static_cast<void**>(block) = list.head;
+                    list.head = block;
+                    list.count++;
+                    return;
+                }
+            }
+
+            std::free(memory);
+        }
+
+    private:
+        static constexpr std::size_t HeaderSize = 16;
+        static constexpr std::array<std::size_t, 7u> BlockSizes = { 32, 64, 128, 256, 512, 1024, 2048 };
+        static constexpr std::size_t MaxFreeBlocks = 1024; //per block size
+
+        //hosts may be serviced on different threads, so each list is locked
+        struct FreeList final
+        {
+            std::mutex mutex;
+            void* head = nullptr;
+            std::size_t count = 0;
+        };
+        std::array<FreeList, BlockSizes.size()> m_freeLists = {};
+    };
+
+    //declared before the NetConf instance so that it's destroyed after it
+    BlockPool blockPool;
+
+    void* ENET_CALLBACK poolMalloc(std::size_t size)
+    {
+        return blockPool.allocate(size);
+    }
+
+    void ENET_CALLBACK poolFree(void* memory)
+    {
+        blockPool.free(memory);
+    }
+}
+
 std::unique_ptr<NetConf> NetConf::instance;
 
 NetConf::NetConf()
     : m_initOK(false)
 {
-    if (enet_initialize() == 0)
+    ENetCallbacks callbacks = {};
+    callbacks.malloc = &poolMalloc;
+    callbacks.free = &poolFree;
+
+    if (enet_initialize_with_callbacks(ENET_VERSION, &callbacks) == 0)
     {
         m_initOK = true;
     }
@@ -92,6 +92,12 @@ std::size_t NetEvent::Packet::getSize() const
     return m_packet->dataLength - sizeof(std::uint8_t);
 }
 
+NetPacketView NetEvent::Packet::getView() const
+{
+    CRO_ASSERT(m_packet, "Not a valid packet instance");
+    return NetPacketView(getData(), getSize());
+}
+
 //private
 void NetEvent::Packet::setPacketData(ENetPacket* packet)
 {
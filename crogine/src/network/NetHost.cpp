@@ -38,32 +38,6 @@ source distribution.
 
 using namespace cro;
 
-namespace
-{
-    ENetPacket* createPacket(std::uint8_t id, const void* data, std::size_t size, NetFlag flags)
-    {
-        std::int32_t packetFlags = 0;
-        if (flags == NetFlag::Reliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_RELIABLE;
-        }
-        else if (flags == NetFlag::Unreliable)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
-        }
-        else if (flags == NetFlag::Unsequenced)
-        {
-            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
-        }
-
-        ENetPacket* packet = enet_packet_create(&id, sizeof(std::uint8_t), packetFlags);
-        enet_packet_resize(packet, sizeof(std::uint8_t) + size);
-        std::memcpy(&packet->data[sizeof(std::uint8_t)], data, size);
-
-        return packet;
-    }
-}
-
 NetHost::NetHost()
     : m_host    (nullptr)
 {
@@ -202,7 +176,9 @@ void NetHost::broadcastPacket(std::uint8_t id, const void* data, std::size_t siz
 {
     if (m_host)
     {
-        enet_host_broadcast(m_host, channel, createPacket(id, data, size, flags));
+        NetPacket packet(id, size, flags);
+        packet.write(data, size);
+        broadcastPacket(packet, channel);
     }
 }
 
@@ -210,7 +186,25 @@ void NetHost::sendPacket(const NetPeer& peer, std::uint8_t id, const void* data,
 {
     if (peer.m_peer)
     {
-        enet_peer_send(peer.m_peer, channel, createPacket(id, data, size, flags));
+        NetPacket packet(id, size, flags);
+        packet.write(data, size);
+        sendPacket(peer, packet, channel);
+    }
+}
+
+void NetHost::sendPacket(const NetPeer& peer, const NetPacket& packet, std::uint8_t channel) const
+{
+    if (peer.m_peer && packet.m_packet)
+    {
+        enet_peer_send(peer.m_peer, channel, packet.m_packet);
+    }
+}
+
+void NetHost::broadcastPacket(const NetPacket& packet, std::uint8_t channel) const
+{
+    if (m_host && packet.m_packet)
+    {
+        enet_host_broadcast(m_host, channel, packet.m_packet);
     }
 }
 
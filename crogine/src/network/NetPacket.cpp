@@ -0,0 +1,183 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include "../detail/enet/enet/enet.h"
+
+#include <crogine/network/NetData.hpp>
+
+using namespace cro;
+
+namespace
+{
+    std::uint32_t getPacketFlags(NetFlag flags)
+    {
+        std::uint32_t packetFlags = 0;
+        if (flags == NetFlag::Reliable)
+        {
+            packetFlags |= ENET_PACKET_FLAG_RELIABLE;
+        }
+        else if (flags == NetFlag::Unreliable)
+        {
+            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT;
+        }
+        else if (flags == NetFlag::Unsequenced)
+        {
+            packetFlags |= ENET_PACKET_FLAG_UNRELIABLE_FRAGMENT | ENET_PACKET_FLAG_UNSEQUENCED;
+        }
+        return packetFlags;
+    }
+}
+
+NetPacket::NetPacket(std::uint8_t id, std::size_t size, NetFlag flags)
+    : m_packet  (nullptr),
+    m_position  (0)
+{
+    //passing no data allocates the packet without copying anything into it
+    m_packet = enet_packet_create(nullptr, sizeof(std::uint8_t) + size, getPacketFlags(flags));
+    if (m_packet)
+    {
+        m_packet->data[0] = id;
+
+        //we hold our own reference so that ENet doesn't destroy
+        //the packet once it's sent while we still point to it
+        m_packet->referenceCount++;
+    }
+}
+
+NetPacket::~NetPacket()
+{
+    if (m_packet
+        && --m_packet->referenceCount == 0)
+    {
+        enet_packet_destroy(m_packet);
+    }
+}
+
+NetPacket::NetPacket(NetPacket&& other) noexcept
+    : m_packet  (other.m_packet),
+    m_position  (other.m_position)
+{
+    other.m_packet = nullptr;
+    other.m_position = 0;
+}
+
+NetPacket& NetPacket::operator=(NetPacket&& other) noexcept
+{
+    if (&other != this)
+    {
+        if (m_packet
+            && --m_packet->referenceCount == 0)
+        {
+            enet_packet_destroy(m_packet);
+        }
+
+        m_packet = other.m_packet;
+        m_position = other.m_position;
+
+        other.m_packet = nullptr;
+        other.m_position = 0;
+    }
+    return *this;
+}
+
+//public
+std::uint8_t NetPacket::getID() const
+{
+    CRO_ASSERT(m_packet, "Not a valid packet instance");
+    return m_packet->data[0];
+}
+
+void* NetPacket::getData()
+{
+    CRO_ASSERT(m_packet, "Not a valid packet instance");
+    CRO_ASSERT(m_packet->referenceCount == 1, "Packet has already been sent");
+    return &m_packet->data[sizeof(std::uint8_t)];
+}
+
+const void* NetPacket::getData() const
+{
+    CRO_ASSERT(m_packet, "Not a valid packet instance");
+    return &m_packet->data[sizeof(std::uint8_t)];
+}
+
+std::size_t NetPacket::getSize() const
+{
+    CRO_ASSERT(m_packet, "Not a valid packet instance");
+    return m_packet->dataLength - sizeof(std::uint8_t);
+}
+
+bool NetPacket::write(const void* data, std::size_t size)
+{
+    if (!m_packet
+        || m_position + size > getSize())
+    {
+        return false;
+    }
+
+    if (size == 0)
+    {
+        return true;
+    }
+
+    std::memcpy(static_cast<std::uint8_t*>(getData()) + m_position, data, size);
+    m_position += size;
+    return true;
+}
+
+NetPacketView::NetPacketView(const void* data, std::size_t size)
+    : m_data    (static_cast<const std::uint8_t*>(data)),
+    m_size      (data ? size : 0),
+    m_position  (0)
+{
+
+}
+
+bool NetPacketView::read(void* dst, std::size_t size)
+{
+    if (size > getRemaining())
+    {
+        return false;
+    }
+
+    std::memcpy(dst, m_data + m_position, size);
+    m_position += size;
+    return true;
+}
+
+bool NetPacketView::skip(std::size_t size)
+{
+    if (size > getRemaining())
+    {
+        return false;
+    }
+
+    m_position += size;
+    return true;
+}
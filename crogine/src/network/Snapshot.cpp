@@ -0,0 +1,575 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+#include <crogine/network/Snapshot.hpp>
+#include <crogine/network/BitStream.hpp>
+#include <crogine/network/InterestManager.hpp>
+#include <crogine/network/NetClient.hpp>
+#include <crogine/network/NetHost.hpp>
+#include <crogine/core/Log.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace cro;
+
+namespace
+{
+    const Detail::Snapshot EmptySnapshot;
+
+    std::size_t getStride(std::size_t stateSize)
+    {
+        return ((stateSize + 3) / 4) * 4;
+    }
+
+    //number of bits used by BitWriter::writeVarUInt() to write an ID. This
+    //is an upper bound when estimating the size of a snapshot, as IDs are
+    //actually written as the difference from the previous ID
+    std::size_t getVarUIntBits(std::uint32_t value)
+    {
+        std::size_t bits = 8;
+        while (value > 0x7f)
+        {
+            bits += 8;
+            value >>= 7;
+        }
+        return bits;
+    }
+
+    //writes the words of state which differ from baseline, preceded by a bit per word
+    void writeState(BitWriter& writer, const std::uint8_t* state, const std::uint8_t* baseline, std::size_t stride)
+    {
+        for (auto i = 0u; i < stride; i += 4)
+        {
+            std::uint32_t word = 0;
+            std::uint32_t baseWord = 0;
+            std::memcpy(&word, state + i, 4);
+            std::memcpy(&baseWord, baseline + i, 4);
+
+            writer.writeBool(word != baseWord);
+            if (word != baseWord)
+            {
+                writer.writeBits(word, 32);
+            }
+        }
+    }
+}
+
+std::size_t Detail::Snapshot::find(std::uint32_t id) const
+{
+    auto result = std::lower_bound(ids.begin(), ids.end(), id);
+    if (result != ids.end() && *result == id)
+    {
+        return std::distance(ids.begin(), result);
+    }
+    return ids.size();
+}
+
+void Detail::Snapshot::clear()
+{
+    sequence = 0;
+    ids.clear();
+    data.clear();
+}
+
+//----------------------------//
+SnapshotHost::SnapshotHost(std::size_t stateSize, std::uint8_t snapshotID, std::uint8_t ackID, std::size_t historySize)
+    : m_stateSize   (stateSize),
+    m_stride        (getStride(stateSize)),
+    m_snapshotID    (snapshotID),
+    m_ackID         (ackID),
+    m_historySize   (historySize),
+    m_sequence      (0),
+    m_lastSendSize  (0)
+{
+    CRO_ASSERT(stateSize > 0, "Invalid state size");
+    CRO_ASSERT(snapshotID != ackID, "Snapshot and acknowledgement packets need unique IDs");
+    CRO_ASSERT(historySize > 1, "History size must be at least 2");
+
+    m_zeroState.resize(m_stride, 0);
+}
+
+//public
+void SnapshotHost::setState(std::uint32_t entityID, const void* state)
+{
+    auto& ids = m_currentState.ids;
+    auto result = std::lower_bound(ids.begin(), ids.end(), entityID);
+    auto index = std::distance(ids.begin(), result);
+
+    if (result == ids.end() || *result != entityID)
+    {
+        ids.insert(result, entityID);
+        m_currentState.data.insert(m_currentState.data.begin() + (index * m_stride), m_stride, 0);
+    }
+    std::memcpy(m_currentState.data.data() + (index * m_stride), state, m_stateSize);
+}
+
+void SnapshotHost::removeEntity(std::uint32_t entityID)
+{
+    auto index = m_currentState.find(entityID);
+    if (index < m_currentState.ids.size())
+    {
+        m_currentState.ids.erase(m_currentState.ids.begin() + index);
+
+        auto start = m_currentState.data.begin() + (index * m_stride);
+        m_currentState.data.erase(start, start + m_stride);
+    }
+}
+
+void SnapshotHost::clearEntities()
+{
+    m_currentState.ids.clear();
+    m_currentState.data.clear();
+}
+
+void SnapshotHost::addPeer(const NetPeer& peer)
+{
+    auto result = std::find_if(m_peers.begin(), m_peers.end(), [&peer](const PeerState& ps) {return ps.peer == peer; });
+    if (result == m_peers.end())
+    {
+        auto& ps = m_peers.emplace_back();
+        ps.peer = peer;
+        ps.history.resize(m_historySize);
+    }
+}
+
+void SnapshotHost::removePeer(const NetPeer& peer)
+{
+    m_peers.erase(std::remove_if(m_peers.begin(), m_peers.end(), 
+        [&peer](const PeerState& ps) 
+        {
+            return ps.peer == peer;
+        }), m_peers.end());
+}
+
+bool SnapshotHost::handleEvent(const NetEvent& evt)
+{
+    if (evt.type == NetEvent::PacketReceived
+        && evt.packet.getID() == m_ackID)
+    {
+        std::uint32_t sequence = 0;
+        if (evt.packet.getView().read(sequence))
+        {
+            auto result = std::find_if(m_peers.begin(), m_peers.end(), [&evt](const PeerState& ps) {return ps.peer == evt.peer; });
+            if (result != m_peers.end()
+                && sequence > result->lastAck
+                && sequence <= m_sequence)
+            {
+                result->lastAck = sequence;
+            }
+        }
+        return true;
+    }
+    else if (evt.type == NetEvent::ClientDisconnect)
+    {
+        removePeer(evt.peer);
+    }
+    return false;
+}
+
+void SnapshotHost::send(NetHost& host, std::uint8_t channel)
+{
+    sendSnapshots(host, nullptr, channel);
+}
+
+void SnapshotHost::send(NetHost& host, InterestManager& interest, std::uint8_t channel)
+{
+    interest.update();
+    sendSnapshots(host, &interest, channel);
+}
+
+//private
+void SnapshotHost::sendSnapshots(NetHost& host, InterestManager* interest, std::uint8_t channel)
+{
+    m_sequence++;
+    m_currentState.sequence = m_sequence;
+    m_lastSendSize = 0;
+
+    BitWriter writer(256);
+    for (auto& peer : m_peers)
+    {
+        //use the most recent acknowledged snapshot as the baseline if
+        //we still have it, else fall back to sending the full state
+        const Detail::Snapshot* baseline = &EmptySnapshot;
+        if (peer.lastAck != 0
+            && m_sequence - peer.lastAck < m_historySize
+            && peer.history[peer.lastAck % m_historySize].sequence == peer.lastAck)
+        {
+            baseline = &peer.history[peer.lastAck % m_historySize];
+        }
+
+        //this is what the peer will have once it receives the snapshot,
+        //so it becomes the baseline for future snapshots once acknowledged
+        auto& state = peer.history[m_sequence % m_historySize];
+        if (!interest
+            || !buildPeerState(*interest, peer.peer, *baseline, state))
+        {
+            state = m_currentState;
+        }
+        state.sequence = m_sequence;
+
+        writer.clear();
+        encode(writer, state, *baseline);
+
+        host.sendPacket(peer.peer, m_snapshotID, writer.getData(), writer.getSize(), NetFlag::Unreliable, channel);
+        m_lastSendSize += writer.getSize();
+    }
+}
+
+bool SnapshotHost::buildPeerState(InterestManager& interest, const NetPeer& peer, const Detail::Snapshot& baseline, Detail::Snapshot& dst)
+{
+    auto* info = interest.getPeer(peer);
+    if (!info)
+    {
+        return false;
+    }
+
+    const auto& relevant = info->relevant;
+    const auto& current = m_currentState;
+    const auto wordCount = m_stride / 4;
+
+    //header and end of list
+    std::size_t bitCount = 32 + 40 + 1;
+
+    m_entries.clear();
+    m_pending.clear();
+
+    std::size_t j = 0;
+    for (auto i = 0u; i < current.ids.size(); ++i)
+    {
+        const auto id = current.ids[i];
+        if (interest.isRegistered(id)
+            && !std::binary_search(relevant.begin(), relevant.end(), id))
+        {
+            continue;
+        }
+
+        //anything skipped in the baseline will be removed
+        while (j < baseline.ids.size() && baseline.ids[j] < id)
+        {
+            bitCount += 2 + getVarUIntBits(baseline.ids[j++]);
+        }
+
+        auto& entry = m_entries.emplace_back();
+        entry.id = id;
+        entry.state = current.data.data() + (i * m_stride);
+
+        if (j < baseline.ids.size() && baseline.ids[j] == id)
+        {
+            entry.baseState = baseline.data.data() + (j * m_stride);
+            j++;
+
+            if (std::memcmp(entry.state, entry.baseState, m_stride) == 0)
+            {
+                continue;
+            }
+        }
+
+        if (info->interest.bandwidthBudget != 0)
+        {
+            const auto* baseState = entry.baseState ? entry.baseState : m_zeroState.data();
+            entry.bitCount = 2 + getVarUIntBits(id) + wordCount;
+            for (auto k = 0u; k < m_stride; k += 4)
+            {
+                if (std::memcmp(entry.state + k, baseState + k, 4) != 0)
+                {
+                    entry.bitCount += 32;
+                }
+            }
+            entry.priority = interest.accumulatePriority(*info, id);
+            m_pending.push_back(m_entries.size() - 1);
+        }
+    }
+
+    while (j < baseline.ids.size())
+    {
+        bitCount += 2 + getVarUIntBits(baseline.ids[j++]);
+    }
+
+    //send changed entities in order of priority until the budget is used.
+    //those which don't fit keep the state the peer already has, and are
+    //left out entirely if the peer hasn't received them yet
+    if (!m_pending.empty())
+    {
+        std::sort(m_pending.begin(), m_pending.end(),
+            [&](std::size_t a, std::size_t b)
+            {
+                return m_entries[a].priority > m_entries[b].priority;
+            });
+
+        const auto budget = info->interest.bandwidthBudget * 8;
+        for (auto k = 0u; k < m_pending.size(); ++k)
+        {
+            auto& entry = m_entries[m_pending[k]];
+
+            //always send at least one entity so nothing is starved by a small budget
+            if (k == 0 || bitCount + entry.bitCount <= budget)
+            {
+                bitCount += entry.bitCount;
+                info->priorities.erase(entry.id);
+            }
+            else
+            {
+                entry.state = entry.baseState;
+            }
+        }
+    }
+
+    dst.ids.clear();
+    dst.data.clear();
+    for (const auto& entry : m_entries)
+    {
+        if (entry.state)
+        {
+            dst.ids.push_back(entry.id);
+            dst.data.insert(dst.data.end(), entry.state, entry.state + m_stride);
+        }
+    }
+
+    return true;
+}
+
+void SnapshotHost::encode(BitWriter& writer, const Detail::Snapshot& state, const Detail::Snapshot& baseline) const
+{
+    writer.writeBits(state.sequence, 32);
+    writer.writeVarUInt(baseline.sequence == 0 ? 0 : state.sequence - baseline.sequence);
+
+    //walk both sorted ID lists at once, writing added, changed and removed entities.
+    //each entry is preceded by a single bit, with a 0 bit marking the end of the list
+    std::uint32_t prevID = 0;
+    auto writeID = [&](std::uint32_t id, bool removed)
+    {
+        writer.writeBool(true);
+        writer.writeVarUInt(id - prevID);
+        writer.writeBool(removed);
+        prevID = id;
+    };
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < state.ids.size() || j < baseline.ids.size())
+    {
+        if (j == baseline.ids.size()
+            || (i < state.ids.size() && state.ids[i] < baseline.ids[j]))
+        {
+            //added
+            writeID(state.ids[i], false);
+            writeState(writer, state.data.data() + (i * m_stride), m_zeroState.data(), m_stride);
+            i++;
+        }
+        else if (i == state.ids.size()
+            || baseline.ids[j] < state.ids[i])
+        {
+            //removed
+            writeID(baseline.ids[j], true);
+            j++;
+        }
+        else
+        {
+            const auto* current = state.data.data() + (i * m_stride);
+            const auto* baseState = baseline.data.data() + (j * m_stride);
+            if (std::memcmp(current, baseState, m_stride) != 0)
+            {
+                writeID(state.ids[i], false);
+                writeState(writer, current, baseState, m_stride);
+            }
+            i++;
+            j++;
+        }
+    }
+    writer.writeBool(false);
+}
+
+//----------------------------//
+SnapshotClient::SnapshotClient(std::size_t stateSize, std::uint8_t snapshotID, std::uint8_t ackID, std::size_t historySize)
+    : m_stateSize   (stateSize),
+    m_stride        (getStride(stateSize)),
+    m_snapshotID    (snapshotID),
+    m_ackID         (ackID),
+    m_current       (0)
+{
+    CRO_ASSERT(stateSize > 0, "Invalid state size");
+    CRO_ASSERT(snapshotID != ackID, "Snapshot and acknowledgement packets need unique IDs");
+    CRO_ASSERT(historySize > 1, "History size must be at least 2");
+
+    m_history.resize(historySize);
+}
+
+//public
+bool SnapshotClient::handleEvent(const NetEvent& evt, NetClient& client)
+{
+    if (evt.type != NetEvent::PacketReceived
+        || evt.packet.getID() != m_snapshotID)
+    {
+        return false;
+    }
+
+    BitReader reader(evt.packet.getData(), evt.packet.getSize());
+    const auto sequence = reader.readBits(32);
+    const auto baseOffset = reader.readVarUInt();
+
+    //ignore snapshots arriving out of order
+    if (reader.overflowed()
+        || sequence <= getSequence())
+    {
+        return false;
+    }
+
+    const Detail::Snapshot* baseline = &EmptySnapshot;
+    if (baseOffset != 0)
+    {
+        const auto baseSequence = sequence - baseOffset;
+        baseline = &m_history[baseSequence % m_history.size()];
+
+        if (baseline->sequence != baseSequence)
+        {
+            //we no longer have the baseline, so wait until the
+            //host falls back to sending the full state
+            return false;
+        }
+    }
+
+    if (!decode(reader, *baseline, m_decodeBuffer))
+    {
+        LogW << "Received malformed snapshot " << sequence << std::endl;
+        return false;
+    }
+
+    m_current = sequence % m_history.size();
+    m_decodeBuffer.sequence = sequence;
+    std::swap(m_history[m_current], m_decodeBuffer);
+
+    client.sendPacket(m_ackID, sequence, NetFlag::Unreliable, evt.channel);
+    return true;
+}
+
+std::uint32_t SnapshotClient::getSequence() const
+{
+    return m_history[m_current].sequence;
+}
+
+const std::vector<std::uint32_t>& SnapshotClient::getEntityIDs() const
+{
+    return m_history[m_current].ids;
+}
+
+bool SnapshotClient::getState(std::uint32_t entityID, void* dst) const
+{
+    const auto& snapshot = m_history[m_current];
+    auto index = snapshot.find(entityID);
+    if (index < snapshot.ids.size())
+    {
+        std::memcpy(dst, snapshot.data.data() + (index * m_stride), m_stateSize);
+        return true;
+    }
+    return false;
+}
+
+void SnapshotClient::reset()
+{
+    for (auto& snapshot : m_history)
+    {
+        snapshot.clear();
+    }
+    m_current = 0;
+}
+
+//private
+bool SnapshotClient::decode(BitReader& reader, const Detail::Snapshot& baseline, Detail::Snapshot& dst)
+{
+    dst.clear();
+
+    auto copyBaseline = [&](std::size_t index)
+    {
+        dst.ids.push_back(baseline.ids[index]);
+        auto start = baseline.data.begin() + (index * m_stride);
+        dst.data.insert(dst.data.end(), start, start + m_stride);
+    };
+
+    std::uint32_t id = 0;
+    std::size_t j = 0;
+    while (reader.readBool())
+    {
+        const auto offset = reader.readVarUInt();
+        if (offset == 0 && !dst.ids.empty())
+        {
+            return false;
+        }
+        id += offset;
+
+        //anything skipped in the baseline is unchanged
+        while (j < baseline.ids.size() && baseline.ids[j] < id)
+        {
+            copyBaseline(j++);
+        }
+
+        const std::uint8_t* baseState = nullptr;
+        if (j < baseline.ids.size() && baseline.ids[j] == id)
+        {
+            baseState = baseline.data.data() + (j * m_stride);
+            j++;
+        }
+
+        if (reader.readBool())
+        {
+            //removed
+            continue;
+        }
+
+        dst.ids.push_back(id);
+        dst.data.resize(dst.data.size() + m_stride, 0);
+        auto* state = dst.data.data() + (dst.data.size() - m_stride);
+        if (baseState)
+        {
+            std::memcpy(state, baseState, m_stride);
+        }
+
+        for (auto i = 0u; i < m_stride; i += 4)
+        {
+            if (reader.readBool())
+            {
+                const auto word = reader.readBits(32);
+                std::memcpy(state + i, &word, 4);
+            }
+        }
+
+        if (reader.overflowed())
+        {
+            return false;
+        }
+    }
+
+    while (j < baseline.ids.size())
+    {
+        copyBaseline(j++);
+    }
+
+    return !reader.overflowed();
+}
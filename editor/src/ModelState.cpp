@@ -92,6 +92,7 @@ ModelState::ModelState(cro::StateStack& stack, cro::State::Context context, Shar
     m_showBakingWindow      (false),
     m_useFreecam            (false),
     m_exportAnimation       (true),
+    m_exportQuantised       (false),
     m_skeletonMeshID        (0),
     m_browseGLTF            (false),
     m_showAABB              (false),
@@ -927,6 +928,9 @@ void ModelState::bakeLightmap()
     normalOffset *= sizeof(float);
     uvOffset *= sizeof(float);
 
+    //vertex data was read back as floats so may not match the stored vertex size
+    const auto vertexSize = static_cast<std::int32_t>(cro::Mesh::getFloatVertexSize(meshData));
+
     cro::Clock timer; //push progress update
 
     //std::int32_t bounces = 2;
@@ -941,9 +945,9 @@ void ModelState::bakeLightmap()
             lmSetTargetLightmap(ctx, m_lightmapBuffers[i].data(), LightmapSize, LightmapSize, 3);
 
             lmSetGeometry(ctx, &modelMatrix[0][0],
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data(), meshData.vertexSize, //position
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + normalOffset, meshData.vertexSize, //normal
-                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + uvOffset, meshData.vertexSize, //UV - TODO select which set to use
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data(), vertexSize, //position
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + normalOffset, vertexSize, //normal
+                LM_FLOAT, (uint8_t*)m_modelProperties.vertexData.data() + uvOffset, vertexSize, //UV - TODO select which set to use
                 meshData.indexData[i].indexCount, GL_UNSIGNED_INT, m_modelProperties.indexData[i].data());
 
             GLint vp[4];            
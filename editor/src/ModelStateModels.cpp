@@ -91,6 +91,10 @@ void ModelState::openModelAtPath(const std::string& path)
 
     closeModel();
 
+    //the definition may have been modified since it was last
+    //opened so make sure we don't use a cached version
+    m_resources.modelDefinitions.clear();
+
     cro::ModelDefinition def(m_resources, &m_environmentMap, m_sharedData.workingDirectory);
     if (def.loadFromFile(path, m_useDeferred))
     {
@@ -1001,7 +1005,7 @@ void ModelState::exportModel(bool modelOnly, bool openOnSave)
 
         //write binary file
         bool animated = m_exportAnimation && m_importedHeader.animated;
-        if (cro::Detail::ModelBinary::write(m_entities[EntityID::ActiveModel], path, animated))
+        if (cro::Detail::ModelBinary::write(m_entities[EntityID::ActiveModel], path, animated, m_exportQuantised))
         {
             //create config file and save as cmt
             auto modelName = cro::FileSystem::getFileName(path);
@@ -1151,48 +1155,6 @@ void ModelState::applyImportTransform()
 
 void ModelState::readBackVertexData(cro::Mesh::Data meshData, std::vector<float>& destVerts, std::vector<std::vector<std::uint32_t>>& destIndices)
 {
-    destVerts.clear();
-    destVerts.resize(meshData.vertexCount * (meshData.vertexSize / sizeof(float)));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, meshData.vbo));
-    glCheck(glGetBufferSubData(GL_ARRAY_BUFFER, 0, meshData.vertexCount * meshData.vertexSize, destVerts.data()));
-    glCheck(glBindBuffer(GL_ARRAY_BUFFER, 0));
-
-    destIndices.clear();
-    destIndices.resize(meshData.submeshCount);
-
-    for (auto i = 0u; i < meshData.submeshCount; ++i)
-    {
-        destIndices[i].resize(meshData.indexData[i].indexCount);
-        glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.indexData[i].ibo));
-
-        //fudgy kludge for different index types
-        switch (meshData.indexData[i].format)
-        {
-        default: break;
-        case GL_UNSIGNED_BYTE:
-        {
-            std::vector<std::uint8_t> temp(meshData.indexData[i].indexCount);
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount, temp.data()));
-            for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-            {
-                destIndices[i][j] = temp[j];
-            }
-        }
-        break;
-        case GL_UNSIGNED_SHORT:
-        {
-            std::vector<std::uint16_t> temp(meshData.indexData[i].indexCount);
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint16_t), temp.data()));
-            for (auto j = 0u; j < meshData.indexData[i].indexCount; ++j)
-            {
-                destIndices[i][j] = temp[j];
-            }
-        }
-        break;
-        case GL_UNSIGNED_INT:
-            glCheck(glGetBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, meshData.indexData[i].indexCount * sizeof(std::uint32_t), destIndices[i].data()));
-            break;
-        }
-    }
-    glCheck(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    //this also converts any quantised attributes and index formats
+    cro::Mesh::readVertexData(meshData, destVerts, destIndices);
 }
\ No newline at end of file
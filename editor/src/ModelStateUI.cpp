@@ -841,6 +841,9 @@ void ModelState::drawInspector()
                     {
                         ImGui::Checkbox("Export Animations", &m_exportAnimation);
                     }
+                    ImGui::Checkbox("Quantise Vertex Data", &m_exportQuantised);
+                    ImGui::SameLine();
+                    helpMarker("Stores normals, colours and UV coordinates in smaller formats, roughly halving the file size and GPU memory used by the model, at the cost of some precision.");
                     if (ImGui::Button("Convert##01"))
                     {
                         exportModel(modelOnly);
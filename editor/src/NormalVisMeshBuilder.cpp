@@ -36,7 +36,7 @@ NormalVisMeshBuilder::NormalVisMeshBuilder(cro::Mesh::Data data, const std::vect
 
 cro::Mesh::Data NormalVisMeshBuilder::build() const
 {
-    auto vertexSize = m_sourceData.vertexSize / sizeof(float);
+    auto vertexSize = cro::Mesh::getFloatVertexSize(m_sourceData) / sizeof(float);
 
     std::size_t normalOffset = 0;
     std::size_t tanOffset = 0;
@@ -353,6 +353,11 @@ void ParticleState::drawInspector()
             {
                 m_particleSettings->blendmode = static_cast<cro::EmitterSettings::BlendMode>(m_selectedBlendMode);
             }
+
+            //depth sort
+            ImGui::Checkbox("Depth Sort", &m_particleSettings->depthSort);
+            ImGui::SameLine();
+            uiConst::showToolTip("Draw particles back to front. Only affects alpha blended particles, and has a performance cost");
             
             //open tetxure
             if (m_particleSettings->texturePath.empty())
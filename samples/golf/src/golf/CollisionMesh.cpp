@@ -59,6 +59,7 @@ void CollisionMesh::updateCollisionMesh(const cro::Mesh::Data& meshData)
 {
     clearCollisionObjects();
     cro::Mesh::readVertexData(meshData, m_vertexData, m_indexData);
+    const auto vertexSize = cro::Mesh::getFloatVertexSize(meshData);
 
     std::int32_t colourOffset = 0;
     for (auto i = 0; i < cro::Mesh::Attribute::Colour; ++i)
@@ -74,14 +75,14 @@ void CollisionMesh::updateCollisionMesh(const cro::Mesh::Data& meshData)
         btIndexedMesh groundMesh;
         groundMesh.m_vertexBase = reinterpret_cast<std::uint8_t*>(m_vertexData.data());
         groundMesh.m_numVertices = meshData.vertexCount;
-        groundMesh.m_vertexStride = meshData.vertexSize;
+        groundMesh.m_vertexStride = static_cast<std::int32_t>(vertexSize);
 
         groundMesh.m_numTriangles = meshData.indexData[i].indexCount / 3;
         groundMesh.m_triangleIndexBase = reinterpret_cast<std::uint8_t*>(m_indexData[i].data());
         groundMesh.m_triangleIndexStride = 3 * sizeof(std::uint32_t);
 
         
-        float terrain = std::min(1.f, std::max(0.f, m_vertexData[(m_indexData[i][0] * (meshData.vertexSize / sizeof(float))) + colourOffset])) * 255.f;
+        float terrain = std::min(1.f, std::max(0.f, m_vertexData[(m_indexData[i][0] * (vertexSize / sizeof(float))) + colourOffset])) * 255.f;
         terrain = std::floor(terrain / 10.f);
         if (terrain >= TerrainID::Hole)
         {
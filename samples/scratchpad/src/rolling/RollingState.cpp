@@ -378,7 +378,7 @@ void RollingState::parseStaticMesh(cro::Entity entity)
     m_triangleVerts = std::make_unique<rp::TriangleVertexArray>(
         static_cast<std::uint32_t>(m_vertexData.size()),
         (void*)m_vertexData.data(),
-        static_cast<std::uint32_t>(meshData.vertexSize),
+        static_cast<std::uint32_t>(cro::Mesh::getFloatVertexSize(meshData)),
         static_cast<std::uint32_t>(m_indexData[0].size() / 3),
         (void*)m_indexData[0].data(),
         static_cast<std::uint32_t>(3 * sizeof(std::uint32_t)),
@@ -347,7 +347,7 @@ void VatsState::createNormalTexture()
         {
             std::vector<std::uint8_t> positionBuffer(meshData.vertexCount * 3);
             std::vector<std::uint8_t> normalBuffer(meshData.vertexCount * 3);
-            const auto stride = meshData.vertexSize / sizeof(float);
+            const auto stride = cro::Mesh::getFloatVertexSize(meshData) / sizeof(float);
 
             std::size_t normalOffset = 0;
             for (auto i = 0u; i < cro::Mesh::Attribute::Normal; ++i)
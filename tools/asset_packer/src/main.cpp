@@ -0,0 +1,55 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+/*
+Packs a directory of assets into an archive which can be
+mounted with cro::FileSystem::mountArchive()
+
+Usage: asset_packer <source directory> <output file>
+
+The source directory is usually the working directory of
+the application, so that paths such as "assets/images/a.png"
+can be found in the archive without modification.
+*/
+
+#include <crogine/core/FileSystem.hpp>
+
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    if (argc != 3)
+    {
+        std::cout << "Usage: asset_packer <source directory> <output file>\n";
+        return 1;
+    }
+
+    return cro::FileSystem::createArchive(argv[1], argv[2]) ? 0 : 1;
+}
@@ -0,0 +1,426 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+/*
+Checks the round trip accuracy of cro::BitWriter and cro::BitReader,
+including edge cases such as values at the limits of their ranges and
+truncated or malformed data, then measures their throughput.
+
+Usage: bitstream_test [iterations]
+
+Returns 0 if all checks pass, else prints each failure and returns 1.
+iterations is the number of values written and read when measuring
+throughput, which defaults to 1000000.
+*/
+
+#include <crogine/network/BitStream.hpp>
+#include <crogine/core/HiResTimer.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::uint32_t failCount = 0;
+
+    void check(bool result, const std::string& description)
+    {
+        if (!result)
+        {
+            std::cout << "FAILED: " << description << "\n";
+            failCount++;
+        }
+    }
+
+    void testRangedInt()
+    {
+        struct Range final
+        {
+            std::int32_t min = 0;
+            std::int32_t max = 0;
+        };
+
+        const std::vector<Range> ranges =
+        {
+            { 0, 1 }, { -1, 1 }, { -100, 100 }, { 0, 255 }, { 0, 256 },
+            { std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max() },
+            { std::numeric_limits<std::int32_t>::max() - 1, std::numeric_limits<std::int32_t>::max() },
+            { std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::min() + 1 }
+        };
+
+        for (const auto [min, max] : ranges)
+        {
+            const auto name = " in range " + std::to_string(min) + " to " + std::to_string(max);
+
+            cro::BitWriter writer;
+            writer.writeInt(min, min, max);
+            writer.writeInt(max, min, max);
+            writer.writeInt(static_cast<std::int32_t>((static_cast<std::int64_t>(min) + max) / 2), min, max);
+
+            //out of range values are clamped
+            writer.writeInt(std::numeric_limits<std::int32_t>::min(), min, max);
+            writer.writeInt(std::numeric_limits<std::int32_t>::max(), min, max);
+
+            const auto bits = cro::bitsRequired(static_cast<std::uint32_t>(static_cast<std::int64_t>(max) - min));
+            check(writer.getBitCount() == bits * 5, "ranged int bit count" + name);
+
+            cro::BitReader reader(writer.getData(), writer.getSize());
+            check(reader.readInt(min, max) == min, "ranged int min" + name);
+            check(reader.readInt(min, max) == max, "ranged int max" + name);
+            check(reader.readInt(min, max) == static_cast<std::int32_t>((static_cast<std::int64_t>(min) + max) / 2), "ranged int mid" + name);
+            check(reader.readInt(min, max) == min, "ranged int clamp below" + name);
+            check(reader.readInt(min, max) == max, "ranged int clamp above" + name);
+            check(!reader.overflowed(), "ranged int overflow" + name);
+        }
+    }
+
+    void testQuantisedFloat()
+    {
+        struct Range final
+        {
+            float min = 0.f;
+            float max = 0.f;
+            float precision = 0.f;
+        };
+
+        const std::vector<Range> ranges =
+        {
+            { 0.f, 1.f, 0.01f }, { -512.f, 512.f, 0.01f }, { -1.f, 1.f, 0.001f },
+            { 0.f, 1000000000.f, 0.1f }, { -1000000000.f, 1000000000.f, 0.0001f },
+            { 0.f, 1.f, 2.f }
+        };
+
+        for (const auto [min, max, precision] : ranges)
+        {
+            const auto name = " in range " + std::to_string(min) + " to " + std::to_string(max) + " with precision " + std::to_string(precision);
+
+            //the read value may differ from a float by the precision of the float
+            //itself as well as the quantisation. At most 32 bits are written, so
+            //precision finer than 1/2^32 of the range is not possible
+            const auto stepSize = std::max(precision, static_cast<float>((static_cast<double>(max) - min) / std::numeric_limits<std::uint32_t>::max()));
+            const auto tolerance = [=](float value)
+            {
+                return std::max(stepSize, std::abs(value) * std::numeric_limits<float>::epsilon() * 2.f);
+            };
+
+            const std::vector<float> values =
+            {
+                min, max, min + precision, max - precision, (min + max) / 2.f
+            };
+
+            cro::BitWriter writer;
+            for (auto v : values)
+            {
+                writer.writeFloat(v, min, max, precision);
+            }
+            writer.writeFloat(min - 1000.f, min, max, precision);
+            writer.writeFloat(max + 1000.f, min, max, precision);
+            writer.writeFloat(-std::numeric_limits<float>::infinity(), min, max, precision);
+            writer.writeFloat(std::numeric_limits<float>::infinity(), min, max, precision);
+            writer.writeFloat(std::numeric_limits<float>::quiet_NaN(), min, max, precision);
+
+            cro::BitReader reader(writer.getData(), writer.getSize());
+            for (auto v : values)
+            {
+                const auto result = reader.readFloat(min, max, precision);
+                check(result >= min && result <= max, "quantised float " + std::to_string(v) + " out of range" + name);
+                check(std::abs(result - v) <= tolerance(v), "quantised float " + std::to_string(v) + " read as " + std::to_string(result) + name);
+            }
+
+            check(reader.readFloat(min, max, precision) == min, "quantised float clamp below" + name);
+            check(reader.readFloat(min, max, precision) == max, "quantised float clamp above" + name);
+            check(reader.readFloat(min, max, precision) == min, "quantised float -inf" + name);
+            check(reader.readFloat(min, max, precision) == max, "quantised float +inf" + name);
+
+            const auto nan = reader.readFloat(min, max, precision);
+            check(nan >= min && nan <= max, "quantised float NaN" + name);
+
+            check(!reader.overflowed(), "quantised float overflow" + name);
+        }
+    }
+
+    void testQuaternion()
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+        std::vector<glm::quat> rotations =
+        {
+            glm::quat(1.f, 0.f, 0.f, 0.f), glm::quat(-1.f, 0.f, 0.f, 0.f),
+            glm::quat(0.f, 1.f, 0.f, 0.f), glm::quat(0.f, 0.f, 0.f, -1.f),
+            glm::normalize(glm::quat(1.f, 1.f, 0.f, 0.f)), glm::normalize(glm::quat(1.f, -1.f, 1.f, -1.f))
+        };
+
+        for (auto i = 0; i < 10000; ++i)
+        {
+            glm::quat q(dist(rng), dist(rng), dist(rng), dist(rng));
+            if (glm::length(q) > 0.001f)
+            {
+                rotations.push_back(glm::normalize(q));
+            }
+        }
+
+        for (auto bitCount = 2u; bitCount < 16u; ++bitCount)
+        {
+            const auto name = " with " + std::to_string(bitCount) + " bits per component";
+
+            cro::BitWriter writer;
+            for (const auto& q : rotations)
+            {
+                writer.writeQuat(q, bitCount);
+            }
+            check(writer.getBitCount() == rotations.size() * (2 + (bitCount * 3)), "quaternion bit count" + name);
+
+            //each component is quantised over the range +/- 1/sqrt(2), and
+            //the error of the derived largest component is slightly greater
+            const float tolerance = 2.5f / static_cast<float>((1u << bitCount) - 1);
+
+            float maxError = 0.f;
+            cro::BitReader reader(writer.getData(), writer.getSize());
+            for (const auto& q : rotations)
+            {
+                const auto result = reader.readQuat(bitCount);
+                check(std::abs(glm::length(result) - 1.f) < 0.0001f, "quaternion not normalised" + name);
+
+                //q and -q are the same rotation
+                const auto expected = glm::dot(q, result) < 0.f ? -q : q;
+                for (auto j = 0; j < 4; ++j)
+                {
+                    maxError = std::max(maxError, std::abs(expected[j] - result[j]));
+                }
+            }
+            check(maxError <= tolerance, "quaternion component error " + std::to_string(maxError) + name);
+            check(!reader.overflowed(), "quaternion overflow" + name);
+        }
+    }
+
+    void testVarInt()
+    {
+        struct Value final
+        {
+            std::uint32_t value = 0;
+            std::size_t bitCount = 0;
+        };
+
+        const std::vector<Value> unsignedValues =
+        {
+            { 0, 8 }, { 127, 8 }, { 128, 16 }, { 16383, 16 }, { 16384, 24 },
+            { 2097151, 24 }, { 2097152, 32 }, { 268435455, 32 }, { 268435456, 40 },
+            { std::numeric_limits<std::uint32_t>::max(), 40 }
+        };
+
+        for (const auto [value, bitCount] : unsignedValues)
+        {
+            cro::BitWriter writer;
+            writer.writeVarUInt(value);
+            check(writer.getBitCount() == bitCount, "var uint bit count for " + std::to_string(value));
+
+            cro::BitReader reader(writer.getData(), writer.getSize());
+            check(reader.readVarUInt() == value, "var uint " + std::to_string(value));
+            check(!reader.overflowed(), "var uint overflow for " + std::to_string(value));
+        }
+
+        const std::vector<std::int32_t> signedValues =
+        {
+            0, -1, 1, -64, 63, -65, 64,
+            std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max()
+        };
+
+        for (const auto value : signedValues)
+        {
+            cro::BitWriter writer;
+            writer.writeVarInt(value);
+            check(writer.getBitCount() <= 40, "var int bit count for " + std::to_string(value));
+
+            cro::BitReader reader(writer.getData(), writer.getSize());
+            check(reader.readVarInt() == value, "var int " + std::to_string(value));
+            check(!reader.overflowed(), "var int overflow for " + std::to_string(value));
+        }
+
+        //small values of either sign use a single byte
+        cro::BitWriter writer;
+        writer.writeVarInt(-64);
+        writer.writeVarInt(63);
+        check(writer.getBitCount() == 16, "var int small values");
+    }
+
+    void testOverflow()
+    {
+        cro::BitWriter writer;
+        writer.writeInt(1000, 0, 10000);
+        writer.writeFloat(3.14159f);
+        writer.writeQuat(glm::quat(1.f, 0.f, 0.f, 0.f));
+        writer.writeVarUInt(std::numeric_limits<std::uint32_t>::max());
+
+        //every truncation of a valid packet is detected
+        for (auto size = 0u; size < writer.getSize(); ++size)
+        {
+            cro::BitReader reader(writer.getData(), size);
+            reader.readInt(0, 10000);
+            reader.readFloat();
+            reader.readQuat();
+            const auto value = reader.readVarUInt();
+            check(reader.overflowed(), "truncation to " + std::to_string(size) + " bytes not detected");
+            check(reader.getRemainingBits() == 0, "truncated read did not stop at the end of the data");
+            check(value == 0, "truncated var uint did not return 0");
+        }
+
+        cro::BitReader reader(writer.getData(), writer.getSize());
+        check(reader.readInt(0, 10000) == 1000, "packet int");
+        check(reader.readFloat() == 3.14159f, "packet float");
+        reader.readQuat();
+        check(reader.readVarUInt() == std::numeric_limits<std::uint32_t>::max(), "packet var uint");
+        check(!reader.overflowed(), "packet overflow");
+
+        //reading into the padding of the final byte is allowed, beyond it is not
+        reader.readBits(static_cast<std::uint32_t>(reader.getRemainingBits()));
+        check(!reader.overflowed(), "padding read overflow");
+        check(reader.readBits(1) == 0 && reader.overflowed(), "read past end not detected");
+
+        //more than 5 bytes in a var int is malformed
+        const std::uint8_t malformed[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+        cro::BitReader varReader(malformed, sizeof(malformed));
+        check(varReader.readVarUInt() == 0 && varReader.overflowed(), "malformed var uint not detected");
+
+        cro::BitReader emptyReader(nullptr, 0);
+        check(emptyReader.readBool() == false && emptyReader.overflowed(), "empty read not detected");
+
+        std::uint8_t bytes[4] = { 1, 2, 3, 4 };
+        cro::BitReader byteReader(malformed, 2);
+        byteReader.readBytes(bytes, sizeof(bytes));
+        check(byteReader.overflowed(), "byte array overflow not detected");
+    }
+
+    void testThroughput(std::size_t iterations)
+    {
+        std::mt19937 rng(5678);
+        std::uniform_real_distribution<float> dist(-1.f, 1.f);
+
+        //a typical entity update of a position, rotation and some state
+        struct Update final
+        {
+            std::uint32_t id = 0;
+            glm::vec3 position = glm::vec3(0.f);
+            glm::quat rotation = glm::quat(1.f, 0.f, 0.f, 0.f);
+            std::int32_t state = 0;
+            bool active = false;
+        };
+
+        std::vector<Update> updates(1024);
+        for (auto i = 0u; i < updates.size(); ++i)
+        {
+            auto& u = updates[i];
+            u.id = i * 37;
+            u.position = glm::vec3(dist(rng), dist(rng), dist(rng)) * 500.f;
+            u.rotation = glm::normalize(glm::quat(dist(rng), dist(rng), dist(rng), dist(rng)));
+            u.state = static_cast<std::int32_t>(dist(rng) * 16.f);
+            u.active = dist(rng) > 0.f;
+        }
+
+        //7 values per update, counting each component of the position
+        const auto updateCount = std::max(std::size_t(1), iterations / 7);
+        cro::BitWriter writer(updateCount * 16);
+
+        cro::HiResTimer timer;
+        for (auto i = 0u; i < updateCount; ++i)
+        {
+            const auto& u = updates[i % updates.size()];
+            writer.writeVarUInt(u.id);
+            writer.writeVec3(u.position, -512.f, 512.f, 0.01f);
+            writer.writeQuat(u.rotation);
+            writer.writeInt(u.state, -16, 16);
+            writer.writeBool(u.active);
+        }
+        const auto writeTime = timer.restart();
+
+        std::uint32_t checksum = 0;
+        cro::BitReader reader(writer.getData(), writer.getSize());
+        for (auto i = 0u; i < updateCount; ++i)
+        {
+            checksum += reader.readVarUInt();
+            const auto position = reader.readVec3(-512.f, 512.f, 0.01f);
+            const auto rotation = reader.readQuat();
+            checksum += static_cast<std::uint32_t>(reader.readInt(-16, 16));
+            checksum += reader.readBool() ? 1 : 0;
+            checksum += static_cast<std::uint32_t>(position.x + rotation.w);
+        }
+        const auto readTime = timer.restart();
+        check(!reader.overflowed(), "throughput overflow");
+
+        const auto valueCount = static_cast<float>(updateCount * 7);
+        const auto megabytes = static_cast<float>(writer.getSize()) / (1024.f * 1024.f);
+
+        std::cout << updateCount << " updates in " << writer.getSize() << " bytes ("
+            << static_cast<float>(writer.getBitCount()) / updateCount << " bits per update, checksum " << checksum << ")\n";
+        std::cout << "Write: " << (valueCount / std::max(writeTime, 0.000001f)) / 1000000.f << " million values/s, "
+            << megabytes / std::max(writeTime, 0.000001f) << " MB/s\n";
+        std::cout << "Read:  " << (valueCount / std::max(readTime, 0.000001f)) / 1000000.f << " million values/s, "
+            << megabytes / std::max(readTime, 0.000001f) << " MB/s\n";
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::size_t iterations = 1000000;
+    if (argc > 1)
+    {
+        try
+        {
+            iterations = std::stoul(argv[1]);
+        }
+        catch (...)
+        {
+            std::cout << "Usage: bitstream_test [iterations]\n";
+            return 1;
+        }
+    }
+
+    testRangedInt();
+    testQuantisedFloat();
+    testQuaternion();
+    testVarInt();
+    testOverflow();
+
+    if (failCount)
+    {
+        std::cout << failCount << " checks failed\n";
+        return 1;
+    }
+    std::cout << "All checks passed\n";
+
+    testThroughput(iterations);
+    return 0;
+}
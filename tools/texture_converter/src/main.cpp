@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------------
+
+Matt Marchant 2022
+http://trederia.blogspot.com
+
+crogine - Zlib license.
+
+This software is provided 'as-is', without any express or
+implied warranty.In no event will the authors be held
+liable for any damages arising from the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute
+it freely, subject to the following restrictions :
+
+1. The origin of this software must not be misrepresented;
+you must not claim that you wrote the original software.
+If you use this software in a product, an acknowledgment
+in the product documentation would be appreciated but
+is not required.
+
+2. Altered source versions must be plainly marked as such,
+and must not be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any
+source distribution.
+
+-----------------------------------------------------------------------*/
+
+
+
+/*
+Converts an image to a block compressed .dds file with a
+full mip chain, which can be loaded with cro::Texture
+
+Usage: texture_converter <input image> <output file> [options]
+
+Options:
+    -bc1, -bc3, -bc4, -bc5  Compression format. By default this is
+                            chosen based on the input image channels
+    -linear                 Filter mip levels without gamma correction.
+                            Use this for normal maps or other non-colour data
+    -repeat                 Wrap the mip filter at the image edges, for tiled textures
+    -nomips                 Only write the top level of the image
+*/
+
+#include <crogine/graphics/TextureCompression.hpp>
+
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: texture_converter <input image> <output file> [-bc1|-bc3|-bc4|-bc5] [-linear] [-repeat] [-nomips]\n";
+        return 1;
+    }
+
+    cro::TextureCompression::Settings settings;
+    for (auto i = 3; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-bc1")
+        {
+            settings.format = cro::TextureCompression::Format::BC1;
+        }
+        else if (arg == "-bc3")
+        {
+            settings.format = cro::TextureCompression::Format::BC3;
+        }
+        else if (arg == "-bc4")
+        {
+            settings.format = cro::TextureCompression::Format::BC4;
+        }
+        else if (arg == "-bc5")
+        {
+            settings.format = cro::TextureCompression::Format::BC5;
+        }
+        else if (arg == "-linear")
+        {
+            settings.gammaCorrect = false;
+        }
+        else if (arg == "-repeat")
+        {
+            settings.repeated = true;
+        }
+        else if (arg == "-nomips")
+        {
+            settings.generateMipMaps = false;
+        }
+        else
+        {
+            std::cout << "Unknown option " << arg << "\n";
+            return 1;
+        }
+    }
+
+    return cro::TextureCompression::compress(std::string(argv[1]), std::string(argv[2]), settings) ? 0 : 1;
+}